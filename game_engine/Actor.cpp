@@ -6,9 +6,23 @@
 //
 
 #include "Actor.hpp"
-#include "Helper.h"
+#include "Time.hpp"
 #include "SceneDB.hpp"
+#include "Rigidbody.hpp"
+#include "Transform.hpp"
+#include "SpriteRenderer.hpp"
+#include "CharacterController2D.hpp"
 
+namespace {
+    /// Whether a C++ userdata component is of the requested native type.
+    bool IsNativeType(const luabridge::LuaRef& comp, const std::string& type) {
+        if (type == "Rigidbody") return comp.isInstance<Rigidbody>();
+        if (type == "Transform") return comp.isInstance<Transform>();
+        if (type == "SpriteRenderer") return comp.isInstance<SpriteRenderer>();
+        if (type == "CharacterController2D") return comp.isInstance<CharacterController2D>();
+        return false;
+    }
+}
 
 luabridge::LuaRef Actor::GetComponentByKey(const std::string & key) {
     auto it = components.find(key);
@@ -31,7 +45,10 @@ luabridge::LuaRef Actor::GetComponent(const std::string & type) {
         if (it == components.end()) continue;
         
         const auto& compRef = *(it->second);
-        if (type == "Rigidbody" && compRef.isUserdata()) return compRef;
+        if (compRef.isUserdata()) {
+            if (IsNativeType(compRef, type)) return compRef;
+            continue;
+        }
         
         if (compRef["type"] == type && compRef["enabled"])
             return compRef;
@@ -50,7 +67,7 @@ luabridge::LuaRef Actor::GetComponents(const std::string & type) {
         
         const auto& compRef = *(it->second);
         if (compRef.isUserdata()) {
-            if (type == "Rigidbody")
+            if (IsNativeType(compRef, type))
                 ret[idx++] = compRef;
             continue;
         }
@@ -68,6 +85,7 @@ luabridge::LuaRef Actor::AddComponent(const std::string& type) {
     
     components[comp_key] = component_ref;
     component_keys.insert(comp_key);
+    ++component_version;
     InjectReference(component_ref);
 
     // Special handling for different component types
@@ -77,11 +95,17 @@ luabridge::LuaRef Actor::AddComponent(const std::string& type) {
             this->id,
             comp_key,
             true,  // isNew
-            Helper::GetFrameNumber()
+            Time::GetFrameNumber()
         });
+    } else if (type == "Transform") {
+        (*component_ref).cast<Transform*>()->Init(this);
+    } else if (type == "SpriteRenderer") {
+        (*component_ref).cast<SpriteRenderer*>()->Init(this, comp_key);
+    } else if (type == "CharacterController2D") {
+        (*component_ref).cast<CharacterController2D*>()->Init(this);
     } else if ((*component_ref).isTable()) {
         // For Lua table components, add frame_added property
-        (*component_ref)["frame_added"] = Helper::GetFrameNumber();
+        (*component_ref)["frame_added"] = Time::GetFrameNumber();
         (*component_ref)["new_addition"] = true;
         
         if ((*component_ref)["OnStart"].isFunction()) {
@@ -106,6 +130,21 @@ void Actor::RemoveComponent(const luabridge::LuaRef& to_remove) {
     }
 }
 
+void Actor::AddTag(const std::string& tag) {
+    const int bit = SceneDB::InternTag(tag);
+    if (bit >= 0) SceneDB::AddTag(this, bit);
+}
+
+void Actor::RemoveTag(const std::string& tag) {
+    const int bit = SceneDB::FindTagBit(tag);
+    if (bit >= 0) SceneDB::RemoveTag(this, bit);
+}
+
+bool Actor::HasTag(const std::string& tag) {
+    const int bit = SceneDB::FindTagBit(tag);
+    return bit >= 0 && (tags & (uint64_t(1) << bit)) != 0;
+}
+
 void Actor::InjectReference(std::shared_ptr<luabridge::LuaRef> comp_ref) {
     luabridge::LuaRef comp = *comp_ref;
     if (comp.isTable())
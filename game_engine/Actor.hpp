@@ -18,6 +18,7 @@
 #include <vector>
 #include <memory>
 #include <set>
+#include <array>
 #include "lua/lua.hpp"
 #include "LuaBridge/LuaBridge.h"
 #include "ComponentDB.hpp"
@@ -36,6 +37,8 @@ class ComponentDB;
  * - Lua scripting: All components are Lua tables with lifecycle methods
  * - Dynamic composition: Components can be added/removed at runtime
  * - Unique identification: Each actor has a globally unique 64-bit ID
+ * - Tags: a bitset of names interned by SceneDB, declared under "tags" in
+ *   templates and scenes or changed at runtime with AddTag/RemoveTag
  *
  * Component Lifecycle:
  * - OnStart(): Called once on the first frame after component creation
@@ -63,6 +66,24 @@ public:
     /// If true, actor persists across scene transitions (see SceneDB::DontDestroy)
     bool dont_destroy = false;
 
+    /// Additive scene that loaded this actor; empty for the main scene and runtime spawns
+    std::string scene;
+
+    /// Maximum number of distinct tag names per world
+    static constexpr int MAX_TAGS = 64;
+
+    /// Tag bitset; bit numbers come from SceneDB::InternTag
+    uint64_t tags = 0;
+
+    /// Position of this actor in each set tag's SceneDB::tag_members list
+    std::array<int, MAX_TAGS> tag_slots{};
+
+    /// WorldStreaming cell this actor is filed under; -1 when not streamed
+    int stream_cell = -1;
+
+    /// Set while WorldStreaming has the actor frozen (no updates, no body)
+    bool frozen = false;
+
     /**
      * @brief Gets the actor's name.
      *
@@ -77,6 +98,12 @@ public:
      */
     uint64_t GetID() {return id;}
 
+    /// Whether WorldStreaming has frozen the actor.
+    bool IsFrozen() {return frozen;}
+
+    /// Whether the actor outlives Scene.Load: DontDestroy or from an additive scene.
+    bool IsResident() const {return dont_destroy || !scene.empty();}
+
     /// Map of component key -> Lua component reference (LuaBridge wrapper)
     std::unordered_map<std::string, std::shared_ptr<luabridge::LuaRef>> components;
 
@@ -86,6 +113,10 @@ public:
     /// Set of all component keys for fast lookup
     std::set<std::string> component_keys;
 
+    /// Bumped whenever a component is added or removed, so native components
+    /// that cache pointers to their siblings know to look them up again.
+    uint32_t component_version = 0;
+
     /**
      * @brief Gets a component by its unique key.
      *
@@ -137,6 +168,21 @@ public:
      */
     void RemoveComponent(const luabridge::LuaRef & to_remove);
 
+    /**
+     * @brief Adds a tag (O(1)); the name is interned on first use.
+     */
+    void AddTag(const std::string& tag);
+
+    /**
+     * @brief Removes a tag (O(1)); unknown tags are ignored.
+     */
+    void RemoveTag(const std::string& tag);
+
+    /**
+     * @brief Checks whether the actor carries a tag.
+     */
+    bool HasTag(const std::string& tag);
+
     /**
      * @brief Injects a component reference (used by SceneDB during actor instantiation).
      *
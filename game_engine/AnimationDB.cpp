@@ -20,7 +20,7 @@ void AnimationDB::Clear() {
 
 void AnimationDB::Update(float dt) {
     for (auto& [key, state] : active_animations) {
-        if (!state.playing) {
+        if (!state.playing || state.paused) {
             continue;
         }
 
@@ -76,6 +76,7 @@ void AnimationDB::Play(const std::string& key, const std::string& anim_name, boo
         state.current_frame = 0;
     }
     state.playing = true;
+    state.paused = false;
     state.loop = loop;
 }
 
@@ -86,6 +87,13 @@ void AnimationDB::Stop(const std::string& key) {
     }
 }
 
+void AnimationDB::SetPaused(const std::string& key, bool paused) {
+    auto it = active_animations.find(key);
+    if (it != active_animations.end()) {
+        it->second.paused = paused;
+    }
+}
+
 void AnimationDB::SetFrame(const std::string& key, int frame) {
     auto it = active_animations.find(key);
     if (it == active_animations.end()) {
@@ -174,6 +182,30 @@ std::string AnimationDB::GetSpritesheet(const std::string& key) {
     return anim_it->second.spritesheet;
 }
 
+const std::string* AnimationDB::GetFrame(const std::string& key, SDL_Rect& rect) {
+    auto state_it = active_animations.find(key);
+    if (state_it == active_animations.end()) {
+        return nullptr;
+    }
+
+    const AnimationState& state = state_it->second;
+    auto anim_it = animations.find(state.current_anim);
+    if (anim_it == animations.end()) {
+        return nullptr;
+    }
+
+    const AnimationDef& def = anim_it->second;
+    rect.x = state.current_frame * def.frame_width;
+    rect.y = 0;
+    rect.w = def.frame_width;
+    rect.h = def.frame_height;
+    return &def.spritesheet;
+}
+
+void AnimationDB::Remove(const std::string& key) {
+    active_animations.erase(key);
+}
+
 bool AnimationDB::HasAnimation(const std::string& name) {
     return animations.find(name) != animations.end();
 }
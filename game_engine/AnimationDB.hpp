@@ -26,6 +26,7 @@ struct AnimationState {
     int current_frame = 0;
     bool playing = false;
     bool loop = true;
+    bool paused = false;
 };
 
 class AnimationDB {
@@ -42,6 +43,8 @@ public:
     static void Play(const std::string& key, const std::string& anim_name, bool loop = true);
     static void Stop(const std::string& key);
     static void SetFrame(const std::string& key, int frame);
+    // Hold a key's playback where it is, e.g. while its actor is frozen
+    static void SetPaused(const std::string& key, bool paused);
 
     // Query state
     static bool IsPlaying(const std::string& key);
@@ -54,10 +57,17 @@ public:
     // Get the spritesheet name for a playing animation
     static std::string GetSpritesheet(const std::string& key);
 
+    // Source rect and spritesheet in one lookup; nullptr when nothing is
+    // assigned to the key. The name stays valid until the animation is redefined.
+    static const std::string* GetFrame(const std::string& key, SDL_Rect& rect);
+
+    // Forget a key's playback state (its owner is gone)
+    static void Remove(const std::string& key);
+
     static bool HasAnimation(const std::string& name);
 
 private:
-    inline static std::unordered_map<std::string, AnimationDef> animations;
-    inline static std::unordered_map<std::string, AnimationState> active_animations;
+    inline static thread_local std::unordered_map<std::string, AnimationDef> animations;
+    inline static thread_local std::unordered_map<std::string, AnimationState> active_animations;
 };
 
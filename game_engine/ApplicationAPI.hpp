@@ -4,7 +4,8 @@
 #include <chrono>
 #include <thread>
 #include <string>
-#include "Helper.h"
+#include "Time.hpp"
+#include "EngineContext.hpp"
 
 #ifdef _WIN32
     #define PLATFORM_COMMAND "start "
@@ -15,15 +16,25 @@
 #endif
 
 namespace ApplicationAPI {
-    inline void Quit() { std::exit(0); }
+    inline void Quit() {
+        // Worlds may run off the main thread or share the process with
+        // others; ask the loop driving this one to stop after the frame.
+        EngineContext* context = EngineContext::Current();
+        if (context) {
+            context->RequestQuit();
+            return;
+        }
+        std::exit(0);
+    }
 
     inline void Sleep(int milliseconds) {
         std::this_thread::sleep_for(std::chrono::milliseconds(milliseconds));
     }
 
-    inline int GetFrame() { return Helper::GetFrameNumber(); }
+    inline int GetFrame() { return Time::GetFrameNumber(); }
 
     inline void OpenURL(const std::string& url) {
+        if (EngineContext::IsHeadlessThread()) return;
         std::string command = PLATFORM_COMMAND + url;
         std::system(command.c_str());
     }
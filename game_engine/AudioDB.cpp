@@ -13,8 +13,10 @@
 #include "Logger.hpp"
 #include "EngineException.hpp"
 #include "ConfigManager.hpp"
+#include "EngineContext.hpp"
 
 void AudioDB::Init() {
+    if (device_open) return;
     if (AudioHelper::Mix_OpenAudio(44100, MIX_DEFAULT_FORMAT, 2, 2048) != 0) {
         std::string error = Mix_GetError();
         LOG_FATAL("SDL_mixer initialization failed: " + error);
@@ -25,9 +27,14 @@ void AudioDB::Init() {
         LOG_FATAL("SDL_mixer channel allocation failed: " + error);
         throw AudioException("SDL_mixer channel allocation failed: " + error);
     }
+    device_open = true;
+    LOG_DEBUG("Audio device opened on first use");
 }
 
 void AudioDB::PlayChannel(int channel, const std::string &audio_clip_name, bool does_loop) {
+    // The mixer is a process-wide device; headless worlds stay silent.
+    if (EngineContext::IsHeadlessThread()) return;
+    Init();
     int loop = does_loop ? -1 : 0;
     if (loaded_audio.find(audio_clip_name) == loaded_audio.end()) {
         std::string pathWav = ConfigManager::GetResourcesPath() + "audio/" + audio_clip_name + ".wav";
@@ -56,10 +63,14 @@ void AudioDB::PlayChannel(int channel, const std::string &audio_clip_name, bool
 }
 
 void AudioDB::HaltChannel(int channel) {
+    // Nothing can be playing before the device is opened.
+    if (EngineContext::IsHeadlessThread() || !device_open) return;
     AudioHelper::Mix_HaltChannel(channel);
 }
 
 void AudioDB::SetVolume(int channel, float volume) {
+    if (EngineContext::IsHeadlessThread()) return;
+    Init();
     int vol = static_cast<int>(std::clamp(volume, 0.0f, 1.0f) * 128);
     AudioHelper::Mix_Volume(channel, vol);
 }
@@ -73,7 +84,10 @@ void AudioDB::Shutdown() {
         }
     }
     loaded_audio.clear();
-    AudioHelper::Mix_CloseAudio();
+    if (device_open) {
+        AudioHelper::Mix_CloseAudio();
+        device_open = false;
+    }
 }
 
 bool AudioDB::IsAutograderMode() {
@@ -49,11 +49,12 @@
 class AudioDB {
 public:
     /**
-     * @brief Initializes SDL_mixer audio system.
+     * @brief Opens the SDL_mixer audio device and allocates channels.
      *
      * @throws AudioException if SDL_mixer initialization fails
      *
-     * @note Called automatically by Engine constructor
+     * @note Called lazily by the first PlayChannel/SetVolume, so games that
+     *       never play audio never open the device. Safe to call repeatedly.
      */
     static void Init();
 
@@ -98,6 +99,9 @@ private:
     /// Audio cache: filename -> Mix_Chunk* (loaded sound data)
     static inline std::unordered_map<std::string, Mix_Chunk*> loaded_audio;
 
+    /// True once Init() has opened the mixer device
+    static inline bool device_open = false;
+
     static bool IsAutograderMode();
 
 };
@@ -0,0 +1,339 @@
+//
+//  CharacterController2D.cpp
+//  game_engine
+//
+//  Native platformer movement for an actor's dynamic Rigidbody.
+//
+
+#include "CharacterController2D.hpp"
+#include "Actor.hpp"
+#include "Rigidbody.hpp"
+#include "RigidbodyWorld.hpp"
+#include "box2d/b2_distance.h"
+#include "ComponentDB.hpp"
+#include "SceneDB.hpp"
+#include "Time.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    /// Unit vector against gravity; -y when there is none.
+    b2Vec2 UpDirection() {
+        b2Vec2 up(0.0f, -1.0f);
+        if (b2World* world = RigidbodyWorld::GetWorld()) {
+            const b2Vec2 g = world->GetGravity();
+            if (g.LengthSquared() > 0.0f) {
+                up = -g;
+                up.Normalize();
+            }
+        }
+        return up;
+    }
+
+    /// Direction along a surface with normal `n`, pointing right of it.
+    b2Vec2 Tangent(const b2Vec2& n) {
+        return b2Vec2(-n.y, n.x);
+    }
+
+    class CandidateQuery : public b2QueryCallback {
+    public:
+        CandidateQuery(b2Body* self, std::vector<b2Fixture*>& out) : self(self), out(out) {}
+        bool ReportFixture(b2Fixture* fixture) override {
+            if (fixture->GetBody() != self && !fixture->IsSensor()) out.push_back(fixture);
+            return true;
+        }
+    private:
+        b2Body* self;
+        std::vector<b2Fixture*>& out;
+    };
+
+    /// The test b2ContactFilter::ShouldCollide applies to a fixture pair.
+    bool FiltersCollide(const b2Filter& a, const b2Filter& b) {
+        if (a.groupIndex == b.groupIndex && a.groupIndex != 0) return a.groupIndex > 0;
+        return (a.maskBits & b.categoryBits) != 0 && (b.maskBits & a.categoryBits) != 0;
+    }
+}
+
+void CharacterController2D::Init(Actor* owner) {
+    actor = owner;
+    rb = nullptr;
+    input_x = 0.0f;
+    jump_held = false;
+    jump_held_last = false;
+    jump_pressed = false;
+    jump_buffered = -1.0f;
+    grounded = false;
+    just_landed = false;
+    just_jumped = false;
+    time_ungrounded = 1.0f;
+    ground_normal = b2Vec2(0.0f, -1.0f);
+    ground_velocity.SetZero();
+    ground_gap = 0.0f;
+    has_ground_actor = false;
+    if (registry_index < 0) {
+        registry_index = static_cast<int>(live.size());
+        live.push_back(this);
+    }
+}
+
+void CharacterController2D::OnDestroy() {
+    if (registry_index >= 0) {
+        // Compacted once per frame rather than erased here, so tearing down
+        // many controllers stays linear.
+        live[registry_index] = nullptr;
+        ++destroyed;
+        registry_index = -1;
+    }
+    has_ground_actor = false;
+}
+
+void CharacterController2D::Init() {
+    Clear();
+}
+
+void CharacterController2D::Clear() {
+    for (CharacterController2D* controller : live) {
+        if (controller) controller->registry_index = -1;
+    }
+    live.clear();
+    destroyed = 0;
+    cast_candidates.clear();
+}
+
+void CharacterController2D::Compact() {
+    size_t next = 0;
+    for (CharacterController2D* controller : live) {
+        if (!controller) continue;
+        controller->registry_index = static_cast<int>(next);
+        live[next++] = controller;
+    }
+    live.resize(next);
+    destroyed = 0;
+}
+
+float CharacterController2D::GetGroundAngle() const {
+    if (!grounded) return 0.0f;
+    // Rising to the right means the normal leans left of up.
+    return std::atan2(-ground_normal.x, -ground_normal.y) * (180.0f / b2_pi);
+}
+
+luabridge::LuaRef CharacterController2D::GetGroundActor() const {
+    lua_State* L = ComponentDB::GetLuaState();
+    if (!has_ground_actor) return luabridge::LuaRef(L);
+    auto it = SceneDB::actors.find(ground_actor_id);
+    if (it == SceneDB::actors.end() || it->second->destroyed) return luabridge::LuaRef(L);
+    return luabridge::LuaRef(L, it->second.get());
+}
+
+void CharacterController2D::SetGroundActor(b2Fixture* fixture) {
+    const Actor* ground = reinterpret_cast<const Actor*>(fixture->GetUserData().pointer);
+    has_ground_actor = ground != nullptr;
+    if (ground) ground_actor_id = ground->id;
+}
+
+bool CharacterController2D::ResolveBody() {
+    rb = nullptr;
+    resolved_version = actor->component_version;
+    for (const std::string& key : actor->component_keys) {
+        auto it = actor->components.find(key);
+        if (it == actor->components.end() || !it->second->isUserdata()) continue;
+        const luabridge::LuaRef& comp = *it->second;
+        if (comp.isInstance<Rigidbody>()) {
+            rb = comp.cast<Rigidbody*>();
+            break;
+        }
+    }
+    if (!rb || !rb->HasBody()) return false;
+    // Characters stay upright; corners and slopes must not tip them over.
+    rb->GetBody()->SetFixedRotation(true);
+    return true;
+}
+
+bool CharacterController2D::BodyReady() {
+    if (!rb || resolved_version != actor->component_version) return ResolveBody();
+    if (!rb->HasBody()) return false;
+    // Streaming and snapshot restores create new bodies; keep those upright too.
+    if (!rb->GetBody()->IsFixedRotation()) rb->GetBody()->SetFixedRotation(true);
+    return true;
+}
+
+void CharacterController2D::ApplyAll(float dt) {
+    if (destroyed > 0) Compact();
+    for (CharacterController2D* controller : live) {
+        if (controller->enabled && !controller->actor->destroyed && !controller->actor->frozen) {
+            controller->Apply(dt);
+        }
+    }
+}
+
+void CharacterController2D::ProbeAll() {
+    for (CharacterController2D* controller : live) {
+        if (controller && controller->enabled && !controller->actor->destroyed && !controller->actor->frozen) {
+            controller->Probe();
+        }
+    }
+}
+
+void CharacterController2D::Apply(float dt) {
+    if (!BodyReady()) return;
+    b2Body* body = rb->GetBody();
+
+    const b2Vec2 up = UpDirection();
+    const b2Vec2 right = Tangent(up);
+
+    // Jump presses are edges of the held input, or explicit Jump() calls.
+    if ((jump_held && !jump_held_last) || jump_pressed) jump_buffered = 0.0f;
+    else if (jump_buffered >= 0.0f && (jump_buffered += dt) > jump_buffer) jump_buffered = -1.0f;
+    jump_held_last = jump_held;
+    jump_pressed = false;
+
+    if (grounded) time_ungrounded = 0.0f;
+    else time_ungrounded += dt;
+
+    const float target = std::clamp(input_x, -1.0f, 1.0f) * move_speed;
+    const b2Vec2 velocity = body->GetLinearVelocity();
+    b2Vec2 next;
+    just_jumped = false;
+
+    if (time_ungrounded <= coyote_time && jump_buffered >= 0.0f) {
+        // Keep the ground's sideways speed so a jump off a moving platform
+        // does not launch straight up while it slides away.
+        next = (target + b2Dot(ground_velocity, right)) * right + jump_speed * up;
+        grounded = false;
+        time_ungrounded = coyote_time + 1.0f;
+        jump_buffered = -1.0f;
+        just_jumped = true;
+    }
+    else if (grounded) {
+        next = target * Tangent(ground_normal) + ground_velocity;
+        // Close the gap the probe found over the coming step.
+        const float timestep = RigidbodyWorld::GetPhysicsTimestep();
+        if (ground_gap > 0.0f && timestep > 0.0f) next -= (ground_gap / timestep) * ground_normal;
+        // Cancel this step's gravity so the body rests on slopes.
+        const b2Vec2 gravity = RigidbodyWorld::GetWorld()->GetGravity();
+        body->ApplyForceToCenter(-body->GetGravityScale() * body->GetMass() * gravity, true);
+    }
+    else {
+        float rise = b2Dot(velocity, up);
+        if (rise < -max_fall_speed) rise = -max_fall_speed;
+        if (!jump_held && rise > jump_cut_speed) rise *= jump_cut;
+        next = target * right + rise * up;
+    }
+
+    body->SetLinearVelocity(next);
+    if (target != 0.0f || just_jumped) body->SetAwake(true);
+    input_x = 0.0f;
+}
+
+void CharacterController2D::Probe() {
+    if (!BodyReady()) return;
+    b2Body* body = rb->GetBody();
+
+    const bool was_grounded = grounded;
+    const b2Vec2 up = UpDirection();
+    const float min_dot = std::cos(max_slope * (b2_pi / 180.0f));
+
+    grounded = false;
+    ground_gap = 0.0f;
+    has_ground_actor = false;
+    ground_velocity.SetZero();
+    ground_normal = up;
+
+    // Touching contacts first. Disabled ones (one-way pass-throughs, ignore
+    // rules) are not ground.
+    float best = min_dot;
+    for (b2ContactEdge* edge = body->GetContactList(); edge; edge = edge->next) {
+        b2Contact* c = edge->contact;
+        if (!c->IsTouching() || !c->IsEnabled()) continue;
+        b2Fixture* A = c->GetFixtureA();
+        b2Fixture* B = c->GetFixtureB();
+        if (A->IsSensor() || B->IsSensor()) continue;
+
+        b2WorldManifold wm;
+        c->GetWorldManifold(&wm);
+        // The manifold normal points from A to B; we want it pointing at us.
+        const bool self_is_b = B->GetBody() == body;
+        const b2Vec2 n = self_is_b ? wm.normal : -wm.normal;
+        const float d = b2Dot(n, up);
+        if (d < best) continue;
+
+        b2Fixture* other = self_is_b ? A : B;
+        const b2Vec2 other_velocity = other->GetBody()->GetLinearVelocityFromWorldPoint(wm.points[0]);
+        // Leaving the surface (a jump on its way up) is not standing on it.
+        if (b2Dot(body->GetLinearVelocity() - other_velocity, n) > 0.5f) continue;
+
+        best = d;
+        grounded = true;
+        ground_normal = n;
+        ground_velocity = other_velocity;
+        SetGroundActor(other);
+    }
+
+    // Nothing touching: look just below, but only for a body that was on the
+    // ground and is not rising, so walking down a slope or a step stays grounded.
+    if (!grounded && was_grounded && ground_probe > 0.0f && b2Dot(body->GetLinearVelocity(), up) <= 0.5f) {
+        grounded = CastDown(body, up, min_dot);
+    }
+
+    just_landed = grounded && !was_grounded;
+}
+
+bool CharacterController2D::CastDown(b2Body* body, const b2Vec2& up, float min_dot) {
+    const b2Vec2 translation = -ground_probe * up;
+    const b2Transform& self_xf = body->GetTransform();
+    float nearest = 1.0f;
+    bool found = false;
+
+    // Collision filters and ignore rules drop the same surfaces they disable
+    // contacts with.
+    const float now = Time::GetTotalTime();
+    auto ignores = [&](b2Fixture* other) {
+        Rigidbody* other_rb = Rigidbody::FromBody(other->GetBody());
+        const Actor* other_actor = reinterpret_cast<const Actor*>(other->GetUserData().pointer);
+        return (rb->HasIgnoreRules() && other_actor && rb->IsIgnoring(other_actor->id, now))
+            || (other_rb && other_rb->HasIgnoreRules() && other_rb->IsIgnoring(actor->id, now));
+    };
+
+    for (b2Fixture* fixture = body->GetFixtureList(); fixture; fixture = fixture->GetNext()) {
+        if (fixture->IsSensor()) continue;
+
+        b2AABB box = fixture->GetAABB(0);
+        box.lowerBound = b2Min(box.lowerBound, box.lowerBound + translation);
+        box.upperBound = b2Max(box.upperBound, box.upperBound + translation);
+        cast_candidates.clear();
+        CandidateQuery query(body, cast_candidates);
+        RigidbodyWorld::GetWorld()->QueryAABB(&query, box);
+
+        const b2Filter& filter = fixture->GetFilterData();
+        for (b2Fixture* other : cast_candidates) {
+            if (!FiltersCollide(filter, other->GetFilterData()) || ignores(other)) continue;
+            Rigidbody* other_rb = Rigidbody::FromBody(other->GetBody());
+            for (int child = 0; child < other->GetShape()->GetChildCount(); ++child) {
+                b2ShapeCastInput input;
+                input.proxyA.Set(other->GetShape(), child);
+                input.proxyB.Set(fixture->GetShape(), 0);
+                input.transformA = other->GetBody()->GetTransform();
+                input.transformB = self_xf;
+                input.translationB = translation;
+
+                b2ShapeCastOutput output;
+                if (!b2ShapeCast(&output, &input)) continue;
+                // The normal points out of the other shape, toward us.
+                if (b2Dot(output.normal, up) < min_dot || output.lambda >= nearest) continue;
+                // A one-way surface only holds what is above it.
+                if (other_rb && other_rb->one_way
+                    && b2Dot(b2Mul(other->GetBody()->GetTransform().q, b2Vec2(0.0f, -1.0f)), output.normal) <= 0.5f) {
+                    continue;
+                }
+
+                nearest = output.lambda;
+                found = true;
+                ground_normal = output.normal;
+                ground_gap = output.lambda * ground_probe;
+                ground_velocity = other->GetBody()->GetLinearVelocityFromWorldPoint(output.point);
+                SetGroundActor(other);
+            }
+        }
+    }
+    return found;
+}
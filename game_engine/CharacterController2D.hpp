@@ -0,0 +1,151 @@
+//
+//  CharacterController2D.hpp
+//  game_engine
+//
+//  Native platformer movement for an actor's dynamic Rigidbody.
+//
+
+#pragma once
+
+#include "box2d/box2d.h"
+#include "lua/lua.hpp"
+#include "LuaBridge/LuaBridge.h"
+#include <cstdint>
+#include <vector>
+
+class Actor;
+class Rigidbody;
+
+/**
+ * @class CharacterController2D
+ * @brief Runs ground detection, slopes, coyote time, jump buffering and
+ * move-and-slide for its actor's Rigidbody in C++.
+ *
+ * Added like any component (`"type": "CharacterController2D"`) next to a
+ * dynamic Rigidbody, whose rotation it locks. A script calls Move(x, y)
+ * once per frame: x in [-1, 1] scales `move_speed`, and y < 0 (up) means
+ * jump is held. Presses are detected here, so a press buffered up to
+ * `jump_buffer` seconds before landing, or made up to `coyote_time` seconds
+ * after leaving a ledge, still jumps. Releasing jump while rising faster
+ * than `jump_cut_speed` scales the rise by `jump_cut` each step.
+ *
+ * ApplyAll() runs just before the physics step. On the ground, the velocity
+ * follows the ground's tangent plus the ground body's own velocity (so
+ * moving platforms carry the actor) and gravity is cancelled, so the actor
+ * stands still on slopes up to `max_slope` degrees; the Box2D solver does the
+ * sliding against walls and ceilings. ProbeAll() runs right after the step:
+ * the body's touching contacts give the ground, and when there are none
+ * (walking down a slope or a step) its collider is shape-cast `ground_probe`
+ * units down, and the next step snaps it onto what it finds. The cast skips
+ * fixtures the collider would not collide with (collision filters, ignore
+ * rules, one-way surfaces from below). The getters report that post-step
+ * state, so scripts read it in their next OnUpdate.
+ */
+class CharacterController2D {
+public:
+    CharacterController2D() = default;
+
+    float move_speed = 5.0f;
+    float jump_speed = 10.0f;
+    float max_fall_speed = 14.0f;
+    float coyote_time = 0.1f;
+    float jump_buffer = 0.1f;
+    float jump_cut = 0.5f;
+    float jump_cut_speed = 2.5f;
+    /// Steepest walkable ground, in degrees from flat.
+    float max_slope = 50.0f;
+    float ground_probe = 0.1f;
+    bool enabled = true;
+
+    /// Owning actor; nullptr until Init().
+    Actor* actor = nullptr;
+
+    /// Slot in the live list; -1 when not registered.
+    int registry_index = -1;
+
+    /// Registers the controller and resets its runtime state.
+    void Init(Actor* owner);
+
+    /// Unregisters the controller.
+    void OnDestroy();
+
+    /// This frame's input; cleared after every physics step.
+    void Move(float x, float y) { input_x = x; jump_held = y < 0.0f; }
+
+    /// Buffers a jump press, as if jump had just been pressed.
+    void Jump() { jump_pressed = true; }
+
+    bool IsGrounded() const { return grounded; }
+    bool JustLanded() const { return just_landed; }
+    bool JustJumped() const { return just_jumped; }
+    float GetTimeUngrounded() const { return time_ungrounded; }
+    /// Ground slope in degrees, positive when it rises to the right.
+    float GetGroundAngle() const;
+    /// The actor stood on, or nil.
+    luabridge::LuaRef GetGroundActor() const;
+
+    static void Init();
+
+    /// Drives every enabled controller's body. Controllers of actors frozen
+    /// by WorldStreaming are skipped with their state kept. Called before the
+    /// physics step.
+    /// Drops the slots of controllers destroyed since the last call first.
+    static void ApplyAll(float dt);
+
+    /// Refreshes every controller's ground state. Called after the physics step.
+    static void ProbeAll();
+
+    /// Forgets every controller. Called before the scene is torn down.
+    static void Clear();
+
+    static size_t GetCount() { return live.size() - destroyed; }
+
+private:
+    void Apply(float dt);
+    void Probe();
+
+    /// Finds the actor's Rigidbody; false if it has none with a body yet.
+    bool ResolveBody();
+
+    /// The cached Rigidbody with its body, looked up again when the actor's
+    /// components changed since; false if there is none yet.
+    bool BodyReady();
+
+    /// Removes the null slots OnDestroy left, keeping creation order.
+    static void Compact();
+
+    /// Casts the collider down; true with the surface normal and distance
+    /// when walkable ground is within `ground_probe`.
+    bool CastDown(b2Body* body, const b2Vec2& up, float min_dot);
+
+    /// Records the actor owning `fixture` as the ground.
+    void SetGroundActor(b2Fixture* fixture);
+
+    Rigidbody* rb = nullptr;
+    /// The actor's component_version when `rb` was looked up.
+    uint32_t resolved_version = 0;
+
+    float input_x = 0.0f;
+    bool jump_held = false;
+    bool jump_held_last = false;
+    bool jump_pressed = false;
+    /// Seconds since the buffered press, or < 0 when none is pending.
+    float jump_buffered = -1.0f;
+
+    bool grounded = false;
+    bool just_landed = false;
+    bool just_jumped = false;
+    float time_ungrounded = 1.0f;
+    b2Vec2 ground_normal = b2Vec2(0.0f, -1.0f);
+    b2Vec2 ground_velocity = b2Vec2(0.0f, 0.0f);
+    /// Gap to ground found by the shape cast; 0 when touching.
+    float ground_gap = 0.0f;
+    /// Id of the actor stood on, looked up when read; it may be gone by then.
+    uint64_t ground_actor_id = 0;
+    bool has_ground_actor = false;
+
+    /// Creation order; destroyed controllers leave a null slot until Compact().
+    inline static thread_local std::vector<CharacterController2D*> live;
+    inline static thread_local size_t destroyed = 0;
+    inline static thread_local std::vector<b2Fixture*> cast_candidates;
+};
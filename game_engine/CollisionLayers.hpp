@@ -72,10 +72,10 @@ public:
 
 private:
     // Layer name -> bit index (0-15)
-    inline static std::unordered_map<std::string, int> layer_bits;
+    inline static thread_local std::unordered_map<std::string, int> layer_bits;
 
     // Set of layer pairs that should collide (stored as "layer1,layer2" with alphabetical order)
-    inline static std::unordered_set<std::string> collision_matrix;
+    inline static thread_local std::unordered_set<std::string> collision_matrix;
 
     static std::string MakePairKey(const std::string& a, const std::string& b);
 };
@@ -6,6 +6,11 @@
 //
 
 #include "CollisionListener.hpp"
+#include "LuaWorkerPool.hpp"
+#include "Rigidbody.hpp"
+#include "Time.hpp"
+#include "Profiler.hpp"
+#include <algorithm>
 
 void CollisionListener::dispatch(b2Contact* c, bool isEnter)
 {
@@ -50,34 +55,263 @@ void CollisionListener::dispatch(b2Contact* c, bool isEnter)
     }
 }
 
-void CollisionListener::dispatchStay(b2Contact* c)
+bool CollisionListener::beginsPassing(b2Contact* c)
 {
-    if (!c->IsTouching()) return;
     auto* A = c->GetFixtureA();
     auto* B = c->GetFixtureB();
+    if (A->IsSensor() || B->IsSensor()) return false;
+
+    Rigidbody* rbA = Rigidbody::FromBody(A->GetBody());
+    Rigidbody* rbB = Rigidbody::FromBody(B->GetBody());
+    const bool oneWayA = rbA && rbA->one_way;
+    const bool oneWayB = rbB && rbB->one_way;
+    if (!oneWayA && !oneWayB) return false;
+
+    b2WorldManifold wm;
+    c->GetWorldManifold(&wm);
+
+    // The normal points from A to B; look at it from the one-way side.
+    b2Body* surface = oneWayA ? A->GetBody() : B->GetBody();
+    b2Body* other = oneWayA ? B->GetBody() : A->GetBody();
+    const b2Vec2 normal = oneWayA ? wm.normal : -wm.normal;
+    const b2Vec2 up = b2Mul(surface->GetTransform().q, b2Vec2(0.0f, -1.0f));
+
+    // Solid only for a body on the up side that is not still rising through.
+    const b2Vec2 rel = other->GetLinearVelocity() - surface->GetLinearVelocity();
+    const bool from_above = b2Dot(normal, up) > 0.5f && b2Dot(rel, up) <= b2_linearSlop;
+    if (from_above) return false;
+
+    passing[c] = true;
+    c->SetEnabled(false);
+    return true;
+}
+
+bool CollisionListener::isIgnored(b2Contact* c)
+{
+    auto* A = c->GetFixtureA();
+    auto* B = c->GetFixtureB();
+    Rigidbody* rbA = Rigidbody::FromBody(A->GetBody());
+    Rigidbody* rbB = Rigidbody::FromBody(B->GetBody());
+    if (!(rbA && rbA->HasIgnoreRules()) && !(rbB && rbB->HasIgnoreRules())) return false;
+
     auto* actorA = reinterpret_cast<Actor*>(A->GetUserData().pointer);
     auto* actorB = reinterpret_cast<Actor*>(B->GetUserData().pointer);
-    if (!actorA || !actorB) return;
+    const float now = Time::GetTotalTime();
+    return (rbA && actorB && rbA->IsIgnoring(actorB->id, now))
+        || (rbB && actorA && rbB->IsIgnoring(actorA->id, now));
+}
 
-    const bool sensorA = A->IsSensor();
-    const bool sensorB = B->IsSensor();
+bool CollisionListener::beginsIgnored(b2Contact* c)
+{
+    if (c->GetFixtureA()->IsSensor() || c->GetFixtureB()->IsSensor()) return false;
+    if (!isIgnored(c)) return false;
+
+    passing[c] = true;
+    c->SetEnabled(false);
+    return true;
+}
+
+void CollisionListener::applyRules(b2Contact* c)
+{
+    if (!passing.empty() && passing.find(c) != passing.end()) {
+        c->SetEnabled(false);
+        return;
+    }
+
+    auto* A = c->GetFixtureA();
+    auto* B = c->GetFixtureB();
+    Rigidbody* rbA = Rigidbody::FromBody(A->GetBody());
+    Rigidbody* rbB = Rigidbody::FromBody(B->GetBody());
+    if (!rbA && !rbB) return;
+
+    // A rule that starts mid-contact disables it but keeps its EndContact,
+    // which pairs the Enter already delivered.
+    if (isIgnored(c)) {
+        passing[c] = false;
+        c->SetEnabled(false);
+        return;
+    }
+
+    const float speedA = rbA ? rbA->surface_speed : 0.0f;
+    const float speedB = rbB ? rbB->surface_speed : 0.0f;
+    if (speedA == 0.0f && speedB == 0.0f) return;
 
+    // Box2D drives vB - vA along the tangent toward the tangent speed; each
+    // conveyor adds its own right-direction speed, seen from its side.
     b2WorldManifold wm;
     c->GetWorldManifold(&wm);
+    const b2Vec2 tangent = b2Cross(wm.normal, 1.0f);
+    float tangent_speed = 0.0f;
+    if (speedA != 0.0f) {
+        tangent_speed += speedA * b2Dot(b2Mul(A->GetBody()->GetTransform().q, b2Vec2(1.0f, 0.0f)), tangent);
+    }
+    if (speedB != 0.0f) {
+        tangent_speed -= speedB * b2Dot(b2Mul(B->GetBody()->GetTransform().q, b2Vec2(1.0f, 0.0f)), tangent);
+    }
+    c->SetTangentSpeed(tangent_speed);
+}
 
-    const b2Vec2 rawPoint  = wm.points[0];
-    const b2Vec2 rawNormal = wm.normal;
-    const b2Vec2 rawRelVel = A->GetBody()->GetLinearVelocity()
-                           - B->GetBody()->GetLinearVelocity();
+void CollisionListener::trackStay(b2Contact* c)
+{
+    auto* A = c->GetFixtureA();
+    auto* B = c->GetFixtureB();
+    auto* actorA = reinterpret_cast<Actor*>(A->GetUserData().pointer);
+    auto* actorB = reinterpret_cast<Actor*>(B->GetUserData().pointer);
+    if (!actorA || !actorB || actorA == actorB) return;
+
+    const bool sensor = A->IsSensor() || B->IsSensor();
+    Actor* low = actorA->id < actorB->id ? actorA : actorB;
+    Actor* high = low == actorA ? actorB : actorA;
+    const PairKey key(low->id, high->id, sensor);
+
+    auto it = stay_pairs.find(key);
+    if (it != stay_pairs.end()) {
+        it->second.contacts.push_back(c);
+        return;
+    }
+
+    // Interest is settled once per pair, when its first contact begins.
+    const char* fn = sensor ? "OnTriggerStay" : "OnCollisionStay";
+    const bool low_wants = wantsStay(low, fn);
+    const bool high_wants = wantsStay(high, fn);
+    if (!low_wants && !high_wants) return;
+
+    StayPair& pair = stay_pairs[key];
+    pair.low = low;
+    pair.high = high;
+    pair.low_wants = low_wants;
+    pair.high_wants = high_wants;
+    pair.contacts.push_back(c);
+}
+
+void CollisionListener::untrackStay(b2Contact* c)
+{
+    if (stay_pairs.empty()) return;
+    auto* A = c->GetFixtureA();
+    auto* B = c->GetFixtureB();
+    auto* actorA = reinterpret_cast<Actor*>(A->GetUserData().pointer);
+    auto* actorB = reinterpret_cast<Actor*>(B->GetUserData().pointer);
+    if (!actorA || !actorB) return;
+
+    const PairKey key(std::min(actorA->id, actorB->id), std::max(actorA->id, actorB->id),
+                      A->IsSensor() || B->IsSensor());
+    auto it = stay_pairs.find(key);
+    if (it == stay_pairs.end()) return;
+
+    std::vector<b2Contact*>& contacts = it->second.contacts;
+    auto contact = std::find(contacts.begin(), contacts.end(), c);
+    if (contact != contacts.end()) contacts.erase(contact);
+    // A callback may end contacts mid-delivery; the pair is dropped afterwards.
+    if (contacts.empty() && !delivering) stay_pairs.erase(it);
+}
+
+void CollisionListener::DeliverStay()
+{
+    if (stay_pairs.empty()) return;
+
+    if (!stay_table) {
+        lua_State* L = ComponentDB::GetLuaState();
+        stay_table = std::make_unique<StayTable>(StayTable{
+            luabridge::newTable(L),
+            luabridge::LuaRef(L, b2Vec2()),
+            luabridge::LuaRef(L, b2Vec2()),
+            luabridge::LuaRef(L, b2Vec2()) });
+    }
 
     const b2Vec2 sentinel(-999.0f, -999.0f);
 
-    if (!sensorA && !sensorB) {
-        callLua(actorA, actorB, rawPoint, rawRelVel, rawNormal, "OnCollisionStay");
-        callLua(actorB, actorA, rawPoint, rawRelVel, rawNormal, "OnCollisionStay");
-    } else if (sensorA || sensorB) {
-        callLua(actorA, actorB, sentinel, rawRelVel, sentinel, "OnTriggerStay");
-        callLua(actorB, actorA, sentinel, rawRelVel, sentinel, "OnTriggerStay");
+    delivering = true;
+    for (auto& [key, pair] : stay_pairs) {
+        b2Contact* c = nullptr;
+        for (b2Contact* candidate : pair.contacts) {
+            if (candidate->IsTouching() && (passing.empty() || passing.find(candidate) == passing.end())) {
+                c = candidate;
+                break;
+            }
+        }
+        if (!c) continue;
+
+        auto* A = c->GetFixtureA();
+        auto* B = c->GetFixtureB();
+        auto* actorA = reinterpret_cast<Actor*>(A->GetUserData().pointer);
+        auto* actorB = reinterpret_cast<Actor*>(B->GetUserData().pointer);
+        const b2Vec2 rawRelVel = A->GetBody()->GetLinearVelocity()
+                               - B->GetBody()->GetLinearVelocity();
+
+        b2Vec2 pt = sentinel;
+        b2Vec2 n = sentinel;
+        if (!std::get<2>(key)) {
+            b2WorldManifold wm;
+            c->GetWorldManifold(&wm);
+            pt = wm.points[0];
+            n = wm.normal;
+        }
+
+        const char* fn = std::get<2>(key) ? "OnTriggerStay" : "OnCollisionStay";
+        const bool wantsA = actorA == pair.low ? pair.low_wants : pair.high_wants;
+        const bool wantsB = actorB == pair.low ? pair.low_wants : pair.high_wants;
+        if (wantsA) callStay(actorA, actorB, pt, rawRelVel, n, fn);
+        if (wantsB) callStay(actorB, actorA, pt, rawRelVel, n, fn);
+    }
+    delivering = false;
+
+    for (auto it = stay_pairs.begin(); it != stay_pairs.end();) {
+        if (it->second.contacts.empty()) it = stay_pairs.erase(it);
+        else ++it;
+    }
+}
+
+void CollisionListener::Clear()
+{
+    stay_pairs.clear();
+    passing.clear();
+    stay_table.reset();
+    delivering = false;
+}
+
+bool CollisionListener::wantsStay(Actor* actor, const char* fn)
+{
+    for (auto const& key : actor->component_keys) {
+        auto it = actor->components.find(key);
+        if (it == actor->components.end()) continue;
+        const luabridge::LuaRef& comp = *it->second;
+        if (comp.isUserdata() || LuaWorkerPool::IsStub(comp)) continue;
+        if (comp[fn].isFunction()) return true;
+    }
+    return false;
+}
+
+void CollisionListener::callStay(Actor* self, Actor* other, const b2Vec2& pt, const b2Vec2& rv,
+                                 const b2Vec2& n, const char* fn)
+{
+    if (self->destroyed || other->destroyed) return;
+
+    // Values are written into the existing userdata, and the fields are
+    // reset in case a handler replaced them.
+    StayTable& col = *stay_table;
+    *col.point.cast<b2Vec2*>() = pt;
+    *col.normal.cast<b2Vec2*>() = n;
+    *col.relative_velocity.cast<b2Vec2*>() = rv;
+    col.table["other"] = other;
+    col.table["point"] = col.point;
+    col.table["relative_velocity"] = col.relative_velocity;
+    col.table["normal"] = col.normal;
+
+    for (auto const& key : self->component_keys) {
+        auto it = self->components.find(key);
+        if (it == self->components.end()) continue;
+        luabridge::LuaRef comp = *it->second;
+        if (comp.isUserdata() || LuaWorkerPool::IsStub(comp)) continue;
+        if (!comp[fn].isFunction()) continue;
+
+        try {
+            SceneDB::RunningActorScope running(self->id);
+            Profiler::CountLuaCall();
+            comp[fn](comp, col.table);
+        }
+        catch (luabridge::LuaException& e) {
+            SceneDB::ReportError(self->GetName(), e);
+        }
     }
 }
 
@@ -97,6 +331,9 @@ void CollisionListener::callLua(Actor* self, Actor* other,
         // Skip C++ userdata components (like Rigidbody) - they don't have Lua callbacks
         if (comp.isUserdata()) continue;
 
+        // Isolated stubs run in a worker state and don't receive collision callbacks
+        if (LuaWorkerPool::IsStub(comp)) continue;
+
         if (!comp[fn].isFunction()) continue;
 
         luabridge::LuaRef col = luabridge::newTable(L);
@@ -106,6 +343,8 @@ void CollisionListener::callLua(Actor* self, Actor* other,
         col["normal"] = n;
 
         try {
+            SceneDB::RunningActorScope running(self->id);
+            Profiler::CountLuaCall();
             comp[fn](comp, col);
         }
         catch (luabridge::LuaException& e) {
@@ -7,31 +7,112 @@
 
 #pragma once
 
+#include <map>
+#include <memory>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
 #include "box2d/box2d.h"
 #include "Actor.hpp"
 #include "SceneDB.hpp"
 #include "lua/lua.h"
 #include "LuaBridge/LuaBridge.h"
 
+/**
+ * @class CollisionListener
+ * @brief Routes Box2D contacts to the Lua collision and trigger callbacks.
+ *
+ * Enter and Exit are called from BeginContact/EndContact inside the step.
+ * Stay is opt-in: a pair of actors is only tracked while touching if, when
+ * the contact begins, one of them has a component whose type defines
+ * OnCollisionStay (or OnTriggerStay for sensor contacts). DeliverStay() runs
+ * after the step and calls each tracked pair once, however many fixtures
+ * touch and however many solver passes ran, with one collision table that
+ * is reused for every call. Handlers must copy what they keep from it.
+ *
+ * PreSolve applies the Rigidbody contact rules natively, with no Lua call:
+ * IgnoreCollisionsWith() windows, `one_way` surfaces and `surface_speed`
+ * conveyors. Whether a contact passes through a one-way surface is decided
+ * once, when it begins, and holds until it ends; such contacts raise no
+ * callbacks. A contact disabled by an ignore rule also stays disabled until
+ * the bodies separate, so a rule that runs out mid-overlap does not pop; one
+ * that begins while a rule holds raises no Enter, Stay or Exit either.
+ */
 class CollisionListener : public b2ContactListener {
 public:
     void BeginContact(b2Contact* contact) override {
+        // A contact that passes through a one-way surface or begins under an
+        // ignore rule is silent throughout.
+        if (beginsPassing(contact) || beginsIgnored(contact)) return;
         dispatch(contact, true);
+        trackStay(contact);
     }
     void EndContact(b2Contact* contact) override {
+        auto pass = passing.find(contact);
+        if (pass != passing.end()) {
+            const bool silent = pass->second;
+            passing.erase(pass);
+            if (silent) return;
+        }
         dispatch(contact, false);
+        untrackStay(contact);
     }
     void PreSolve(b2Contact* contact, const b2Manifold* oldManifold) override {
         (void)oldManifold;
-        dispatchStay(contact);
+        applyRules(contact);
     }
-    
+
+    /// Calls OnCollisionStay / OnTriggerStay once per touching tracked pair.
+    static void DeliverStay();
+
+    /// Forgets every tracked pair and releases the reused collision table.
+    /// Called before the Lua state is closed.
+    static void Clear();
+
 private:
+    /// (lower actor id, higher actor id, sensor contact)
+    using PairKey = std::tuple<uint64_t, uint64_t, bool>;
+
+    struct StayPair {
+        Actor* low = nullptr;
+        Actor* high = nullptr;
+        bool low_wants = false;
+        bool high_wants = false;
+        /// Touching fixture contacts between the two actors.
+        std::vector<b2Contact*> contacts;
+    };
+
     void dispatch(b2Contact* c, bool isEnter);
-    void dispatchStay(b2Contact* c);
-    
+    bool beginsPassing(b2Contact* c);
+    bool beginsIgnored(b2Contact* c);
+    static bool isIgnored(b2Contact* c);
+    void applyRules(b2Contact* c);
+    void trackStay(b2Contact* c);
+    void untrackStay(b2Contact* c);
+
+    static bool wantsStay(Actor* actor, const char* fn);
+    static void callStay(Actor* self, Actor* other, const b2Vec2& pt, const b2Vec2& rv,
+                         const b2Vec2& n, const char* fn);
+
     void callLua(Actor* self, Actor* other,
                  const b2Vec2& pt, const b2Vec2& rv,
                  const b2Vec2& n, const char* fn);
-};
 
+    /// Ordered by actor ids, so delivery order does not depend on contact order.
+    inline static thread_local std::map<PairKey, StayPair> stay_pairs;
+    inline static thread_local bool delivering = false;
+
+    /// Disabled contacts, until they end; true for those disabled from the
+    /// start (one-way pass-throughs and ignored pairs), whose EndContact is
+    /// not reported either.
+    inline static thread_local std::unordered_map<b2Contact*, bool> passing;
+
+    /// The reused collision table and the b2Vec2 userdata its fields hold.
+    struct StayTable {
+        luabridge::LuaRef table;
+        luabridge::LuaRef point;
+        luabridge::LuaRef normal;
+        luabridge::LuaRef relative_velocity;
+    };
+    inline static thread_local std::unique_ptr<StayTable> stay_table;
+};
@@ -23,12 +23,19 @@
 #include "Scheduler.hpp"
 #include "Tween.hpp"
 #include "Transform.hpp"
+#include "SpriteRenderer.hpp"
+#include "CharacterController2D.hpp"
+#include "SceneSnapshot.hpp"
+#include "WorldStreaming.hpp"
 #include "CollisionLayers.hpp"
 #include "ConfigManager.hpp"
 #include "AnimationDB.hpp"
 #include "ParticleSystem.hpp"
 #include "DebugDraw.hpp"
+#include "PerfOverlay.hpp"
 #include "SceneTransition.hpp"
+#include "Navigation.hpp"
+#include "SpatialHash.hpp"
 
 void ComponentDB::Init() {
     using namespace luabridge;
@@ -66,6 +73,8 @@ void ComponentDB::Init() {
             .addProperty("has_collider", &Rigidbody::has_collider)
             .addProperty("has_trigger", &Rigidbody::has_trigger)
             .addProperty("collision_layer", &Rigidbody::collision_layer)
+            .addProperty("one_way", &Rigidbody::one_way)
+            .addProperty("surface_speed", &Rigidbody::surface_speed)
             .addFunction("GetPosition", &Rigidbody::GetPosition)
             .addFunction("GetRotation", &Rigidbody::GetRotation)
             .addFunction("AddForce", &Rigidbody::AddForce)
@@ -81,6 +90,7 @@ void ComponentDB::Init() {
             .addFunction("GetGravityScale", &Rigidbody::GetGravityScale)
             .addFunction("GetUpDirection", &Rigidbody::GetUpDirection)
             .addFunction("GetRightDirection", &Rigidbody::GetRightDirection)
+            .addFunction("IgnoreCollisionsWith", &Rigidbody::IgnoreCollisionsWith)
         .endClass()
     
         // Physics
@@ -110,10 +120,16 @@ void ComponentDB::Init() {
             .addFunction("GetComponents", &Actor::GetComponents)
             .addFunction("AddComponent", &Actor::AddComponent)
             .addFunction("RemoveComponent", &Actor::RemoveComponent)
+            .addFunction("AddTag", &Actor::AddTag)
+            .addFunction("RemoveTag", &Actor::RemoveTag)
+            .addFunction("HasTag", &Actor::HasTag)
+            .addFunction("IsFrozen", &Actor::IsFrozen)
         .endClass()
         .beginNamespace("Actor")
             .addFunction("Find", &SceneDB::FindActor)
             .addFunction("FindAll", &SceneDB::FindAllActor)
+            .addFunction("FindByTags", &SceneDB::FindByTags)
+            .addFunction("CountByTags", &SceneDB::CountByTags)
             .addFunction("Instantiate", &SceneDB::InstantiateActor)
             .addFunction("Destroy", &SceneDB::DestroyActor)
         .endNamespace()
@@ -171,7 +187,16 @@ void ComponentDB::Init() {
             .addFunction("Load", &SceneDB::Load)
             .addFunction("GetCurrent", &SceneDB::GetCurrent)
             .addFunction("DontDestroy", &SceneDB::DontDestroy)
+            .addFunction("LoadAdditive", &SceneDB::LoadAdditive)
+            .addFunction("Unload", &SceneDB::Unload)
+            .addFunction("IsLoaded", &SceneDB::IsLoaded)
+            .addFunction("IsLoading", &SceneDB::IsLoading)
             .addFunction("LoadWithTransition", &SceneTransition::StartTransition)
+            .addFunction("Snapshot", &SceneSnapshot::Snapshot)
+            .addFunction("Restore", &SceneSnapshot::Restore)
+            .addFunction("ReleaseSnapshot", &SceneSnapshot::Release)
+            .addFunction("GetSnapshotStats", &SceneSnapshot::GetStats)
+            .addFunction("GetStreamingStats", &WorldStreaming::GetStats)
         .endNamespace()
 
         // TIME API
@@ -212,11 +237,11 @@ void ComponentDB::Init() {
         // TRANSFORM COMPONENT
         .beginClass<Transform>("Transform")
             .addConstructor<void (*) (void)>()
-            .addProperty("x", &Transform::x)
-            .addProperty("y", &Transform::y)
-            .addProperty("rotation", &Transform::rotation)
-            .addProperty("scale_x", &Transform::scale_x)
-            .addProperty("scale_y", &Transform::scale_y)
+            .addProperty("x", &Transform::GetX, &Transform::SetX)
+            .addProperty("y", &Transform::GetY, &Transform::SetY)
+            .addProperty("rotation", &Transform::GetRotation, &Transform::SetRotation)
+            .addProperty("scale_x", &Transform::GetScaleX, &Transform::SetScaleX)
+            .addProperty("scale_y", &Transform::GetScaleY, &Transform::SetScaleY)
             .addFunction("GetPosition", &Transform::GetPosition)
             .addFunction("SetPosition", &Transform::SetPosition)
             .addFunction("Translate", &Transform::Translate)
@@ -228,6 +253,63 @@ void ComponentDB::Init() {
             .addFunction("SetUniformScale", &Transform::SetUniformScale)
             .addFunction("GetUpDirection", &Transform::GetUpDirection)
             .addFunction("GetRightDirection", &Transform::GetRightDirection)
+            .addFunction("SetParent", &Transform::SetParent)
+            .addFunction("GetParent", &Transform::GetParent)
+            .addFunction("GetChildren", &Transform::GetChildren)
+            .addFunction("GetChildCount", &Transform::GetChildCount)
+            .addFunction("GetWorldPosition", &Transform::GetWorldPosition)
+            .addFunction("SetWorldPosition", &Transform::SetWorldPosition)
+            .addFunction("GetWorldRotation", &Transform::GetWorldRotation)
+            .addFunction("GetWorldScale", &Transform::GetWorldScale)
+            .addFunction("TransformPoint", &Transform::TransformPoint)
+            .addFunction("InverseTransformPoint", &Transform::InverseTransformPoint)
+        .endClass()
+
+        // SPRITE RENDERER COMPONENT
+        .beginClass<SpriteRenderer>("SpriteRenderer")
+            .addProperty("image", &SpriteRenderer::image)
+            .addProperty("offset_x", &SpriteRenderer::offset_x)
+            .addProperty("offset_y", &SpriteRenderer::offset_y)
+            .addProperty("rotation", &SpriteRenderer::rotation)
+            .addProperty("scale_x", &SpriteRenderer::scale_x)
+            .addProperty("scale_y", &SpriteRenderer::scale_y)
+            .addProperty("pivot_x", &SpriteRenderer::pivot_x)
+            .addProperty("pivot_y", &SpriteRenderer::pivot_y)
+            .addProperty("r", &SpriteRenderer::r)
+            .addProperty("g", &SpriteRenderer::g)
+            .addProperty("b", &SpriteRenderer::b)
+            .addProperty("a", &SpriteRenderer::a)
+            .addProperty("sorting_order", &SpriteRenderer::sorting_order)
+            .addProperty("flip_x", &SpriteRenderer::flip_x)
+            .addProperty("flip_y", &SpriteRenderer::flip_y)
+            .addProperty("enabled", &SpriteRenderer::enabled)
+            .addProperty("animation", &SpriteRenderer::animation)
+            .addProperty("animation_loop", &SpriteRenderer::animation_loop)
+            .addFunction("SetScale", &SpriteRenderer::SetScale)
+            .addFunction("GetScale", &SpriteRenderer::GetScale)
+            .addFunction("SetOffset", &SpriteRenderer::SetOffset)
+            .addFunction("GetOffset", &SpriteRenderer::GetOffset)
+            .addFunction("SetTint", &SpriteRenderer::SetTint)
+        .endClass()
+        .beginClass<CharacterController2D>("CharacterController2D")
+            .addProperty("move_speed", &CharacterController2D::move_speed)
+            .addProperty("jump_speed", &CharacterController2D::jump_speed)
+            .addProperty("max_fall_speed", &CharacterController2D::max_fall_speed)
+            .addProperty("coyote_time", &CharacterController2D::coyote_time)
+            .addProperty("jump_buffer", &CharacterController2D::jump_buffer)
+            .addProperty("jump_cut", &CharacterController2D::jump_cut)
+            .addProperty("jump_cut_speed", &CharacterController2D::jump_cut_speed)
+            .addProperty("max_slope", &CharacterController2D::max_slope)
+            .addProperty("ground_probe", &CharacterController2D::ground_probe)
+            .addProperty("enabled", &CharacterController2D::enabled)
+            .addFunction("Move", &CharacterController2D::Move)
+            .addFunction("Jump", &CharacterController2D::Jump)
+            .addFunction("IsGrounded", &CharacterController2D::IsGrounded)
+            .addFunction("JustLanded", &CharacterController2D::JustLanded)
+            .addFunction("JustJumped", &CharacterController2D::JustJumped)
+            .addFunction("GetTimeUngrounded", &CharacterController2D::GetTimeUngrounded)
+            .addFunction("GetGroundAngle", &CharacterController2D::GetGroundAngle)
+            .addFunction("GetGroundActor", &CharacterController2D::GetGroundActor)
         .endClass()
 
         // ANIMATION SYSTEM
@@ -255,12 +337,18 @@ void ComponentDB::Init() {
             .addProperty("end_size", &ParticleConfig::end_size)
             .addProperty("image_name", &ParticleConfig::image_name)
             .addProperty("sorting_order", &ParticleConfig::sorting_order)
+            .addProperty("collision", &ParticleConfig::collision)
+            .addProperty("restitution", &ParticleConfig::restitution)
+            .addProperty("friction", &ParticleConfig::friction)
             .addFunction("SetStartColor", &ParticleConfig::SetStartColor)
             .addFunction("SetEndColor", &ParticleConfig::SetEndColor)
         .endClass()
         .beginNamespace("Particles")
             .addFunction("Emit", &ParticleSystem::Emit)
             .addFunction("GetActiveCount", &ParticleSystem::GetActiveCount)
+            .addFunction("CountInRect", &ParticleSystem::CountInRect)
+            .addFunction("SetCollisionBudget", &ParticleSystem::SetCollisionBudget)
+            .addFunction("GetCollisionChecks", &ParticleSystem::GetCollisionChecks)
         .endNamespace()
 
         // COLLISION LAYERS
@@ -270,11 +358,38 @@ void ComponentDB::Init() {
             .addFunction("DoLayersCollide", &CollisionLayers::DoLayersCollide)
         .endNamespace()
 
+        // NAVIGATION
+        .beginNamespace("Navigation")
+            .addFunction("BuildGrid", &Navigation::BuildGrid)
+            .addFunction("BuildGridFromTiles", &Navigation::BuildGridFromTiles)
+            .addFunction("SetWalkable", &Navigation::SetWalkable)
+            .addFunction("IsWalkable", &Navigation::IsWalkable)
+            .addFunction("FindPath", &Navigation::FindPath)
+            .addFunction("FindPathAsync", &Navigation::FindPathAsync)
+            .addFunction("GetFlowDirection", &Navigation::GetFlowDirection)
+            .addFunction("ClearCache", &Navigation::ClearCache)
+        .endNamespace()
+
+        // SPATIAL QUERIES
+        .beginNamespace("Spatial")
+            .addFunction("QueryRadius", &SpatialHash::QueryRadius)
+            .addFunction("QueryRect", &SpatialHash::QueryRect)
+            .addFunction("QueryNearest", &SpatialHash::QueryNearest)
+            .addFunction("CountRadius", &SpatialHash::CountRadius)
+        .endNamespace()
+
         // DEBUG OVERLAY
         .beginNamespace("DebugOverlay")
             .addFunction("Toggle", &DebugDraw::ToggleEnabled)
             .addFunction("SetEnabled", &DebugDraw::SetEnabled)
             .addFunction("IsEnabled", &DebugDraw::IsEnabled)
+        .endNamespace()
+
+        // PERFORMANCE OVERLAY
+        .beginNamespace("PerfOverlay")
+            .addFunction("Toggle", &PerfOverlay::ToggleEnabled)
+            .addFunction("SetEnabled", &PerfOverlay::SetEnabled)
+            .addFunction("IsEnabled", &PerfOverlay::IsEnabled)
         .endNamespace();
 
     componentTypeCache.reserve(50);
@@ -329,6 +444,12 @@ void ComponentDB::loadComponents(Actor * a, const rapidjson::Value &doc) {
                         dimensions_overridden = true;
                     }
                 }
+                else if (comp_type == "Transform")
+                    overrideTransformValue(existing_table, prop, it_2->value);
+                else if (comp_type == "SpriteRenderer")
+                    overrideSpriteRendererValue(existing_table, prop, it_2->value);
+                else if (comp_type == "CharacterController2D")
+                    overrideCharacterControllerValue(existing_table, prop, it_2->value);
                 else
                     overrideLuaRefValue(existing_table, prop, it_2->value);
             }
@@ -361,6 +482,12 @@ void ComponentDB::loadComponents(Actor * a, const rapidjson::Value &doc) {
                 if (prop_name == "type") continue;
                 if (rigidbody)
                     overrideRigidbodyfValue(*component_ref, prop_name, it_2->value);
+                else if (comp_type == "Transform")
+                    overrideTransformValue(*component_ref, prop_name, it_2->value);
+                else if (comp_type == "SpriteRenderer")
+                    overrideSpriteRendererValue(*component_ref, prop_name, it_2->value);
+                else if (comp_type == "CharacterController2D")
+                    overrideCharacterControllerValue(*component_ref, prop_name, it_2->value);
                 else
                     overrideLuaRefValue(*component_ref, prop_name, it_2->value);
             }
@@ -369,6 +496,15 @@ void ComponentDB::loadComponents(Actor * a, const rapidjson::Value &doc) {
                 Rigidbody* rb = (*component_ref).cast<Rigidbody*>();
                 rb->Init(a);
             }
+            else if (comp_type == "Transform") {
+                (*component_ref).cast<Transform*>()->Init(a);
+            }
+            else if (comp_type == "SpriteRenderer") {
+                (*component_ref).cast<SpriteRenderer*>()->Init(a, comp_key);
+            }
+            else if (comp_type == "CharacterController2D") {
+                (*component_ref).cast<CharacterController2D*>()->Init(a);
+            }
             a->components[comp_key] = component_ref;
             a->component_keys.insert(comp_key);
             a->InjectReference(component_ref);
@@ -394,6 +530,24 @@ std::shared_ptr<luabridge::LuaRef> ComponentDB::CreateComponent(const std::strin
                 
         return std::make_shared<luabridge::LuaRef>(ref);
     }
+
+    if (type == "Transform") {
+        // Same ownership as Rigidbody above. Registered in the spatial hash
+        // by Transform::Init once its actor is known.
+        luabridge::LuaRef ref(L, new Transform());
+        return std::make_shared<luabridge::LuaRef>(ref);
+    }
+
+    if (type == "SpriteRenderer") {
+        // Registered for drawing by SpriteRenderer::Init.
+        luabridge::LuaRef ref(L, new SpriteRenderer());
+        return std::make_shared<luabridge::LuaRef>(ref);
+    }
+
+    if (type == "CharacterController2D") {
+        luabridge::LuaRef ref(L, new CharacterController2D());
+        return std::make_shared<luabridge::LuaRef>(ref);
+    }
     
     if (componentTypeCache.find(type) == componentTypeCache.end()) {
         std::string lua_path = ConfigManager::GetResourcesPath() + "component_types/" + type + ".lua";
@@ -460,6 +614,7 @@ namespace {
         {"trigger_width", &Rigidbody::trigger_width},
         {"trigger_height", &Rigidbody::trigger_height},
         {"trigger_radius", &Rigidbody::trigger_radius},
+        {"surface_speed", &Rigidbody::surface_speed},
     };
     const std::unordered_map<std::string, std::string Rigidbody::*> kRigidbodyStringFields = {
         {"body_type", &Rigidbody::body_type},
@@ -471,6 +626,48 @@ namespace {
         {"precise", &Rigidbody::precise},
         {"has_collider", &Rigidbody::has_collider},
         {"has_trigger", &Rigidbody::has_trigger},
+        {"one_way", &Rigidbody::one_way},
+    };
+    const std::unordered_map<std::string, float Transform::*> kTransformFloatFields = {
+        {"x", &Transform::x},
+        {"y", &Transform::y},
+        {"rotation", &Transform::rotation},
+        {"scale_x", &Transform::scale_x},
+        {"scale_y", &Transform::scale_y},
+    };
+    const std::unordered_map<std::string, float SpriteRenderer::*> kSpriteFloatFields = {
+        {"offset_x", &SpriteRenderer::offset_x},
+        {"offset_y", &SpriteRenderer::offset_y},
+        {"rotation", &SpriteRenderer::rotation},
+        {"scale_x", &SpriteRenderer::scale_x},
+        {"scale_y", &SpriteRenderer::scale_y},
+        {"pivot_x", &SpriteRenderer::pivot_x},
+        {"pivot_y", &SpriteRenderer::pivot_y},
+        {"r", &SpriteRenderer::r},
+        {"g", &SpriteRenderer::g},
+        {"b", &SpriteRenderer::b},
+        {"a", &SpriteRenderer::a},
+    };
+    const std::unordered_map<std::string, std::string SpriteRenderer::*> kSpriteStringFields = {
+        {"image", &SpriteRenderer::image},
+        {"animation", &SpriteRenderer::animation},
+    };
+    const std::unordered_map<std::string, bool SpriteRenderer::*> kSpriteBoolFields = {
+        {"flip_x", &SpriteRenderer::flip_x},
+        {"flip_y", &SpriteRenderer::flip_y},
+        {"enabled", &SpriteRenderer::enabled},
+        {"animation_loop", &SpriteRenderer::animation_loop},
+    };
+    const std::unordered_map<std::string, float CharacterController2D::*> kControllerFloatFields = {
+        {"move_speed", &CharacterController2D::move_speed},
+        {"jump_speed", &CharacterController2D::jump_speed},
+        {"max_fall_speed", &CharacterController2D::max_fall_speed},
+        {"coyote_time", &CharacterController2D::coyote_time},
+        {"jump_buffer", &CharacterController2D::jump_buffer},
+        {"jump_cut", &CharacterController2D::jump_cut},
+        {"jump_cut_speed", &CharacterController2D::jump_cut_speed},
+        {"max_slope", &CharacterController2D::max_slope},
+        {"ground_probe", &CharacterController2D::ground_probe},
     };
 }
 
@@ -494,6 +691,50 @@ void ComponentDB::overrideRigidbodyfValue(luabridge::LuaRef& table, const std::s
         return;
     }
 }
+void ComponentDB::overrideTransformValue(luabridge::LuaRef& table, const std::string& name, const rapidjson::Value& prop_value) {
+    Transform* transform = table.cast<Transform*>();
+    if (!transform) return;
+
+    auto it = kTransformFloatFields.find(name);
+    if (it == kTransformFloatFields.end()) {
+        LOG_WARNING("Transform has no property '" + name + "', skipping");
+        return;
+    }
+    if (!prop_value.IsNumber()) {
+        LOG_WARNING("Transform property '" + name + "' expects a number, skipping");
+        return;
+    }
+    transform->*(it->second) = prop_value.GetFloat();
+    transform->OnMoved();
+}
+
+void ComponentDB::overrideSpriteRendererValue(luabridge::LuaRef& table, const std::string& name, const rapidjson::Value& prop_value) {
+    SpriteRenderer* sprite = table.cast<SpriteRenderer*>();
+    if (!sprite) return;
+
+    if (name == "sorting_order") {
+        if (prop_value.IsNumber()) sprite->sorting_order = static_cast<int>(prop_value.GetFloat());
+        else LOG_WARNING("SpriteRenderer property 'sorting_order' expects a number, skipping");
+        return;
+    }
+    if (auto it = kSpriteFloatFields.find(name); it != kSpriteFloatFields.end()) {
+        if (prop_value.IsNumber()) sprite->*(it->second) = prop_value.GetFloat();
+        else LOG_WARNING("SpriteRenderer property '" + name + "' expects a number, skipping");
+        return;
+    }
+    if (auto it = kSpriteStringFields.find(name); it != kSpriteStringFields.end()) {
+        if (prop_value.IsString()) sprite->*(it->second) = prop_value.GetString();
+        else LOG_WARNING("SpriteRenderer property '" + name + "' expects a string, skipping");
+        return;
+    }
+    if (auto it = kSpriteBoolFields.find(name); it != kSpriteBoolFields.end()) {
+        if (prop_value.IsBool()) sprite->*(it->second) = prop_value.GetBool();
+        else LOG_WARNING("SpriteRenderer property '" + name + "' expects a bool, skipping");
+        return;
+    }
+    LOG_WARNING("SpriteRenderer has no property '" + name + "', skipping");
+}
+
 void ComponentDB::EstablishInheritance(luabridge::LuaRef& instance_table, luabridge::LuaRef& parent_table) {
     luabridge::LuaRef new_metatable = luabridge::newTable(L);
     new_metatable["__index"] = parent_table;
@@ -503,3 +744,20 @@ void ComponentDB::EstablishInheritance(luabridge::LuaRef& instance_table, luabri
     lua_setmetatable(L, -2);
     lua_pop(L, 1);
 }
+
+void ComponentDB::overrideCharacterControllerValue(luabridge::LuaRef& table, const std::string& name, const rapidjson::Value& prop_value) {
+    CharacterController2D* controller = table.cast<CharacterController2D*>();
+    if (!controller) return;
+
+    if (name == "enabled") {
+        if (prop_value.IsBool()) controller->enabled = prop_value.GetBool();
+        else LOG_WARNING("CharacterController2D property 'enabled' expects a bool, skipping");
+        return;
+    }
+    if (auto it = kControllerFloatFields.find(name); it != kControllerFloatFields.end()) {
+        if (prop_value.IsNumber()) controller->*(it->second) = prop_value.GetFloat();
+        else LOG_WARNING("CharacterController2D property '" + name + "' expects a number, skipping");
+        return;
+    }
+    LOG_WARNING("CharacterController2D has no property '" + name + "', skipping");
+}
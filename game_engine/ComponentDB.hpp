@@ -103,7 +103,7 @@ public:
     static std::shared_ptr<luabridge::LuaRef> CreateComponent(const std::string& type, const std::string& comp_key);
 
     /// Component type cache: type_name -> LuaRef to prototype table
-    inline static std::unordered_map<std::string, std::shared_ptr<luabridge::LuaRef>> componentTypeCache;
+    inline static thread_local std::unordered_map<std::string, std::shared_ptr<luabridge::LuaRef>> componentTypeCache;
 
     /// Logs a message from Lua via Debug.Log().
     static void CPPLog(const std::string& message);
@@ -119,7 +119,7 @@ public:
     static lua_State * GetLuaState() {return L;};
 
     /// Counter for runtime component additions (used for unique key generation)
-    inline static int runtime_comp_add = 0;
+    inline static thread_local int runtime_comp_add = 0;
 
     /**
      * @brief Establishes prototype-based inheritance for a component instance.
@@ -133,7 +133,7 @@ public:
 
 private:
     /// Global Lua state (shared by all components)
-    inline static lua_State* L;
+    inline static thread_local lua_State* L;
 
     /**
      * @brief Overrides a Lua component property with a JSON value.
@@ -152,5 +152,32 @@ private:
      * @param prop_value JSON value to assign
      */
     static void overrideRigidbodyfValue(luabridge::LuaRef& table, const std::string & name, const rapidjson::Value& prop_value);
+
+    /**
+     * @brief Overrides a Transform component property with a JSON value.
+     *
+     * @param table Lua userdata wrapping the Transform
+     * @param name Property name (x, y, rotation, scale_x, scale_y)
+     * @param prop_value JSON value to assign
+     */
+    static void overrideTransformValue(luabridge::LuaRef& table, const std::string & name, const rapidjson::Value& prop_value);
+
+    /**
+     * @brief Overrides a SpriteRenderer component property with a JSON value.
+     *
+     * @param table Lua userdata wrapping the SpriteRenderer
+     * @param name Property name (image, scale_x, sorting_order, flip_x, ...)
+     * @param prop_value JSON value to assign
+     */
+    static void overrideSpriteRendererValue(luabridge::LuaRef& table, const std::string & name, const rapidjson::Value& prop_value);
+
+    /**
+     * @brief Overrides a CharacterController2D property with a JSON value.
+     *
+     * @param table Lua userdata wrapping the controller
+     * @param name Property name (move_speed, jump_speed, coyote_time, enabled, ...)
+     * @param prop_value JSON value to assign
+     */
+    static void overrideCharacterControllerValue(luabridge::LuaRef& table, const std::string & name, const rapidjson::Value& prop_value);
 };
 
@@ -6,6 +6,7 @@
 //
 
 #include <filesystem>
+#include <algorithm>
 #include "ConfigManager.hpp"
 #include "Actor.hpp"
 #include "Logger.hpp"
@@ -57,6 +58,9 @@ void ConfigManager::LoadRender() {
         if (renderDoc.HasMember("clear_color_b")) {
             color.z = renderDoc["clear_color_b"].GetInt();
         }
+        if (renderDoc.HasMember("pipelined_rendering") && renderDoc["pipelined_rendering"].IsBool()) {
+            pipelinedRendering = renderDoc["pipelined_rendering"].GetBool();
+        }
     }
 }
 
@@ -77,6 +81,20 @@ void ConfigManager::LoadGame() {
         LOG_FATAL("initial_scene not specified in game.config");
         throw ConfigurationException("initial_scene not specified in game.config");
     }
+    if (gameDoc.HasMember("lua_worker_states") && gameDoc["lua_worker_states"].IsInt()) {
+        luaWorkerStates = std::max(0, gameDoc["lua_worker_states"].GetInt());
+    }
+    if (gameDoc.HasMember("spatial_cell_size") && gameDoc["spatial_cell_size"].IsNumber()) {
+        const float size = gameDoc["spatial_cell_size"].GetFloat();
+        if (size > 0.0f) spatialCellSize = size;
+        else LOG_WARNING("spatial_cell_size must be positive; using " + std::to_string(spatialCellSize));
+    }
+    if (gameDoc.HasMember("parallel_physics") && gameDoc["parallel_physics"].IsBool()) {
+        parallelPhysics = gameDoc["parallel_physics"].GetBool();
+    }
+    if (gameDoc.HasMember("scene_actors_per_frame") && gameDoc["scene_actors_per_frame"].IsInt()) {
+        sceneActorsPerFrame = std::max(0, gameDoc["scene_actors_per_frame"].GetInt());
+    }
 }
 
 
@@ -96,6 +114,26 @@ std::string ConfigManager::GetInitialScene() {
     return initialScene;
 }
 
+int ConfigManager::GetLuaWorkerStates() {
+    return luaWorkerStates;
+}
+
+float ConfigManager::GetSpatialCellSize() {
+    return spatialCellSize;
+}
+
+bool ConfigManager::GetParallelPhysics() {
+    return parallelPhysics;
+}
+
+int ConfigManager::GetSceneActorsPerFrame() {
+    return sceneActorsPerFrame;
+}
+
+bool ConfigManager::GetPipelinedRendering() {
+    return pipelinedRendering;
+}
+
 void ConfigManager::SetInitialSceneOverride(const std::string& scene) {
     if (!scene.empty()) initialScene = scene;
 }
@@ -39,6 +39,26 @@ public:
     static glm::ivec3 GetClearColor();
     static std::string GetInitialScene();
 
+    /// Number of worker Lua states for isolated components
+    /// (`lua_worker_states` in game.config, 0 = disabled).
+    static int GetLuaWorkerStates();
+
+    /// Cell size of the Transform spatial hash in world units
+    /// (`spatial_cell_size` in game.config, default 2).
+    static float GetSpatialCellSize();
+
+    /// Solve independent physics islands on the JobSystem workers
+    /// (`parallel_physics` in game.config, default false).
+    static bool GetParallelPhysics();
+
+    /// Scene entries built per frame while a scene loads
+    /// (`scene_actors_per_frame` in game.config, 0 = all in the load frame).
+    static int GetSceneActorsPerFrame();
+
+    /// Overlap the next frame's update with rendering the previous one
+    /// (`pipelined_rendering` in rendering.config, default true).
+    static bool GetPipelinedRendering();
+
     static void SetResourcesPath(const std::string& path);
     static std::string GetResourcesPath();
 
@@ -54,6 +74,11 @@ private:
     inline static std::string renderConfigPath;
     inline static std::string gameTitle = "";
     inline static std::string initialScene = "";
+    inline static int luaWorkerStates = 0;
+    inline static float spatialCellSize = 2.0f;
+    inline static bool parallelPhysics = false;
+    inline static int sceneActorsPerFrame = 0;
+    inline static bool pipelinedRendering = true;
 
     inline static rapidjson::Document gameDoc;
     inline static rapidjson::Document renderDoc;
@@ -11,7 +11,7 @@
 #include <cmath>
 
 void DebugDraw::Init() {
-    static DebugDraw inst;
+    static thread_local DebugDraw inst;
     instance = &inst;
     instance->SetFlags(e_shapeBit | e_jointBit | e_aabbBit);
 }
@@ -28,7 +28,8 @@ void DebugDraw::ToggleEnabled() {
     enabled = !enabled;
 }
 
-void DebugDraw::Render() {
+void DebugDraw::Record(std::vector<DebugPrimitive>& out) {
+    out.clear();
     if (!enabled || !instance) {
         return;
     }
@@ -38,16 +39,64 @@ void DebugDraw::Render() {
         return;
     }
 
-    // Temporarily reset render scale so debug lines are drawn in pixel coords
-    SDL_Renderer* sdl_renderer = Renderer::getSDLRenderer();
-    float zoom = Renderer::GetCameraZoomFactor();
-    SDL_RenderSetScale(sdl_renderer, 1.0f, 1.0f);
-
+    instance->recording = &out;
     world->SetDebugDraw(instance);
     world->DebugDraw();
+    instance->recording = nullptr;
+}
+
+void DebugDraw::Execute(const std::vector<DebugPrimitive>& primitives) {
+    if (primitives.empty()) {
+        return;
+    }
+
+    // Debug shapes are recorded in pixel coords
+    SDL_Renderer* sdl_renderer = Renderer::getSDLRenderer();
+    SDL_RenderSetScale(sdl_renderer, 1.0f, 1.0f);
 
-    // Restore render scale
-    SDL_RenderSetScale(sdl_renderer, zoom, zoom);
+    for (const DebugPrimitive& p : primitives) {
+        SDL_SetRenderDrawColor(sdl_renderer, p.r, p.g, p.b, p.a);
+
+        switch (p.kind) {
+            case DebugPrimitive::Kind::Line:
+                SDL_RenderDrawLine(sdl_renderer, p.x1, p.y1, p.x2, p.y2);
+                break;
+
+            case DebugPrimitive::Kind::Circle: {
+                // Midpoint circle algorithm
+                int x = p.x2;
+                int y = 0;
+                int err = 1 - p.x2;
+
+                while (x >= y) {
+                    SDL_RenderDrawPoint(sdl_renderer, p.x1 + x, p.y1 + y);
+                    SDL_RenderDrawPoint(sdl_renderer, p.x1 + y, p.y1 + x);
+                    SDL_RenderDrawPoint(sdl_renderer, p.x1 - y, p.y1 + x);
+                    SDL_RenderDrawPoint(sdl_renderer, p.x1 - x, p.y1 + y);
+                    SDL_RenderDrawPoint(sdl_renderer, p.x1 - x, p.y1 - y);
+                    SDL_RenderDrawPoint(sdl_renderer, p.x1 - y, p.y1 - x);
+                    SDL_RenderDrawPoint(sdl_renderer, p.x1 + y, p.y1 - x);
+                    SDL_RenderDrawPoint(sdl_renderer, p.x1 + x, p.y1 - y);
+
+                    y++;
+                    if (err < 0) {
+                        err += 2 * y + 1;
+                    } else {
+                        x--;
+                        err += 2 * (y - x) + 1;
+                    }
+                }
+                break;
+            }
+
+            case DebugPrimitive::Kind::Square: {
+                int half = p.x2 / 2;
+                SDL_Rect rect = {p.x1 - half, p.y1 - half, p.x2, p.x2};
+                SDL_RenderFillRect(sdl_renderer, &rect);
+                break;
+            }
+        }
+    }
 }
 
 glm::ivec2 DebugDraw::WorldToScreen(const b2Vec2& worldPos) const {
@@ -59,18 +108,27 @@ glm::ivec2 DebugDraw::WorldToScreen(const b2Vec2& worldPos) const {
     return {sx, sy};
 }
 
-void DebugDraw::DrawPolygon(const b2Vec2* vertices, int32 vertexCount, const b2Color& color) {
-    SDL_Renderer* sdl_renderer = Renderer::getSDLRenderer();
-    SDL_SetRenderDrawColor(sdl_renderer,
-        (Uint8)(color.r * 255),
-        (Uint8)(color.g * 255),
-        (Uint8)(color.b * 255),
-        128);
+void DebugDraw::Push(DebugPrimitive::Kind kind, int x1, int y1, int x2, int y2,
+                     const b2Color& color, Uint8 alpha) {
+    if (!recording) return;
+    DebugPrimitive p;
+    p.kind = kind;
+    p.x1 = x1;
+    p.y1 = y1;
+    p.x2 = x2;
+    p.y2 = y2;
+    p.r = (Uint8)(color.r * 255);
+    p.g = (Uint8)(color.g * 255);
+    p.b = (Uint8)(color.b * 255);
+    p.a = alpha;
+    recording->push_back(p);
+}
 
+void DebugDraw::DrawPolygon(const b2Vec2* vertices, int32 vertexCount, const b2Color& color) {
     for (int32 i = 0; i < vertexCount; ++i) {
         glm::ivec2 p1 = WorldToScreen(vertices[i]);
         glm::ivec2 p2 = WorldToScreen(vertices[(i + 1) % vertexCount]);
-        SDL_RenderDrawLine(sdl_renderer, p1.x, p1.y, p2.x, p2.y);
+        Push(DebugPrimitive::Kind::Line, p1.x, p1.y, p2.x, p2.y, color, 128);
     }
 }
 
@@ -80,40 +138,10 @@ void DebugDraw::DrawSolidPolygon(const b2Vec2* vertices, int32 vertexCount, cons
 }
 
 void DebugDraw::DrawCircle(const b2Vec2& center, float radius, const b2Color& color) {
-    SDL_Renderer* sdl_renderer = Renderer::getSDLRenderer();
-    SDL_SetRenderDrawColor(sdl_renderer,
-        (Uint8)(color.r * 255),
-        (Uint8)(color.g * 255),
-        (Uint8)(color.b * 255),
-        128);
-
     float zoom = Renderer::GetCameraZoomFactor();
     glm::ivec2 c = WorldToScreen(center);
     int r = (int)(radius * 100.0f * zoom);
-
-    // Midpoint circle algorithm
-    int x = r;
-    int y = 0;
-    int err = 1 - r;
-
-    while (x >= y) {
-        SDL_RenderDrawPoint(sdl_renderer, c.x + x, c.y + y);
-        SDL_RenderDrawPoint(sdl_renderer, c.x + y, c.y + x);
-        SDL_RenderDrawPoint(sdl_renderer, c.x - y, c.y + x);
-        SDL_RenderDrawPoint(sdl_renderer, c.x - x, c.y + y);
-        SDL_RenderDrawPoint(sdl_renderer, c.x - x, c.y - y);
-        SDL_RenderDrawPoint(sdl_renderer, c.x - y, c.y - x);
-        SDL_RenderDrawPoint(sdl_renderer, c.x + y, c.y - x);
-        SDL_RenderDrawPoint(sdl_renderer, c.x + x, c.y - y);
-
-        y++;
-        if (err < 0) {
-            err += 2 * y + 1;
-        } else {
-            x--;
-            err += 2 * (y - x) + 1;
-        }
-    }
+    Push(DebugPrimitive::Kind::Circle, c.x, c.y, r, 0, color, 128);
 }
 
 void DebugDraw::DrawSolidCircle(const b2Vec2& center, float radius, const b2Vec2& axis, const b2Color& color) {
@@ -125,16 +153,9 @@ void DebugDraw::DrawSolidCircle(const b2Vec2& center, float radius, const b2Vec2
 }
 
 void DebugDraw::DrawSegment(const b2Vec2& p1, const b2Vec2& p2, const b2Color& color) {
-    SDL_Renderer* sdl_renderer = Renderer::getSDLRenderer();
-    SDL_SetRenderDrawColor(sdl_renderer,
-        (Uint8)(color.r * 255),
-        (Uint8)(color.g * 255),
-        (Uint8)(color.b * 255),
-        128);
-
     glm::ivec2 sp1 = WorldToScreen(p1);
     glm::ivec2 sp2 = WorldToScreen(p2);
-    SDL_RenderDrawLine(sdl_renderer, sp1.x, sp1.y, sp2.x, sp2.y);
+    Push(DebugPrimitive::Kind::Line, sp1.x, sp1.y, sp2.x, sp2.y, color, 128);
 }
 
 void DebugDraw::DrawTransform(const b2Transform& xf) {
@@ -151,16 +172,6 @@ void DebugDraw::DrawTransform(const b2Transform& xf) {
 }
 
 void DebugDraw::DrawPoint(const b2Vec2& p, float size, const b2Color& color) {
-    SDL_Renderer* sdl_renderer = Renderer::getSDLRenderer();
-    SDL_SetRenderDrawColor(sdl_renderer,
-        (Uint8)(color.r * 255),
-        (Uint8)(color.g * 255),
-        (Uint8)(color.b * 255),
-        255);
-
     glm::ivec2 sp = WorldToScreen(p);
-    int half = (int)(size * 0.5f);
-
-    SDL_Rect rect = {sp.x - half, sp.y - half, (int)size, (int)size};
-    SDL_RenderFillRect(sdl_renderer, &rect);
+    Push(DebugPrimitive::Kind::Square, sp.x, sp.y, (int)size, 0, color, 255);
 }
@@ -7,17 +7,35 @@
 
 #pragma once
 
+#include <cstdint>
+#include <vector>
 #include "box2d/box2d.h"
 #include "SDL2/SDL.h"
 #include "glm/glm.hpp"
 
+/// One screen-space debug shape recorded for the render stage.
+struct DebugPrimitive {
+    enum class Kind : uint8_t { Line, Circle, Square };
+
+    Kind kind = Kind::Line;
+    int x1 = 0, y1 = 0;   ///< Line start, circle center or square center
+    int x2 = 0, y2 = 0;   ///< Line end; x2 is the circle radius or square size
+    Uint8 r = 0, g = 0, b = 0, a = 255;
+};
+
 class DebugDraw : public b2Draw {
 public:
     static void Init();
     static void SetEnabled(bool enabled);
     static bool IsEnabled();
     static void ToggleEnabled();
-    static void Render();
+
+    // Walk the physics world and record its shapes in screen space
+    // (empty when disabled). Runs on the world's thread.
+    static void Record(std::vector<DebugPrimitive>& out);
+
+    // Draw recorded shapes. Runs on the render thread.
+    static void Execute(const std::vector<DebugPrimitive>& primitives);
 
     // b2Draw interface implementation
     void DrawPolygon(const b2Vec2* vertices, int32 vertexCount, const b2Color& color) override;
@@ -29,8 +47,13 @@ public:
     void DrawPoint(const b2Vec2& p, float size, const b2Color& color) override;
 
 private:
-    inline static bool enabled = false;
-    inline static DebugDraw* instance = nullptr;
+    inline static thread_local bool enabled = false;
+    inline static thread_local DebugDraw* instance = nullptr;
+
+    /// Destination of the b2Draw callbacks during Record()
+    std::vector<DebugPrimitive>* recording = nullptr;
+
+    void Push(DebugPrimitive::Kind kind, int x1, int y1, int x2, int y2, const b2Color& color, Uint8 alpha);
 
     // Convert Box2D world coords to screen coords
     glm::ivec2 WorldToScreen(const b2Vec2& worldPos) const;
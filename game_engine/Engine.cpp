@@ -11,6 +11,8 @@
 #include <memory>
 #include <filesystem>
 #include <set>
+#include <sstream>
+#include <iomanip>
 #include "EngineUtils.hpp"
 #include "SceneDB.hpp"
 #include "rapidjson/document.h"
@@ -29,158 +31,204 @@
 #include "AnimationDB.hpp"
 #include "ParticleSystem.hpp"
 #include "DebugDraw.hpp"
+#include "PerfOverlay.hpp"
 #include "SceneTransition.hpp"
 #include "Logger.hpp"
+#include "JobSystem.hpp"
+#include "LuaWorkerPool.hpp"
+#include "RenderCommandBuffer.hpp"
+#include "SimulationThread.hpp"
+#include "GoldenFrame.hpp"
+#include "Profiler.hpp"
 #include "SDL2_image/SDL_image.h"
 
 
-Engine::Engine() {
+Engine::Engine(bool headless_mode) {
+    headless = headless_mode;
     cleanColor = ConfigManager::GetClearColor();
-    TextDB::Init();
-    Input::Init();
-    AudioDB::Init();
-    ComponentDB::Init();
-    Time::Init();
-    EventSystem::Init();
-    Scheduler::Init();
-    Tween::Init();
-    CollisionLayers::Init();
-    AnimationDB::Init();
-    ParticleSystem::Init();
-    DebugDraw::Init();
-    SceneTransition::Init();
-    ImageDB::CreateDefaultParticleTextureWithName("__default_particle");
-
-    scene.loadScene();
+    // TextDB and AudioDB start on first use; see TextDB::GetFont and AudioDB::PlayChannel.
+    JobSystem::Init();
+    MarkStartupPhase("jobs");
+    if (!headless && ConfigManager::GetPipelinedRendering()) {
+        simulation = std::make_unique<SimulationThread>();
+    }
+    else {
+        context = std::make_unique<EngineContext>(headless);
+    }
+    MarkStartupPhase("world");
+    if (headless && fixed_delta_time <= 0.0f) {
+        fixed_delta_time = 1.0f / 60.0f;
+    }
 }
 
 Engine::~Engine() {
-    // Every system that caches Lua references must release them before
-    // ComponentDB::Shutdown() closes the Lua state.
-    EventSystem::Clear();
-    Scheduler::Clear();
-    Tween::Clear();
-    AnimationDB::Clear();
-    ParticleSystem::Clear();
-    scene.clearLuaRefs();
-    ComponentDB::Shutdown();
-    AudioDB::Shutdown();
-    TextDB::Shutdown();
+    simulation.reset();
+    context.reset();
+    if (render_capture.IsOpen()) {
+        LOG_INFO("Captured " + std::to_string(render_capture.GetFrameCount()) + " render frames");
+        render_capture.Close();
+    }
+    JobSystem::Shutdown();
+    if (!headless) {
+        AudioDB::Shutdown();
+        TextDB::Shutdown();
+    }
 }
 
 void Engine::GameLoop(int max_frames) {
-    Renderer::clear(cleanColor);
+    if (!headless) Renderer::clear(cleanColor);
 
     bool quit = false;
     int frames = 0;
+    std::vector<SDL_Event> events;
     while (!quit) {
-        Input::BeginFrame();
-
-        SDL_Event e;
-        while (Helper::SDL_PollEvent(&e)) {
-            if (e.type == SDL_QUIT) quit = true;
+        const auto frame_start = std::chrono::steady_clock::now();
+        const uint64_t allocations_before = Profiler::GetAllocationCount();
 
-            if (e.type == SDL_KEYDOWN && e.key.keysym.scancode == SDL_SCANCODE_F1) {
-                DebugDraw::ToggleEnabled();
+        if (replay.IsLoaded()) {
+            for (const SDL_Event& e : replay.EventsForFrame(frames)) {
+                if (e.type == SDL_QUIT) quit = true;
+                events.push_back(e);
             }
-
-            Input::ProcessEvent(e);
         }
 
-        Update();
+        if (!headless) {
+            SDL_Event e;
+            while (Helper::SDL_PollEvent(&e)) {
+                if (e.type == SDL_QUIT) quit = true;
+                events.push_back(e);
+            }
+        }
 
-        // Capture the screenshot on the *last* frame if one's queued.
-        if (max_frames >= 0 && frames + 1 == max_frames) {
-            screenshot_capture_this_frame = true;
+        if (simulation) {
+            // Step and record frame N on the simulation thread while this
+            // thread submits frame N-1.
+            RenderFrame& recording = render_frames[frames % 2];
+            simulation->StartStep(events, fixed_delta_time, recording);
+            if (frames > 0) {
+                Render(render_frames[(frames - 1) % 2]);
+            }
+            simulation->WaitStep();
+            if (simulation->IsQuitRequested()) quit = true;
         }
+        else {
+            for (const SDL_Event& e : events) {
+                context->QueueEvent(e);
+            }
+            events.clear();
 
-        Render();
+            Update();
 
-        Input::LateUpdate();
+            if (!headless) {
+                // Capture the screenshot on the *last* frame if one's queued.
+                if (max_frames >= 0 && frames + 1 == max_frames) {
+                    screenshot_capture_this_frame = true;
+                }
 
-        if (max_frames >= 0 && ++frames >= max_frames) quit = true;
-    }
-}
+                RenderCommandBuffer::Record(render_frames[0]);
+                Render(render_frames[0]);
+            }
+            else {
+                // Keep the draw stream only when the final frame is checked;
+                // --stats-out counts the dropped draws instead.
+                if (!golden_path.empty()) RenderCommandBuffer::Record(render_frames[0]);
+                if (frames == 0) {
+                    MarkStartupPhase("first frame");
+                    LogStartupTimings();
+                }
+            }
 
-void Engine::Update() {
-    // Update time at the start of each frame
-    Time::Update();
+            if (context->IsQuitRequested()) quit = true;
+        }
 
-    // Handle scene loading (from direct load or transition)
-    bool should_load_scene = !SceneDB::next_scene_to_load.empty();
+        FrameProfile& profile = last_frame_profile;
+        profile = simulation ? simulation->GetProfile() : FrameProfile{};
+        Profiler::TakeFrame(profile);
+        profile.frame_ms = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - frame_start).count();
+        profile.allocations = Profiler::GetAllocationCount() - allocations_before;
+        PerfOverlay::AddFrame(profile);
+        if (frame_budget.IsLoaded()) frame_budget.AddFrame(frames, profile);
+        if (state_hash_log.IsActive()) {
+            state_hash_log.AddFrame(frames, simulation ? simulation->GetStateHash() : context->GetStateHash());
+        }
+        if (stats_writer.IsOpen()) {
+            FrameStatsRecord record;
+            record.frame = frames;
+            record.profile = profile;
+            record.world = simulation ? simulation->GetWorldStats() : context->GetWorldStats();
+            if (headless && golden_path.empty()) {
+                record.draw_calls = record.world.dropped_draws;
+                record.batches = -1;
+            }
+            else {
+                const RenderStats draws = RenderCommandBuffer::Measure(render_frames[simulation ? frames % 2 : 0]);
+                record.draw_calls = draws.draw_calls;
+                record.batches = draws.batches;
+            }
+            stats_writer.AddFrame(record);
+        }
 
-    if (!should_load_scene && SceneTransition::ShouldLoadScene()) {
-        SceneDB::next_scene_to_load = SceneTransition::GetTargetScene();
-        SceneTransition::ClearTargetScene();
-        should_load_scene = true;
+        ++frames;
+        if (max_frames >= 0 && frames >= max_frames) quit = true;
     }
 
-    if (should_load_scene) {
-        EventSystem::Clear();
-        Scheduler::Clear();
-        Tween::Clear();
-        AnimationDB::Clear();
-        ParticleSystem::Clear();
-        scene.loadScene();
+    // The last recorded frame is still waiting for the render stage.
+    if (simulation && frames > 0) {
+        if (max_frames >= 0 && frames == max_frames) {
+            screenshot_capture_this_frame = true;
+        }
+        Render(render_frames[(frames - 1) % 2]);
     }
 
-    // Update timer and tween systems
-    float dt = Time::GetDeltaTime();
-    Scheduler::Update(dt);
-    Tween::Update(dt);
-    AnimationDB::Update(dt);
-    ParticleSystem::Update(dt);
-    SceneTransition::Update(dt);
-    Renderer::UpdateCamera(dt);
-
-    scene.UpdateScene();
+    const RenderFrame* last_frame = nullptr;
+    if (frames > 0 && (!headless || !golden_path.empty())) {
+        last_frame = &render_frames[simulation ? (frames - 1) % 2 : 0];
+    }
+    RunEndOfRunChecks(last_frame);
 }
 
-void Engine::Render() {
-    Renderer::clear(cleanColor);
-
-    ImageDB::RenderAndClearAllImages();
+void Engine::RunEndOfRunChecks(const RenderFrame* last_frame) {
+    if (!golden_path.empty()) {
+        if (!last_frame) {
+            LOG_ERROR("No frame was recorded to compare with golden " + golden_path);
+            checks_failed = true;
+        }
+        else if (golden_update) {
+            GoldenFrame::Save(golden_path, *last_frame);
+        }
+        else if (!GoldenFrame::Check(golden_path, *last_frame, golden_tolerance)) {
+            checks_failed = true;
+        }
+    }
 
-    // Render particles (world-space, after images, before text/UI)
-    const auto& particle_data = ParticleSystem::GetDrawData();
-    if (!particle_data.empty()) {
-        float zoom = Renderer::GetCameraZoomFactor();
-        glm::ivec2 cam_dims = Renderer::GetCameraDimensions();
-        glm::vec2 cam_pos = Renderer::GetEffectiveCameraPosition();
-        SDL_RenderSetScale(Renderer::getSDLRenderer(), zoom, zoom);
+    if (frame_budget.IsLoaded() && !frame_budget.Report()) {
+        checks_failed = true;
+    }
 
-        for (const auto& p : particle_data) {
-            const std::string& tex_name = p.image_name.empty() ? std::string("__default_particle") : p.image_name;
-            SDL_Texture* tex = ImageDB::GetTexture(tex_name);
-            SDL_SetTextureColorMod(tex, p.r, p.g, p.b);
-            SDL_SetTextureAlphaMod(tex, p.a);
+    if (state_hash_log.IsActive() && !state_hash_log.Report()) {
+        checks_failed = true;
+    }
 
-            float screen_x = (p.x - cam_pos.x) * 100.0f +
-                cam_dims.x * 0.5f * (1.0f / zoom) - p.size * 0.5f;
-            float screen_y = (p.y - cam_pos.y) * 100.0f +
-                cam_dims.y * 0.5f * (1.0f / zoom) - p.size * 0.5f;
+    stats_writer.Close();
+}
 
-            SDL_FRect rect = { screen_x, screen_y, p.size, p.size };
-            SDL_RenderCopyF(Renderer::getSDLRenderer(), tex, NULL, &rect);
+void Engine::Update() {
+    context->Step(fixed_delta_time);
+}
 
-            SDL_SetTextureColorMod(tex, 255, 255, 255);
-            SDL_SetTextureAlphaMod(tex, 255);
-        }
-        SDL_RenderSetScale(Renderer::getSDLRenderer(), 1.0f, 1.0f);
-    }
+void Engine::Render(const RenderFrame& frame) {
+    Profiler::Scope scope(ProfileStage::Render);
+    render_capture.WriteFrame(frame);
 
-    // Rects draw before text so they work as HUD backdrops.
-    ImageDB::RenderAndClearAllRects();
-    TextDB::RenderQueuedTexts();
-    // Pixels draw on top of everything for debug overlays.
-    ImageDB::RenderAndClearAllPixels();
+    Renderer::clear(cleanColor);
 
-    DebugDraw::Render();
-    SceneTransition::Render();
+    RenderCommandBuffer::Execute(frame);
+    PerfOverlay::Execute(frame);
 
     if (screenshot_capture_this_frame && !screenshot_path_pending.empty()) {
         SDL_Renderer* r = Renderer::getSDLRenderer();
-        glm::ivec2 dims = Renderer::GetCameraDimensions();
+        glm::ivec2 dims = frame.camera.dimensions;
         SDL_Surface* surface = SDL_CreateRGBSurfaceWithFormat(
             0, dims.x, dims.y, 32, SDL_PIXELFORMAT_RGBA32);
         if (surface) {
@@ -201,8 +249,82 @@ void Engine::Render() {
     }
 
     Renderer::present();
+
+    if (!first_frame_presented) {
+        first_frame_presented = true;
+        MarkStartupPhase("first frame");
+        LogStartupTimings();
+    }
+}
+
+void Engine::BeginStartupTiming() {
+    startup_phases.clear();
+    startup_mark = std::chrono::steady_clock::now();
+}
+
+void Engine::MarkStartupPhase(const std::string& phase) {
+    const auto now = std::chrono::steady_clock::now();
+    const double ms = std::chrono::duration<double, std::milli>(now - startup_mark).count();
+    startup_phases.emplace_back(phase, ms);
+    startup_mark = now;
+
+    std::ostringstream msg;
+    msg << std::fixed << std::setprecision(1) << "Startup phase '" << phase << "': " << ms << " ms";
+    LOG_DEBUG(msg.str());
+}
+
+void Engine::LogStartupTimings() {
+    double total = 0.0;
+    std::ostringstream breakdown;
+    breakdown << std::fixed << std::setprecision(1);
+    for (size_t i = 0; i < startup_phases.size(); ++i) {
+        total += startup_phases[i].second;
+        breakdown << (i ? ", " : "") << startup_phases[i].first << ' ' << startup_phases[i].second;
+    }
+
+    std::ostringstream msg;
+    msg << std::fixed << std::setprecision(1) << "Time to first frame: " << total << " ms ("
+        << breakdown.str() << ")";
+    LOG_INFO(msg.str());
 }
 
 void Engine::SetScreenshotPath(const std::string& path) {
     screenshot_path_pending = path;
 }
+
+void Engine::SetRenderCapturePath(const std::string& path) {
+    render_capture.Open(path, ConfigManager::GetResolution(), ConfigManager::GetClearColor());
+}
+
+void Engine::SetGoldenFrame(const std::string& path, bool update, float tolerance) {
+    golden_path = path;
+    golden_update = update;
+    golden_tolerance = tolerance;
+    // Headless worlds drop their draws unless told to keep them.
+    if (context) context->SetRecordDraws(!path.empty());
+}
+
+void Engine::SetFrameBudgetPath(const std::string& path) {
+    frame_budget.Load(path);
+}
+
+void Engine::SetStateHashLog(const std::string& path, bool check) {
+    if (check) state_hash_log.Load(path);
+    else state_hash_log.Open(path);
+    if (context) context->SetStateHashing(true);
+    if (simulation) simulation->SetStateHashing(true);
+}
+
+void Engine::SetStatsOutPath(const std::string& path) {
+    stats_writer.Open(path);
+    if (context) context->SetStatsCollection(true);
+    if (simulation) simulation->SetStatsCollection(true);
+}
+
+void Engine::SetFixedDeltaTime(float dt) {
+    fixed_delta_time = dt > 0.0f ? dt : 0.0f;
+}
+
+void Engine::SetReplayPath(const std::string& path) {
+    replay.Load(path);
+}
@@ -12,6 +12,10 @@
 
 #include <string>
 #include <optional>
+#include <memory>
+#include <chrono>
+#include <utility>
+#include <vector>
 #include "Renderer.hpp"
 #include "EngineUtils.hpp"
 #include "SceneDB.hpp"
@@ -22,6 +26,15 @@
 #include "lua/lua.hpp"
 #include "LuaBridge/LuaBridge.h"
 #include "ApplicationAPI.hpp"
+#include "EngineContext.hpp"
+#include "InputReplay.hpp"
+#include "RenderCommandBuffer.hpp"
+#include "SimulationThread.hpp"
+#include "RenderCapture.hpp"
+#include "Profiler.hpp"
+#include "FrameBudget.hpp"
+#include "StateHash.hpp"
+#include "FrameStats.hpp"
 
 /**
  * @class Engine
@@ -34,14 +47,17 @@
  * Architecture:
  * - Singleton pattern for global access to engine state
  * - Fixed timestep physics with variable rendering
- * - Deferred rendering system with batched draw calls
+ * - Pipelined frames: the world steps on a SimulationThread and records a
+ *   RenderFrame, which the main thread submits while the next step runs
  * - Lua scripting integration via LuaBridge
  *
  * Lifecycle:
- * 1. Constructor: Initialize all subsystems (TextDB, AudioDB, Input, ComponentDB, Renderer)
+ * 1. Constructor: Start the JobSystem and create the world (Input, ComponentDB,
+ *    scene, ...), on a SimulationThread when pipelined. Fonts, the audio device,
+ *    the particle pool and the default particle texture are created on first use.
  * 2. GameLoop(): Main loop handling events, updates, and rendering
  * 3. Update(): Process game logic and component updates via SceneDB
- * 4. Render(): Execute deferred rendering for images, text, and UI
+ * 4. Render(): Submit a recorded RenderFrame to SDL and present
  * 5. Destructor: Cleanup resources and shutdown subsystems
  *
  * @note The Engine uses static methods for the game loop to allow global access
@@ -53,33 +69,64 @@ public:
      * @brief Constructs the Engine and initializes all subsystems.
      *
      * Initialization order:
-     * 1. Parse game.config and rendering.config (JSON)
-     * 2. Initialize TextDB (SDL_ttf)
-     * 3. Initialize AudioDB (SDL_mixer)
-     * 4. Initialize Input system
-     * 5. Initialize ComponentDB (Lua state and API bindings)
-     * 6. Create Renderer with window and SDL2 context
-     * 7. Load initial scene from configuration
+     * 1. Start the JobSystem worker pool
+     * 2. Create the EngineContext (Input, ComponentDB, subsystems, initial scene),
+     *    on a SimulationThread unless headless or `pipelined_rendering` is false
      *
+     * Everything else starts lazily so time-to-first-frame only pays for what
+     * the scene uses: SDL_ttf on the first font load, the SDL_mixer device on
+     * the first sound, the particle pool on the first Emit and the default
+     * particle texture on the first particle drawn. Each phase is recorded
+     * with MarkStartupPhase().
+     *
+     * @param headless Run without window, renderer or audio device.
      * @throws std::runtime_error if any subsystem fails to initialize
      */
-    Engine();
+    explicit Engine(bool headless = false);
 
     /**
      * @brief Destructs the Engine and cleans up all resources.
      *
      * Cleanup order:
-     * 1. Shutdown Renderer (SDL window/renderer)
-     * 2. Close Lua state (ComponentDB)
-     * 3. Cleanup TextDB (fonts and textures)
-     * 4. Cleanup AudioDB (sound effects and music)
+     * 1. Destroy the EngineContext (Lua refs, Lua states, physics world), on
+     *    the simulation thread when pipelined, and join that thread
+     * 2. Join the JobSystem workers
+     * 3. Cleanup AudioDB (sound effects and music, device if opened)
+     * 4. Cleanup TextDB (fonts and textures, SDL_ttf if started)
      */
     ~Engine();
 
 
 private:
-    /// Scene database managing all actors and game state
-    inline static SceneDB scene;
+    /// The world driven by GameLoop on this thread (headless or unpipelined)
+    inline static std::unique_ptr<EngineContext> context;
+
+    /// The world stepped on its own thread (windowed, pipelined)
+    inline static std::unique_ptr<SimulationThread> simulation;
+
+    /// Double buffer: one frame is recorded while the other is submitted
+    inline static RenderFrame render_frames[2];
+
+    /// Set once the first frame has been presented (ends startup timing)
+    inline static bool first_frame_presented = false;
+
+    /// True when running without window, renderer or audio device
+    inline static bool headless = false;
+
+    /// Simulation step in seconds; 0 uses the wall clock
+    inline static float fixed_delta_time = 0.0f;
+
+    /// Recorded input fed into the context, if any
+    inline static InputReplay replay;
+
+    /// Start of the current startup phase
+    inline static std::chrono::steady_clock::time_point startup_mark;
+
+    /// Completed startup phases and their durations in milliseconds
+    inline static std::vector<std::pair<std::string, double>> startup_phases;
+
+    /// Logs the phase breakdown recorded since BeginStartupTiming().
+    static void LogStartupTimings();
 
     /// Background clear color (RGB) for rendering
     inline static glm::ivec3 cleanColor;
@@ -89,9 +136,38 @@ private:
     /// Set by GameLoop on the last frame so Render() saves at the end, not the start.
     inline static bool screenshot_capture_this_frame = false;
 
+    /// Every frame Render() submits, when `--capture-render` is given
+    inline static RenderCaptureWriter render_capture;
+
+    /// Golden frame the last frame is compared with (or written to)
+    inline static std::string golden_path;
+    inline static bool golden_update = false;
+    inline static float golden_tolerance = 0.01f;
+
+    /// Stage, frame-time and allocation budgets, when `--frame-budget` is given
+    inline static FrameBudget frame_budget;
+
+    /// Per-frame state hashes written or checked, when `--state-hash` or
+    /// `--state-hash-check` is given
+    inline static StateHashLog state_hash_log;
+
+    /// Per-frame statistics, when `--stats-out` is given
+    inline static FrameStatsWriter stats_writer;
+
+    /// Counters of the last completed frame
+    inline static FrameProfile last_frame_profile;
+
+    /// Set when a golden-frame, budget or state-hash check fails
+    inline static bool checks_failed = false;
+
+    /// Compares (or saves) the final frame and reports the frame budget.
+    static void RunEndOfRunChecks(const RenderFrame* last_frame);
+
 public:
-    /// Main game loop. Runs forever until SDL_QUIT or a non-negative
-    /// `max_frames` frame budget is reached (used by `--self-check`).
+    /// Main game loop. Runs until SDL_QUIT, Application.Quit() or a
+    /// non-negative `max_frames` frame budget is reached (used by
+    /// `--self-check`). Headless mode never polls SDL or renders and runs as
+    /// fast as possible.
     static void GameLoop(int max_frames = -1);
 
     /// If set before GameLoop starts, the final rendered frame is saved
@@ -99,10 +175,58 @@ public:
     /// final frame.
     static void SetScreenshotPath(const std::string& path);
 
+    /// Step the simulation by `dt` seconds every frame instead of the
+    /// measured frame time. Headless mode defaults to 1/60.
+    static void SetFixedDeltaTime(float dt);
+
+    /// Feed input from a recorded replay file (see InputReplay) before
+    /// GameLoop starts. In headless mode this is the only input source.
+    static void SetReplayPath(const std::string& path);
+
+    /// Append every rendered frame's draw stream to `path` (see
+    /// RenderCapture.hpp) for `tools/render_replay`. Windowed runs only.
+    /// @throws ConfigurationException if the file cannot be created.
+    static void SetRenderCapturePath(const std::string& path);
+
+    /// Compare the final recorded frame with the golden frame at `path`
+    /// (see GoldenFrame), or overwrite it when `update` is set. Works
+    /// headless: the draw stream is recorded but not rendered.
+    static void SetGoldenFrame(const std::string& path, bool update, float tolerance);
+
+    /// Check every frame after warm-up against the budgets in `path`
+    /// (see FrameBudget) and report at the end of GameLoop.
+    /// @throws ConfigurationException if the file is missing or malformed.
+    static void SetFrameBudgetPath(const std::string& path);
+
+    /// Hash the world after every step (see StateHash) and write the
+    /// hashes to `path`, or with `check` compare them against the log
+    /// already there and report the first divergent frame.
+    /// @throws ConfigurationException if the file cannot be opened.
+    static void SetStateHashLog(const std::string& path, bool check);
+
+    /// Write one line of statistics per frame to `path` (see
+    /// FrameStatsWriter) from a background thread. Headless runs record
+    /// their draw stream so draw calls can be counted.
+    /// @throws ConfigurationException if the file cannot be created.
+    static void SetStatsOutPath(const std::string& path);
+
+    /// True if the golden-frame, frame-budget or state-hash check failed.
+    static bool ChecksFailed() { return checks_failed; }
+
+    /// Stage timings, frame time and allocation count of the last frame.
+    static const FrameProfile& GetLastFrameProfile() { return last_frame_profile; }
+
+    /// Starts the startup clock. Called first thing in main().
+    static void BeginStartupTiming();
+
+    /// Closes the current startup phase under `phase` and starts the next.
+    /// GameLoop logs the breakdown together with the time to first frame.
+    static void MarkStartupPhase(const std::string& phase);
+
     /**
-     * @brief Processes game logic updates for the current frame.
+     * @brief Steps the world owned by this thread (headless or unpipelined).
      *
-     * Update pipeline:
+     * Forwards to EngineContext::Step(). Update pipeline:
      * 1. SceneDB::UpdateScene() - Execute component lifecycle methods:
      *    - ProcessOnStart() for newly created components
      *    - ProcessUpdate() for OnUpdate() callbacks
@@ -110,24 +234,26 @@ public:
      * 2. Handle actor destruction and scene transitions
      * 3. Step physics simulation (Box2D world)
      *
-     * @note Update runs at a variable framerate; physics uses fixed timestep internally
+     * @note Pipelined runs step on the SimulationThread instead.
      */
     static void Update();
 
     /**
-     * @brief Executes the rendering pipeline for the current frame.
+     * @brief Submits a recorded frame and presents it.
      *
      * Render pipeline:
-     * 1. Renderer::clear() - Clear screen with background color
-     * 2. ImageDB::RenderAndClearAllImages() - Draw all queued sprites (sorted by z-order)
-     * 3. TextDB::RenderQueuedTexts() - Draw all queued text elements
-     * 4. ImageDB::RenderAndClearAllPixels() - Draw debug pixels (last, on top)
-     * 5. Clear all draw queues for next frame
+     * 1. Append the frame to the render capture, if one is open
+     * 2. Renderer::clear() - Clear screen with background color
+     * 3. RenderCommandBuffer::Execute() - images, particles, rects, text,
+     *    pixels, physics debug shapes, fade overlay
+     * 4. PerfOverlay::Execute() - the F2 performance HUD, when it is on
+     * 5. Save the screenshot if this is the frame it was requested for
+     * 6. Renderer::present()
      *
-     * @note All rendering is deferred - components queue draw requests during Update(),
-     *       which are batched and sorted before actual rendering
+     * @note Runs on the main thread, which owns the SDL renderer. With
+     *       pipelining it draws frame N while frame N+1 is being simulated.
      */
-    static void Render();
+    static void Render(const RenderFrame& frame);
 
 };
 
@@ -0,0 +1,209 @@
+//
+//  EngineContext.cpp
+//  game_engine
+//
+//  One simulated world: owns the lifecycle of the per-thread engine state
+//  so several headless worlds can run side by side in one process.
+//
+
+#include "EngineContext.hpp"
+#include "SceneDB.hpp"
+#include "ConfigManager.hpp"
+#include "ComponentDB.hpp"
+#include "LuaWorkerPool.hpp"
+#include "RigidbodyWorld.hpp"
+#include "CollisionListener.hpp"
+#include "Renderer.hpp"
+#include "Input.hpp"
+#include "Time.hpp"
+#include "EventSystem.hpp"
+#include "Scheduler.hpp"
+#include "Tween.hpp"
+#include "CollisionLayers.hpp"
+#include "AnimationDB.hpp"
+#include "ParticleSystem.hpp"
+#include "DebugDraw.hpp"
+#include "PerfOverlay.hpp"
+#include "SceneTransition.hpp"
+#include "Navigation.hpp"
+#include "SpatialHash.hpp"
+#include "TransformHierarchy.hpp"
+#include "SpriteRenderer.hpp"
+#include "CharacterController2D.hpp"
+#include "SceneSnapshot.hpp"
+#include "WorldStreaming.hpp"
+#include "StateHash.hpp"
+#include "ImageDB.hpp"
+#include "TextDB.hpp"
+#include "EngineUtils.hpp"
+#include "Logger.hpp"
+#include "EngineException.hpp"
+#include "Profiler.hpp"
+
+EngineContext::EngineContext(bool headless)
+    : owner(std::this_thread::get_id()), headless(headless) {
+    if (current) {
+        LOG_FATAL("An engine context already runs on this thread");
+        throw EngineException("An engine context already runs on this thread");
+    }
+    current = this;
+
+    try {
+        EngineUtils::SeedRandom(random_seed);
+        Input::Init();
+        ComponentDB::Init();
+        if (deterministic) {
+            luabridge::getGlobal(ComponentDB::GetLuaState(), "math")["randomseed"](
+                static_cast<lua_Integer>(random_seed));
+        }
+        LuaWorkerPool::Init(ConfigManager::GetLuaWorkerStates());
+        Time::Init();
+        EventSystem::Init();
+        Scheduler::Init();
+        Tween::Init();
+        CollisionLayers::Init();
+        AnimationDB::Init();
+        ParticleSystem::Init();
+        DebugDraw::Init();
+        SceneTransition::Init();
+        Navigation::Init();
+        SpatialHash::Init();
+        TransformHierarchy::Init();
+        SpriteRenderer::Init();
+        CharacterController2D::Init();
+        WorldStreaming::Init();
+        Renderer::ResetCamera();
+
+        scene = std::make_unique<SceneDB>();
+        scene->loadScene();
+    }
+    catch (...) {
+        // The destructor won't run for a half-built context.
+        LuaWorkerPool::Shutdown();
+        ComponentDB::Shutdown();
+        current = nullptr;
+        throw;
+    }
+}
+
+EngineContext::~EngineContext() {
+    // Every system that caches Lua references must release them before
+    // ComponentDB::Shutdown() closes the Lua state.
+    EventSystem::Clear();
+    Scheduler::Clear();
+    Tween::Clear();
+    AnimationDB::Clear();
+    ParticleSystem::Clear();
+    Navigation::Clear();
+    TransformHierarchy::Clear();
+    SpatialHash::Clear();
+    SpriteRenderer::Clear();
+    CharacterController2D::Clear();
+    WorldStreaming::Clear();
+    SceneSnapshot::Clear();
+    CollisionListener::Clear();
+    scene->clearLuaRefs();
+    LuaWorkerPool::Shutdown();
+    ComponentDB::Shutdown();
+    RigidbodyWorld::Shutdown();
+    scene.reset();
+
+    ImageDB::ClearQueues();
+    TextDB::ClearQueue();
+    current = nullptr;
+}
+
+void EngineContext::QueueEvent(const SDL_Event& event) {
+    pending_events.push_back(event);
+}
+
+void EngineContext::Step(float fixed_dt) {
+    if (std::this_thread::get_id() != owner) {
+        throw EngineException("EngineContext::Step called from a thread that does not own the context");
+    }
+    dropped_draws = 0;
+
+    {
+        Profiler::Scope scope(ProfileStage::Input);
+        Input::BeginFrame();
+        for (const SDL_Event& event : pending_events) {
+            if (event.type == SDL_KEYDOWN && event.key.keysym.scancode == SDL_SCANCODE_F1) {
+                DebugDraw::ToggleEnabled();
+            }
+            if (event.type == SDL_KEYDOWN && event.key.keysym.scancode == SDL_SCANCODE_F2) {
+                PerfOverlay::ToggleEnabled();
+            }
+            Input::ProcessEvent(event);
+        }
+        pending_events.clear();
+    }
+
+    {
+        Profiler::Scope scope(ProfileStage::Systems);
+        if (fixed_dt > 0.0f) Time::Advance(fixed_dt);
+        else Time::Update();
+
+        // Handle scene loading (from direct load or transition)
+        bool should_load_scene = !SceneDB::next_scene_to_load.empty();
+
+        if (!should_load_scene && SceneTransition::ShouldLoadScene()) {
+            SceneDB::next_scene_to_load = SceneTransition::GetTargetScene();
+            SceneTransition::ClearTargetScene();
+            should_load_scene = true;
+        }
+
+        if (should_load_scene) {
+            // Resident actors (DontDestroy and additive scenes) keep their
+            // subscriptions, timers and tweens, and the particles in flight
+            // while an additive scene is loaded.
+            EventSystem::ClearNonResident();
+            Scheduler::ClearNonResident();
+            Tween::ClearNonResident();
+            AnimationDB::Clear();
+            if (SceneDB::additive_scenes.empty()) ParticleSystem::Clear();
+            Navigation::Clear();
+            SceneSnapshot::Clear();
+            scene->loadScene();
+        }
+        else {
+            SceneSnapshot::ApplyPendingRestore();
+        }
+        SceneDB::ApplyPendingAdditive();
+
+        // Update timer and tween systems
+        float dt = Time::GetDeltaTime();
+        Scheduler::Update(dt);
+        Navigation::Update();
+        Tween::Update(dt);
+        AnimationDB::Update(dt);
+        ParticleSystem::Update(dt);
+        SceneTransition::Update(dt);
+        Renderer::UpdateCamera(dt);
+    }
+
+    {
+        // Physics opens its own stage inside UpdateScene().
+        Profiler::Scope scope(ProfileStage::Scripts);
+        scene->UpdateScene();
+    }
+
+    {
+        // After the physics step, so body-parented transforms see this
+        // frame's poses.
+        Profiler::Scope scope(ProfileStage::Systems);
+        TransformHierarchy::Update();
+    }
+
+    {
+        Profiler::Scope scope(ProfileStage::Input);
+        Input::LateUpdate();
+    }
+
+    if (hash_state) state_hash = StateHash::Compute();
+    if (collect_stats) WorldStats::Collect(world_stats);
+
+    if (headless && !record_draws) {
+        ImageDB::ClearQueues();
+        TextDB::ClearQueue();
+    }
+}
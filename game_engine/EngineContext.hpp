@@ -0,0 +1,166 @@
+//
+//  EngineContext.hpp
+//  game_engine
+//
+//  One simulated world: owns the lifecycle of the per-thread engine state
+//  so several headless worlds can run side by side in one process.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "SDL2/SDL.h"
+#include "FrameStats.hpp"
+
+class SceneDB;
+
+/**
+ * @class EngineContext
+ * @brief Owns one world's scene, Lua state, physics world and subsystems.
+ *
+ * Engine subsystems keep their API as static classes, but everything that
+ * describes a world (actors, Lua state, Box2D world, input, time, camera,
+ * events, timers, tweens, particles, draw queues) is `thread_local`. An
+ * EngineContext initialises that state on the thread that constructs it
+ * and tears it down in its destructor, so each thread hosts at most one
+ * world and worlds on different threads never observe each other.
+ *
+ * State that is genuinely process-wide stays shared: the SDL window and
+ * renderer, loaded textures and fonts, the audio mixer, ConfigManager,
+ * Logger and the JobSystem pool.
+ *
+ * Step() never touches the SDL renderer: draws stay in the thread's queues
+ * until RenderCommandBuffer::Record() moves them into a RenderFrame. A
+ * headless context never renders or plays audio: draw queues are dropped
+ * at the end of every Step() (unless SetRecordDraws() keeps them for
+ * golden-frame checks) and audio calls are ignored. In every context
+ * Application.Quit() only requests the end of that world (see
+ * IsQuitRequested()); whoever drives Step() decides when to stop.
+ *
+ * @code
+ * std::thread([] {
+ *     EngineContext world(true);
+ *     for (int i = 0; i < 600 && !world.IsQuitRequested(); ++i)
+ *         world.Step(1.0f / 60.0f);
+ * }).join();
+ * @endcode
+ */
+class EngineContext {
+public:
+    /**
+     * @brief Initialises a world on the calling thread and loads the initial scene.
+     * @param headless True to run without rendering, audio or cursor side effects.
+     * @throws EngineException if the calling thread already hosts a context.
+     */
+    explicit EngineContext(bool headless);
+
+    /**
+     * @brief Releases every Lua reference, closes the Lua states and the
+     *        physics world, and frees the thread for a new context.
+     */
+    ~EngineContext();
+
+    EngineContext(const EngineContext&) = delete;
+    EngineContext& operator=(const EngineContext&) = delete;
+
+    /**
+     * @brief Queues an SDL event for the next Step().
+     *
+     * Must be called from the owning thread, like every other method.
+     */
+    void QueueEvent(const SDL_Event& event);
+
+    /**
+     * @brief Simulates one frame: input (F1 toggles the physics overlay, F2
+     *        the performance overlay), time, scene loads, timers, tweens, animation, particles, camera,
+     *        the component lifecycle and the transform hierarchy.
+     *
+     * @param fixed_dt Step in seconds; 0 measures wall-clock time instead.
+     * @throws EngineException if called from a thread other than the owner.
+     */
+    void Step(float fixed_dt = 0.0f);
+
+    bool IsHeadless() const { return headless; }
+
+    /**
+     * @brief Keeps a headless world's draw requests so the caller can
+     *        Record() them, e.g. to compare against a golden frame.
+     *
+     * Nothing is rendered either way; windowed contexts always keep them.
+     */
+    void SetRecordDraws(bool record) { record_draws = record; }
+
+    /**
+     * @brief Computes StateHash::Compute() at the end of every Step(), for
+     *        comparing runs frame by frame. Off by default.
+     */
+    void SetStateHashing(bool enabled) { hash_state = enabled; }
+
+    /// Hash of the world after the last Step(); 0 unless SetStateHashing() is on.
+    uint64_t GetStateHash() const { return state_hash; }
+
+    /// Collects WorldStats at the end of every Step(), for --stats-out. Off by default.
+    void SetStatsCollection(bool enabled) { collect_stats = enabled; }
+
+    /// Counters after the last Step(); zero unless SetStatsCollection() is on.
+    const WorldStats& GetWorldStats() const { return world_stats; }
+
+    /// Asks the world to stop; checked by whoever drives Step().
+    void RequestQuit() { quit_requested = true; }
+    bool IsQuitRequested() const { return quit_requested; }
+
+    /**
+     * @brief Deterministic mode for every context constructed afterwards:
+     *        engine random streams and `math.random` in the main and
+     *        worker Lua states start from `seed` instead of a fixed engine
+     *        seed and random Lua ones.
+     *
+     * Process-wide; call before any context exists. Together with a fixed
+     * Step() dt and the same input, two runs then produce the same state
+     * hashes frame for frame.
+     */
+    static void SetDeterministicSeed(uint32_t seed) {
+        random_seed = seed;
+        deterministic = true;
+    }
+
+    static bool IsDeterministic() { return deterministic; }
+    static uint32_t GetRandomSeed() { return random_seed; }
+
+    /// Context hosted by the calling thread, or nullptr.
+    static EngineContext* Current() { return current; }
+
+    /// True when the calling thread hosts a headless context.
+    static bool IsHeadlessThread() { return current && current->headless; }
+
+    /// True when draw requests on the calling thread would never be
+    /// recorded (headless, without SetRecordDraws()).
+    static bool DropsDrawsOnThread() { return current && current->headless && !current->record_draws; }
+
+    /// Counts draw requests dropped on the calling thread, so --stats-out
+    /// can report draws without recording them.
+    static void CountDroppedDraws(int n = 1) { if (current) current->dropped_draws += n; }
+
+    /// Draw requests dropped during the current or last Step().
+    int GetDroppedDraws() const { return dropped_draws; }
+
+private:
+    std::unique_ptr<SceneDB> scene;
+    std::vector<SDL_Event> pending_events;
+    std::thread::id owner;
+    bool headless = false;
+    bool record_draws = false;
+    int dropped_draws = 0;
+    bool quit_requested = false;
+    bool hash_state = false;
+    uint64_t state_hash = 0;
+    bool collect_stats = false;
+    WorldStats world_stats;
+
+    inline static thread_local EngineContext* current = nullptr;
+    inline static uint32_t random_seed = 5489u;
+    inline static bool deterministic = false;
+};
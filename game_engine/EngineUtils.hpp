@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <cstdio>
 #include <memory>
 #include "rapidjson/filereadstream.h"
@@ -14,6 +15,48 @@
 #include "Logger.hpp"
 #include "EngineException.hpp"
 
+/**
+ * @struct Pcg32
+ * @brief PCG32 (XSH-RR) generator: 16 bytes of state, fast, and the same
+ * sequence on every platform and standard library.
+ */
+struct Pcg32 {
+    uint64_t state;
+    uint64_t inc;       ///< stream selector, always odd
+
+    void Seed(uint64_t seed, uint64_t stream) {
+        state = 0;
+        inc = (stream << 1u) | 1u;
+        Next();
+        state += seed;
+        Next();
+    }
+
+    static Pcg32 Seeded(uint64_t seed, uint64_t stream) {
+        Pcg32 pcg;
+        pcg.Seed(seed, stream);
+        return pcg;
+    }
+
+    uint32_t Next() {
+        const uint64_t old = state;
+        state = old * 6364136223846793005ULL + inc;
+        const uint32_t xorshifted = static_cast<uint32_t>(((old >> 18u) ^ old) >> 27u);
+        const uint32_t rot = static_cast<uint32_t>(old >> 59u);
+        return (xorshifted >> rot) | (xorshifted << ((32u - rot) & 31u));
+    }
+
+    /// Uniform float in [0, 1) from the top 24 bits.
+    float NextUnit() { return static_cast<float>(Next() >> 8) * (1.0f / 16777216.0f); }
+};
+
+/// Independent random streams, one per engine system that needs one.
+enum class RandomStream : uint8_t {
+    Particles,
+    Camera,
+    Count
+};
+
 /**
  * @class EngineUtils
  * @brief Utility functions for engine operations.
@@ -53,5 +96,36 @@ public:
             throw ConfigurationException("JSON parse error in file: " + path);
         }
     }
+
+    /**
+     * @brief Uniform random float in [0, 1) from one of the engine's
+     *        random streams (particle spread, camera shake).
+     *
+     * Each system draws from its own stream, so adding a particle emitter
+     * does not change the camera shake sequence. Streams are per thread:
+     * concurrent engine contexts neither race on them nor perturb each
+     * other's sequence.
+     */
+    static float RandomUnit(RandomStream stream) { return Stream(stream).NextUnit(); }
+
+    /// Reseeds every stream of the calling thread (done when an engine context starts).
+    static void SeedRandom(uint32_t seed) {
+        for (size_t i = 0; i < RANDOM_STREAM_COUNT; ++i) {
+            Stream(static_cast<RandomStream>(i)).Seed(seed, i + 1);
+        }
+    }
+
+    /// Current state of a stream, mixed into the per-frame state hash.
+    static uint64_t GetRandomState(RandomStream stream) { return Stream(stream).state; }
+
+private:
+    static constexpr size_t RANDOM_STREAM_COUNT = static_cast<size_t>(RandomStream::Count);
+
+    static Pcg32& Stream(RandomStream stream) {
+        static thread_local Pcg32 streams[RANDOM_STREAM_COUNT] = {
+            Pcg32::Seeded(5489u, 1), Pcg32::Seeded(5489u, 2)
+        };
+        return streams[static_cast<size_t>(stream)];
+    }
 };
 
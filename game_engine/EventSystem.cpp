@@ -7,6 +7,8 @@
 
 #include "EventSystem.hpp"
 #include "Logger.hpp"
+#include "Profiler.hpp"
+#include "SceneDB.hpp"
 
 void EventSystem::Init() {
     subscriptions.clear();
@@ -26,7 +28,9 @@ void EventSystem::Emit(const std::string& event_name, luabridge::LuaRef data) {
 
     for (const auto& sub : subs_copy) {
         try {
+            SceneDB::RunningActorScope running(sub.owner);
             if (sub.callback && sub.callback->isFunction()) {
+                Profiler::CountLuaCall();
                 (*sub.callback)(data);
             }
         }
@@ -56,6 +60,7 @@ int EventSystem::Subscribe(const std::string& event_name, luabridge::LuaRef call
     EventSubscription sub;
     sub.id = id;
     sub.callback = std::make_shared<luabridge::LuaRef>(callback);
+    sub.owner = SceneDB::GetRunningActor();
     sub.once = false;
 
     subscriptions[event_name].push_back(sub);
@@ -75,6 +80,7 @@ int EventSystem::SubscribeOnce(const std::string& event_name, luabridge::LuaRef
     EventSubscription sub;
     sub.id = id;
     sub.callback = std::make_shared<luabridge::LuaRef>(callback);
+    sub.owner = SceneDB::GetRunningActor();
     sub.once = true;
 
     subscriptions[event_name].push_back(sub);
@@ -120,3 +126,20 @@ void EventSystem::Clear() {
     subscriptions.clear();
     subscription_to_event.clear();
 }
+
+void EventSystem::ClearNonResident() {
+    for (auto it = subscriptions.begin(); it != subscriptions.end();) {
+        auto& subs = it->second;
+        subs.erase(
+            std::remove_if(subs.begin(), subs.end(),
+                [](const EventSubscription& sub) {
+                    if (SceneDB::IsResidentOwner(sub.owner)) return false;
+                    subscription_to_event.erase(sub.id);
+                    return true;
+                }),
+            subs.end()
+        );
+        if (subs.empty()) it = subscriptions.erase(it);
+        else ++it;
+    }
+}
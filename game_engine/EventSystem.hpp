@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <unordered_map>
@@ -22,6 +23,7 @@ struct EventSubscription {
     int id;
     std::shared_ptr<luabridge::LuaRef> callback;
     bool once;  // If true, auto-unsubscribe after first call
+    uint64_t owner;  // Actor that subscribed (SceneDB::NO_ACTOR outside any actor)
 };
 
 /**
@@ -74,13 +76,19 @@ public:
     static void UnsubscribeAll(const std::string& event_name);
 
     /**
-     * @brief Clear all subscriptions. Called on scene change.
+     * @brief Clear all subscriptions. Called on shutdown.
      */
     static void Clear();
 
+    /**
+     * @brief Drops the subscriptions not owned by a resident (DontDestroy or
+     * additive) actor. Called on Scene.Load.
+     */
+    static void ClearNonResident();
+
 private:
-    inline static std::unordered_map<std::string, std::vector<EventSubscription>> subscriptions;
-    inline static std::unordered_map<int, std::string> subscription_to_event;
-    inline static int next_subscription_id = 1;
+    inline static thread_local std::unordered_map<std::string, std::vector<EventSubscription>> subscriptions;
+    inline static thread_local std::unordered_map<int, std::string> subscription_to_event;
+    inline static thread_local int next_subscription_id = 1;
 };
 
@@ -0,0 +1,203 @@
+//
+//  FrameBudget.cpp
+//  game_engine
+//
+//  Per-stage frame-time and allocation budgets checked over a run.
+//
+
+#include "FrameBudget.hpp"
+#include "EngineUtils.hpp"
+#include "Logger.hpp"
+#include "EngineException.hpp"
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+namespace {
+    double ReadNumber(const rapidjson::Value& value, const std::string& key, const std::string& path) {
+        if (!value.IsNumber()) {
+            LOG_FATAL("Frame budget '" + key + "' must be a number in " + path);
+            throw ConfigurationException("Frame budget '" + key + "' must be a number in " + path);
+        }
+        return value.GetDouble();
+    }
+
+    struct StageResult {
+        double at_percentile = 0.0;
+        double max = 0.0;
+        int max_frame = -1;
+    };
+
+    template <typename Get>
+    StageResult Measure(const std::vector<FrameProfile>& samples, const std::vector<int>& frames,
+                        double percentile, Get get) {
+        StageResult result;
+        if (samples.empty()) return result;
+
+        std::vector<double> values;
+        values.reserve(samples.size());
+        for (size_t i = 0; i < samples.size(); ++i) {
+            const double v = get(samples[i]);
+            values.push_back(v);
+            if (result.max_frame < 0 || v > result.max) {
+                result.max = v;
+                result.max_frame = frames[i];
+            }
+        }
+        const size_t at = std::min(values.size() - 1,
+                                   static_cast<size_t>(percentile / 100.0 * (values.size() - 1) + 0.5));
+        std::nth_element(values.begin(), values.begin() + static_cast<std::ptrdiff_t>(at), values.end());
+        result.at_percentile = values[at];
+        return result;
+    }
+}
+
+void FrameBudget::Load(const std::string& budget_path) {
+    rapidjson::Document doc;
+    EngineUtils::ReadJsonFile(budget_path, doc);
+    if (!doc.IsObject()) {
+        LOG_FATAL("Frame budget must be a JSON object: " + budget_path);
+        throw ConfigurationException("Frame budget must be a JSON object: " + budget_path);
+    }
+
+    stage_budget_ms.fill(-1.0);
+    if (doc.HasMember("warmup_frames")) {
+        warmup_frames = static_cast<int>(ReadNumber(doc["warmup_frames"], "warmup_frames", budget_path));
+    }
+    if (doc.HasMember("percentile")) {
+        percentile = std::clamp(ReadNumber(doc["percentile"], "percentile", budget_path), 0.0, 100.0);
+    }
+    double headroom = 1.0;
+    double min_ms = 0.0;
+    if (doc.HasMember("headroom")) headroom = ReadNumber(doc["headroom"], "headroom", budget_path);
+    if (doc.HasMember("min_ms")) min_ms = ReadNumber(doc["min_ms"], "min_ms", budget_path);
+
+    // Both objects map stage names (and "frame" for the whole frame) to
+    // milliseconds; a baseline becomes max(baseline * headroom, min_ms).
+    auto read_stages = [&](const char* key, bool baseline) {
+        if (!doc.HasMember(key)) return;
+        const rapidjson::Value& stages = doc[key];
+        if (!stages.IsObject()) {
+            LOG_FATAL("Frame budget '" + std::string(key) + "' must be an object in " + budget_path);
+            throw ConfigurationException("Frame budget '" + std::string(key) + "' must be an object in "
+                                         + budget_path);
+        }
+        for (auto it = stages.MemberBegin(); it != stages.MemberEnd(); ++it) {
+            const std::string name = it->name.GetString();
+            double ms = ReadNumber(it->value, name, budget_path);
+            if (baseline) ms = std::max(ms * headroom, min_ms);
+            if (name == "frame") {
+                frame_budget_ms = ms;
+                continue;
+            }
+            size_t stage = 0;
+            while (stage < STAGE_COUNT && name != Profiler::GetStageName(static_cast<ProfileStage>(stage))) {
+                ++stage;
+            }
+            if (stage == STAGE_COUNT) {
+                LOG_FATAL("Unknown frame stage '" + name + "' in " + budget_path);
+                throw ConfigurationException("Unknown frame stage '" + name + "' in " + budget_path);
+            }
+            stage_budget_ms[stage] = ms;
+        }
+    };
+    frame_budget_ms = -1.0;
+    read_stages("baseline_ms", true);
+    read_stages("stage_ms", false);
+    if (doc.HasMember("frame_ms")) {
+        frame_budget_ms = ReadNumber(doc["frame_ms"], "frame_ms", budget_path);
+    }
+    if (doc.HasMember("allocations_per_frame")) {
+        allocation_budget = static_cast<long long>(
+            ReadNumber(doc["allocations_per_frame"], "allocations_per_frame", budget_path));
+    }
+
+    path = budget_path;
+    samples.clear();
+    sample_frames.clear();
+}
+
+void FrameBudget::AddFrame(int index, const FrameProfile& frame) {
+    if (index < warmup_frames) return;
+    samples.push_back(frame);
+    sample_frames.push_back(index);
+}
+
+bool FrameBudget::Report() const {
+    if (samples.empty()) {
+        LOG_ERROR("Frame budget " + path + ": no frames after the " + std::to_string(warmup_frames)
+                  + " warm-up frames");
+        return false;
+    }
+
+    std::ostringstream header;
+    header << "Frame budget " << path << ": " << samples.size() << " frames after "
+           << warmup_frames << " warm-up, p" << percentile;
+    LOG_INFO(header.str());
+
+    std::ostringstream percentile_label;
+    percentile_label << 'p' << percentile;
+
+    bool ok = true;
+    auto check = [&](const std::string& name, const StageResult& r, double budget) {
+        std::ostringstream line;
+        line << std::fixed << std::setprecision(3) << "  " << std::left << std::setw(8) << name << std::right
+             << ' ' << percentile_label.str() << ' ' << std::setw(8) << r.at_percentile << " ms   max "
+             << std::setw(8) << r.max << " ms (frame " << r.max_frame << ")";
+        if (budget < 0.0) {
+            LOG_INFO(line.str());
+            return;
+        }
+        line << "   budget " << std::setw(7) << budget << " ms";
+        if (r.at_percentile <= budget) {
+            LOG_INFO(line.str() + "  ok");
+        }
+        else {
+            LOG_ERROR(line.str() + "  OVER BUDGET");
+            ok = false;
+        }
+    };
+
+    for (size_t stage = 0; stage < STAGE_COUNT; ++stage) {
+        const StageResult r = Measure(samples, sample_frames, percentile,
+                                      [stage](const FrameProfile& f) { return f.stage_ms[stage]; });
+        check(Profiler::GetStageName(static_cast<ProfileStage>(stage)), r, stage_budget_ms[stage]);
+    }
+    check("frame", Measure(samples, sample_frames, percentile, [](const FrameProfile& f) { return f.frame_ms; }),
+          frame_budget_ms);
+
+    unsigned long long total = 0;
+    unsigned long long worst = 0;
+    int worst_frame = -1;
+    int first_frame = -1;
+    size_t over = 0;
+    for (size_t i = 0; i < samples.size(); ++i) {
+        const unsigned long long n = samples[i].allocations;
+        total += n;
+        if (n > worst) {
+            worst = n;
+            worst_frame = sample_frames[i];
+        }
+        if (allocation_budget >= 0 && n > static_cast<unsigned long long>(allocation_budget)) {
+            if (first_frame < 0) first_frame = sample_frames[i];
+            ++over;
+        }
+    }
+
+    std::ostringstream line;
+    line << "  allocations " << total << " total, max " << worst << " per frame";
+    if (worst_frame >= 0) line << " (frame " << worst_frame << ")";
+    if (allocation_budget < 0) {
+        LOG_INFO(line.str());
+    }
+    else if (over == 0) {
+        LOG_INFO(line.str() + ", budget " + std::to_string(allocation_budget) + "  ok");
+    }
+    else {
+        line << ", budget " << allocation_budget << "  OVER BUDGET in " << over << " of " << samples.size()
+             << " frames, first at frame " << first_frame;
+        LOG_ERROR(line.str());
+        ok = false;
+    }
+    return ok;
+}
@@ -0,0 +1,77 @@
+//
+//  FrameBudget.hpp
+//  game_engine
+//
+//  Per-stage frame-time and allocation budgets checked over a run.
+//
+
+#pragma once
+
+#include <array>
+#include <string>
+#include <vector>
+#include "Profiler.hpp"
+
+/**
+ * @class FrameBudget
+ * @brief Collects FrameProfiles and checks them against a budget file.
+ *
+ * Budget file (JSON, every key optional; omitted budgets are not checked):
+ *
+ * @code
+ * {
+ *     "warmup_frames": 60,
+ *     "percentile": 95,
+ *     "baseline_ms": { "systems": 0.02, "scripts": 0.07, "frame": 0.1 },
+ *     "headroom": 10,
+ *     "min_ms": 0.5,
+ *     "stage_ms": { "render": 8.0 },
+ *     "frame_ms": 12.0,
+ *     "allocations_per_frame": 0
+ * }
+ * @endcode
+ *
+ * `baseline_ms` holds times measured on a reference run (the percentile
+ * column of Report()), per stage and for the whole `frame`. Each becomes a
+ * budget of `baseline * headroom`, but never less than `min_ms`, so
+ * stages that take microseconds are not failed by scheduler noise.
+ * `stage_ms` and `frame_ms` set absolute budgets and override a baseline.
+ *
+ * Time budgets apply to the given percentile of the frames after warm-up,
+ * so a single descheduled frame does not fail a run. The allocation budget
+ * applies to every steady-state frame.
+ */
+class FrameBudget {
+public:
+    /**
+     * @brief Reads a budget file.
+     * @throws ConfigurationException if it is missing or malformed.
+     */
+    void Load(const std::string& path);
+
+    bool IsLoaded() const { return !path.empty(); }
+
+    /// Records frame `index`; warm-up frames are ignored.
+    void AddFrame(int index, const FrameProfile& frame);
+
+    /**
+     * @brief Logs a table of the measured stages and every exceeded budget.
+     *
+     * Within-budget results log at INFO, violations at ERROR.
+     * @return true if every budget held.
+     */
+    bool Report() const;
+
+private:
+    static constexpr size_t STAGE_COUNT = static_cast<size_t>(ProfileStage::Count);
+
+    std::string path;
+    int warmup_frames = 0;
+    double percentile = 95.0;
+    std::array<double, STAGE_COUNT> stage_budget_ms;    ///< < 0 = unchecked
+    double frame_budget_ms = -1.0;
+    long long allocation_budget = -1;
+
+    std::vector<FrameProfile> samples;
+    std::vector<int> sample_frames;
+};
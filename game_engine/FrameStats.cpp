@@ -0,0 +1,134 @@
+//
+//  FrameStats.cpp
+//  game_engine
+//
+//  Per-frame statistics written to a file for offline analysis (--stats-out).
+//
+
+#include "FrameStats.hpp"
+#include "SceneDB.hpp"
+#include "EngineContext.hpp"
+#include "Time.hpp"
+#include "Logger.hpp"
+#include "EngineException.hpp"
+#include <chrono>
+#include <cstring>
+
+void WorldStats::Collect(WorldStats& out) {
+    out.dt = Time::GetUnscaledDeltaTime();
+    out.counters = PerfCounters{};
+    PerfOverlay::Count(out.counters);
+    std::snprintf(out.scene, sizeof(out.scene), "%s", SceneDB::current_scene_name.c_str());
+    const EngineContext* context = EngineContext::Current();
+    out.dropped_draws = context ? context->GetDroppedDraws() : 0;
+}
+
+FrameStatsWriter::~FrameStatsWriter() {
+    Close();
+}
+
+void FrameStatsWriter::Open(const std::string& stats_path) {
+    Close();
+    file = std::fopen(stats_path.c_str(), "w");
+    if (!file) {
+        LOG_FATAL("Cannot create stats file: " + stats_path);
+        throw ConfigurationException("Cannot create stats file: " + stats_path);
+    }
+    std::setvbuf(file, nullptr, _IOFBF, 1 << 16);
+    path = stats_path;
+    ring.assign(CAPACITY, FrameStatsRecord{});
+    batch.reserve(CAPACITY);
+    head = 0;
+    count = 0;
+    written = 0;
+    dropped = 0;
+    stopping = false;
+    thread = std::thread([this] { Run(); });
+}
+
+void FrameStatsWriter::AddFrame(const FrameStatsRecord& record) {
+    bool wake = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (count == CAPACITY) {
+            ++dropped;
+            return;
+        }
+        ring[head] = record;
+        head = (head + 1) % CAPACITY;
+        ++count;
+        wake = count == CAPACITY / 4;
+    }
+    if (wake) cv.notify_one();
+}
+
+void FrameStatsWriter::Close() {
+    if (!file) return;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    cv.notify_one();
+    thread.join();
+    std::fclose(file);
+    file = nullptr;
+
+    std::string message = "Wrote " + std::to_string(written) + " frame stats to " + path;
+    if (dropped > 0) message += " (" + std::to_string(dropped) + " dropped; the writer fell behind)";
+    LOG_INFO(message);
+}
+
+void FrameStatsWriter::Run() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        cv.wait_for(lock, std::chrono::milliseconds(100),
+                    [this] { return stopping || count >= CAPACITY / 4; });
+
+        // Copy the pending records out, then format them unlocked.
+        batch.clear();
+        for (size_t tail = (head + CAPACITY - count) % CAPACITY; count > 0; --count) {
+            batch.push_back(ring[tail]);
+            tail = (tail + 1) % CAPACITY;
+        }
+        const bool done = stopping;
+        lock.unlock();
+
+        for (const FrameStatsRecord& record : batch) Write(record);
+        written += batch.size();
+        if (done) {
+            std::fflush(file);
+            return;
+        }
+        lock.lock();
+    }
+}
+
+void FrameStatsWriter::Write(const FrameStatsRecord& record) {
+    const FrameProfile& profile = record.profile;
+    const PerfCounters& counters = record.world.counters;
+
+    // Scene names come from file names; escape what JSON needs anyway.
+    char scene[2 * sizeof(record.world.scene)];
+    size_t n = 0;
+    for (const char* c = record.world.scene; *c && n + 2 < sizeof(scene); ++c) {
+        if (*c == '"' || *c == '\\') scene[n++] = '\\';
+        scene[n++] = (static_cast<unsigned char>(*c) < 0x20) ? '?' : *c;
+    }
+    scene[n] = '\0';
+
+    std::fprintf(file, "{\"frame\":%d,\"scene\":\"%s\",\"dt\":%.6f,\"frame_ms\":%.3f,\"stages\":{",
+                 record.frame, scene, record.world.dt, profile.frame_ms);
+    for (size_t i = 0; i < profile.stage_ms.size(); ++i) {
+        std::fprintf(file, "%s\"%s\":%.3f", i ? "," : "", Profiler::GetStageName(static_cast<ProfileStage>(i)),
+                     profile.stage_ms[i]);
+    }
+    char batches[16] = "null";
+    if (record.batches >= 0) std::snprintf(batches, sizeof(batches), "%d", record.batches);
+    std::fprintf(file,
+                 "},\"allocations\":%llu,\"lua_calls\":%llu,\"actors\":%d,\"components\":%d,\"lua_kb\":%d,"
+                 "\"draws\":%d,\"batches\":%s,\"particles\":%d,\"bodies\":%d,\"contacts\":%d}\n",
+                 static_cast<unsigned long long>(profile.allocations),
+                 static_cast<unsigned long long>(profile.lua_calls), counters.actors, counters.components,
+                 counters.lua_kb, record.draw_calls, batches, counters.particles, counters.bodies,
+                 counters.contacts);
+}
@@ -0,0 +1,207 @@
+//
+//  GoldenFrame.cpp
+//  game_engine
+//
+//  Compares a run's final RenderFrame against a stored golden frame.
+//
+
+#include "GoldenFrame.hpp"
+#include "RenderCapture.hpp"
+#include "RenderCommandBuffer.hpp"
+#include "ConfigManager.hpp"
+#include "Logger.hpp"
+#include <cmath>
+#include <filesystem>
+#include <sstream>
+#include <type_traits>
+#include <vector>
+
+namespace {
+    constexpr size_t MAX_REPORTED = 20;
+
+    /// Collects human-readable differences between actual and golden values.
+    struct FrameDiff {
+        float tolerance;
+        std::vector<std::string> lines;
+
+        /// Floats may differ by `tolerance`; integers (pixels, colors, degrees)
+        /// by one unit when any tolerance is allowed, to absorb rounding.
+        template <typename T>
+        void Number(const std::string& where, const char* field, T actual, T golden) {
+            const double allowed = std::is_floating_point_v<T> ? tolerance : (tolerance > 0.0f ? 1.0 : 0.0);
+            if (std::fabs(static_cast<double>(actual) - static_cast<double>(golden)) <= allowed) return;
+            Report(where, field, actual, golden);
+        }
+
+        /// Flags, kinds and sorting orders never get a tolerance.
+        void Exact(const std::string& where, const char* field, int actual, int golden) {
+            if (actual != golden) Report(where, field, actual, golden);
+        }
+
+        template <typename T>
+        void Report(const std::string& where, const char* field, T actual, T golden) {
+            std::ostringstream line;
+            line << where << ' ' << field << ": " << actual << " (golden " << golden << ")";
+            lines.push_back(line.str());
+        }
+
+        void Text(const std::string& where, const char* field, const std::string& actual, const std::string& golden) {
+            if (actual == golden) return;
+            lines.push_back(where + ' ' + field + ": '" + actual + "' (golden '" + golden + "')");
+        }
+
+        void Color(const std::string& where, int r, int g, int b, int a, int gr, int gg, int gb, int ga) {
+            Number(where, "r", r, gr);
+            Number(where, "g", g, gg);
+            Number(where, "b", b, gb);
+            Number(where, "a", a, ga);
+        }
+
+        /// Reports a count mismatch; returns the number of entries both have.
+        size_t Count(const char* list, size_t actual, size_t golden) {
+            if (actual != golden) {
+                lines.push_back(std::string(list) + ": " + std::to_string(actual) + " entries (golden "
+                                + std::to_string(golden) + ")");
+            }
+            return std::min(actual, golden);
+        }
+    };
+
+    std::string At(const char* list, size_t index, const std::string& name = "") {
+        std::string where = std::string(list) + "[" + std::to_string(index) + "]";
+        if (!name.empty()) where += " '" + name + "'";
+        return where;
+    }
+
+    void Compare(const RenderFrame& a, const RenderFrame& g, FrameDiff& diff) {
+        diff.Number("camera", "x", a.camera.position.x, g.camera.position.x);
+        diff.Number("camera", "y", a.camera.position.y, g.camera.position.y);
+        diff.Number("camera", "zoom", a.camera.zoom, g.camera.zoom);
+        diff.Exact("camera", "width", a.camera.dimensions.x, g.camera.dimensions.x);
+        diff.Exact("camera", "height", a.camera.dimensions.y, g.camera.dimensions.y);
+        diff.Number("frame", "fade_alpha", a.fade_alpha, g.fade_alpha);
+        diff.Exact("frame", "cursor_visible", a.cursor_visible, g.cursor_visible);
+
+        for (size_t i = 0, n = diff.Count("images", a.images.size(), g.images.size()); i < n; ++i) {
+            const ImageDrawRequest& x = a.images[i];
+            const ImageDrawRequest& y = g.images[i];
+            const std::string where = At("images", i, y.image_name);
+            diff.Text(where, "image", x.image_name, y.image_name);
+            diff.Number(where, "x", x.x, y.x);
+            diff.Number(where, "y", x.y, y.y);
+            diff.Number(where, "rotation", x.rotation_degrees, y.rotation_degrees);
+            diff.Number(where, "scale_x", x.scale_x, y.scale_x);
+            diff.Number(where, "scale_y", x.scale_y, y.scale_y);
+            diff.Number(where, "pivot_x", x.pivot_x, y.pivot_x);
+            diff.Number(where, "pivot_y", x.pivot_y, y.pivot_y);
+            diff.Exact(where, "source_x", x.source.x, y.source.x);
+            diff.Exact(where, "source_y", x.source.y, y.source.y);
+            diff.Exact(where, "source_w", x.source.w, y.source.w);
+            diff.Exact(where, "source_h", x.source.h, y.source.h);
+            diff.Color(where, x.r, x.g, x.b, x.a, y.r, y.g, y.b, y.a);
+            diff.Exact(where, "sorting_order", x.sorting_order, y.sorting_order);
+            diff.Exact(where, "is_ui", x.is_ui, y.is_ui);
+        }
+
+        for (size_t i = 0, n = diff.Count("particles", a.particles.size(), g.particles.size()); i < n; ++i) {
+            const ParticleDrawData& x = a.particles[i];
+            const ParticleDrawData& y = g.particles[i];
+            const std::string where = At("particles", i, y.image_name);
+            diff.Text(where, "image", x.image_name, y.image_name);
+            diff.Number(where, "x", x.x, y.x);
+            diff.Number(where, "y", x.y, y.y);
+            diff.Number(where, "size", x.size, y.size);
+            diff.Color(where, x.r, x.g, x.b, x.a, y.r, y.g, y.b, y.a);
+        }
+
+        for (size_t i = 0, n = diff.Count("rects", a.rects.size(), g.rects.size()); i < n; ++i) {
+            const RectDrawRequest& x = a.rects[i];
+            const RectDrawRequest& y = g.rects[i];
+            const std::string where = At("rects", i);
+            diff.Number(where, "x", x.x, y.x);
+            diff.Number(where, "y", x.y, y.y);
+            diff.Number(where, "w", x.w, y.w);
+            diff.Number(where, "h", x.h, y.h);
+            diff.Color(where, x.r, x.g, x.b, x.a, y.r, y.g, y.b, y.a);
+        }
+
+        for (size_t i = 0, n = diff.Count("texts", a.texts.size(), g.texts.size()); i < n; ++i) {
+            const TextDrawRequest& x = a.texts[i];
+            const TextDrawRequest& y = g.texts[i];
+            const std::string where = At("texts", i, y.content);
+            diff.Text(where, "content", x.content, y.content);
+            diff.Text(where, "font", x.fontName, y.fontName);
+            diff.Number(where, "x", x.x, y.x);
+            diff.Number(where, "y", x.y, y.y);
+            diff.Exact(where, "size", x.fontSize, y.fontSize);
+            diff.Color(where, x.color.r, x.color.g, x.color.b, x.color.a, y.color.r, y.color.g, y.color.b, y.color.a);
+        }
+
+        for (size_t i = 0, n = diff.Count("pixels", a.pixels.size(), g.pixels.size()); i < n; ++i) {
+            const PixelDrawRequest& x = a.pixels[i];
+            const PixelDrawRequest& y = g.pixels[i];
+            const std::string where = At("pixels", i);
+            diff.Number(where, "x", x.x, y.x);
+            diff.Number(where, "y", x.y, y.y);
+            diff.Color(where, x.r, x.g, x.b, x.a, y.r, y.g, y.b, y.a);
+        }
+
+        for (size_t i = 0, n = diff.Count("debug", a.debug.size(), g.debug.size()); i < n; ++i) {
+            const DebugPrimitive& x = a.debug[i];
+            const DebugPrimitive& y = g.debug[i];
+            const std::string where = At("debug", i);
+            diff.Exact(where, "kind", static_cast<int>(x.kind), static_cast<int>(y.kind));
+            diff.Number(where, "x1", x.x1, y.x1);
+            diff.Number(where, "y1", x.y1, y.y1);
+            diff.Number(where, "x2", x.x2, y.x2);
+            diff.Number(where, "y2", x.y2, y.y2);
+            diff.Color(where, x.r, x.g, x.b, x.a, y.r, y.g, y.b, y.a);
+        }
+    }
+}
+
+void GoldenFrame::Save(const std::string& path, const RenderFrame& frame) {
+    RenderCaptureWriter writer;
+    writer.Open(path, ConfigManager::GetResolution(), ConfigManager::GetClearColor());
+    writer.WriteFrame(frame);
+    writer.Close();
+    LOG_INFO("Golden frame written to " + path);
+}
+
+bool GoldenFrame::Check(const std::string& path, const RenderFrame& frame, float tolerance) {
+    if (!std::filesystem::exists(path)) {
+        LOG_ERROR("Golden frame missing: " + path + " (run with --update-golden to create it)");
+        return false;
+    }
+
+    RenderFrame golden;
+    RenderCaptureReader reader;
+    reader.Open(path);
+    if (!reader.ReadFrame(golden)) {
+        LOG_ERROR("Golden frame is empty: " + path);
+        return false;
+    }
+
+    FrameDiff diff{tolerance, {}};
+    Compare(frame, golden, diff);
+    if (diff.lines.empty()) {
+        LOG_INFO("Golden frame matches " + path);
+        return true;
+    }
+
+    const std::string actual_path = std::filesystem::path(path).stem().string() + ".actual.frc";
+    LOG_ERROR("Final frame differs from golden " + path + " in " + std::to_string(diff.lines.size())
+              + " field(s); actual frame saved to " + actual_path);
+    for (size_t i = 0; i < diff.lines.size() && i < MAX_REPORTED; ++i) {
+        LOG_ERROR("  " + diff.lines[i]);
+    }
+    if (diff.lines.size() > MAX_REPORTED) {
+        LOG_ERROR("  ... and " + std::to_string(diff.lines.size() - MAX_REPORTED) + " more");
+    }
+
+    RenderCaptureWriter writer;
+    writer.Open(actual_path, ConfigManager::GetResolution(), ConfigManager::GetClearColor());
+    writer.WriteFrame(frame);
+    writer.Close();
+    return false;
+}
@@ -0,0 +1,50 @@
+//
+//  GoldenFrame.hpp
+//  game_engine
+//
+//  Compares a run's final RenderFrame against a stored golden frame.
+//
+
+#pragma once
+
+#include <string>
+
+struct RenderFrame;
+
+/**
+ * @class GoldenFrame
+ * @brief Golden-frame regression check on the recorded draw stream.
+ *
+ * A golden is a one-frame render capture (see RenderCapture.hpp) of the
+ * last frame of a deterministic run. Comparing draw streams instead of
+ * pixels works headless, and does not depend on the GPU, driver or SDL
+ * backend that rasterizes them.
+ *
+ * @code
+ * game_engine --headless --self-check 300 --golden tests/golden/demo.frc
+ * game_engine --headless --self-check 300 --golden tests/golden/demo.frc --update-golden
+ * @endcode
+ */
+class GoldenFrame {
+public:
+    /**
+     * @brief Writes `frame` as the new golden at `path`.
+     * @throws ConfigurationException if the file cannot be created.
+     */
+    static void Save(const std::string& path, const RenderFrame& frame);
+
+    /**
+     * @brief Compares `frame` with the golden at `path`.
+     *
+     * Float fields (world positions, scales, zoom, particle sizes) may
+     * differ by up to `tolerance`, and integer fields (pixel positions,
+     * colors, rotation) by one unit when `tolerance` > 0. Names, text,
+     * counts, flags and sorting orders must match exactly.
+     * On a mismatch the differences are logged as errors, one line each
+     * (the first 20), and the actual frame is written to the working
+     * directory as `<golden name>.actual.frc` for render_replay.
+     *
+     * @return true if the frame matches.
+     */
+    static bool Check(const std::string& path, const RenderFrame& frame, float tolerance);
+};
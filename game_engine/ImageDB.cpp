@@ -6,6 +6,8 @@
 //
 
 #include "ImageDB.hpp"
+#include "EngineContext.hpp"
+#include "RenderCommandBuffer.hpp"
 #include "SDL2_image/SDL_image.h"
 #include "Logger.hpp"
 #include "EngineException.hpp"
@@ -60,6 +62,11 @@ SDL_Texture* ImageDB::GetTexture(const std::string& imageName) {
 // Image API methods
 
 void ImageDB::QueueImageDraw(const std::string& imageName, float x, float y) {
+    // Headless contexts never render; skip the request unless it is recorded.
+    if (EngineContext::DropsDrawsOnThread()) {
+        EngineContext::CountDroppedDraws();
+        return;
+    }
     ImageDrawRequest request;
     request.image_name = imageName;
     request.x = x;
@@ -85,6 +92,10 @@ void ImageDB::QueueImageDrawEx(const std::string& imageName, float x, float y,
                               float pivotX, float pivotY,
                               float r, float g, float b, float a,
                               float sortingOrder) {
+    if (EngineContext::DropsDrawsOnThread()) {
+        EngineContext::CountDroppedDraws();
+        return;
+    }
     ImageDrawRequest request;
     request.image_name = imageName;
     request.x = x;
@@ -105,7 +116,26 @@ void ImageDB::QueueImageDrawEx(const std::string& imageName, float x, float y,
     image_draw_request_queue.push_back(request);
 }
 
+void ImageDB::QueueImageDrawRequest(ImageDrawRequest& request) {
+    if (EngineContext::DropsDrawsOnThread()) {
+        EngineContext::CountDroppedDraws();
+        return;
+    }
+    request.r = clamp_color(request.r);
+    request.g = clamp_color(request.g);
+    request.b = clamp_color(request.b);
+    request.a = clamp_color(request.a);
+    request.is_ui = false;
+    request.order_index = request_counter++;
+
+    image_draw_request_queue.push_back(request);
+}
+
 void ImageDB::QueueImageDrawUI(const std::string& imageName, float x, float y) {
+    if (EngineContext::DropsDrawsOnThread()) {
+        EngineContext::CountDroppedDraws();
+        return;
+    }
     ImageDrawRequest request;
     request.image_name = imageName;
     
@@ -133,6 +163,10 @@ void ImageDB::QueueImageDrawUI(const std::string& imageName, float x, float y) {
 void ImageDB::QueueImageDrawUIEx(const std::string& imageName, float x, float y,
     float r, float g, float b, float a,
     float sortingOrder) {
+    if (EngineContext::DropsDrawsOnThread()) {
+        EngineContext::CountDroppedDraws();
+        return;
+    }
     ImageDrawRequest request;
     request.image_name = imageName;
     
@@ -156,6 +190,10 @@ void ImageDB::QueueImageDrawUIEx(const std::string& imageName, float x, float y,
 }
 
 void ImageDB::QueueDrawPixel(float x, float y, float r, float g, float b, float a) {
+    if (EngineContext::DropsDrawsOnThread()) {
+        EngineContext::CountDroppedDraws();
+        return;
+    }
     PixelDrawRequest request;
     request.x = static_cast<int>(x);
     request.y = static_cast<int>(y);
@@ -168,6 +206,10 @@ void ImageDB::QueueDrawPixel(float x, float y, float r, float g, float b, float
 }
 
 void ImageDB::QueueDrawRect(float x, float y, float w, float h, float r, float g, float b, float a) {
+    if (EngineContext::DropsDrawsOnThread()) {
+        EngineContext::CountDroppedDraws();
+        return;
+    }
     RectDrawRequest request;
     request.x = static_cast<int>(x);
     request.y = static_cast<int>(y);
@@ -181,20 +223,46 @@ void ImageDB::QueueDrawRect(float x, float y, float w, float h, float r, float g
     rect_draw_request_queue.push_back(request);
 }
 
-void ImageDB::RenderAndClearAllImages() {
-    std::stable_sort(image_draw_request_queue.begin(), image_draw_request_queue.end(), compare_image_requests);
+void ImageDB::TakeQueues(std::vector<ImageDrawRequest>& images,
+                         std::vector<RectDrawRequest>& rects,
+                         std::vector<PixelDrawRequest>& pixels) {
+    // order_index makes the comparison a total order, so an in-place sort is
+    // as stable as std::stable_sort without its temporary buffer.
+    std::sort(image_draw_request_queue.begin(), image_draw_request_queue.end(), compare_image_requests);
+
+    images.clear();
+    rects.clear();
+    pixels.clear();
+    images.swap(image_draw_request_queue);
+    rects.swap(rect_draw_request_queue);
+    pixels.swap(pixel_draw_request_queue);
+    request_counter = 0;
+}
 
-    float zoom_factor = Renderer::GetCameraZoomFactor();
-    glm::ivec2 cam_dimensions = Renderer::GetCameraDimensions();
+void ImageDB::RenderImages(const std::vector<ImageDrawRequest>& requests, const RenderCamera& camera) {
+    SDL_Renderer* renderer = Renderer::getSDLRenderer();
+    const float zoom_factor = camera.zoom;
+    const glm::ivec2 cam_dimensions = camera.dimensions;
     const int pixels_per_meter = 100;
 
-    for (auto& request : image_draw_request_queue) {
+    for (const auto& request : requests) {
         SDL_Texture* tex = GetTexture(request.image_name);
         SDL_FRect tex_rect;
 
         float texture_width, texture_height;
         Helper::SDL_QueryTexture(tex, &texture_width, &texture_height);
 
+        // A source region (an animation frame) replaces the texture size.
+        SDL_FRect source_rect;
+        const SDL_FRect* source = nullptr;
+        if (request.source.w > 0 && request.source.h > 0) {
+            source_rect = { static_cast<float>(request.source.x), static_cast<float>(request.source.y),
+                            static_cast<float>(request.source.w), static_cast<float>(request.source.h) };
+            source = &source_rect;
+            texture_width = static_cast<float>(request.source.w);
+            texture_height = static_cast<float>(request.source.h);
+        }
+
         // Apply scale
         float x_scale = glm::abs(request.scale_x);
         float y_scale = glm::abs(request.scale_y);
@@ -212,15 +280,15 @@ void ImageDB::RenderAndClearAllImages() {
             flip_mode |= SDL_FLIP_VERTICAL;
 
         if (request.is_ui) {
-            SDL_RenderSetScale(Renderer::getSDLRenderer(), 1, 1);
+            SDL_RenderSetScale(renderer, 1, 1);
 
             tex_rect.x = request.x;
             tex_rect.y = request.y;
         }
         else {
-            SDL_RenderSetScale(Renderer::getSDLRenderer(), zoom_factor, zoom_factor);
+            SDL_RenderSetScale(renderer, zoom_factor, zoom_factor);
 
-            glm::vec2 final_rendering_position = glm::vec2(request.x, request.y) - Renderer::GetEffectiveCameraPosition();
+            glm::vec2 final_rendering_position = glm::vec2(request.x, request.y) - camera.position;
 
             tex_rect.x = final_rendering_position.x * pixels_per_meter +
                 cam_dimensions.x * 0.5f * (1.0f / zoom_factor) -
@@ -233,7 +301,7 @@ void ImageDB::RenderAndClearAllImages() {
         SDL_SetTextureColorMod(tex, request.r, request.g, request.b);
         SDL_SetTextureAlphaMod(tex, request.a);
 
-        Helper::SDL_RenderCopyEx(-1, "", Renderer::getSDLRenderer(), tex, NULL, &tex_rect,
+        Helper::SDL_RenderCopyEx(-1, "", renderer, tex, source, &tex_rect,
             request.rotation_degrees, &pivot_point,
             static_cast<SDL_RendererFlip>(flip_mode));
 
@@ -241,40 +309,34 @@ void ImageDB::RenderAndClearAllImages() {
         SDL_SetTextureAlphaMod(tex, 255);
     }
 
-    SDL_RenderSetScale(Renderer::getSDLRenderer(), 1, 1);
-
-    image_draw_request_queue.clear();
+    SDL_RenderSetScale(renderer, 1, 1);
 }
 
-void ImageDB::RenderAndClearAllRects() {
+void ImageDB::RenderRects(const std::vector<RectDrawRequest>& requests) {
     SDL_Renderer* renderer = Renderer::getSDLRenderer();
     SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
 
-    for (const auto& request : rect_draw_request_queue) {
+    for (const auto& request : requests) {
         SDL_SetRenderDrawColor(renderer, request.r, request.g, request.b, request.a);
         SDL_Rect rect = {request.x, request.y, request.w, request.h};
         SDL_RenderFillRect(renderer, &rect);
     }
 
     SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
-    rect_draw_request_queue.clear();
 }
 
-void ImageDB::RenderAndClearAllPixels() {
+void ImageDB::RenderPixels(const std::vector<PixelDrawRequest>& requests) {
     SDL_Renderer* renderer = Renderer::getSDLRenderer();
     SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
 
-    for (const auto& request : pixel_draw_request_queue) {
+    for (const auto& request : requests) {
         SDL_SetRenderDrawColor(renderer, request.r, request.g, request.b, request.a);
         SDL_RenderDrawPoint(renderer, request.x, request.y);
     }
 
     SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
-    pixel_draw_request_queue.clear();
 }
 
-
-
 void ImageDB::ClearQueues() {
     image_draw_request_queue.clear();
     pixel_draw_request_queue.clear();
@@ -301,3 +363,17 @@ void ImageDB::CreateDefaultParticleTextureWithName(const std::string& name) {
     SDL_FreeSurface(surface);
     textureMap[name] = texture;
 }
+
+uint64_t ImageDB::GetTextureMemory() {
+    if (texture_bytes_count == textureMap.size()) return texture_bytes;
+    texture_bytes = 0;
+    for (const auto& [name, texture] : textureMap) {
+        int w = 0;
+        int h = 0;
+        if (texture && SDL_QueryTexture(texture, nullptr, nullptr, &w, &h) == 0) {
+            texture_bytes += static_cast<uint64_t>(w) * h * 4;
+        }
+    }
+    texture_bytes_count = textureMap.size();
+    return texture_bytes;
+}
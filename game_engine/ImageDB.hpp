@@ -22,6 +22,8 @@
 #include <queue>
 #include <algorithm>
 
+struct RenderCamera;
+
 /**
  * @struct ImageDrawRequest
  * @brief Encapsulates all parameters for a deferred sprite draw call.
@@ -38,6 +40,7 @@ struct ImageDrawRequest {
     float scale_y;              ///< Vertical scale factor (1.0 = normal)
     float pivot_x;              ///< Pivot point X (0.5 = center)
     float pivot_y;              ///< Pivot point Y (0.5 = center)
+    SDL_Rect source = { 0, 0, 0, 0 }; ///< Texture region to draw (w == 0 = whole texture)
     int r;                      ///< Red color modulation (0-255)
     int g;                      ///< Green color modulation (0-255)
     int b;                      ///< Blue color modulation (0-255)
@@ -77,7 +80,7 @@ struct RectDrawRequest {
  *
  * ImageDB manages texture loading, caching, and deferred rendering of sprites.
  * Components queue draw requests via QueueImageDraw*() methods, which are batched,
- * sorted by z-order, and rendered during Engine::Render().
+ * sorted by z-order, and rendered by the render stage (see RenderCommandBuffer).
  *
  * Features:
  * - Automatic texture loading and caching from resources/images/
@@ -91,10 +94,10 @@ struct RectDrawRequest {
  * Rendering Pipeline:
  * 1. Components call QueueImageDraw*() during Update phase
  * 2. Draw requests accumulate in image_draw_request_queue
- * 3. Engine::Render() calls RenderAndClearAllImages()
- * 4. Requests are sorted by (sorting_order, order_index)
- * 5. Each request is rendered with SDL_RenderCopyEx()
- * 6. Queue is cleared for next frame
+ * 3. RenderCommandBuffer::Record() calls TakeQueues(), which sorts the
+ *    requests by (sorting_order, order_index) and moves them into a RenderFrame
+ * 4. The render stage calls RenderImages(), which draws each request with
+ *    SDL_RenderCopyEx()
  *
  * @note ImageDB uses static methods for global access from Lua scripts
  */
@@ -149,6 +152,13 @@ public:
                           float r, float g, float b, float a,
                           float sortingOrder);
 
+    /**
+     * @brief Queues a prepared world-space request, e.g. from a SpriteRenderer.
+     *
+     * Colors are clamped and order_index is assigned here.
+     */
+    static void QueueImageDrawRequest(ImageDrawRequest& request);
+
     /**
      * @brief Queues a UI sprite draw (screen-space, ignores camera).
      *
@@ -196,32 +206,46 @@ public:
     static void QueueDrawRect(float x, float y, float w, float h, float r, float g, float b, float a);
 
     /**
-     * @brief Renders all queued image draws, then clears the queue.
+     * @brief Moves this thread's queues into a render frame.
+     *
+     * Image requests are sorted by (is_ui, sorting_order, order_index) here,
+     * on the recording thread, so the render stage only submits. The frame's
+     * vectors are swapped with the queues, so both keep their capacity.
+     *
+     * @note Called by RenderCommandBuffer::Record()
+     */
+    static void TakeQueues(std::vector<ImageDrawRequest>& images,
+                           std::vector<RectDrawRequest>& rects,
+                           std::vector<PixelDrawRequest>& pixels);
+
+    /**
+     * @brief Draws recorded sprite requests.
      *
      * Rendering process:
-     * 1. Sort image_draw_request_queue by (sorting_order, order_index)
-     * 2. For each request, apply camera transform (if not UI)
-     * 3. Render with SDL_RenderCopyEx() (rotation, scale, color mod)
-     * 4. Clear queue
+     * 1. For each request, apply the recorded camera transform (if not UI)
+     * 2. Render with SDL_RenderCopyEx() (rotation, scale, color mod)
      *
-     * @note Called once per frame by Engine::Render()
+     * @param requests Requests already sorted by TakeQueues()
+     * @param camera Camera state recorded with the frame
+     *
+     * @note Called on the render thread by RenderCommandBuffer::Execute()
      */
-    static void RenderAndClearAllImages();
+    static void RenderImages(const std::vector<ImageDrawRequest>& requests, const RenderCamera& camera);
 
     /**
-     * @brief Renders queued filled rectangles, then clears the queue.
+     * @brief Draws recorded filled rectangles.
      *
-     * @note UI-space. Intended for backdrops behind HUD text, so this is
-     *       called *before* TextDB::RenderQueuedTexts().
+     * @note UI-space. Intended for backdrops behind HUD text, so this runs
+     *       *before* TextDB::RenderTexts().
      */
-    static void RenderAndClearAllRects();
+    static void RenderRects(const std::vector<RectDrawRequest>& requests);
 
     /**
-     * @brief Renders queued pixel draws, then clears the queue.
+     * @brief Draws recorded pixels.
      *
      * @note Pixels draw last, on top of everything, and ignore camera.
      */
-    static void RenderAndClearAllPixels();
+    static void RenderPixels(const std::vector<PixelDrawRequest>& requests);
 
     /**
      * @brief Clears all draw queues without rendering.
@@ -239,21 +263,32 @@ public:
      */
     static void CreateDefaultParticleTextureWithName(const std::string& name);
 
+    /**
+     * @brief Approximate bytes held by cached textures (width * height * 4).
+     *
+     * @note Re-measured only when the cache has changed size. Render thread.
+     */
+    static uint64_t GetTextureMemory();
+
 private:
     /// Texture cache: image name -> SDL_Texture*
     inline static std::unordered_map<std::string, SDL_Texture*> textureMap;
 
+    /// GetTextureMemory() result and the cache size it was measured at
+    inline static uint64_t texture_bytes = 0;
+    inline static size_t texture_bytes_count = 0;
+
     /// Deferred draw request queue for images
-    inline static std::vector<ImageDrawRequest> image_draw_request_queue;
+    inline static thread_local std::vector<ImageDrawRequest> image_draw_request_queue;
 
     /// Deferred draw request queue for pixels
-    inline static std::vector<PixelDrawRequest> pixel_draw_request_queue;
-    inline static std::vector<RectDrawRequest> rect_draw_request_queue;
+    inline static thread_local std::vector<PixelDrawRequest> pixel_draw_request_queue;
+    inline static thread_local std::vector<RectDrawRequest> rect_draw_request_queue;
 
     /// Submission order counter for stable sorting
-    inline static size_t request_counter = 0;
+    inline static thread_local size_t request_counter = 0;
 
     /// Pixel submission order counter
-    inline static size_t pixel_request_counter = 0;
+    inline static thread_local size_t pixel_request_counter = 0;
 };
 
@@ -99,6 +99,7 @@ void Input::Init() {
     mouseButtonStates[1] = INPUT_STATE_UP;
     mouseButtonStates[2] = INPUT_STATE_UP;
     mouseButtonStates[3] = INPUT_STATE_UP;
+    cursor_visible = true;
 
     mouse_scroll_this_frame = 0.0f;
     mouse_position = {0.0f, 0.0f};
@@ -227,12 +228,12 @@ float Input::GetMouseScrollDelta() {
 }
 
 void Input::HideCursor() {
-    SDL_ShowCursor(SDL_DISABLE);
+    cursor_visible = false;
 }
 
 void Input::ShowCursor()
 {
-    SDL_ShowCursor(SDL_ENABLE);
+    cursor_visible = true;
 }
 
 void Input::BeginFrame() {
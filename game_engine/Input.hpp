@@ -201,50 +201,65 @@ public:
     /**
      * @brief Hides the mouse cursor.
      *
-     * @note Uses SDL_ShowCursor(SDL_DISABLE) internally
+     * @note Recorded with the frame; the render stage applies it with
+     *       SDL_ShowCursor(SDL_DISABLE)
      */
     static void HideCursor();
 
     /**
      * @brief Shows the mouse cursor.
      *
-     * @note Uses SDL_ShowCursor(SDL_ENABLE) internally
+     * @note Recorded with the frame; the render stage applies it with
+     *       SDL_ShowCursor(SDL_ENABLE)
      */
     static void ShowCursor();
 
+    /// Cursor visibility requested by this world's scripts.
+    static bool IsCursorVisible() { return cursor_visible; }
+
+    /**
+     * @brief Converts a string key name to SDL scancode.
+     *
+     * @param key Key name (e.g., "space", "return", "a", "escape")
+     * @return Corresponding SDL_Scancode
+     *
+     * @note Uses SDL_GetScancodeFromName() internally
+     */
+    static SDL_Scancode StringToScancode(const std::string& key);
+
+    /// Current state of every key seen so far (absent keys are up).
+    static const std::unordered_map<SDL_Scancode, INPUT_STATE>& GetKeyStates() { return keyStates; }
+
+    /// Current state of every mouse button seen so far (absent buttons are up).
+    static const std::unordered_map<int, INPUT_STATE>& GetMouseButtonStates() { return mouseButtonStates; }
+
 private:
     /// Map of SDL scancodes to their current input state
-    static inline std::unordered_map<SDL_Scancode, INPUT_STATE> keyStates;
+    static inline thread_local std::unordered_map<SDL_Scancode, INPUT_STATE> keyStates;
 
     /// List of keys that transitioned to JUST_BECAME_DOWN this frame
-    static inline std::vector<SDL_Scancode> justBecameDown;
+    static inline thread_local std::vector<SDL_Scancode> justBecameDown;
 
     /// List of keys that transitioned to JUST_BECAME_UP this frame
-    static inline std::vector<SDL_Scancode> justBecameUp;
+    static inline thread_local std::vector<SDL_Scancode> justBecameUp;
 
     /// Current mouse cursor position in screen space (pixels)
-    static inline glm::vec2 mouse_position;
+    static inline thread_local glm::vec2 mouse_position;
 
     /// Map of mouse buttons to their current input state
-    static inline std::unordered_map<int, INPUT_STATE> mouseButtonStates;
+    static inline thread_local std::unordered_map<int, INPUT_STATE> mouseButtonStates;
 
     /// List of mouse buttons that transitioned to JUST_BECAME_DOWN this frame
-    static inline std::vector<int> mouseButtonsJustDown;
+    static inline thread_local std::vector<int> mouseButtonsJustDown;
 
     /// List of mouse buttons that transitioned to JUST_BECAME_UP this frame
-    static inline std::vector<int> mouseButtonsJustUp;
+    static inline thread_local std::vector<int> mouseButtonsJustUp;
 
     /// Mouse scroll delta for the current frame (reset each frame)
-    static inline float mouse_scroll_this_frame = 0;
+    static inline thread_local float mouse_scroll_this_frame = 0;
+
+    /// Requested cursor visibility, applied by the render stage
+    static inline thread_local bool cursor_visible = true;
 
-    /**
-     * @brief Converts a string key name to SDL scancode.
-     *
-     * @param key Key name (e.g., "space", "return", "a", "escape")
-     * @return Corresponding SDL_Scancode
-     *
-     * @note Uses SDL_GetScancodeFromName() internally
-     */
-    static SDL_Scancode StringToScancode(const std::string& key);
 };
 
@@ -0,0 +1,108 @@
+//
+//  InputReplay.cpp
+//  game_engine
+//
+//  Feeds recorded SDL input back into the engine, frame by frame.
+//
+
+#include "InputReplay.hpp"
+#include "Logger.hpp"
+#include "EngineException.hpp"
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+namespace {
+    /// Splits the next comma-separated field off an event string.
+    bool NextField(std::istringstream& stream, std::string& out) {
+        if (!std::getline(stream, out, ',')) return false;
+        out.erase(std::remove(out.begin(), out.end(), '\r'), out.end());
+        return !out.empty();
+    }
+
+    bool ParseEvent(const std::string& text, SDL_Event& event) {
+        std::istringstream stream(text);
+        std::string field;
+        if (!NextField(stream, field)) return false;
+
+        SDL_zero(event);
+        event.type = static_cast<Uint32>(std::stoul(field));
+
+        switch (event.type) {
+            case SDL_KEYDOWN:
+            case SDL_KEYUP:
+                if (!NextField(stream, field)) return false;
+                event.key.keysym.scancode = static_cast<SDL_Scancode>(std::stoi(field));
+                return true;
+            case SDL_MOUSEMOTION: {
+                std::string y_field;
+                if (!NextField(stream, field) || !NextField(stream, y_field)) return false;
+                event.motion.x = static_cast<Sint32>(std::stoi(field));
+                event.motion.y = static_cast<Sint32>(std::stoi(y_field));
+                return true;
+            }
+            case SDL_MOUSEBUTTONDOWN:
+            case SDL_MOUSEBUTTONUP:
+                if (!NextField(stream, field)) return false;
+                event.button.button = static_cast<Uint8>(std::stoi(field));
+                return true;
+            case SDL_MOUSEWHEEL:
+                if (!NextField(stream, field)) return false;
+                event.wheel.preciseY = std::stof(field);
+                return true;
+            case SDL_QUIT:
+                return true;
+            default:
+                return false;
+        }
+    }
+}
+
+void InputReplay::Load(const std::string& path) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        LOG_FATAL("Replay file missing: " + path);
+        throw ResourceNotFoundException("replay", path);
+    }
+
+    frame_events.clear();
+    last_frame = -1;
+
+    std::string line;
+    int line_number = 0;
+    size_t event_count = 0;
+    while (std::getline(file, line)) {
+        ++line_number;
+        if (line.empty() || line == "\r") continue;
+
+        try {
+            std::istringstream line_stream(line);
+            std::string frame_field;
+            std::getline(line_stream, frame_field, ';');
+            const int frame = std::stoi(frame_field);
+
+            std::string event_text;
+            while (std::getline(line_stream, event_text, ';')) {
+                SDL_Event event;
+                if (!ParseEvent(event_text, event)) continue;
+                frame_events[frame].push_back(event);
+                ++event_count;
+            }
+            last_frame = std::max(last_frame, frame);
+        }
+        catch (const std::logic_error&) {
+            LOG_FATAL("Malformed replay line " + std::to_string(line_number) + " in " + path);
+            throw ConfigurationException("Malformed replay line " + std::to_string(line_number) + " in " + path);
+        }
+    }
+
+    loaded = true;
+    LOG_INFO("Loaded replay " + path + " (" + std::to_string(event_count) + " events, last frame "
+             + std::to_string(last_frame) + ")");
+}
+
+const std::vector<SDL_Event>& InputReplay::EventsForFrame(int frame) const {
+    static const std::vector<SDL_Event> none;
+    auto it = frame_events.find(frame);
+    return it == frame_events.end() ? none : it->second;
+}
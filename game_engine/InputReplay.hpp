@@ -0,0 +1,52 @@
+//
+//  InputReplay.hpp
+//  game_engine
+//
+//  Feeds recorded SDL input back into the engine, frame by frame.
+//
+
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "SDL2/SDL.h"
+
+/**
+ * @class InputReplay
+ * @brief Loads a recorded input file and hands out its events per frame.
+ *
+ * Uses the same line format Helper.h records to `recorded_sdl_user_input.txt`:
+ *
+ * @code
+ * <frame>;<event_type>,<payload>;<event_type>,<payload>;...
+ * @endcode
+ *
+ * where the payload is a scancode (key events), `x,y` (mouse motion), a
+ * button index (mouse buttons) or a float scroll amount (mouse wheel).
+ * Frames are zero-based simulation frames (Time::GetFrameNumber()).
+ */
+class InputReplay {
+public:
+    /**
+     * @brief Parses a replay file.
+     * @param path Path to the replay file.
+     * @throws ResourceNotFoundException if the file cannot be opened.
+     * @throws ConfigurationException if a line cannot be parsed.
+     */
+    void Load(const std::string& path);
+
+    /// True once a replay file has been loaded.
+    bool IsLoaded() const { return loaded; }
+
+    /// Events recorded for a frame (empty if none).
+    const std::vector<SDL_Event>& EventsForFrame(int frame) const;
+
+    /// Last frame with recorded events, or -1 for an empty replay.
+    int GetLastFrame() const { return last_frame; }
+
+private:
+    std::unordered_map<int, std::vector<SDL_Event>> frame_events;
+    int last_frame = -1;
+    bool loaded = false;
+};
@@ -0,0 +1,111 @@
+//
+//  JobSystem.cpp
+//  game_engine
+//
+//  Process-wide worker thread pool for data-parallel engine work.
+//
+
+#include "JobSystem.hpp"
+#include "Logger.hpp"
+#include <algorithm>
+
+void JobSystem::Init(int thread_count) {
+    if (!workers.empty()) return;
+
+    if (thread_count <= 0) {
+        thread_count = static_cast<int>(std::thread::hardware_concurrency());
+    }
+    thread_count = std::max(thread_count, 1);
+
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex);
+        stopping = false;
+    }
+
+    workers.reserve(thread_count - 1);
+    for (int i = 1; i < thread_count; ++i) {
+        workers.emplace_back(&JobSystem::WorkerLoop);
+    }
+
+    LOG_DEBUG("JobSystem started with " + std::to_string(thread_count) + " thread(s)");
+}
+
+void JobSystem::Shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex);
+        stopping = true;
+    }
+    queue_cv.notify_all();
+
+    for (auto& worker : workers) {
+        if (worker.joinable()) worker.join();
+    }
+    workers.clear();
+    pending.clear();
+}
+
+void JobSystem::ParallelFor(int count, const std::function<void(int)>& job) {
+    if (count <= 0) return;
+
+    // Nothing to gain from a hand-off; run inline.
+    if (workers.empty() || count == 1) {
+        for (int i = 0; i < count; ++i) job(i);
+        return;
+    }
+
+    auto batch = std::make_shared<Batch>();
+    batch->job = &job;
+    batch->count = count;
+    batch->remaining.store(count);
+
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex);
+        pending.push_back(batch);
+    }
+    queue_cv.notify_all();
+
+    RunBatch(*batch);
+
+    std::unique_lock<std::mutex> lock(queue_mutex);
+    done_cv.wait(lock, [&batch] { return batch->remaining.load() == 0; });
+
+    auto it = std::find(pending.begin(), pending.end(), batch);
+    if (it != pending.end()) pending.erase(it);
+}
+
+void JobSystem::RunBatch(Batch& batch) {
+    while (true) {
+        int index = batch.next.fetch_add(1);
+        if (index >= batch.count) return;
+
+        (*batch.job)(index);
+
+        if (batch.remaining.fetch_sub(1) == 1) {
+            // Last index finished: wake the submitter. Taking the lock orders
+            // the notify after the submitter's predicate check.
+            std::lock_guard<std::mutex> lock(queue_mutex);
+            done_cv.notify_all();
+        }
+    }
+}
+
+void JobSystem::WorkerLoop() {
+    while (true) {
+        std::shared_ptr<Batch> batch;
+        {
+            std::unique_lock<std::mutex> lock(queue_mutex);
+            queue_cv.wait(lock, [] { return stopping || !pending.empty(); });
+            if (stopping) return;
+
+            batch = pending.front();
+            // Retire batches whose indices have all been claimed so idle
+            // workers stop spinning on them.
+            if (batch->next.load() >= batch->count) {
+                pending.pop_front();
+                continue;
+            }
+        }
+
+        RunBatch(*batch);
+    }
+}
@@ -0,0 +1,80 @@
+//
+//  JobSystem.hpp
+//  game_engine
+//
+//  Process-wide worker thread pool for data-parallel engine work.
+//
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @class JobSystem
+ * @brief Static worker pool that runs index-parallel jobs.
+ *
+ * The pool is shared by every subsystem that wants to fan work out across
+ * cores (isolated Lua states, physics islands, particle queries, ...). Work
+ * is expressed as ParallelFor(count, job): job(i) runs exactly once for every
+ * i in [0, count) and the call returns when all of them have finished.
+ *
+ * The calling thread always participates in its own batch, so ParallelFor
+ * never deadlocks when called from inside another job and degrades to a plain
+ * loop when the pool has no workers (single-core machines, or Init(1)).
+ *
+ * Jobs must not touch the main Lua state, SDL, or any engine static that the
+ * caller is not prepared to share; the caller is parked for the duration of
+ * the batch, so read-only access to engine state is safe.
+ */
+class JobSystem {
+public:
+    /**
+     * @brief Starts the worker threads.
+     * @param thread_count Total threads including the caller; 0 picks
+     *                     std::thread::hardware_concurrency().
+     */
+    static void Init(int thread_count = 0);
+
+    /**
+     * @brief Joins all worker threads. Safe to call more than once.
+     */
+    static void Shutdown();
+
+    /**
+     * @brief Number of threads that can execute a batch (workers + caller).
+     */
+    static int GetThreadCount() { return static_cast<int>(workers.size()) + 1; }
+
+    /**
+     * @brief Runs job(i) for every i in [0, count) and waits for completion.
+     * @param count Number of job indices.
+     * @param job Callable invoked once per index, from any pool thread.
+     */
+    static void ParallelFor(int count, const std::function<void(int)>& job);
+
+private:
+    struct Batch {
+        const std::function<void(int)>* job = nullptr;
+        int count = 0;
+        std::atomic<int> next{0};
+        std::atomic<int> remaining{0};
+    };
+
+    /// Claims and runs indices from a batch until it is exhausted.
+    static void RunBatch(Batch& batch);
+    static void WorkerLoop();
+
+    inline static std::vector<std::thread> workers;
+    inline static std::deque<std::shared_ptr<Batch>> pending;
+    inline static std::mutex queue_mutex;
+    inline static std::condition_variable queue_cv;
+    inline static std::condition_variable done_cv;
+    inline static bool stopping = false;
+};
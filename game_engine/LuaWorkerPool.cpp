@@ -0,0 +1,747 @@
+//
+//  LuaWorkerPool.cpp
+//  game_engine
+//
+//  Hosts "isolated" component types in worker Lua states that update in
+//  parallel and talk to the engine through deferred command buffers.
+//
+
+#include "LuaWorkerPool.hpp"
+#include "JobSystem.hpp"
+#include "ComponentDB.hpp"
+#include "SceneDB.hpp"
+#include "ConfigManager.hpp"
+#include "ImageDB.hpp"
+#include "EventSystem.hpp"
+#include "Input.hpp"
+#include "Time.hpp"
+#include "Logger.hpp"
+#include "EngineContext.hpp"
+#include "EngineException.hpp"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+
+namespace {
+    /// Upper bound on replay rounds per Update; Actor.Send chains that keep
+    /// producing commands past this spill into the next frame.
+    constexpr int kMaxApplyRounds = 8;
+
+    void PushPayload(lua_State* L, const IsolatedCommand& command) {
+        switch (command.payload_type) {
+            case LUA_TBOOLEAN: lua_pushboolean(L, command.payload_number != 0.0); break;
+            case LUA_TNUMBER:  lua_pushnumber(L, command.payload_number); break;
+            case LUA_TSTRING:
+                lua_pushlstring(L, command.payload_string.data(), command.payload_string.size());
+                break;
+            default: lua_pushnil(L); break;
+        }
+    }
+
+    luabridge::LuaRef PayloadToLuaRef(const IsolatedCommand& command) {
+        lua_State* L = ComponentDB::GetLuaState();
+        PushPayload(L, command);
+        luabridge::LuaRef value = luabridge::LuaRef::fromStack(L, -1);
+        lua_pop(L, 1);
+        return value;
+    }
+}
+
+void LuaWorkerPool::Init(int state_count) {
+    Shutdown();
+    if (state_count <= 0) return;
+
+    workers.reserve(state_count);
+    for (int i = 0; i < state_count; ++i) {
+        auto worker = std::make_unique<Worker>();
+        worker->L = luaL_newstate();
+        if (!worker->L) {
+            LOG_FATAL("Failed to create isolated Lua state");
+            throw ScriptException("Failed to create isolated Lua state");
+        }
+        *static_cast<Worker**>(lua_getextraspace(worker->L)) = worker.get();
+        worker->frame = &frame;
+        OpenWorkerAPI(*worker);
+        if (EngineContext::IsDeterministic()) {
+            // Each state draws its own stream of the seed, like the engine's.
+            lua_State* L = worker->L;
+            lua_getglobal(L, LUA_MATHLIBNAME);
+            lua_getfield(L, -1, "randomseed");
+            lua_pushinteger(L, static_cast<lua_Integer>(EngineContext::GetRandomSeed()));
+            lua_pushinteger(L, i + 1);
+            lua_call(L, 2, 0);
+            lua_pop(L, 1);
+        }
+        workers.push_back(std::move(worker));
+    }
+
+    LOG_INFO("Isolated components hosted in " + std::to_string(state_count) + " Lua worker state(s)");
+}
+
+void LuaWorkerPool::Shutdown() {
+    for (auto& worker : workers) {
+        worker->instances.clear();
+        if (worker->L) {
+            lua_close(worker->L);
+            worker->L = nullptr;
+        }
+    }
+    workers.clear();
+}
+
+bool LuaWorkerPool::IsStub(const luabridge::LuaRef& component) {
+    return !workers.empty() && component.isTable() && component["isolated_worker"].isNumber();
+}
+
+void LuaWorkerPool::OpenWorkerAPI(Worker& worker) {
+    lua_State* L = worker.L;
+
+    // Only the pure libraries: no io, os, package, debug or coroutine.
+    luaL_requiref(L, LUA_GNAME, luaopen_base, 1);
+    luaL_requiref(L, LUA_TABLIBNAME, luaopen_table, 1);
+    luaL_requiref(L, LUA_STRLIBNAME, luaopen_string, 1);
+    luaL_requiref(L, LUA_MATHLIBNAME, luaopen_math, 1);
+    luaL_requiref(L, LUA_UTF8LIBNAME, luaopen_utf8, 1);
+    lua_pop(L, 5);
+
+    for (const char* banned : {"dofile", "loadfile"}) {
+        lua_pushnil(L);
+        lua_setglobal(L, banned);
+    }
+
+    auto register_namespace = [L](const char* name, const luaL_Reg* funcs) {
+        lua_newtable(L);
+        luaL_setfuncs(L, funcs, 0);
+        lua_setglobal(L, name);
+    };
+
+    static const luaL_Reg debug_funcs[] = {
+        {"Log", &LuaWorkerPool::LuaLog},
+        {"LogError", &LuaWorkerPool::LuaLogError},
+        {nullptr, nullptr}
+    };
+    static const luaL_Reg time_funcs[] = {
+        {"GetDeltaTime", &LuaWorkerPool::LuaGetDeltaTime},
+        {"GetUnscaledDeltaTime", &LuaWorkerPool::LuaGetUnscaledDeltaTime},
+        {"GetTimeScale", &LuaWorkerPool::LuaGetTimeScale},
+        {"GetTotalTime", &LuaWorkerPool::LuaGetTotalTime},
+        {"GetUnscaledTotalTime", &LuaWorkerPool::LuaGetUnscaledTotalTime},
+        {"GetFrameCount", &LuaWorkerPool::LuaGetFrameCount},
+        {nullptr, nullptr}
+    };
+    static const luaL_Reg application_funcs[] = {
+        {"GetFrame", &LuaWorkerPool::LuaGetFrame},
+        {nullptr, nullptr}
+    };
+    static const luaL_Reg input_funcs[] = {
+        {"GetKey", &LuaWorkerPool::LuaGetKey},
+        {"GetKeyDown", &LuaWorkerPool::LuaGetKeyDown},
+        {"GetKeyUp", &LuaWorkerPool::LuaGetKeyUp},
+        {"GetMousePosition", &LuaWorkerPool::LuaGetMousePosition},
+        {"GetMouseButton", &LuaWorkerPool::LuaGetMouseButton},
+        {"GetMouseButtonDown", &LuaWorkerPool::LuaGetMouseButtonDown},
+        {"GetMouseButtonUp", &LuaWorkerPool::LuaGetMouseButtonUp},
+        {nullptr, nullptr}
+    };
+    static const luaL_Reg image_funcs[] = {
+        {"Draw", &LuaWorkerPool::LuaDraw},
+        {"DrawEx", &LuaWorkerPool::LuaDrawEx},
+        {"DrawUI", &LuaWorkerPool::LuaDrawUI},
+        {"DrawUIEx", &LuaWorkerPool::LuaDrawUIEx},
+        {"DrawRect", &LuaWorkerPool::LuaDrawRect},
+        {nullptr, nullptr}
+    };
+    static const luaL_Reg actor_funcs[] = {
+        {"Instantiate", &LuaWorkerPool::LuaInstantiate},
+        {"Destroy", &LuaWorkerPool::LuaDestroy},
+        {"Send", &LuaWorkerPool::LuaSend},
+        {nullptr, nullptr}
+    };
+    static const luaL_Reg event_funcs[] = {
+        {"Emit", &LuaWorkerPool::LuaEmit},
+        {nullptr, nullptr}
+    };
+
+    register_namespace("Debug", debug_funcs);
+    register_namespace("Time", time_funcs);
+    register_namespace("Application", application_funcs);
+    register_namespace("Input", input_funcs);
+    register_namespace("Image", image_funcs);
+    register_namespace("Actor", actor_funcs);
+    register_namespace("Event", event_funcs);
+
+    // Globals are frozen outside of type loading so instances hosted in the
+    // same state cannot share hidden state through them.
+    lua_pushglobaltable(L);
+    lua_newtable(L);
+    lua_pushcfunction(L, &LuaWorkerPool::LuaGlobalNewIndex);
+    lua_setfield(L, -2, "__newindex");
+    lua_setmetatable(L, -2);
+    lua_pop(L, 1);
+}
+
+void LuaWorkerPool::EnsureTypeLoaded(Worker& worker, const std::string& type) {
+    if (worker.loaded_types.count(type)) return;
+
+    std::string lua_path = ConfigManager::GetResourcesPath() + "component_types/" + type + ".lua";
+    if (!std::filesystem::exists(lua_path)) {
+        LOG_FATAL("Component type missing: " + type);
+        throw ScriptException("Component type not found: " + type);
+    }
+
+    worker.loading_types = true;
+    int status = luaL_dofile(worker.L, lua_path.c_str());
+    worker.loading_types = false;
+
+    if (status != LUA_OK) {
+        std::string error = lua_tostring(worker.L, -1);
+        lua_pop(worker.L, 1);
+        LOG_FATAL("Lua error in isolated component " + type + ": " + error);
+        throw ScriptException("Lua error in isolated component " + type + ": " + error);
+    }
+
+    if (lua_getglobal(worker.L, type.c_str()) != LUA_TTABLE) {
+        lua_pop(worker.L, 1);
+        LOG_FATAL("Isolated component " + type + " does not define a table named " + type);
+        throw ScriptException("Isolated component " + type + " does not define a table named " + type);
+    }
+    lua_pop(worker.L, 1);
+
+    worker.loaded_types.insert(type);
+}
+
+void LuaWorkerPool::Attach(uint64_t actor_id, const std::string& actor_name,
+                           const std::string& key, luabridge::LuaRef stub) {
+    if (workers.empty()) return;
+
+    Worker& worker = WorkerFor(actor_id);
+    auto instance_key = std::make_pair(actor_id, key);
+    if (worker.instances.count(instance_key)) return;
+
+    std::string type = stub["type"].cast<std::string>();
+    EnsureTypeLoaded(worker, type);
+
+    lua_State* W = worker.L;
+    lua_State* M = ComponentDB::GetLuaState();
+
+    lua_newtable(W);
+    lua_newtable(W);
+    lua_getglobal(W, type.c_str());
+    lua_setfield(W, -2, "__index");
+    lua_setmetatable(W, -2);
+
+    // Copy the stub's own scalar fields (defaults set by CreateComponent and
+    // any JSON overrides). Tables and userdata cannot cross states.
+    stub.push(M);
+    lua_pushnil(M);
+    while (lua_next(M, -2) != 0) {
+        if (lua_type(M, -2) == LUA_TSTRING) {
+            const char* field = lua_tostring(M, -2);
+            bool copied = true;
+            switch (lua_type(M, -1)) {
+                case LUA_TBOOLEAN:
+                    lua_pushboolean(W, lua_toboolean(M, -1));
+                    break;
+                case LUA_TNUMBER:
+                    if (lua_isinteger(M, -1)) lua_pushinteger(W, lua_tointeger(M, -1));
+                    else lua_pushnumber(W, lua_tonumber(M, -1));
+                    break;
+                case LUA_TSTRING: {
+                    size_t len = 0;
+                    const char* value = lua_tolstring(M, -1, &len);
+                    lua_pushlstring(W, value, len);
+                    break;
+                }
+                default:
+                    copied = false;
+                    break;
+            }
+            if (copied) lua_setfield(W, -2, field);
+        }
+        lua_pop(M, 1);
+    }
+    lua_pop(M, 1);
+
+    lua_pushinteger(W, static_cast<lua_Integer>(actor_id));
+    lua_setfield(W, -2, "actor_id");
+    lua_pushlstring(W, actor_name.data(), actor_name.size());
+    lua_setfield(W, -2, "actor_name");
+
+    Instance instance;
+    instance.ref = luaL_ref(W, LUA_REGISTRYINDEX);
+    instance.actor_name = actor_name;
+    if (stub["new_addition"].isBool() && stub["new_addition"].cast<bool>() && stub["frame_added"].isNumber()) {
+        instance.frame_added = stub["frame_added"].cast<int>();
+    }
+    worker.instances.emplace(std::move(instance_key), std::move(instance));
+
+    stub["isolated_worker"] = static_cast<int>(actor_id % workers.size());
+}
+
+void LuaWorkerPool::Detach(uint64_t actor_id, const std::string& key) {
+    if (workers.empty()) return;
+
+    Worker& worker = WorkerFor(actor_id);
+    auto it = worker.instances.find(std::make_pair(actor_id, key));
+    if (it == worker.instances.end()) return;
+
+    // Commands recorded by OnDestroy are replayed with the next Update.
+    CallMethod(worker, it->second, "OnDestroy", 0);
+    luaL_unref(worker.L, LUA_REGISTRYINDEX, it->second.ref);
+    worker.instances.erase(it);
+}
+
+bool LuaWorkerPool::CallMethod(Worker& worker, Instance& instance, const char* method_name, int nargs) {
+    lua_State* L = worker.L;
+    const int base = lua_gettop(L) - nargs;
+
+    lua_rawgeti(L, LUA_REGISTRYINDEX, instance.ref);
+    lua_getfield(L, -1, method_name);
+    if (!lua_isfunction(L, -1)) {
+        lua_settop(L, base);
+        return true;
+    }
+
+    // [args..., self, fn] -> [fn, self, args...]
+    lua_insert(L, base + 1);
+    lua_insert(L, base + 2);
+
+    if (lua_pcall(L, nargs + 1, 0, 0) != LUA_OK) {
+        std::string error_message = lua_isstring(L, -1) ? lua_tostring(L, -1) : "unknown error";
+        lua_settop(L, base);
+        std::replace(error_message.begin(), error_message.end(), '\\', '/');
+
+        IsolatedCommand command;
+        command.kind = IsolatedCommand::Kind::LogError;
+        command.name = instance.actor_name + " : " + error_message;
+        worker.commands.push_back(std::move(command));
+        return false;
+    }
+    return true;
+}
+
+void LuaWorkerPool::UpdateWorker(Worker& worker, const char* method_name, int current_frame) {
+    lua_State* L = worker.L;
+
+    for (auto& [instance_key, instance] : worker.instances) {
+        lua_rawgeti(L, LUA_REGISTRYINDEX, instance.ref);
+        lua_getfield(L, -1, "enabled");
+        const bool enabled = lua_toboolean(L, -1);
+        lua_pop(L, 2);
+
+        if (!enabled) continue;
+        if (instance.frame_added == current_frame) continue;
+
+        if (!instance.started) {
+            instance.started = true;
+            CallMethod(worker, instance, "OnStart", 0);
+        }
+
+        if (!CallMethod(worker, instance, method_name, 0)) {
+            instance.error_count++;
+            if (instance.error_count >= 3) {
+                lua_rawgeti(L, LUA_REGISTRYINDEX, instance.ref);
+                lua_pushboolean(L, 0);
+                lua_setfield(L, -2, "enabled");
+                lua_pop(L, 1);
+
+                IsolatedCommand command;
+                command.kind = IsolatedCommand::Kind::LogWarning;
+                command.name = "Component disabled after " + std::to_string(instance.error_count)
+                    + " errors on actor: " + instance.actor_name;
+                worker.commands.push_back(std::move(command));
+            }
+        }
+    }
+}
+
+void LuaWorkerPool::Update(const char* method_name) {
+    if (workers.empty()) return;
+
+    CaptureFrame();
+    const int current_frame = frame.frame_number;
+
+    // `workers` is thread_local: hand the pool threads this context's list.
+    auto& context_workers = workers;
+    JobSystem::ParallelFor(static_cast<int>(context_workers.size()),
+        [&context_workers, method_name, current_frame](int index) {
+            UpdateWorker(*context_workers[index], method_name, current_frame);
+        });
+
+    ApplyCommands();
+}
+
+void LuaWorkerPool::CaptureFrame() {
+    frame.delta_time = Time::GetDeltaTime();
+    frame.unscaled_delta_time = Time::GetUnscaledDeltaTime();
+    frame.time_scale = Time::GetTimeScale();
+    frame.total_time = Time::GetTotalTime();
+    frame.unscaled_total_time = Time::GetUnscaledTotalTime();
+    frame.frame_count = Time::GetFrameCount();
+    frame.frame_number = Time::GetFrameNumber();
+
+    glm::vec2 mouse = Input::GetMousePosition();
+    frame.mouse_x = mouse.x;
+    frame.mouse_y = mouse.y;
+
+    frame.keys.clear();
+    for (const auto& [code, state] : Input::GetKeyStates()) {
+        if (state != INPUT_STATE_UP) frame.keys[static_cast<int>(code)] = state;
+    }
+    frame.mouse_buttons.clear();
+    for (const auto& [button, state] : Input::GetMouseButtonStates()) {
+        if (state != INPUT_STATE_UP) frame.mouse_buttons[button] = state;
+    }
+}
+
+void LuaWorkerPool::ApplyCommands() {
+    for (int round = 0; round < kMaxApplyRounds; ++round) {
+        bool applied_any = false;
+        for (auto& worker : workers) {
+            if (worker->commands.empty()) continue;
+            applied_any = true;
+
+            // Commands produced while replaying (Actor.Send into a worker)
+            // land in a fresh buffer and are picked up next round.
+            std::vector<IsolatedCommand> batch;
+            batch.swap(worker->commands);
+            for (const auto& command : batch) {
+                ApplyCommand(command);
+            }
+        }
+        if (!applied_any) break;
+    }
+}
+
+void LuaWorkerPool::ApplyCommand(const IsolatedCommand& command) {
+    const float* a = command.args;
+    switch (command.kind) {
+        case IsolatedCommand::Kind::DrawImage:
+            ImageDB::QueueImageDraw(command.name, a[0], a[1]);
+            break;
+        case IsolatedCommand::Kind::DrawImageEx:
+            ImageDB::QueueImageDrawEx(command.name, a[0], a[1], a[2], a[3], a[4], a[5], a[6],
+                                      a[7], a[8], a[9], a[10], a[11]);
+            break;
+        case IsolatedCommand::Kind::DrawImageUI:
+            ImageDB::QueueImageDrawUI(command.name, a[0], a[1]);
+            break;
+        case IsolatedCommand::Kind::DrawImageUIEx:
+            ImageDB::QueueImageDrawUIEx(command.name, a[0], a[1], a[2], a[3], a[4], a[5], a[6]);
+            break;
+        case IsolatedCommand::Kind::DrawRect:
+            ImageDB::QueueDrawRect(a[0], a[1], a[2], a[3], a[4], a[5], a[6], a[7]);
+            break;
+        case IsolatedCommand::Kind::Instantiate:
+            SceneDB::InstantiateActor(command.name);
+            break;
+        case IsolatedCommand::Kind::Destroy: {
+            auto it = SceneDB::actors.find(command.actor_id);
+            if (it != SceneDB::actors.end() && !it->second->destroyed) {
+                SceneDB::DestroyActor(it->second.get());
+            }
+            break;
+        }
+        case IsolatedCommand::Kind::Emit:
+            EventSystem::Emit(command.name, PayloadToLuaRef(command));
+            break;
+        case IsolatedCommand::Kind::Send:
+            DeliverSend(command);
+            break;
+        case IsolatedCommand::Kind::Log:
+            LOG_INFO(command.name);
+            break;
+        case IsolatedCommand::Kind::LogWarning:
+            LOG_WARNING(command.name);
+            break;
+        case IsolatedCommand::Kind::LogError:
+            LOG_ERROR(command.name);
+            break;
+    }
+}
+
+void LuaWorkerPool::DeliverSend(const IsolatedCommand& command) {
+    auto actor_it = SceneDB::actors.find(command.actor_id);
+    if (actor_it == SceneDB::actors.end()) return;
+    Actor& actor = *actor_it->second;
+    if (actor.destroyed) return;
+
+    for (const auto& key : actor.component_keys) {
+        auto comp_it = actor.components.find(key);
+        if (comp_it == actor.components.end()) continue;
+        luabridge::LuaRef comp = *comp_it->second;
+        if (comp.isUserdata()) continue;
+
+        if (IsStub(comp)) {
+            Worker& worker = WorkerFor(actor.GetID());
+            auto instance_it = worker.instances.find(std::make_pair(actor.GetID(), key));
+            if (instance_it == worker.instances.end()) continue;
+            PushPayload(worker.L, command);
+            CallMethod(worker, instance_it->second, command.name.c_str(), 1);
+            continue;
+        }
+
+        if (!comp["enabled"] || !comp[command.name].isFunction()) continue;
+        try {
+            comp[command.name](comp, PayloadToLuaRef(command));
+        }
+        catch (luabridge::LuaException& e) {
+            SceneDB::ReportError(actor.GetName(), e);
+        }
+    }
+}
+
+LuaWorkerPool::Worker& LuaWorkerPool::WorkerFromState(lua_State* L) {
+    return **static_cast<Worker**>(lua_getextraspace(L));
+}
+
+IsolatedCommand& LuaWorkerPool::PushCommand(lua_State* L, IsolatedCommand::Kind kind) {
+    auto& commands = WorkerFromState(L).commands;
+    commands.emplace_back();
+    commands.back().kind = kind;
+    return commands.back();
+}
+
+void LuaWorkerPool::ReadPayload(lua_State* L, int index, IsolatedCommand& command) {
+    switch (lua_type(L, index)) {
+        case LUA_TNONE:
+        case LUA_TNIL:
+            command.payload_type = LUA_TNIL;
+            break;
+        case LUA_TBOOLEAN:
+            command.payload_type = LUA_TBOOLEAN;
+            command.payload_number = lua_toboolean(L, index) ? 1.0 : 0.0;
+            break;
+        case LUA_TNUMBER:
+            command.payload_type = LUA_TNUMBER;
+            command.payload_number = lua_tonumber(L, index);
+            break;
+        case LUA_TSTRING: {
+            size_t len = 0;
+            const char* value = lua_tolstring(L, index, &len);
+            command.payload_type = LUA_TSTRING;
+            command.payload_string.assign(value, len);
+            break;
+        }
+        default:
+            command.payload_type = LUA_TNIL;
+            break;
+    }
+}
+
+// ─── Whitelisted worker API ─────────────────────────────────────────────────
+
+int LuaWorkerPool::LuaLog(lua_State* L) {
+    size_t len = 0;
+    const char* message = luaL_tolstring(L, 1, &len);
+    PushCommand(L, IsolatedCommand::Kind::Log).name.assign(message, len);
+    return 0;
+}
+
+int LuaWorkerPool::LuaLogError(lua_State* L) {
+    size_t len = 0;
+    const char* message = luaL_tolstring(L, 1, &len);
+    PushCommand(L, IsolatedCommand::Kind::LogError).name.assign(message, len);
+    return 0;
+}
+
+int LuaWorkerPool::LuaGetDeltaTime(lua_State* L) {
+    lua_pushnumber(L, WorkerFromState(L).frame->delta_time);
+    return 1;
+}
+
+int LuaWorkerPool::LuaGetUnscaledDeltaTime(lua_State* L) {
+    lua_pushnumber(L, WorkerFromState(L).frame->unscaled_delta_time);
+    return 1;
+}
+
+int LuaWorkerPool::LuaGetTimeScale(lua_State* L) {
+    lua_pushnumber(L, WorkerFromState(L).frame->time_scale);
+    return 1;
+}
+
+int LuaWorkerPool::LuaGetTotalTime(lua_State* L) {
+    lua_pushnumber(L, WorkerFromState(L).frame->total_time);
+    return 1;
+}
+
+int LuaWorkerPool::LuaGetUnscaledTotalTime(lua_State* L) {
+    lua_pushnumber(L, WorkerFromState(L).frame->unscaled_total_time);
+    return 1;
+}
+
+int LuaWorkerPool::LuaGetFrameCount(lua_State* L) {
+    lua_pushinteger(L, WorkerFromState(L).frame->frame_count);
+    return 1;
+}
+
+int LuaWorkerPool::LuaGetFrame(lua_State* L) {
+    lua_pushinteger(L, WorkerFromState(L).frame->frame_number);
+    return 1;
+}
+
+int LuaWorkerPool::SnapshotKeyState(lua_State* L, int arg) {
+    std::string key = luaL_checkstring(L, arg);
+    const auto& keys = WorkerFromState(L).frame->keys;
+    auto it = keys.find(static_cast<int>(Input::StringToScancode(key)));
+    return it == keys.end() ? INPUT_STATE_UP : it->second;
+}
+
+int LuaWorkerPool::SnapshotButtonState(lua_State* L, int arg) {
+    int button = static_cast<int>(luaL_checkinteger(L, arg));
+    const auto& buttons = WorkerFromState(L).frame->mouse_buttons;
+    auto it = buttons.find(button);
+    return it == buttons.end() ? INPUT_STATE_UP : it->second;
+}
+
+int LuaWorkerPool::LuaGetKey(lua_State* L) {
+    int state = SnapshotKeyState(L, 1);
+    lua_pushboolean(L, state == INPUT_STATE_DOWN || state == INPUT_STATE_JUST_BECAME_DOWN);
+    return 1;
+}
+
+int LuaWorkerPool::LuaGetKeyDown(lua_State* L) {
+    lua_pushboolean(L, SnapshotKeyState(L, 1) == INPUT_STATE_JUST_BECAME_DOWN);
+    return 1;
+}
+
+int LuaWorkerPool::LuaGetKeyUp(lua_State* L) {
+    lua_pushboolean(L, SnapshotKeyState(L, 1) == INPUT_STATE_JUST_BECAME_UP);
+    return 1;
+}
+
+int LuaWorkerPool::LuaGetMousePosition(lua_State* L) {
+    const IsolatedFrameSnapshot& snapshot = *WorkerFromState(L).frame;
+    lua_createtable(L, 0, 2);
+    lua_pushnumber(L, snapshot.mouse_x);
+    lua_setfield(L, -2, "x");
+    lua_pushnumber(L, snapshot.mouse_y);
+    lua_setfield(L, -2, "y");
+    return 1;
+}
+
+int LuaWorkerPool::LuaGetMouseButton(lua_State* L) {
+    int state = SnapshotButtonState(L, 1);
+    lua_pushboolean(L, state == INPUT_STATE_DOWN || state == INPUT_STATE_JUST_BECAME_DOWN);
+    return 1;
+}
+
+int LuaWorkerPool::LuaGetMouseButtonDown(lua_State* L) {
+    lua_pushboolean(L, SnapshotButtonState(L, 1) == INPUT_STATE_JUST_BECAME_DOWN);
+    return 1;
+}
+
+int LuaWorkerPool::LuaGetMouseButtonUp(lua_State* L) {
+    lua_pushboolean(L, SnapshotButtonState(L, 1) == INPUT_STATE_JUST_BECAME_UP);
+    return 1;
+}
+
+namespace {
+    /// Validates a payload argument before any C++ object is constructed,
+    /// since a Lua error unwinds with longjmp.
+    void CheckPayload(lua_State* L, int index) {
+        int type = lua_type(L, index);
+        if (type != LUA_TNONE && type != LUA_TNIL && type != LUA_TBOOLEAN
+            && type != LUA_TNUMBER && type != LUA_TSTRING) {
+            luaL_argerror(L, index, "isolated components can only send nil, boolean, number or string values");
+        }
+    }
+
+    void ReadArgs(lua_State* L, int first, int count, float* out) {
+        for (int i = 0; i < count; ++i) {
+            out[i] = static_cast<float>(luaL_checknumber(L, first + i));
+        }
+    }
+}
+
+int LuaWorkerPool::LuaDraw(lua_State* L) {
+    const char* image = luaL_checkstring(L, 1);
+    float args[2];
+    ReadArgs(L, 2, 2, args);
+    auto& command = PushCommand(L, IsolatedCommand::Kind::DrawImage);
+    command.name = image;
+    std::copy(args, args + 2, command.args);
+    return 0;
+}
+
+int LuaWorkerPool::LuaDrawEx(lua_State* L) {
+    const char* image = luaL_checkstring(L, 1);
+    float args[12];
+    ReadArgs(L, 2, 12, args);
+    auto& command = PushCommand(L, IsolatedCommand::Kind::DrawImageEx);
+    command.name = image;
+    std::copy(args, args + 12, command.args);
+    return 0;
+}
+
+int LuaWorkerPool::LuaDrawUI(lua_State* L) {
+    const char* image = luaL_checkstring(L, 1);
+    float args[2];
+    ReadArgs(L, 2, 2, args);
+    auto& command = PushCommand(L, IsolatedCommand::Kind::DrawImageUI);
+    command.name = image;
+    std::copy(args, args + 2, command.args);
+    return 0;
+}
+
+int LuaWorkerPool::LuaDrawUIEx(lua_State* L) {
+    const char* image = luaL_checkstring(L, 1);
+    float args[7];
+    ReadArgs(L, 2, 7, args);
+    auto& command = PushCommand(L, IsolatedCommand::Kind::DrawImageUIEx);
+    command.name = image;
+    std::copy(args, args + 7, command.args);
+    return 0;
+}
+
+int LuaWorkerPool::LuaDrawRect(lua_State* L) {
+    float args[8];
+    ReadArgs(L, 1, 8, args);
+    auto& command = PushCommand(L, IsolatedCommand::Kind::DrawRect);
+    std::copy(args, args + 8, command.args);
+    return 0;
+}
+
+int LuaWorkerPool::LuaInstantiate(lua_State* L) {
+    const char* template_name = luaL_checkstring(L, 1);
+    PushCommand(L, IsolatedCommand::Kind::Instantiate).name = template_name;
+    return 0;
+}
+
+int LuaWorkerPool::LuaDestroy(lua_State* L) {
+    lua_Integer actor_id = luaL_checkinteger(L, 1);
+    PushCommand(L, IsolatedCommand::Kind::Destroy).actor_id = static_cast<uint64_t>(actor_id);
+    return 0;
+}
+
+int LuaWorkerPool::LuaSend(lua_State* L) {
+    lua_Integer actor_id = luaL_checkinteger(L, 1);
+    const char* method_name = luaL_checkstring(L, 2);
+    CheckPayload(L, 3);
+    IsolatedCommand command;
+    command.kind = IsolatedCommand::Kind::Send;
+    command.actor_id = static_cast<uint64_t>(actor_id);
+    command.name = method_name;
+    ReadPayload(L, 3, command);
+    WorkerFromState(L).commands.push_back(std::move(command));
+    return 0;
+}
+
+int LuaWorkerPool::LuaEmit(lua_State* L) {
+    const char* event_name = luaL_checkstring(L, 1);
+    CheckPayload(L, 2);
+    IsolatedCommand command;
+    command.kind = IsolatedCommand::Kind::Emit;
+    command.name = event_name;
+    ReadPayload(L, 2, command);
+    WorkerFromState(L).commands.push_back(std::move(command));
+    return 0;
+}
+
+int LuaWorkerPool::LuaGlobalNewIndex(lua_State* L) {
+    if (WorkerFromState(L).loading_types) {
+        lua_rawset(L, 1);
+        return 0;
+    }
+    return luaL_error(L, "isolated components cannot assign global '%s'", luaL_tolstring(L, 2, nullptr));
+}
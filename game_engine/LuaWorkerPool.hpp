@@ -0,0 +1,228 @@
+//
+//  LuaWorkerPool.hpp
+//  game_engine
+//
+//  Hosts "isolated" component types in worker Lua states that update in
+//  parallel and talk to the engine through deferred command buffers.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+#include "lua.hpp"
+#include "LuaBridge/LuaBridge.h"
+
+/**
+ * @struct IsolatedCommand
+ * @brief One engine mutation recorded by an isolated component.
+ *
+ * Worker states never touch engine state directly; every draw, spawn,
+ * destroy, event, or cross-actor call becomes a command that the main
+ * thread replays after the parallel update.
+ */
+struct IsolatedCommand {
+    enum class Kind : uint8_t {
+        DrawImage,
+        DrawImageEx,
+        DrawImageUI,
+        DrawImageUIEx,
+        DrawRect,
+        Instantiate,
+        Destroy,
+        Emit,
+        Send,
+        Log,
+        LogWarning,
+        LogError
+    };
+
+    Kind kind = Kind::Log;
+    uint64_t actor_id = 0;    ///< Target actor for Destroy/Send
+    std::string name;         ///< Image, template, event, method, or log text
+    float args[12] = {};      ///< Numeric draw arguments
+
+    /// Scalar payload for Emit/Send (LUA_TNIL, LUA_TBOOLEAN, LUA_TNUMBER, LUA_TSTRING).
+    int payload_type = LUA_TNIL;
+    double payload_number = 0.0;
+    std::string payload_string;
+};
+
+/**
+ * @struct IsolatedFrameSnapshot
+ * @brief Read-only view of Time and Input handed to worker states.
+ *
+ * Taken on the owning thread before each parallel pass. Engine state is
+ * thread_local per context, so pool threads must not query Time or Input
+ * themselves.
+ */
+struct IsolatedFrameSnapshot {
+    float delta_time = 0.0f;
+    float unscaled_delta_time = 0.0f;
+    float time_scale = 1.0f;
+    float total_time = 0.0f;
+    float unscaled_total_time = 0.0f;
+    int frame_count = 0;
+    int frame_number = 0;
+    float mouse_x = 0.0f;
+    float mouse_y = 0.0f;
+    std::unordered_map<int, int> keys;           ///< SDL_Scancode -> INPUT_STATE
+    std::unordered_map<int, int> mouse_buttons;  ///< button -> INPUT_STATE
+};
+
+/**
+ * @class LuaWorkerPool
+ * @brief Runs isolated component types across N worker Lua states.
+ *
+ * A component type opts in by declaring `isolated = true` in its Lua table.
+ * When `lua_worker_states` in game.config is greater than zero, such
+ * components are not cached by SceneDB; instead the main-state table stays
+ * behind as a stub (so Actor:GetComponent still finds it) and the live
+ * instance is created in worker state `actor_id % N`.
+ *
+ * Each frame, after the main-state OnUpdate/OnLateUpdate pass, every worker
+ * state runs its instances on the JobSystem. Worker states only expose a
+ * whitelisted API: read-only Time/Input/Application getters, plus Image,
+ * Actor, Event and Debug calls that append to that worker's command buffer.
+ * Buffers are replayed on the main thread in worker order, then submission
+ * order, so results do not depend on thread scheduling.
+ *
+ * With `lua_worker_states` unset or 0 the flag is ignored and isolated
+ * components run in the main state like any other component.
+ */
+class LuaWorkerPool {
+public:
+    /**
+     * @brief Creates the worker states.
+     * @param state_count Number of worker Lua states (0 disables the pool).
+     */
+    static void Init(int state_count);
+
+    /**
+     * @brief Releases all instances and closes the worker states.
+     */
+    static void Shutdown();
+
+    /// True when isolated components are hosted in worker states.
+    static bool IsEnabled() { return !workers.empty(); }
+
+    /**
+     * @brief Returns true if a main-state component table is an isolated
+     *        stub whose behaviour lives in a worker state.
+     */
+    static bool IsStub(const luabridge::LuaRef& component);
+
+    /**
+     * @brief Creates the worker-side instance for an isolated component.
+     *
+     * Scalar fields of the stub (JSON overrides included) are copied into
+     * the worker instance. Calling Attach for an already hosted component
+     * is a no-op, so scene reloads can re-run cache building freely.
+     *
+     * @param actor_id Owning actor ID.
+     * @param actor_name Owning actor name (used in error reports).
+     * @param key Component key.
+     * @param stub Main-state component table.
+     */
+    static void Attach(uint64_t actor_id, const std::string& actor_name,
+                       const std::string& key, luabridge::LuaRef stub);
+
+    /**
+     * @brief Calls OnDestroy on the worker instance and releases it.
+     */
+    static void Detach(uint64_t actor_id, const std::string& key);
+
+    /**
+     * @brief Runs a lifecycle method ("OnUpdate" or "OnLateUpdate") on every
+     *        hosted instance in parallel, then replays the command buffers.
+     *
+     * OnStart runs lazily before a component's first OnUpdate.
+     */
+    static void Update(const char* method_name);
+
+private:
+    struct Instance {
+        int ref = LUA_NOREF;
+        std::string actor_name;
+        int frame_added = -1;
+        bool started = false;
+        int error_count = 0;
+    };
+
+    struct Worker {
+        lua_State* L = nullptr;
+        std::map<std::pair<uint64_t, std::string>, Instance> instances;
+        std::unordered_set<std::string> loaded_types;
+        std::vector<IsolatedCommand> commands;
+        const IsolatedFrameSnapshot* frame = nullptr;
+        bool loading_types = false;
+    };
+
+    /// Opens the whitelisted libraries and engine API in a worker state.
+    static void OpenWorkerAPI(Worker& worker);
+
+    /// Loads a component type file into a worker state on first use.
+    static void EnsureTypeLoaded(Worker& worker, const std::string& type);
+
+    /// Calls instance[method](instance, payload...) with the payload on the stack.
+    static bool CallMethod(Worker& worker, Instance& instance, const char* method_name, int nargs);
+
+    /// Copies the calling context's Time and Input state into `frame`.
+    static void CaptureFrame();
+
+    /// Looks up a key or mouse button state in the worker's snapshot.
+    static int SnapshotKeyState(lua_State* L, int arg);
+    static int SnapshotButtonState(lua_State* L, int arg);
+
+    /// Runs one worker's instances; executed on a JobSystem thread.
+    static void UpdateWorker(Worker& worker, const char* method_name, int current_frame);
+
+    /// Replays every command buffer on the main thread.
+    static void ApplyCommands();
+    static void ApplyCommand(const IsolatedCommand& command);
+
+    /// Delivers an Actor.Send call to every component of the target actor.
+    static void DeliverSend(const IsolatedCommand& command);
+
+    static Worker& WorkerFor(uint64_t actor_id) { return *workers[actor_id % workers.size()]; }
+    static Worker& WorkerFromState(lua_State* L);
+    static IsolatedCommand& PushCommand(lua_State* L, IsolatedCommand::Kind kind);
+    static void ReadPayload(lua_State* L, int index, IsolatedCommand& command);
+
+    // Whitelisted worker API (lua_CFunction)
+    static int LuaLog(lua_State* L);
+    static int LuaLogError(lua_State* L);
+    static int LuaGetDeltaTime(lua_State* L);
+    static int LuaGetUnscaledDeltaTime(lua_State* L);
+    static int LuaGetTimeScale(lua_State* L);
+    static int LuaGetTotalTime(lua_State* L);
+    static int LuaGetUnscaledTotalTime(lua_State* L);
+    static int LuaGetFrameCount(lua_State* L);
+    static int LuaGetFrame(lua_State* L);
+    static int LuaGetKey(lua_State* L);
+    static int LuaGetKeyDown(lua_State* L);
+    static int LuaGetKeyUp(lua_State* L);
+    static int LuaGetMousePosition(lua_State* L);
+    static int LuaGetMouseButton(lua_State* L);
+    static int LuaGetMouseButtonDown(lua_State* L);
+    static int LuaGetMouseButtonUp(lua_State* L);
+    static int LuaDraw(lua_State* L);
+    static int LuaDrawEx(lua_State* L);
+    static int LuaDrawUI(lua_State* L);
+    static int LuaDrawUIEx(lua_State* L);
+    static int LuaDrawRect(lua_State* L);
+    static int LuaInstantiate(lua_State* L);
+    static int LuaDestroy(lua_State* L);
+    static int LuaSend(lua_State* L);
+    static int LuaEmit(lua_State* L);
+    static int LuaGlobalNewIndex(lua_State* L);
+
+    inline static thread_local std::vector<std::unique_ptr<Worker>> workers;
+    inline static thread_local IsolatedFrameSnapshot frame;
+};
@@ -0,0 +1,480 @@
+//
+//  Navigation.cpp
+//  game_engine
+//
+//  Grid pathfinding for Lua agents: A* paths and shared flow fields.
+//
+
+#include "Navigation.hpp"
+#include "ComponentDB.hpp"
+#include "RigidbodyWorld.hpp"
+#include "JobSystem.hpp"
+#include "Logger.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+namespace {
+    // Neighbor offsets in circular order, so (k + 4) & 7 is the opposite
+    // direction and odd k are diagonals.
+    constexpr int DX[8] = {1, 1, 0, -1, -1, -1, 0, 1};
+    constexpr int DY[8] = {0, 1, 1, 1, 0, -1, -1, -1};
+    constexpr float SQRT2 = 1.41421356f;
+    constexpr size_t MAX_CELLS = size_t(1) << 22;
+
+    struct OpenEntry {
+        float priority;
+        int cell;
+    };
+
+    /// Min-heap order for std::push_heap / pop_heap; ties break on cell
+    /// index so equal-cost searches are deterministic.
+    struct OpenGreater {
+        bool operator()(const OpenEntry& a, const OpenEntry& b) const {
+            return a.priority != b.priority ? a.priority > b.priority : a.cell > b.cell;
+        }
+    };
+
+    /// Per-thread search state, sized to the grid and reused between
+    /// searches. Generation stamps replace clearing the arrays.
+    struct SearchScratch {
+        std::vector<float> cost;
+        std::vector<int> parent;
+        std::vector<uint32_t> seen;     ///< == generation: cost/parent valid
+        std::vector<uint32_t> closed;   ///< == generation: expanded
+        std::vector<OpenEntry> open;
+        uint32_t generation = 0;
+
+        void Begin(size_t cells) {
+            if (seen.size() != cells) {
+                cost.assign(cells, 0.0f);
+                parent.assign(cells, -1);
+                seen.assign(cells, 0);
+                closed.assign(cells, 0);
+                generation = 0;
+            }
+            if (++generation == 0) {
+                std::fill(seen.begin(), seen.end(), 0);
+                std::fill(closed.begin(), closed.end(), 0);
+                generation = 1;
+            }
+            open.clear();
+        }
+
+        void Push(float priority, int cell) {
+            open.push_back({priority, cell});
+            std::push_heap(open.begin(), open.end(), OpenGreater{});
+        }
+
+        int Pop() {
+            std::pop_heap(open.begin(), open.end(), OpenGreater{});
+            const int cell = open.back().cell;
+            open.pop_back();
+            return cell;
+        }
+    };
+
+    thread_local SearchScratch scratch;
+
+    /// Whether an agent in (col, row) can move in direction k: the target
+    /// must be walkable and diagonals may not cut a blocked corner. The
+    /// relation is symmetric, which lets flow fields search from the goal.
+    bool CanStep(const NavGrid& grid, int col, int row, int k, int& next) {
+        const int c = col + DX[k];
+        const int r = row + DY[k];
+        if (c < 0 || r < 0 || c >= grid.cols || r >= grid.rows) return false;
+        next = r * grid.cols + c;
+        if (grid.blocked[next]) return false;
+        if (k & 1) {
+            return !grid.blocked[row * grid.cols + c] && !grid.blocked[r * grid.cols + col];
+        }
+        return true;
+    }
+
+    /// A* with an octile heuristic; exits as soon as the goal is expanded.
+    bool SolveAStar(const NavGrid& grid, int start, int goal, std::vector<int>& cells) {
+        cells.clear();
+        SearchScratch& s = scratch;
+        s.Begin(grid.blocked.size());
+        const uint32_t gen = s.generation;
+
+        const int goal_col = goal % grid.cols;
+        const int goal_row = goal / grid.cols;
+        auto heuristic = [&](int cell) {
+            const int dx = std::abs(cell % grid.cols - goal_col);
+            const int dy = std::abs(cell / grid.cols - goal_row);
+            return static_cast<float>(dx + dy) + (SQRT2 - 2.0f) * static_cast<float>(std::min(dx, dy));
+        };
+
+        s.cost[start] = 0.0f;
+        s.parent[start] = -1;
+        s.seen[start] = gen;
+        s.Push(heuristic(start), start);
+
+        while (!s.open.empty()) {
+            const int cell = s.Pop();
+            if (s.closed[cell] == gen) continue;     // stale heap entry
+            s.closed[cell] = gen;
+
+            if (cell == goal) {
+                for (int at = goal; at != -1; at = s.parent[at]) cells.push_back(at);
+                std::reverse(cells.begin(), cells.end());
+                return true;
+            }
+
+            const int col = cell % grid.cols;
+            const int row = cell / grid.cols;
+            for (int k = 0; k < 8; ++k) {
+                int next;
+                if (!CanStep(grid, col, row, k, next) || s.closed[next] == gen) continue;
+                const float cost = s.cost[cell] + ((k & 1) ? SQRT2 : 1.0f);
+                if (s.seen[next] != gen || cost < s.cost[next]) {
+                    s.seen[next] = gen;
+                    s.cost[next] = cost;
+                    s.parent[next] = cell;
+                    s.Push(cost + heuristic(next), next);
+                }
+            }
+        }
+        return false;
+    }
+
+    /// Dijkstra outward from the goal; each reached cell stores the neighbor
+    /// it should step to.
+    void BuildFlowField(const NavGrid& grid, int goal, std::vector<int8_t>& direction) {
+        direction.assign(grid.blocked.size(), -1);
+        SearchScratch& s = scratch;
+        s.Begin(grid.blocked.size());
+        const uint32_t gen = s.generation;
+
+        s.cost[goal] = 0.0f;
+        s.seen[goal] = gen;
+        s.Push(0.0f, goal);
+
+        while (!s.open.empty()) {
+            const int cell = s.Pop();
+            if (s.closed[cell] == gen) continue;
+            s.closed[cell] = gen;
+
+            const int col = cell % grid.cols;
+            const int row = cell / grid.cols;
+            for (int k = 0; k < 8; ++k) {
+                int next;
+                if (!CanStep(grid, col, row, k, next) || s.closed[next] == gen) continue;
+                const float cost = s.cost[cell] + ((k & 1) ? SQRT2 : 1.0f);
+                if (s.seen[next] != gen || cost < s.cost[next]) {
+                    s.seen[next] = gen;
+                    s.cost[next] = cost;
+                    direction[next] = static_cast<int8_t>((k + 4) & 7);
+                    s.Push(cost, next);
+                }
+            }
+        }
+
+        // An agent pushed into a blocked cell steps to its cheapest reached
+        // neighbor instead of stalling.
+        for (int cell = 0; cell < static_cast<int>(grid.blocked.size()); ++cell) {
+            if (!grid.blocked[cell]) continue;
+            const int col = cell % grid.cols;
+            const int row = cell / grid.cols;
+            float best = 0.0f;
+            for (int k = 0; k < 8; ++k) {
+                const int c = col + DX[k];
+                const int r = row + DY[k];
+                if (c < 0 || r < 0 || c >= grid.cols || r >= grid.rows) continue;
+                const int next = r * grid.cols + c;
+                if (grid.blocked[next] || s.seen[next] != gen) continue;
+                if (direction[cell] < 0 || s.cost[next] < best) {
+                    best = s.cost[next];
+                    direction[cell] = static_cast<int8_t>(k);
+                }
+            }
+        }
+    }
+
+    uint64_t PathKey(int start, int goal) {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(start)) << 32) | static_cast<uint32_t>(goal);
+    }
+}
+
+int NavGrid::CellAt(const b2Vec2& position) const {
+    if (!IsValid()) return -1;
+    const float fx = std::floor((position.x - origin.x) / cell_size);
+    const float fy = std::floor((position.y - origin.y) / cell_size);
+    if (fx < 0.0f || fy < 0.0f || fx >= static_cast<float>(cols) || fy >= static_cast<float>(rows)) return -1;
+    return static_cast<int>(fy) * cols + static_cast<int>(fx);
+}
+
+b2Vec2 NavGrid::CellCenter(int cell) const {
+    return b2Vec2(origin.x + (static_cast<float>(cell % cols) + 0.5f) * cell_size,
+                  origin.y + (static_cast<float>(cell / cols) + 0.5f) * cell_size);
+}
+
+void Navigation::Init() {
+    Clear();
+    next_request_id = 1;
+}
+
+void Navigation::Clear() {
+    grid = NavGrid{};
+    path_cache.clear();
+    flow_fields.clear();
+    flow_clock = 0;
+    pending.clear();
+    in_flight.clear();
+}
+
+void Navigation::ClearCache() {
+    path_cache.clear();
+    for (FlowField& field : flow_fields) {
+        field.goal = -1;
+        field.last_used = 0;
+    }
+}
+
+void Navigation::OnGridChanged() {
+    ClearCache();
+}
+
+void Navigation::BuildGrid(const b2Vec2& min, const b2Vec2& max, float cell_size) {
+    if (cell_size <= 0.0f || max.x <= min.x || max.y <= min.y) {
+        LOG_WARNING("Navigation.BuildGrid: empty area or cell_size <= 0");
+        return;
+    }
+    const int cols = static_cast<int>(std::ceil((max.x - min.x) / cell_size));
+    const int rows = static_cast<int>(std::ceil((max.y - min.y) / cell_size));
+    if (static_cast<size_t>(cols) * static_cast<size_t>(rows) > MAX_CELLS) {
+        LOG_WARNING("Navigation.BuildGrid: " + std::to_string(cols) + "x" + std::to_string(rows)
+                    + " cells is too many; use a larger cell_size");
+        return;
+    }
+
+    grid.origin = min;
+    grid.cell_size = cell_size;
+    grid.cols = cols;
+    grid.rows = rows;
+    grid.blocked.assign(static_cast<size_t>(cols) * rows, 0);
+
+    b2World* world = RigidbodyWorld::GetWorld();
+    if (world) {
+        // Slightly smaller than a cell so colliders that only touch a cell's
+        // edge leave it walkable.
+        const float half = cell_size * 0.49f;
+        b2PolygonShape cell_box;
+        b2Transform identity;
+        identity.SetIdentity();
+
+        for (b2Body* body = world->GetBodyList(); body; body = body->GetNext()) {
+            if (body->GetType() != b2_staticBody) continue;
+            for (b2Fixture* fixture = body->GetFixtureList(); fixture; fixture = fixture->GetNext()) {
+                // Same skip rule as PhysicsQuery: triggers and phantoms don't block.
+                if (fixture->IsSensor() || fixture->GetFilterData().maskBits == 0) continue;
+
+                for (int child = 0; child < fixture->GetShape()->GetChildCount(); ++child) {
+                    const b2AABB& aabb = fixture->GetAABB(child);
+                    const int c0 = std::max(0, static_cast<int>(std::floor((aabb.lowerBound.x - min.x) / cell_size)));
+                    const int r0 = std::max(0, static_cast<int>(std::floor((aabb.lowerBound.y - min.y) / cell_size)));
+                    const int c1 = std::min(cols - 1, static_cast<int>(std::floor((aabb.upperBound.x - min.x) / cell_size)));
+                    const int r1 = std::min(rows - 1, static_cast<int>(std::floor((aabb.upperBound.y - min.y) / cell_size)));
+
+                    for (int r = r0; r <= r1; ++r) {
+                        for (int c = c0; c <= c1; ++c) {
+                            const int cell = r * cols + c;
+                            if (grid.blocked[cell]) continue;
+                            cell_box.SetAsBox(half, half, grid.CellCenter(cell), 0.0f);
+                            if (b2TestOverlap(fixture->GetShape(), child, &cell_box, 0, body->GetTransform(), identity)) {
+                                grid.blocked[cell] = 1;
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    OnGridChanged();
+    LOG_DEBUG("Navigation grid " + std::to_string(cols) + "x" + std::to_string(rows) + " built from static colliders");
+}
+
+void Navigation::BuildGridFromTiles(const b2Vec2& origin, float cell_size, luabridge::LuaRef tiles) {
+    if (cell_size <= 0.0f || !tiles.isTable()) {
+        LOG_WARNING("Navigation.BuildGridFromTiles: expected a cell_size > 0 and an array of strings");
+        return;
+    }
+
+    const int rows = tiles.length();
+    int cols = 0;
+    for (int r = 1; r <= rows; ++r) {
+        if (!tiles[r].isString()) {
+            LOG_WARNING("Navigation.BuildGridFromTiles: row " + std::to_string(r) + " is not a string");
+            return;
+        }
+        cols = std::max(cols, static_cast<int>(tiles[r].tostring().size()));
+    }
+    if (rows == 0 || cols == 0 || static_cast<size_t>(cols) * static_cast<size_t>(rows) > MAX_CELLS) {
+        LOG_WARNING("Navigation.BuildGridFromTiles: tile map is empty or too large");
+        return;
+    }
+
+    grid.origin = origin;
+    grid.cell_size = cell_size;
+    grid.cols = cols;
+    grid.rows = rows;
+    grid.blocked.assign(static_cast<size_t>(cols) * rows, 0);
+    for (int r = 0; r < rows; ++r) {
+        const std::string row = tiles[r + 1].tostring();
+        for (size_t c = 0; c < row.size(); ++c) {
+            grid.blocked[r * cols + static_cast<int>(c)] = row[c] == '#' ? 1 : 0;
+        }
+    }
+
+    OnGridChanged();
+}
+
+void Navigation::SetWalkable(const b2Vec2& position, bool walkable) {
+    const int cell = grid.CellAt(position);
+    if (cell < 0 || grid.blocked[cell] == (walkable ? 0 : 1)) return;
+    grid.blocked[cell] = walkable ? 0 : 1;
+    OnGridChanged();
+}
+
+bool Navigation::IsWalkable(const b2Vec2& position) {
+    const int cell = grid.CellAt(position);
+    return cell >= 0 && !grid.blocked[cell];
+}
+
+const std::vector<int>& Navigation::SolveCached(int start_cell, int goal_cell) {
+    const uint64_t key = PathKey(start_cell, goal_cell);
+    auto it = path_cache.find(key);
+    if (it != path_cache.end()) return it->second;
+
+    if (path_cache.size() >= MAX_CACHED_PATHS) path_cache.clear();
+    std::vector<int>& cells = path_cache[key];
+    SolveAStar(grid, start_cell, goal_cell, cells);
+    return cells;
+}
+
+luabridge::LuaRef Navigation::MakePathTable(const std::vector<int>& cells, const b2Vec2& goal) {
+    lua_State* L = ComponentDB::GetLuaState();
+    if (cells.empty()) return luabridge::LuaRef(L);  // nil
+
+    // Skip the start cell and end on the exact goal rather than its cell center.
+    luabridge::LuaRef table = luabridge::newTable(L);
+    int index = 1;
+    for (size_t i = 1; i + 1 < cells.size(); ++i) {
+        table[index++] = grid.CellCenter(cells[i]);
+    }
+    table[index] = goal;
+    return table;
+}
+
+luabridge::LuaRef Navigation::FindPath(const b2Vec2& start, const b2Vec2& goal) {
+    static const std::vector<int> no_path;
+    const int start_cell = grid.CellAt(start);
+    const int goal_cell = grid.CellAt(goal);
+    if (start_cell < 0 || goal_cell < 0 || grid.blocked[goal_cell]) return MakePathTable(no_path, goal);
+    return MakePathTable(SolveCached(start_cell, goal_cell), goal);
+}
+
+int Navigation::FindPathAsync(const b2Vec2& start, const b2Vec2& goal, luabridge::LuaRef callback) {
+    if (!callback.isFunction()) {
+        LOG_WARNING("Navigation.FindPathAsync: callback is not a function");
+        return 0;
+    }
+
+    PathRequest request;
+    request.id = next_request_id++;
+    request.start = start;
+    request.goal = goal;
+    request.callback = std::make_shared<luabridge::LuaRef>(callback);
+    pending.push_back(std::move(request));
+    return pending.back().id;
+}
+
+void Navigation::Update() {
+    if (pending.empty()) return;
+
+    // Callbacks may queue new requests for the frame after this one.
+    in_flight.swap(pending);
+
+    for (PathRequest& request : in_flight) {
+        request.start_cell = grid.CellAt(request.start);
+        request.goal_cell = grid.CellAt(request.goal);
+        request.cells.clear();
+        request.solved = true;
+        if (request.start_cell < 0 || request.goal_cell < 0 || grid.blocked[request.goal_cell]) continue;
+
+        auto it = path_cache.find(PathKey(request.start_cell, request.goal_cell));
+        if (it != path_cache.end()) {
+            request.cells = it->second;
+            continue;
+        }
+        request.solved = false;
+    }
+
+    // The grid and request list are this thread's thread_locals; hand the
+    // workers pointers to them. Each worker searches with its own scratch.
+    const NavGrid* shared_grid = &grid;
+    std::vector<PathRequest>* requests = &in_flight;
+    JobSystem::ParallelFor(static_cast<int>(in_flight.size()), [shared_grid, requests](int i) {
+        PathRequest& request = (*requests)[i];
+        if (!request.solved) SolveAStar(*shared_grid, request.start_cell, request.goal_cell, request.cells);
+    });
+
+    for (PathRequest& request : in_flight) {
+        if (request.solved) continue;
+        if (path_cache.size() >= MAX_CACHED_PATHS) path_cache.clear();
+        path_cache[PathKey(request.start_cell, request.goal_cell)] = request.cells;
+    }
+
+    for (PathRequest& request : in_flight) {
+        try {
+            (*request.callback)(MakePathTable(request.cells, request.goal));
+        }
+        catch (luabridge::LuaException& e) {
+            LOG_ERROR("Navigation.FindPathAsync callback error: " + std::string(e.what()));
+        }
+    }
+    in_flight.clear();
+}
+
+Navigation::FlowField& Navigation::GetFlowField(int goal_cell) {
+    ++flow_clock;
+    for (FlowField& field : flow_fields) {
+        if (field.goal == goal_cell) {
+            field.last_used = flow_clock;
+            return field;
+        }
+    }
+
+    // Reuse the least recently used field's storage once the cache is full.
+    FlowField* slot = nullptr;
+    if (flow_fields.size() < MAX_FLOW_FIELDS) {
+        slot = &flow_fields.emplace_back();
+    }
+    else {
+        slot = &*std::min_element(flow_fields.begin(), flow_fields.end(),
+                                  [](const FlowField& a, const FlowField& b) { return a.last_used < b.last_used; });
+    }
+    slot->goal = goal_cell;
+    slot->last_used = flow_clock;
+    BuildFlowField(grid, goal_cell, slot->direction);
+    return *slot;
+}
+
+b2Vec2 Navigation::GetFlowDirection(const b2Vec2& goal, const b2Vec2& position) {
+    const b2Vec2 none(0.0f, 0.0f);
+    const int goal_cell = grid.CellAt(goal);
+    const int cell = grid.CellAt(position);
+    if (goal_cell < 0 || cell < 0 || grid.blocked[goal_cell]) return none;
+
+    b2Vec2 toward = goal - position;
+    if (cell != goal_cell) {
+        const int k = GetFlowField(goal_cell).direction[cell];
+        if (k < 0) return none;
+        const int next = cell + DY[k] * grid.cols + DX[k];
+        toward = grid.CellCenter(next) - position;
+    }
+    if (toward.Normalize() < b2_epsilon) return none;
+    return toward;
+}
@@ -0,0 +1,149 @@
+//
+//  Navigation.hpp
+//  game_engine
+//
+//  Grid pathfinding for Lua agents: A* paths and shared flow fields.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+#include "box2d/box2d.h"
+#include "lua.hpp"
+#include "LuaBridge/LuaBridge.h"
+
+/**
+ * @struct NavGrid
+ * @brief Walkability grid in world units (the same units as Rigidbody).
+ *
+ * Cell (0, 0) has its top-left corner at `origin`; cells are indexed
+ * row-major as row * cols + col.
+ */
+struct NavGrid {
+    b2Vec2 origin = b2Vec2(0.0f, 0.0f);
+    float cell_size = 1.0f;
+    int cols = 0;
+    int rows = 0;
+    std::vector<uint8_t> blocked;
+
+    bool IsValid() const { return cols > 0 && rows > 0; }
+
+    /// Cell index containing a world position, or -1 outside the grid.
+    int CellAt(const b2Vec2& position) const;
+
+    b2Vec2 CellCenter(int cell) const;
+};
+
+/**
+ * @class Navigation
+ * @brief Static pathfinding subsystem exposed to Lua as `Navigation`.
+ *
+ * Scripts build one walkable grid per scene, either from the scene's static
+ * colliders (BuildGrid) or from a tilemap (BuildGridFromTiles), then query it:
+ *
+ * - FindPath() runs 8-connected A* (binary heap, no corner cutting, stops
+ *   as soon as the goal is expanded) and caches the result per
+ *   (start cell, goal cell) until the grid changes.
+ * - FindPathAsync() queues the same query. Queued queries are solved
+ *   together on the JobSystem at the start of the next frame and their
+ *   callbacks run then, on the world's thread.
+ * - GetFlowDirection() serves many agents heading to one goal: the first
+ *   query for a goal cell builds a flow field over the whole grid, after
+ *   which every agent's lookup is O(1). The most recently used fields are
+ *   kept.
+ *
+ * Paths are Lua arrays of Vector2 waypoints (cell centers, ending at the exact
+ * goal), or nil when the goal is unreachable or outside the grid. State is
+ * per world thread and is dropped on scene change.
+ */
+class Navigation {
+public:
+    static void Init();
+
+    /**
+     * @brief Solves queued FindPathAsync requests and runs their callbacks.
+     * Call once per frame.
+     */
+    static void Update();
+
+    /**
+     * @brief Drops the grid, caches and queued requests. Called on scene
+     * change and before the Lua state closes.
+     */
+    static void Clear();
+
+    /**
+     * @brief Builds a grid over [min, max] and blocks every cell overlapped
+     * by a non-sensor fixture of a static body.
+     */
+    static void BuildGrid(const b2Vec2& min, const b2Vec2& max, float cell_size);
+
+    /**
+     * @brief Builds a grid from a Lua array of strings, one per row from the
+     * top. '#' marks a blocked cell; any other character is walkable.
+     */
+    static void BuildGridFromTiles(const b2Vec2& origin, float cell_size, luabridge::LuaRef tiles);
+
+    static void SetWalkable(const b2Vec2& position, bool walkable);
+    static bool IsWalkable(const b2Vec2& position);
+
+    /// Waypoint table from start to goal, or nil.
+    static luabridge::LuaRef FindPath(const b2Vec2& start, const b2Vec2& goal);
+
+    /**
+     * @brief Queues a path query; callback(path) runs next frame.
+     * @return Request id (0 if the callback is not a function).
+     */
+    static int FindPathAsync(const b2Vec2& start, const b2Vec2& goal, luabridge::LuaRef callback);
+
+    /**
+     * @brief Unit direction an agent at `position` should move to reach
+     * `goal`, or (0, 0) at the goal or when it cannot be reached.
+     */
+    static b2Vec2 GetFlowDirection(const b2Vec2& goal, const b2Vec2& position);
+
+    /// Forgets cached paths and flow fields.
+    static void ClearCache();
+
+private:
+    struct FlowField {
+        int goal = -1;
+        uint64_t last_used = 0;
+        std::vector<int8_t> direction;   ///< neighbor index toward goal, -1 none
+    };
+
+    struct PathRequest {
+        int id;
+        b2Vec2 start;
+        b2Vec2 goal;
+        std::shared_ptr<luabridge::LuaRef> callback;
+        int start_cell = -1;
+        int goal_cell = -1;
+        bool solved = false;
+        std::vector<int> cells;
+    };
+
+    /// Called after any grid edit.
+    static void OnGridChanged();
+
+    /// Cached or freshly solved A* path; empty when unreachable.
+    static const std::vector<int>& SolveCached(int start_cell, int goal_cell);
+
+    static FlowField& GetFlowField(int goal_cell);
+
+    static luabridge::LuaRef MakePathTable(const std::vector<int>& cells, const b2Vec2& goal);
+
+    static constexpr size_t MAX_CACHED_PATHS = 256;
+    static constexpr size_t MAX_FLOW_FIELDS = 8;
+
+    inline static thread_local NavGrid grid;
+    inline static thread_local std::unordered_map<uint64_t, std::vector<int>> path_cache;
+    inline static thread_local std::vector<FlowField> flow_fields;
+    inline static thread_local uint64_t flow_clock = 0;
+    inline static thread_local std::vector<PathRequest> pending;
+    inline static thread_local std::vector<PathRequest> in_flight;
+    inline static thread_local int next_request_id = 1;
+};
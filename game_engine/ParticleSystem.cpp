@@ -7,6 +7,12 @@
 
 #include "ParticleSystem.hpp"
 #include "Logger.hpp"
+#include "EngineUtils.hpp"
+#include "EngineContext.hpp"
+#include "JobSystem.hpp"
+#include "Rigidbody.hpp"
+#include "RigidbodyWorld.hpp"
+#include <algorithm>
 #include <cmath>
 #include <cstdlib>
 
@@ -15,19 +21,46 @@
 #endif
 
 static float RandomRange(float min_val, float max_val) {
-    float t = static_cast<float>(rand()) / static_cast<float>(RAND_MAX);
+    float t = EngineUtils::RandomUnit(RandomStream::Particles);
     return min_val + t * (max_val - min_val);
 }
 
+namespace {
+    // Segments per job when collision rays are cast in parallel
+    constexpr int kCollisionChunk = 128;
+    // How far off the surface a bounced or stuck particle is placed
+    constexpr float kCollisionSkin = 0.01f;
+
+    // Closest static, solid fixture along a ray
+    class StaticRayCast : public b2RayCastCallback {
+    public:
+        bool hit = false;
+        b2Vec2 point;
+        b2Vec2 normal;
+
+        float ReportFixture(b2Fixture* fixture, const b2Vec2& at, const b2Vec2& n, float fraction) override {
+            b2Body* body = fixture->GetBody();
+            if (fixture->IsSensor() || body->GetType() != b2_staticBody) return -1.0f;
+            // A one-way collider only stops what arrives from its up side.
+            const Rigidbody* rb = Rigidbody::FromBody(body);
+            if (rb && rb->one_way && b2Dot(b2Mul(body->GetTransform().q, b2Vec2(0.0f, -1.0f)), n) <= 0.0f) return -1.0f;
+            hit = true;
+            point = at;
+            normal = n;
+            return fraction;
+        }
+    };
+}
+
 void ParticleSystem::Init() {
+    // The pool is allocated by the first Emit.
     particles.clear();
-    particles.resize(MAX_PARTICLES);
-    for (auto& p : particles) {
-        p.active = false;
-    }
     draw_data.clear();
-    draw_data.reserve(MAX_PARTICLES);
+    segments.clear();
     active_count = 0;
+    collision_budget = 512;
+    collision_cursor = 0;
+    collision_checks = 0;
 }
 
 void ParticleSystem::Clear() {
@@ -35,14 +68,21 @@ void ParticleSystem::Clear() {
         p.active = false;
     }
     draw_data.clear();
+    segments.clear();
     active_count = 0;
+    collision_cursor = 0;
+    collision_checks = 0;
 }
 
 void ParticleSystem::Update(float dt) {
     active_count = 0;
     draw_data.clear();
+    segments.clear();
+    // Headless contexts never render, so skip building draw data unless recorded.
+    const bool record_draws = !EngineContext::DropsDrawsOnThread();
 
-    for (auto& p : particles) {
+    for (int i = 0; i < static_cast<int>(particles.size()); i++) {
+        Particle& p = particles[i];
         if (!p.active) {
             continue;
         }
@@ -60,12 +100,27 @@ void ParticleSystem::Update(float dt) {
         p.x += p.vx * dt;
         p.y += p.vy * dt;
 
+        if (p.collision != ParticleCollision::None) {
+            segments.push_back({ i, false, 0.0f, 0.0f, 0.0f, 0.0f });
+        }
+    }
+
+    Collide();
+
+    for (auto& p : particles) {
+        if (!p.active) {
+            continue;
+        }
+
         // Interpolate based on life progress (0 = just spawned, 1 = about to die)
         float life_ratio = 1.0f - (p.lifetime / p.max_lifetime);
 
         // Interpolate size
         p.size = p.start_size + (p.end_size - p.start_size) * life_ratio;
 
+        active_count++;
+        if (!record_draws) continue;
+
         // Interpolate color
         glm::vec4 color = p.start_color + (p.end_color - p.start_color) * life_ratio;
 
@@ -80,8 +135,86 @@ void ParticleSystem::Update(float dt) {
         dd.a = static_cast<int>(color.w);
         dd.sorting_order = p.sorting_order;
         draw_data.push_back(dd);
+    }
+    if (!record_draws) EngineContext::CountDroppedDraws(active_count);
+}
 
-        active_count++;
+void ParticleSystem::Collide() {
+    collision_checks = 0;
+    b2World* world = RigidbodyWorld::GetWorld();
+    if (!world || segments.empty() || collision_budget == 0) {
+        return;
+    }
+
+    // Over budget, test a window that starts where the last update stopped.
+    const int total = static_cast<int>(segments.size());
+    const int count = std::min(total, collision_budget);
+    const int first = count < total ? collision_cursor % total : 0;
+    collision_cursor = first + count;
+    collision_checks = count;
+
+    // Ray casts only read the world, so chunks run on the job workers. The
+    // lists are thread_local, so jobs get their data pointers.
+    CollisionSegment* data = segments.data();
+    const Particle* pool = particles.data();
+    auto cast_chunk = [world, data, pool, first, total, count](int chunk) {
+        const int end = std::min(count, (chunk + 1) * kCollisionChunk);
+        for (int i = chunk * kCollisionChunk; i < end; i++) {
+            CollisionSegment& s = data[(first + i) % total];
+            const Particle& p = pool[s.index];
+            const b2Vec2 from(p.checked_x, p.checked_y);
+            const b2Vec2 to(p.x, p.y);
+            if (b2DistanceSquared(from, to) <= b2_epsilon * b2_epsilon) continue;
+
+            StaticRayCast ray;
+            world->RayCast(&ray, from, to);
+            s.hit = ray.hit;
+            s.hit_x = ray.point.x;
+            s.hit_y = ray.point.y;
+            s.normal_x = ray.normal.x;
+            s.normal_y = ray.normal.y;
+        }
+    };
+    JobSystem::ParallelFor((count + kCollisionChunk - 1) / kCollisionChunk, cast_chunk);
+
+    for (int i = 0; i < count; i++) {
+        const CollisionSegment& s = segments[(first + i) % total];
+        Particle& p = particles[s.index];
+        if (!s.hit) {
+            p.checked_x = p.x;
+            p.checked_y = p.y;
+            continue;
+        }
+
+        const float nx = s.normal_x;
+        const float ny = s.normal_y;
+        switch (p.collision) {
+        case ParticleCollision::Kill:
+            p.active = false;
+            continue;
+        case ParticleCollision::Stick:
+            p.vx = 0.0f;
+            p.vy = 0.0f;
+            p.gravity = 0.0f;
+            p.collision = ParticleCollision::None;
+            break;
+        case ParticleCollision::Bounce: {
+            const float vn = p.vx * nx + p.vy * ny;
+            const float tx = p.vx - vn * nx;
+            const float ty = p.vy - vn * ny;
+            const float bounced = vn < 0.0f ? -vn * p.restitution : vn;
+            const float keep = 1.0f - p.friction;
+            p.vx = tx * keep + bounced * nx;
+            p.vy = ty * keep + bounced * ny;
+            break;
+        }
+        case ParticleCollision::None:
+            break;
+        }
+        p.x = s.hit_x + nx * kCollisionSkin;
+        p.y = s.hit_y + ny * kCollisionSkin;
+        p.checked_x = p.x;
+        p.checked_y = p.y;
     }
 }
 
@@ -90,6 +223,19 @@ void ParticleSystem::Emit(float x, float y, int count, const ParticleConfig& con
     float spread_rad = static_cast<float>(config.spread_angle * M_PI / 180.0);
     float half_spread = spread_rad * 0.5f;
 
+    ParticleCollision collision = ParticleCollision::None;
+    if (config.collision == "bounce") collision = ParticleCollision::Bounce;
+    else if (config.collision == "kill") collision = ParticleCollision::Kill;
+    else if (config.collision == "stick") collision = ParticleCollision::Stick;
+    else if (!config.collision.empty()) {
+        LOG_WARNING("ParticleSystem: unknown collision '" + config.collision + "' (use bounce, kill or stick)");
+    }
+
+    if (particles.empty()) {
+        particles.resize(MAX_PARTICLES);
+        draw_data.reserve(MAX_PARTICLES);
+    }
+
     for (int i = 0; i < count; i++) {
         int idx = FindFreeParticle();
         if (idx < 0) {
@@ -118,6 +264,11 @@ void ParticleSystem::Emit(float x, float y, int count, const ParticleConfig& con
         p.end_color = config.end_color;
         p.image_name = config.image_name;
         p.sorting_order = config.sorting_order;
+        p.collision = collision;
+        p.restitution = config.restitution;
+        p.friction = config.friction;
+        p.checked_x = x;
+        p.checked_y = y;
     }
 }
 
@@ -125,10 +276,25 @@ const std::vector<ParticleDrawData>& ParticleSystem::GetDrawData() {
     return draw_data;
 }
 
+void ParticleSystem::TakeDrawData(std::vector<ParticleDrawData>& out) {
+    out.clear();
+    out.swap(draw_data);
+}
+
 int ParticleSystem::GetActiveCount() {
     return active_count;
 }
 
+int ParticleSystem::CountInRect(float min_x, float min_y, float max_x, float max_y) {
+    int count = 0;
+    for (const auto& p : particles) {
+        if (p.active && p.x >= min_x && p.x <= max_x && p.y >= min_y && p.y <= max_y) {
+            count++;
+        }
+    }
+    return count;
+}
+
 int ParticleSystem::FindFreeParticle() {
     for (int i = 0; i < MAX_PARTICLES; i++) {
         if (!particles[i].active) {
@@ -12,6 +12,9 @@
 #include <vector>
 #include "glm/glm.hpp"
 
+/// What a particle does when its path crosses a static collider.
+enum class ParticleCollision { None, Bounce, Kill, Stick };
+
 struct Particle {
     float x, y;
     float vx, vy;
@@ -26,6 +29,10 @@ struct Particle {
     std::string image_name;
     int sorting_order = 999;
     bool active = false;
+    ParticleCollision collision = ParticleCollision::None;
+    float restitution;
+    float friction;
+    float checked_x, checked_y;  // where the last collision test ended
 };
 
 struct ParticleConfig {
@@ -42,6 +49,9 @@ struct ParticleConfig {
     glm::vec4 end_color = {255, 255, 255, 0};
     std::string image_name = "";  // empty = use default particle texture
     int sorting_order = 999;
+    std::string collision = "";   // "bounce", "kill" or "stick" against static colliders; empty = none
+    float restitution = 0.5f;     // bounce: share of the speed into the surface kept
+    float friction = 0.2f;        // bounce: share of the speed along the surface lost
 
     void SetStartColor(float r, float g, float b, float a) {
         start_color = {r, g, b, a};
@@ -71,14 +81,44 @@ public:
     // Get current particles for rendering
     static const std::vector<ParticleDrawData>& GetDrawData();
 
+    // Move this frame's draw data into a render frame (swaps, keeps capacity)
+    static void TakeDrawData(std::vector<ParticleDrawData>& out);
+
     static int GetActiveCount();
 
+    // Active particles inside the axis-aligned rectangle [min, max]
+    static int CountInRect(float min_x, float min_y, float max_x, float max_y);
+
+    // Most colliding particles tested against the physics world per update.
+    // The window rotates; a particle left out is tested on its turn from
+    // where its last test ended, so it reacts late but never tunnels.
+    static void SetCollisionBudget(int rays) { collision_budget = rays < 0 ? 0 : rays; }
+
+    // Segments tested in the last update
+    static int GetCollisionChecks() { return collision_checks; }
+
 private:
     static constexpr int MAX_PARTICLES = 2000;
-    inline static std::vector<Particle> particles;
-    inline static std::vector<ParticleDrawData> draw_data;
-    inline static int active_count = 0;
+    inline static thread_local std::vector<Particle> particles;
+    inline static thread_local std::vector<ParticleDrawData> draw_data;
+    inline static thread_local int active_count = 0;
+
+    /// A colliding particle's movement since its last test, and what it hit.
+    struct CollisionSegment {
+        int index;
+        bool hit;
+        float hit_x, hit_y;
+        float normal_x, normal_y;
+    };
+    inline static thread_local std::vector<CollisionSegment> segments;
+    inline static thread_local int collision_budget = 512;
+    inline static thread_local int collision_cursor = 0;
+    inline static thread_local int collision_checks = 0;
 
     static int FindFreeParticle();
+
+    // Ray casts this update's segments against static fixtures, then applies
+    // each hit particle's response
+    static void Collide();
 };
 
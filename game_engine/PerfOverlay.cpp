@@ -0,0 +1,201 @@
+//
+//  PerfOverlay.cpp
+//  game_engine
+//
+//  On-screen frame-time graph and engine counters (F2).
+//
+
+#include "PerfOverlay.hpp"
+#include "RenderCommandBuffer.hpp"
+#include "Renderer.hpp"
+#include "RigidbodyWorld.hpp"
+#include "SceneDB.hpp"
+#include "ComponentDB.hpp"
+#include "ImageDB.hpp"
+#include "ParticleSystem.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+
+namespace {
+    constexpr int kPixel = 2;                   ///< Font pixel size in screen pixels
+    constexpr int kAdvance = 4 * kPixel;
+    constexpr int kLineHeight = 6 * kPixel;
+    constexpr int kMargin = 8;
+    constexpr int kPadding = 6;
+    constexpr int kPanelWidth = 36 * kAdvance + 2 * kPadding;
+    constexpr int kBarWidth = 2;
+    constexpr int kGraphHeight = 60;
+    constexpr float kGraphMaxMs = 1000.0f / 30.0f;
+    constexpr float kBudgetMs = 1000.0f / 60.0f;
+
+    /// 3x5 glyph, top row in the high bits, left column first.
+    uint16_t Glyph(char c) {
+        static constexpr uint16_t digits[10] = {
+            0b111101101101111, 0b010110010010111, 0b111001111100111, 0b111001111001111, 0b101101111001001,
+            0b111100111001111, 0b111100111101111, 0b111001001001001, 0b111101111101111, 0b111101111001111,
+        };
+        static constexpr uint16_t letters[26] = {
+            0b010101111101101, 0b110101110101110, 0b011100100100011, 0b110101101101110, 0b111100110100111,
+            0b111100110100100, 0b011100101101011, 0b101101111101101, 0b111010010010111, 0b001001001101010,
+            0b101101110101101, 0b100100100100111, 0b101111111101101, 0b110101101101101, 0b010101101101010,
+            0b110101110100100, 0b010101101110011, 0b110101110101101, 0b011100010001110, 0b111010010010010,
+            0b101101101101111, 0b101101101101010, 0b101101111111101, 0b101101010101101, 0b101101010010010,
+            0b111001010100111,
+        };
+        if (c >= '0' && c <= '9') return digits[c - '0'];
+        if (c >= 'A' && c <= 'Z') return letters[c - 'A'];
+        if (c >= 'a' && c <= 'z') return letters[c - 'a'];
+        switch (c) {
+            case '.': return 0b000000000000010;
+            case ':': return 0b000010000010000;
+            case '/': return 0b001001010100100;
+            case '-': return 0b000000111000000;
+            case '%': return 0b101001010100101;
+            default: return 0;
+        }
+    }
+}
+
+void PerfOverlay::SetEnabled(bool value) {
+    enabled = value;
+}
+
+bool PerfOverlay::IsEnabled() {
+    return enabled;
+}
+
+void PerfOverlay::ToggleEnabled() {
+    enabled = !enabled;
+}
+
+void PerfOverlay::Record(PerfCounters& out) {
+    out = PerfCounters{};
+    out.enabled = enabled;
+    if (enabled) Count(out);
+}
+
+void PerfOverlay::Count(PerfCounters& out) {
+    out.actors = static_cast<int>(SceneDB::actors.size());
+    for (const auto& [id, actor] : SceneDB::actors) {
+        out.components += static_cast<int>(actor->components.size());
+    }
+    if (lua_State* L = ComponentDB::GetLuaState()) out.lua_kb = lua_gc(L, LUA_GCCOUNT, 0);
+    out.particles = ParticleSystem::GetActiveCount();
+    if (b2World* world = RigidbodyWorld::GetWorld()) {
+        out.bodies = world->GetBodyCount();
+        out.contacts = world->GetContactCount();
+    }
+}
+
+void PerfOverlay::AddFrame(const FrameProfile& profile) {
+    frame_ms[history_head] = static_cast<float>(profile.frame_ms);
+    history_head = (history_head + 1) % HISTORY;
+    history_count = std::min(history_count + 1, HISTORY);
+    last_profile = profile;
+}
+
+void PerfOverlay::AddText(int x, int y, const char* text) {
+    for (; *text; ++text, x += kAdvance) {
+        const uint16_t glyph = Glyph(*text);
+        if (glyph == 0) continue;
+        for (int row = 0; row < 5; ++row) {
+            const int bits = (glyph >> (12 - 3 * row)) & 0b111;
+            // One rect per horizontal run of set pixels.
+            for (int col = 0; col < 3;) {
+                if (!(bits & (0b100 >> col))) {
+                    ++col;
+                    continue;
+                }
+                int end = col + 1;
+                while (end < 3 && (bits & (0b100 >> end))) ++end;
+                text_rects.push_back({ x + col * kPixel, y + row * kPixel, (end - col) * kPixel, kPixel });
+                col = end;
+            }
+        }
+    }
+}
+
+void PerfOverlay::Execute(const RenderFrame& frame) {
+    if (!frame.perf.enabled) return;
+    const auto start = std::chrono::steady_clock::now();
+    const PerfCounters& counters = frame.perf;
+    const RenderStats draws = RenderCommandBuffer::Measure(frame);
+
+    text_rects.clear();
+    for (auto& bars : bar_rects) bars.clear();
+
+    float total_ms = 0.0f;
+    for (int i = 0; i < history_count; ++i) total_ms += frame_ms[i];
+    const float average_ms = history_count > 0 ? total_ms / history_count : 0.0f;
+
+    const int x = kMargin + kPadding;
+    int y = kMargin + kPadding;
+    char line[64];
+    auto print = [&]() {
+        AddText(x, y, line);
+        y += kLineHeight;
+    };
+
+    std::snprintf(line, sizeof(line), "FPS %.0f  FRAME %.2f MS", average_ms > 0.0f ? 1000.0f / average_ms : 0.0f,
+                  last_profile.frame_ms);
+    print();
+    std::snprintf(line, sizeof(line), "INPUT %.2f  SYSTEMS %.2f", last_profile[ProfileStage::Input],
+                  last_profile[ProfileStage::Systems]);
+    print();
+    std::snprintf(line, sizeof(line), "SCRIPTS %.2f  PHYSICS %.2f", last_profile[ProfileStage::Scripts],
+                  last_profile[ProfileStage::Physics]);
+    print();
+    std::snprintf(line, sizeof(line), "RECORD %.2f  RENDER %.2f", last_profile[ProfileStage::Record],
+                  last_profile[ProfileStage::Render]);
+    print();
+    std::snprintf(line, sizeof(line), "ACTORS %d  COMPONENTS %d", counters.actors, counters.components);
+    print();
+    std::snprintf(line, sizeof(line), "LUA %d KB  DRAWS %d  BATCHES %d", counters.lua_kb, draws.draw_calls,
+                  draws.batches);
+    print();
+    std::snprintf(line, sizeof(line), "BODIES %d  CONTACTS %d", counters.bodies, counters.contacts);
+    print();
+    std::snprintf(line, sizeof(line), "PARTICLES %d  TEXTURES %.1f MB", counters.particles,
+                  ImageDB::GetTextureMemory() / (1024.0 * 1024.0));
+    print();
+
+    // Frame-time graph, oldest on the left, full height at 30 FPS, with a
+    // line at the 60 FPS budget.
+    const int graph_top = y + kPadding;
+    const int graph_bottom = graph_top + kGraphHeight;
+    for (int i = 0; i < history_count; ++i) {
+        const float ms = frame_ms[(history_head - history_count + i + HISTORY) % HISTORY];
+        const int height = std::clamp(static_cast<int>(ms / kGraphMaxMs * kGraphHeight), 1, kGraphHeight);
+        const int color = ms <= kBudgetMs ? 0 : (ms <= kGraphMaxMs ? 1 : 2);
+        bar_rects[color].push_back({ x + i * kBarWidth, graph_bottom - height, kBarWidth, height });
+    }
+    const int budget_y = graph_bottom - static_cast<int>(kBudgetMs / kGraphMaxMs * kGraphHeight);
+    text_rects.push_back({ x, budget_y, HISTORY * kBarWidth, 1 });
+    y = graph_bottom + kPadding;
+
+    std::snprintf(line, sizeof(line), "OVERLAY %.3f MS", last_cost_ms);
+    print();
+
+    SDL_Renderer* renderer = Renderer::getSDLRenderer();
+    SDL_BlendMode previous_blend;
+    SDL_GetRenderDrawBlendMode(renderer, &previous_blend);
+    SDL_RenderSetScale(renderer, 1.0f, 1.0f);
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+
+    const SDL_Rect panel = { kMargin, kMargin, kPanelWidth, y - kLineHeight + 5 * kPixel + kPadding - kMargin };
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 170);
+    SDL_RenderFillRect(renderer, &panel);
+
+    static constexpr SDL_Color bar_colors[3] = { {80, 220, 100, 255}, {240, 200, 60, 255}, {240, 70, 60, 255} };
+    for (int i = 0; i < 3; ++i) {
+        if (bar_rects[i].empty()) continue;
+        SDL_SetRenderDrawColor(renderer, bar_colors[i].r, bar_colors[i].g, bar_colors[i].b, bar_colors[i].a);
+        SDL_RenderFillRects(renderer, bar_rects[i].data(), static_cast<int>(bar_rects[i].size()));
+    }
+    SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
+    SDL_RenderFillRects(renderer, text_rects.data(), static_cast<int>(text_rects.size()));
+
+    SDL_SetRenderDrawBlendMode(renderer, previous_blend);
+    last_cost_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
@@ -0,0 +1,80 @@
+//
+//  PerfOverlay.hpp
+//  game_engine
+//
+//  On-screen frame-time graph and engine counters (F2).
+//
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <vector>
+#include "SDL2/SDL.h"
+#include "Profiler.hpp"
+
+struct RenderFrame;
+
+/// World-side counters recorded with a frame while the overlay is on.
+struct PerfCounters {
+    bool enabled = false;
+    int actors = 0;
+    int components = 0;
+    int lua_kb = 0;
+    int particles = 0;
+    int bodies = 0;
+    int contacts = 0;
+};
+
+/**
+ * @class PerfOverlay
+ * @brief Performance HUD drawn over the frame: a rolling frame-time graph,
+ * FPS, per-stage timings and engine counters.
+ *
+ * Like DebugDraw it is split across threads. The enabled flag and the world
+ * counters (actors, components, Lua heap, particles, bodies, contacts) live
+ * with the world and are recorded into the RenderFrame. The frame-time
+ * history comes from Engine::GameLoop, and draw calls and texture memory are
+ * measured when the frame is drawn.
+ *
+ * Text uses a built-in 3x5 pixel font, so no TTF texture is made. The whole
+ * overlay goes out as one SDL_RenderFillRects call per colour, a handful in
+ * all, and its own cost is shown on its last line.
+ */
+class PerfOverlay {
+public:
+    static void SetEnabled(bool enabled);
+    static bool IsEnabled();
+    static void ToggleEnabled();
+
+    /// Fills `out` from the calling world; only `enabled` is set while off.
+    static void Record(PerfCounters& out);
+
+    /// Counts the calling world's actors, components, Lua heap, particles,
+    /// bodies and contacts into `out`, whether or not the overlay is on.
+    static void Count(PerfCounters& out);
+
+    /// Adds a finished frame to the graph. Called by Engine::GameLoop.
+    static void AddFrame(const FrameProfile& profile);
+
+    /// Draws the overlay for a recorded frame, if it was on. Render thread.
+    static void Execute(const RenderFrame& frame);
+
+private:
+    static constexpr int HISTORY = 120;
+
+    /// Appends the rects of `text` at pixel (x, y) to `text_rects`.
+    static void AddText(int x, int y, const char* text);
+
+    inline static thread_local bool enabled = false;
+
+    inline static std::array<float, HISTORY> frame_ms{};
+    inline static int history_head = 0;
+    inline static int history_count = 0;
+    inline static FrameProfile last_profile;
+    inline static double last_cost_ms = 0.0;
+
+    /// Scratch, reused so drawing the overlay does not allocate.
+    inline static std::vector<SDL_Rect> text_rects;
+    inline static std::array<std::vector<SDL_Rect>, 3> bar_rects;
+};
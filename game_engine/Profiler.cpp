@@ -0,0 +1,139 @@
+//
+//  Profiler.cpp
+//  game_engine
+//
+//  Per-stage frame timings and a process-wide allocation counter.
+//
+
+#include "Profiler.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+namespace {
+    std::atomic<uint64_t> allocation_count{0};
+}
+
+// Global replacements so steady-state frames can be checked for heap
+// traffic. Every allocating form is replaced, plain and over-aligned,
+// throwing and nothrow, so none escapes the count whichever way the
+// standard library implements its defaults.
+namespace {
+    void* Allocate(std::size_t size) {
+        allocation_count.fetch_add(1, std::memory_order_relaxed);
+        if (size == 0) size = 1;
+        while (true) {
+            if (void* p = std::malloc(size)) return p;
+            std::new_handler handler = std::get_new_handler();
+            if (!handler) throw std::bad_alloc();
+            handler();
+        }
+    }
+
+    void* AllocateAligned(std::size_t size, std::align_val_t align) {
+        allocation_count.fetch_add(1, std::memory_order_relaxed);
+        if (size == 0) size = 1;
+        const std::size_t alignment = std::max(static_cast<std::size_t>(align), sizeof(void*));
+        while (true) {
+#ifdef _WIN32
+            if (void* p = _aligned_malloc(size, alignment)) return p;
+#else
+            void* p = nullptr;
+            if (posix_memalign(&p, alignment, size) == 0) return p;
+#endif
+            std::new_handler handler = std::get_new_handler();
+            if (!handler) throw std::bad_alloc();
+            handler();
+        }
+    }
+
+    void FreeAligned(void* p) noexcept {
+#ifdef _WIN32
+        _aligned_free(p);
+#else
+        std::free(p);
+#endif
+    }
+}
+
+void* operator new(std::size_t size) { return Allocate(size); }
+void* operator new[](std::size_t size) { return Allocate(size); }
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    try { return Allocate(size); } catch (...) { return nullptr; }
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    try { return Allocate(size); } catch (...) { return nullptr; }
+}
+
+void* operator new(std::size_t size, std::align_val_t align) { return AllocateAligned(size, align); }
+void* operator new[](std::size_t size, std::align_val_t align) { return AllocateAligned(size, align); }
+
+void* operator new(std::size_t size, std::align_val_t align, const std::nothrow_t&) noexcept {
+    try { return AllocateAligned(size, align); } catch (...) { return nullptr; }
+}
+
+void* operator new[](std::size_t size, std::align_val_t align, const std::nothrow_t&) noexcept {
+    try { return AllocateAligned(size, align); } catch (...) { return nullptr; }
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { std::free(p); }
+
+void operator delete(void* p, std::align_val_t) noexcept { FreeAligned(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { FreeAligned(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { FreeAligned(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { FreeAligned(p); }
+void operator delete(void* p, std::align_val_t, const std::nothrow_t&) noexcept { FreeAligned(p); }
+void operator delete[](void* p, std::align_val_t, const std::nothrow_t&) noexcept { FreeAligned(p); }
+
+Profiler::Scope::Scope(ProfileStage stage) : previous(active) {
+    Switch(stage);
+}
+
+Profiler::Scope::~Scope() {
+    Switch(previous);
+}
+
+void Profiler::Switch(ProfileStage stage) {
+    const Clock::time_point now = Clock::now();
+    if (active != ProfileStage::Count) {
+        accumulated[static_cast<size_t>(active)] += std::chrono::duration<double, std::milli>(now - mark).count();
+    }
+    active = stage;
+    mark = now;
+}
+
+void Profiler::TakeFrame(FrameProfile& frame) {
+    for (size_t i = 0; i < accumulated.size(); ++i) {
+        frame.stage_ms[i] += accumulated[i];
+        accumulated[i] = 0.0;
+    }
+    frame.lua_calls += lua_calls;
+    lua_calls = 0;
+}
+
+uint64_t Profiler::GetAllocationCount() {
+    return allocation_count.load(std::memory_order_relaxed);
+}
+
+const char* Profiler::GetStageName(ProfileStage stage) {
+    switch (stage) {
+        case ProfileStage::Input:   return "input";
+        case ProfileStage::Systems: return "systems";
+        case ProfileStage::Scripts: return "scripts";
+        case ProfileStage::Physics: return "physics";
+        case ProfileStage::Record:  return "record";
+        case ProfileStage::Render:  return "render";
+        default:                    return "?";
+    }
+}
@@ -0,0 +1,98 @@
+//
+//  Profiler.hpp
+//  game_engine
+//
+//  Per-stage frame timings and a process-wide allocation counter.
+//
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+
+/**
+ * @enum ProfileStage
+ * @brief Exclusive buckets a frame's time is split into.
+ */
+enum class ProfileStage : uint8_t {
+    Input,      ///< Input::BeginFrame and event processing
+    Systems,    ///< Time, scene loads, timers, tweens, animation, particles, camera
+    Scripts,    ///< Component lifecycle (OnStart / OnUpdate / OnLateUpdate, destruction)
+    Physics,    ///< Box2D step and contact callbacks
+    Record,     ///< RenderCommandBuffer::Record
+    Render,     ///< RenderCommandBuffer::Execute, screenshot and present
+    Count
+};
+
+/**
+ * @struct FrameProfile
+ * @brief One frame's counters.
+ */
+struct FrameProfile {
+    std::array<double, static_cast<size_t>(ProfileStage::Count)> stage_ms{};
+    double frame_ms = 0.0;      ///< Wall time of the whole frame (loop iteration)
+    uint64_t allocations = 0;   ///< operator new calls made by any thread during the frame
+    uint64_t lua_calls = 0;     ///< Engine calls into Lua: lifecycle, collision, event and timer callbacks
+
+    double& operator[](ProfileStage stage) { return stage_ms[static_cast<size_t>(stage)]; }
+    double operator[](ProfileStage stage) const { return stage_ms[static_cast<size_t>(stage)]; }
+};
+
+/**
+ * @class Profiler
+ * @brief Accumulates stage timings on the calling thread.
+ *
+ * Stages are exclusive: opening a Scope pauses the enclosing one, so
+ * Physics time (which runs inside SceneDB::UpdateScene) is not also
+ * counted under Scripts. Timings are thread_local like the world they
+ * measure; whoever drives the frame collects them with TakeFrame().
+ *
+ * The allocation counter replaces the global operator new in all its
+ * forms, aligned and nothrow included (see Profiler.cpp), and counts every
+ * allocation in the process.
+ *
+ * @code
+ * { Profiler::Scope scope(ProfileStage::Physics); world->Step(...); }
+ * FrameProfile frame;
+ * Profiler::TakeFrame(frame);   // adds this thread's stage times, resets them
+ * @endcode
+ */
+class Profiler {
+public:
+    class Scope {
+    public:
+        explicit Scope(ProfileStage stage);
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        ProfileStage previous;
+    };
+
+    /// Adds the calling thread's accumulated stage times and Lua call
+    /// count to `frame` and resets them.
+    static void TakeFrame(FrameProfile& frame);
+
+    /// Counts one engine call into Lua on the calling thread.
+    static void CountLuaCall() { ++lua_calls; }
+
+    /// Total operator new calls since process start.
+    static uint64_t GetAllocationCount();
+
+    /// Lower-case stage name used in reports ("input", "scripts", ...).
+    static const char* GetStageName(ProfileStage stage);
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    static void Switch(ProfileStage stage);
+
+    inline static thread_local std::array<double, static_cast<size_t>(ProfileStage::Count)> accumulated{};
+    /// Stage currently being timed; Count = none
+    inline static thread_local ProfileStage active = ProfileStage::Count;
+    inline static thread_local Clock::time_point mark;
+    inline static thread_local uint64_t lua_calls = 0;
+};
@@ -0,0 +1,332 @@
+//
+//  RenderCapture.cpp
+//  game_engine
+//
+//  Binary capture of recorded RenderFrames, for replaying a game's draw
+//  stream through the renderer without running its scripts.
+//
+
+#include "RenderCapture.hpp"
+#include "RenderCommandBuffer.hpp"
+#include "Logger.hpp"
+#include "EngineException.hpp"
+#include <cstring>
+
+namespace {
+    constexpr char FILE_MAGIC[4] = {'F', 'R', 'R', 'C'};
+    constexpr char FRAME_MAGIC[4] = {'F', 'R', 'A', 'M'};
+
+    template <typename T>
+    void Put(std::vector<char>& buffer, T value) {
+        const size_t at = buffer.size();
+        buffer.resize(at + sizeof(T));
+        std::memcpy(buffer.data() + at, &value, sizeof(T));
+    }
+
+    void PutColor(std::vector<char>& buffer, int r, int g, int b, int a) {
+        Put<uint8_t>(buffer, static_cast<uint8_t>(r));
+        Put<uint8_t>(buffer, static_cast<uint8_t>(g));
+        Put<uint8_t>(buffer, static_cast<uint8_t>(b));
+        Put<uint8_t>(buffer, static_cast<uint8_t>(a));
+    }
+
+    template <typename T>
+    T Get(std::ifstream& in, const std::string& path) {
+        T value;
+        if (!in.read(reinterpret_cast<char*>(&value), sizeof(T))) {
+            LOG_FATAL("Truncated render capture: " + path);
+            throw ConfigurationException("Truncated render capture: " + path);
+        }
+        return value;
+    }
+
+    /// Guards counts read from the file against absurd allocations.
+    uint32_t GetCount(std::ifstream& in, const std::string& path) {
+        const uint32_t count = Get<uint32_t>(in, path);
+        if (count > (1u << 24)) {
+            LOG_FATAL("Corrupt render capture: " + path);
+            throw ConfigurationException("Corrupt render capture: " + path);
+        }
+        return count;
+    }
+}
+
+void RenderCaptureWriter::Open(const std::string& path, glm::ivec2 resolution, glm::ivec3 clear_color) {
+    out.open(path, std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) {
+        LOG_FATAL("Cannot create render capture: " + path);
+        throw ConfigurationException("Cannot create render capture: " + path);
+    }
+
+    buffer.clear();
+    buffer.insert(buffer.end(), FILE_MAGIC, FILE_MAGIC + 4);
+    Put<uint32_t>(buffer, RenderCaptureFormat::VERSION);
+    Put<int32_t>(buffer, resolution.x);
+    Put<int32_t>(buffer, resolution.y);
+    Put<uint8_t>(buffer, static_cast<uint8_t>(clear_color.x));
+    Put<uint8_t>(buffer, static_cast<uint8_t>(clear_color.y));
+    Put<uint8_t>(buffer, static_cast<uint8_t>(clear_color.z));
+    out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+
+    string_ids.clear();
+    frame_count = 0;
+    LOG_INFO("Capturing render frames to " + path);
+}
+
+uint32_t RenderCaptureWriter::Intern(const std::string& text) {
+    auto [it, inserted] = string_ids.try_emplace(text, static_cast<uint32_t>(string_ids.size()));
+    if (inserted) new_strings.push_back(&it->first);
+    return it->second;
+}
+
+void RenderCaptureWriter::WriteFrame(const RenderFrame& frame) {
+    if (!out.is_open()) return;
+
+    // Records are built first so that strings they intern can be written
+    // ahead of them in the frame.
+    new_strings.clear();
+    buffer.clear();
+
+    const RenderCamera& camera = frame.camera;
+    Put<float>(buffer, camera.position.x);
+    Put<float>(buffer, camera.position.y);
+    Put<float>(buffer, camera.zoom);
+    Put<int32_t>(buffer, camera.dimensions.x);
+    Put<int32_t>(buffer, camera.dimensions.y);
+    Put<int32_t>(buffer, frame.fade_alpha);
+    Put<uint8_t>(buffer, frame.cursor_visible ? 1 : 0);
+
+    Put<uint32_t>(buffer, static_cast<uint32_t>(frame.images.size()));
+    for (const ImageDrawRequest& r : frame.images) {
+        Put<uint32_t>(buffer, Intern(r.image_name));
+        Put<float>(buffer, r.x);
+        Put<float>(buffer, r.y);
+        Put<int32_t>(buffer, r.rotation_degrees);
+        Put<float>(buffer, r.scale_x);
+        Put<float>(buffer, r.scale_y);
+        Put<float>(buffer, r.pivot_x);
+        Put<float>(buffer, r.pivot_y);
+        Put<int32_t>(buffer, r.source.x);
+        Put<int32_t>(buffer, r.source.y);
+        Put<int32_t>(buffer, r.source.w);
+        Put<int32_t>(buffer, r.source.h);
+        PutColor(buffer, r.r, r.g, r.b, r.a);
+        Put<int32_t>(buffer, r.sorting_order);
+        Put<uint8_t>(buffer, r.is_ui ? 1 : 0);
+    }
+
+    Put<uint32_t>(buffer, static_cast<uint32_t>(frame.particles.size()));
+    for (const ParticleDrawData& p : frame.particles) {
+        Put<uint32_t>(buffer, p.image_name.empty() ? RenderCaptureFormat::NO_STRING : Intern(p.image_name));
+        Put<float>(buffer, p.x);
+        Put<float>(buffer, p.y);
+        Put<float>(buffer, p.size);
+        PutColor(buffer, p.r, p.g, p.b, p.a);
+        Put<int32_t>(buffer, p.sorting_order);
+    }
+
+    Put<uint32_t>(buffer, static_cast<uint32_t>(frame.rects.size()));
+    for (const RectDrawRequest& r : frame.rects) {
+        Put<int32_t>(buffer, r.x);
+        Put<int32_t>(buffer, r.y);
+        Put<int32_t>(buffer, r.w);
+        Put<int32_t>(buffer, r.h);
+        PutColor(buffer, r.r, r.g, r.b, r.a);
+    }
+
+    Put<uint32_t>(buffer, static_cast<uint32_t>(frame.texts.size()));
+    for (const TextDrawRequest& t : frame.texts) {
+        Put<uint32_t>(buffer, Intern(t.content));
+        Put<int32_t>(buffer, t.x);
+        Put<int32_t>(buffer, t.y);
+        Put<uint32_t>(buffer, Intern(t.fontName));
+        Put<int32_t>(buffer, t.fontSize);
+        PutColor(buffer, t.color.r, t.color.g, t.color.b, t.color.a);
+    }
+
+    Put<uint32_t>(buffer, static_cast<uint32_t>(frame.pixels.size()));
+    for (const PixelDrawRequest& p : frame.pixels) {
+        Put<int32_t>(buffer, p.x);
+        Put<int32_t>(buffer, p.y);
+        PutColor(buffer, p.r, p.g, p.b, p.a);
+    }
+
+    Put<uint32_t>(buffer, static_cast<uint32_t>(frame.debug.size()));
+    for (const DebugPrimitive& d : frame.debug) {
+        Put<uint8_t>(buffer, static_cast<uint8_t>(d.kind));
+        Put<int32_t>(buffer, d.x1);
+        Put<int32_t>(buffer, d.y1);
+        Put<int32_t>(buffer, d.x2);
+        Put<int32_t>(buffer, d.y2);
+        PutColor(buffer, d.r, d.g, d.b, d.a);
+    }
+
+    out.write(FRAME_MAGIC, 4);
+    const uint32_t string_count = static_cast<uint32_t>(new_strings.size());
+    out.write(reinterpret_cast<const char*>(&string_count), sizeof(string_count));
+    for (const std::string* s : new_strings) {
+        const uint32_t length = static_cast<uint32_t>(s->size());
+        out.write(reinterpret_cast<const char*>(&length), sizeof(length));
+        out.write(s->data(), static_cast<std::streamsize>(length));
+    }
+    out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    ++frame_count;
+}
+
+void RenderCaptureReader::Open(const std::string& capture_path) {
+    path = capture_path;
+    in.open(path, std::ios::binary);
+    if (!in.is_open()) {
+        LOG_FATAL("Render capture missing: " + path);
+        throw ResourceNotFoundException("render capture", path);
+    }
+
+    char magic[4] = {};
+    in.read(magic, 4);
+    if (!in || std::memcmp(magic, FILE_MAGIC, 4) != 0
+        || Get<uint32_t>(in, path) != RenderCaptureFormat::VERSION) {
+        LOG_FATAL("Not a version " + std::to_string(RenderCaptureFormat::VERSION) + " render capture: " + path);
+        throw ConfigurationException("Not a version " + std::to_string(RenderCaptureFormat::VERSION)
+                                     + " render capture: " + path);
+    }
+
+    resolution.x = Get<int32_t>(in, path);
+    resolution.y = Get<int32_t>(in, path);
+    clear_color.x = Get<uint8_t>(in, path);
+    clear_color.y = Get<uint8_t>(in, path);
+    clear_color.z = Get<uint8_t>(in, path);
+    strings.clear();
+}
+
+const std::string& RenderCaptureReader::String(uint32_t id) const {
+    static const std::string none;
+    if (id == RenderCaptureFormat::NO_STRING) return none;
+    if (id >= strings.size()) {
+        LOG_FATAL("Corrupt render capture: " + path);
+        throw ConfigurationException("Corrupt render capture: " + path);
+    }
+    return strings[id];
+}
+
+bool RenderCaptureReader::ReadFrame(RenderFrame& frame) {
+    char magic[4];
+    if (!in.read(magic, 4)) return false;
+    if (std::memcmp(magic, FRAME_MAGIC, 4) != 0) {
+        LOG_FATAL("Corrupt render capture: " + path);
+        throw ConfigurationException("Corrupt render capture: " + path);
+    }
+
+    const uint32_t string_count = GetCount(in, path);
+    for (uint32_t i = 0; i < string_count; ++i) {
+        std::string text(GetCount(in, path), '\0');
+        if (!in.read(text.data(), static_cast<std::streamsize>(text.size()))) {
+            LOG_FATAL("Truncated render capture: " + path);
+            throw ConfigurationException("Truncated render capture: " + path);
+        }
+        strings.push_back(std::move(text));
+    }
+
+    frame.camera.position.x = Get<float>(in, path);
+    frame.camera.position.y = Get<float>(in, path);
+    frame.camera.zoom = Get<float>(in, path);
+    frame.camera.dimensions.x = Get<int32_t>(in, path);
+    frame.camera.dimensions.y = Get<int32_t>(in, path);
+    frame.fade_alpha = Get<int32_t>(in, path);
+    frame.cursor_visible = Get<uint8_t>(in, path) != 0;
+
+    frame.images.resize(GetCount(in, path));
+    for (size_t i = 0; i < frame.images.size(); ++i) {
+        ImageDrawRequest& r = frame.images[i];
+        r.image_name = String(Get<uint32_t>(in, path));
+        r.x = Get<float>(in, path);
+        r.y = Get<float>(in, path);
+        r.rotation_degrees = Get<int32_t>(in, path);
+        r.scale_x = Get<float>(in, path);
+        r.scale_y = Get<float>(in, path);
+        r.pivot_x = Get<float>(in, path);
+        r.pivot_y = Get<float>(in, path);
+        r.source.x = Get<int32_t>(in, path);
+        r.source.y = Get<int32_t>(in, path);
+        r.source.w = Get<int32_t>(in, path);
+        r.source.h = Get<int32_t>(in, path);
+        r.r = Get<uint8_t>(in, path);
+        r.g = Get<uint8_t>(in, path);
+        r.b = Get<uint8_t>(in, path);
+        r.a = Get<uint8_t>(in, path);
+        r.sorting_order = Get<int32_t>(in, path);
+        r.is_ui = Get<uint8_t>(in, path) != 0;
+        r.order_index = i;
+    }
+
+    frame.particles.resize(GetCount(in, path));
+    for (ParticleDrawData& p : frame.particles) {
+        p.image_name = String(Get<uint32_t>(in, path));
+        p.x = Get<float>(in, path);
+        p.y = Get<float>(in, path);
+        p.size = Get<float>(in, path);
+        p.r = Get<uint8_t>(in, path);
+        p.g = Get<uint8_t>(in, path);
+        p.b = Get<uint8_t>(in, path);
+        p.a = Get<uint8_t>(in, path);
+        p.sorting_order = Get<int32_t>(in, path);
+    }
+
+    frame.rects.resize(GetCount(in, path));
+    for (size_t i = 0; i < frame.rects.size(); ++i) {
+        RectDrawRequest& r = frame.rects[i];
+        r.x = Get<int32_t>(in, path);
+        r.y = Get<int32_t>(in, path);
+        r.w = Get<int32_t>(in, path);
+        r.h = Get<int32_t>(in, path);
+        r.r = Get<uint8_t>(in, path);
+        r.g = Get<uint8_t>(in, path);
+        r.b = Get<uint8_t>(in, path);
+        r.a = Get<uint8_t>(in, path);
+        r.order_index = i;
+    }
+
+    frame.texts.resize(GetCount(in, path));
+    for (TextDrawRequest& t : frame.texts) {
+        t.content = String(Get<uint32_t>(in, path));
+        t.x = Get<int32_t>(in, path);
+        t.y = Get<int32_t>(in, path);
+        t.fontName = String(Get<uint32_t>(in, path));
+        t.fontSize = Get<int32_t>(in, path);
+        t.color.r = Get<uint8_t>(in, path);
+        t.color.g = Get<uint8_t>(in, path);
+        t.color.b = Get<uint8_t>(in, path);
+        t.color.a = Get<uint8_t>(in, path);
+    }
+
+    frame.pixels.resize(GetCount(in, path));
+    for (size_t i = 0; i < frame.pixels.size(); ++i) {
+        PixelDrawRequest& p = frame.pixels[i];
+        p.x = Get<int32_t>(in, path);
+        p.y = Get<int32_t>(in, path);
+        p.r = Get<uint8_t>(in, path);
+        p.g = Get<uint8_t>(in, path);
+        p.b = Get<uint8_t>(in, path);
+        p.a = Get<uint8_t>(in, path);
+        p.order_index = i;
+    }
+
+    frame.debug.resize(GetCount(in, path));
+    for (DebugPrimitive& d : frame.debug) {
+        const uint8_t kind = Get<uint8_t>(in, path);
+        if (kind > static_cast<uint8_t>(DebugPrimitive::Kind::Square)) {
+            LOG_FATAL("Corrupt render capture: " + path);
+            throw ConfigurationException("Corrupt render capture: " + path);
+        }
+        d.kind = static_cast<DebugPrimitive::Kind>(kind);
+        d.x1 = Get<int32_t>(in, path);
+        d.y1 = Get<int32_t>(in, path);
+        d.x2 = Get<int32_t>(in, path);
+        d.y2 = Get<int32_t>(in, path);
+        d.r = Get<uint8_t>(in, path);
+        d.g = Get<uint8_t>(in, path);
+        d.b = Get<uint8_t>(in, path);
+        d.a = Get<uint8_t>(in, path);
+    }
+
+    return true;
+}
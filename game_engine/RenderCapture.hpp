@@ -0,0 +1,104 @@
+//
+//  RenderCapture.hpp
+//  game_engine
+//
+//  Binary capture of recorded RenderFrames, for replaying a game's draw
+//  stream through the renderer without running its scripts.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "glm/glm.hpp"
+
+struct RenderFrame;
+
+/**
+ * File layout (little-endian, no padding):
+ *
+ * @code
+ * header:  "FRRC" u32 version  i32 width  i32 height  u8 clear_r,g,b
+ * frame:   "FRAM" u32 new_string_count  { u32 length, bytes }...
+ *          f32 camera_x  f32 camera_y  f32 zoom  i32 camera_w  i32 camera_h
+ *          i32 fade_alpha  u8 cursor_visible
+ *          u32 count + records, for images, particles, rects, texts, pixels,
+ *          debug primitives (in that order)
+ * @endcode
+ *
+ * Image names, font names and text contents are interned: each string is
+ * written once, in the frame that first uses it, and referenced by index
+ * (0xFFFFFFFF = none) afterwards.
+ */
+namespace RenderCaptureFormat {
+    constexpr uint32_t VERSION = 2;
+    constexpr uint32_t NO_STRING = 0xFFFFFFFFu;
+}
+
+/**
+ * @class RenderCaptureWriter
+ * @brief Appends every executed RenderFrame to a capture file.
+ */
+class RenderCaptureWriter {
+public:
+    /**
+     * @brief Creates the capture file and writes its header.
+     * @throws ConfigurationException if the file cannot be created.
+     */
+    void Open(const std::string& path, glm::ivec2 resolution, glm::ivec3 clear_color);
+
+    bool IsOpen() const { return out.is_open(); }
+
+    /// Serializes one frame. Reuses its scratch buffer between frames.
+    void WriteFrame(const RenderFrame& frame);
+
+    int GetFrameCount() const { return frame_count; }
+
+    /// Flushes and closes the file; WriteFrame() is a no-op afterwards.
+    void Close() { if (out.is_open()) out.close(); }
+
+private:
+    uint32_t Intern(const std::string& text);
+
+    std::ofstream out;
+    std::unordered_map<std::string, uint32_t> string_ids;
+    std::vector<const std::string*> new_strings;
+    std::vector<char> buffer;
+    int frame_count = 0;
+};
+
+/**
+ * @class RenderCaptureReader
+ * @brief Reads a capture back one RenderFrame at a time.
+ */
+class RenderCaptureReader {
+public:
+    /**
+     * @brief Opens a capture and reads its header.
+     * @throws ResourceNotFoundException if the file cannot be opened.
+     * @throws ConfigurationException if it is not a capture of this version.
+     */
+    void Open(const std::string& path);
+
+    /**
+     * @brief Reads the next frame into `frame`, reusing its storage.
+     * @return false at end of file.
+     * @throws ConfigurationException if the frame is truncated or corrupt.
+     */
+    bool ReadFrame(RenderFrame& frame);
+
+    glm::ivec2 GetResolution() const { return resolution; }
+    glm::ivec3 GetClearColor() const { return clear_color; }
+
+private:
+    const std::string& String(uint32_t id) const;
+
+    std::ifstream in;
+    std::string path;
+    std::vector<std::string> strings;
+    glm::ivec2 resolution = {0, 0};
+    glm::ivec3 clear_color = {0, 0, 0};
+};
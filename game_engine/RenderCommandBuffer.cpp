@@ -0,0 +1,120 @@
+//
+//  RenderCommandBuffer.cpp
+//  game_engine
+//
+//  One frame's draw stream, recorded by the simulation and submitted to SDL
+//  by the render stage.
+//
+
+#include "RenderCommandBuffer.hpp"
+#include "Renderer.hpp"
+#include "Input.hpp"
+#include "SceneTransition.hpp"
+#include "Profiler.hpp"
+
+void RenderCommandBuffer::Record(RenderFrame& frame) {
+    Profiler::Scope scope(ProfileStage::Record);
+
+    frame.camera.position = Renderer::GetEffectiveCameraPosition();
+    frame.camera.zoom = Renderer::GetCameraZoomFactor();
+    frame.camera.dimensions = Renderer::GetCameraDimensions();
+
+    ImageDB::TakeQueues(frame.images, frame.rects, frame.pixels);
+    ParticleSystem::TakeDrawData(frame.particles);
+    TextDB::TakeQueue(frame.texts);
+    DebugDraw::Record(frame.debug);
+    PerfOverlay::Record(frame.perf);
+
+    frame.fade_alpha = SceneTransition::GetFadeAlpha();
+    frame.cursor_visible = Input::IsCursorVisible();
+}
+
+void RenderCommandBuffer::Execute(const RenderFrame& frame) {
+    ImageDB::RenderImages(frame.images, frame.camera);
+
+    // Particles are world-space, after images, before text/UI
+    RenderParticles(frame.particles, frame.camera);
+
+    // Rects draw before text so they work as HUD backdrops.
+    ImageDB::RenderRects(frame.rects);
+    TextDB::RenderTexts(frame.texts);
+    // Pixels draw on top of everything for debug overlays.
+    ImageDB::RenderPixels(frame.pixels);
+
+    DebugDraw::Execute(frame.debug);
+    RenderFade(frame.fade_alpha, frame.camera);
+
+    if (frame.cursor_visible != applied_cursor_visible) {
+        SDL_ShowCursor(frame.cursor_visible ? SDL_ENABLE : SDL_DISABLE);
+        applied_cursor_visible = frame.cursor_visible;
+    }
+}
+
+RenderStats RenderCommandBuffer::Measure(const RenderFrame& frame) {
+    RenderStats stats;
+    stats.draw_calls = static_cast<int>(frame.images.size() + frame.particles.size() + frame.rects.size()
+        + frame.texts.size() + frame.pixels.size() + frame.debug.size()) + (frame.fade_alpha > 0 ? 1 : 0);
+
+    for (size_t i = 0; i < frame.images.size(); ++i) {
+        if (i == 0 || frame.images[i].image_name != frame.images[i - 1].image_name
+            || frame.images[i].is_ui != frame.images[i - 1].is_ui) {
+            ++stats.batches;
+        }
+    }
+    for (size_t i = 0; i < frame.particles.size(); ++i) {
+        if (i == 0 || frame.particles[i].image_name != frame.particles[i - 1].image_name) {
+            ++stats.batches;
+        }
+    }
+    stats.batches += static_cast<int>(frame.texts.size());
+    stats.batches += (frame.rects.empty() ? 0 : 1) + (frame.pixels.empty() ? 0 : 1)
+        + (frame.debug.empty() ? 0 : 1) + (frame.fade_alpha > 0 ? 1 : 0);
+    return stats;
+}
+
+void RenderCommandBuffer::RenderParticles(const std::vector<ParticleDrawData>& particles,
+                                          const RenderCamera& camera) {
+    if (particles.empty()) {
+        return;
+    }
+
+    // Built on the first particle drawn; a cache hit afterwards.
+    ImageDB::CreateDefaultParticleTextureWithName("__default_particle");
+
+    SDL_Renderer* renderer = Renderer::getSDLRenderer();
+    const float zoom = camera.zoom;
+    SDL_RenderSetScale(renderer, zoom, zoom);
+
+    for (const auto& p : particles) {
+        SDL_Texture* tex = ImageDB::GetTexture(p.image_name.empty() ? "__default_particle" : p.image_name);
+        SDL_SetTextureColorMod(tex, p.r, p.g, p.b);
+        SDL_SetTextureAlphaMod(tex, p.a);
+
+        float screen_x = (p.x - camera.position.x) * 100.0f +
+            camera.dimensions.x * 0.5f * (1.0f / zoom) - p.size * 0.5f;
+        float screen_y = (p.y - camera.position.y) * 100.0f +
+            camera.dimensions.y * 0.5f * (1.0f / zoom) - p.size * 0.5f;
+
+        SDL_FRect rect = { screen_x, screen_y, p.size, p.size };
+        SDL_RenderCopyF(renderer, tex, NULL, &rect);
+
+        SDL_SetTextureColorMod(tex, 255, 255, 255);
+        SDL_SetTextureAlphaMod(tex, 255);
+    }
+    SDL_RenderSetScale(renderer, 1.0f, 1.0f);
+}
+
+void RenderCommandBuffer::RenderFade(int alpha, const RenderCamera& camera) {
+    if (alpha <= 0) {
+        return;
+    }
+
+    SDL_Renderer* renderer = Renderer::getSDLRenderer();
+    SDL_RenderSetScale(renderer, 1.0f, 1.0f);
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, static_cast<Uint8>(alpha));
+
+    SDL_Rect fullscreen = {0, 0, camera.dimensions.x, camera.dimensions.y};
+    SDL_RenderFillRect(renderer, &fullscreen);
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
+}
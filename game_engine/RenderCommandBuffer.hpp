@@ -0,0 +1,110 @@
+//
+//  RenderCommandBuffer.hpp
+//  game_engine
+//
+//  One frame's draw stream, recorded by the simulation and submitted to SDL
+//  by the render stage.
+//
+
+#pragma once
+
+#include <vector>
+#include "glm/glm.hpp"
+#include "ImageDB.hpp"
+#include "TextDB.hpp"
+#include "ParticleSystem.hpp"
+#include "DebugDraw.hpp"
+#include "PerfOverlay.hpp"
+
+/**
+ * @struct RenderCamera
+ * @brief Camera state captured with a frame.
+ *
+ * The camera belongs to the world (it is thread_local like the rest of the
+ * simulation), so the render stage never reads Renderer's camera getters.
+ */
+struct RenderCamera {
+    glm::vec2 position = {0.0f, 0.0f};      ///< Effective position (shake included)
+    float zoom = 1.0f;
+    glm::ivec2 dimensions = {0, 0};
+};
+
+/**
+ * @struct RenderFrame
+ * @brief Everything needed to draw one frame, with no references back into
+ *        the world that produced it.
+ *
+ * Frames are reused: the queues are swapped in rather than copied, so after
+ * the first few frames recording allocates nothing.
+ */
+struct RenderFrame {
+    RenderCamera camera;
+    std::vector<ImageDrawRequest> images;       ///< Sorted by (is_ui, sorting_order, order_index)
+    std::vector<ParticleDrawData> particles;
+    std::vector<RectDrawRequest> rects;
+    std::vector<TextDrawRequest> texts;
+    std::vector<PixelDrawRequest> pixels;
+    std::vector<DebugPrimitive> debug;
+    PerfCounters perf;                          ///< PerfOverlay counters; drawn by Engine::Render
+    int fade_alpha = 0;                         ///< SceneTransition overlay, 0 = none
+    bool cursor_visible = true;
+};
+
+/**
+ * @struct RenderStats
+ * @brief Submission cost of a frame, as counted by RenderCommandBuffer::Measure().
+ */
+struct RenderStats {
+    int draw_calls = 0;     ///< One per sprite, particle, rect, text line, pixel, debug shape, fade
+    int batches = 0;        ///< Runs of consecutive draws sharing a texture or draw state
+};
+
+/**
+ * @class RenderCommandBuffer
+ * @brief Splits rendering into a record step and an execute step.
+ *
+ * Record() runs on the thread that owns the world, right after
+ * EngineContext::Step(), and drains every draw queue (ImageDB, particles,
+ * TextDB, DebugDraw, SceneTransition, cursor) into a RenderFrame. Execute()
+ * runs on the thread that owns the SDL renderer and is the only place that
+ * issues SDL draw calls.
+ *
+ * Engine keeps two frames: while the render stage executes frame N, the
+ * simulation thread steps and records frame N+1 into the other one.
+ */
+class RenderCommandBuffer {
+public:
+    /**
+     * @brief Moves the calling world's draw queues into `frame`.
+     * @note Must run on the thread that owns the EngineContext.
+     */
+    static void Record(RenderFrame& frame);
+
+    /**
+     * @brief Submits a recorded frame to the SDL renderer.
+     *
+     * Order: images (world + UI), particles, rects, text, pixels, physics
+     * debug shapes, fade overlay. The caller clears and presents.
+     *
+     * @note Must run on the thread that created the SDL renderer.
+     */
+    static void Execute(const RenderFrame& frame);
+
+    /**
+     * @brief Counts the draw calls and state batches Execute() would issue
+     *        for `frame`, without touching SDL.
+     *
+     * A batch is a run of consecutive draws a batching backend could merge:
+     * images and particles sharing a texture (and UI/world space), all rects,
+     * all pixels, all debug shapes. Every text line is its own batch since
+     * it renders to a fresh texture.
+     */
+    static RenderStats Measure(const RenderFrame& frame);
+
+private:
+    static void RenderParticles(const std::vector<ParticleDrawData>& particles, const RenderCamera& camera);
+    static void RenderFade(int alpha, const RenderCamera& camera);
+
+    /// Cursor visibility last passed to SDL_ShowCursor
+    inline static bool applied_cursor_visible = true;
+};
@@ -11,10 +11,12 @@
 #include "EngineException.hpp"
 #include "Actor.hpp"
 #include "Rigidbody.hpp"
+#include "EngineUtils.hpp"
+#include "ConfigManager.hpp"
 #include <iostream>
 #include <cstdlib>
 
-Renderer::Renderer(const std::string& title, glm::ivec3& clearColor, const glm::ivec2& resolution)
+Renderer::Renderer(const std::string& title, glm::ivec3& clearColor, const glm::ivec2& resolution, bool vsync)
     : title(title), clearColor(clearColor), resolution(resolution) {
     window = Helper::SDL_CreateWindow(title.c_str(), 100, 100, resolution.x, resolution.y, SDL_WINDOW_SHOWN);
     if (!window) {
@@ -23,7 +25,9 @@ Renderer::Renderer(const std::string& title, glm::ivec3& clearColor, const glm::
         throw RenderException("Failed to create SDL window: " + error);
     }
 
-    renderer = Helper::SDL_CreateRenderer(window, -1, SDL_RENDERER_PRESENTVSYNC | SDL_RENDERER_ACCELERATED);
+    Uint32 flags = SDL_RENDERER_ACCELERATED;
+    if (vsync) flags |= SDL_RENDERER_PRESENTVSYNC;
+    renderer = Helper::SDL_CreateRenderer(window, -1, flags);
     if (!renderer) {
         std::string error = SDL_GetError();
         LOG_FATAL("Failed to create SDL renderer: " + error);
@@ -50,6 +54,19 @@ Renderer::~Renderer() {
     if (window) SDL_DestroyWindow(window);
 }
 
+void Renderer::ResetCamera() {
+    camera_pos = {0.0f, 0.0f};
+    zoom_factor = 1.0f;
+    camera_dimensions = ConfigManager::GetResolution();
+    follow_target = nullptr;
+    follow_lerp_speed = 5.0f;
+    shake_intensity = 0.0f;
+    shake_duration = 0.0f;
+    shake_elapsed = 0.0f;
+    shake_offset = {0.0f, 0.0f};
+    has_bounds = false;
+}
+
 void Renderer::Follow(Actor* target, float lerp_speed) {
     follow_target = target;
     follow_lerp_speed = lerp_speed;
@@ -110,8 +127,8 @@ void Renderer::UpdateCamera(float dt) {
         shake_elapsed += dt;
         float progress = shake_elapsed / shake_duration;
         float current_intensity = shake_intensity * (1.0f - progress);
-        shake_offset.x = (static_cast<float>(std::rand()) / RAND_MAX * 2.0f - 1.0f) * current_intensity;
-        shake_offset.y = (static_cast<float>(std::rand()) / RAND_MAX * 2.0f - 1.0f) * current_intensity;
+        shake_offset.x = (EngineUtils::RandomUnit(RandomStream::Camera) * 2.0f - 1.0f) * current_intensity;
+        shake_offset.y = (EngineUtils::RandomUnit(RandomStream::Camera) * 2.0f - 1.0f) * current_intensity;
     } else {
         shake_offset = {0.0f, 0.0f};
     }
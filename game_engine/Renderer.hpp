@@ -47,12 +47,12 @@ public:
      * @param title Window title displayed in the OS window chrome
      * @param clearColor RGB clear color used when clearing the screen (0-255 per channel)
      * @param resolution Window resolution in pixels (width, height)
+     * @param vsync Request SDL_RENDERER_PRESENTVSYNC; tools that measure
+     *              raw submission speed pass false
      *
      * @throws std::runtime_error if SDL2 initialization fails or window/renderer creation fails
-     *
-     * @note Automatically enables VSync via SDL_RENDERER_PRESENTVSYNC flag
      */
-    Renderer(const std::string &title, glm::ivec3 &clearColor, const glm::ivec2 &resolution);
+    Renderer(const std::string &title, glm::ivec3 &clearColor, const glm::ivec2 &resolution, bool vsync = true);
 
     /**
      * @brief Destructs the Renderer and cleans up SDL2 resources.
@@ -101,16 +101,22 @@ public:
     static float GetCameraZoomFactor() { return zoom_factor; }
 
     /**
-     * @brief Sets the camera zoom factor and updates SDL render scale.
+     * @brief Sets the camera zoom factor.
      *
      * @param zoom New zoom factor (e.g., 2.0 for 2x zoom, 0.5 for 50% zoom)
      *
-     * @note Zoom is applied via SDL_RenderSetScale() and affects all rendering
+     * @note Recorded with each frame; the render stage applies it via
+     *       SDL_RenderSetScale() to world-space draws
+     */
+    static void SetCameraZoomFactor(float zoom) { zoom_factor = zoom; }
+
+    /**
+     * @brief Restores the calling thread's camera to its defaults.
+     *
+     * Camera state is per engine context; each context starts from a
+     * centred, unzoomed camera sized to the configured resolution.
      */
-    static void SetCameraZoomFactor(float zoom) {
-        zoom_factor = zoom;
-        if (renderer) SDL_RenderSetScale(renderer, zoom, zoom);
-    }
+    static void ResetCamera();
 
     /**
      * @brief Sets the camera position in world space.
@@ -151,28 +157,28 @@ public:
     static glm::ivec2 GetCameraDimensions() { return camera_dimensions; }
 
     /// Current camera position in world space (affects all non-UI rendering)
-    inline static glm::vec2 camera_pos = {0.0f, 0.0f};
+    inline static thread_local glm::vec2 camera_pos = {0.0f, 0.0f};
 
     /// Current zoom factor (1.0 = normal scale, applied via SDL_RenderSetScale)
-    inline static float zoom_factor = 1.0f;
+    inline static thread_local float zoom_factor = 1.0f;
 
     /// Camera viewport dimensions in pixels (typically matches window resolution)
-    inline static glm::ivec2 camera_dimensions;
+    inline static thread_local glm::ivec2 camera_dimensions;
 
     // Camera follow
-    inline static Actor* follow_target = nullptr;
-    inline static float follow_lerp_speed = 5.0f;
+    inline static thread_local Actor* follow_target = nullptr;
+    inline static thread_local float follow_lerp_speed = 5.0f;
 
     // Screen shake
-    inline static float shake_intensity = 0.0f;
-    inline static float shake_duration = 0.0f;
-    inline static float shake_elapsed = 0.0f;
-    inline static glm::vec2 shake_offset = {0.0f, 0.0f};
+    inline static thread_local float shake_intensity = 0.0f;
+    inline static thread_local float shake_duration = 0.0f;
+    inline static thread_local float shake_elapsed = 0.0f;
+    inline static thread_local glm::vec2 shake_offset = {0.0f, 0.0f};
 
     // Camera bounds
-    inline static bool has_bounds = false;
-    inline static glm::vec2 bounds_min = {0.0f, 0.0f};
-    inline static glm::vec2 bounds_max = {0.0f, 0.0f};
+    inline static thread_local bool has_bounds = false;
+    inline static thread_local glm::vec2 bounds_min = {0.0f, 0.0f};
+    inline static thread_local glm::vec2 bounds_max = {0.0f, 0.0f};
 
     static void Follow(Actor* target, float lerp_speed);
     static void StopFollow();
@@ -8,6 +8,9 @@
 #include "Rigidbody.hpp"
 #include "RigidbodyWorld.hpp"
 #include "CollisionLayers.hpp"
+#include "TransformHierarchy.hpp"
+#include "Time.hpp"
+#include <algorithm>
 #include "glm/glm.hpp"
 
 
@@ -39,6 +42,9 @@ void Rigidbody::Init(Actor * owner) {
     bodyDef.angularDamping = angular_friction;
     
     bodyDef.angle = rotation * (b2_pi / 180.0f);
+
+    // Lets the contact listener find the component behind a fixture's body.
+    bodyDef.userData.pointer = reinterpret_cast<uintptr_t>(this);
     
     RigidbodyWorld::Init();
     
@@ -49,6 +55,11 @@ void Rigidbody::Init(Actor * owner) {
 }
 
 void Rigidbody::OnDestroy() {
+    TransformHierarchy::RemoveBody(this);
+    DestroyBody();
+}
+
+void Rigidbody::DestroyBody() {
     if (body) {
         RigidbodyWorld::GetWorld()->DestroyBody(body);
         body = nullptr;
@@ -66,6 +77,53 @@ void Rigidbody::RecreateFixtures(Actor* owner) {
     CreateFixtures(owner);
 }
 
+void Rigidbody::IgnoreCollisionsWith(Actor* other, float seconds) {
+    if (!other) return;
+    const float now = Time::GetTotalTime();
+    ignored.erase(std::remove_if(ignored.begin(), ignored.end(),
+                                 [&](const std::pair<uint64_t, float>& rule) {
+                                     return rule.first == other->id || rule.second <= now;
+                                 }),
+                  ignored.end());
+    if (seconds > 0.0f) ignored.emplace_back(other->id, now + seconds);
+    if (body) body->SetAwake(true);
+}
+
+bool Rigidbody::IsIgnoring(uint64_t actor_id, float now) {
+    bool ignoring = false;
+    bool expired = false;
+    for (const auto& [id, until] : ignored) {
+        if (until <= now) expired = true;
+        else if (id == actor_id) ignoring = true;
+    }
+    if (expired) {
+        ignored.erase(std::remove_if(ignored.begin(), ignored.end(),
+                                     [now](const std::pair<uint64_t, float>& rule) { return rule.second <= now; }),
+                      ignored.end());
+    }
+    return ignoring;
+}
+
+RigidbodyState Rigidbody::CaptureState() const {
+    RigidbodyState state;
+    state.position = body->GetPosition();
+    state.angle = body->GetAngle();
+    state.linear_velocity = body->GetLinearVelocity();
+    state.angular_velocity = body->GetAngularVelocity();
+    state.gravity_scale = body->GetGravityScale();
+    state.awake = body->IsAwake();
+    return state;
+}
+
+void Rigidbody::RestoreState(const RigidbodyState& state) {
+    if (!body) return;
+    body->SetTransform(state.position, state.angle);
+    body->SetLinearVelocity(state.linear_velocity);
+    body->SetAngularVelocity(state.angular_velocity);
+    body->SetGravityScale(state.gravity_scale);
+    body->SetAwake(state.awake);
+}
+
 void Rigidbody::CreateFixtures(Actor* owner) {
     if (has_collider) {
         b2FixtureDef colDef;
@@ -172,6 +230,11 @@ void Rigidbody::SetRotation(float degrees_clockwise) {
         body->SetTransform(body->GetPosition(), degrees_clockwise * (b2_pi / 180.0f));
 }
 
+void Rigidbody::SetPose(const b2Vec2& position, float degrees_clockwise) {
+    if (body)
+        body->SetTransform(position, degrees_clockwise * (b2_pi / 180.0f));
+}
+
 void Rigidbody::SetAngularVelocity(float degrees_clockwise) {
     if (body)
         body->SetAngularVelocity(degrees_clockwise * (b2_pi / 180.0f));
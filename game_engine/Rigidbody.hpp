@@ -11,9 +11,24 @@
 #pragma once
 
 #include <string>
+#include <utility>
+#include <vector>
 #include "box2d/box2d.h"
 #include "Actor.hpp"
 
+/**
+ * @struct RigidbodyState
+ * @brief Dynamic state of a live Box2D body, captured by scene snapshots.
+ */
+struct RigidbodyState {
+    b2Vec2 position;
+    float angle;                ///< radians, as stored by Box2D
+    b2Vec2 linear_velocity;
+    float angular_velocity;     ///< radians per second
+    float gravity_scale;
+    bool awake;
+};
+
 /**
  * @class Rigidbody
  * @brief Box2D physics wrapper for 2D rigid body dynamics and collision detection.
@@ -181,6 +196,13 @@ public:
      */
     void OnDestroy();
 
+    /**
+     * @brief Destroys the Box2D body but keeps the component's hierarchy
+     * links, so Transforms parented to it and followers survive until Init()
+     * creates the body again. Used by WorldStreaming to freeze an actor.
+     */
+    void DestroyBody();
+
     /**
      * @brief Recreates all fixtures with current dimension properties.
      *
@@ -190,6 +212,52 @@ public:
      */
     void RecreateFixtures(Actor* owner);
 
+    /// Whether Init() has created the Box2D body.
+    bool HasBody() const { return body != nullptr; }
+    b2Body* GetBody() const { return body; }
+
+    bool IsDynamic() const { return body_type == "dynamic"; }
+
+    /// Puts the body to sleep or wakes it; used to suspend off-screen actors.
+    void SetAwake(bool awake) { if (body) body->SetAwake(awake); }
+
+    /**
+     * @brief Teleports the body to a position and rotation in one step.
+     * Used to carry kinematic and static bodies along with a parented Transform.
+     */
+    void SetPose(const b2Vec2& position, float degrees_clockwise);
+
+    /**
+     * @brief Disables contacts between this body and another actor's bodies
+     * for a while, e.g. to drop through a one-way platform.
+     *
+     * @param other Actor to pass through
+     * @param seconds Duration; 0 or less lifts an existing rule
+     */
+    void IgnoreCollisionsWith(Actor* other, float seconds);
+
+    /// Whether contacts with `actor_id` are disabled at time `now`. Drops
+    /// expired rules, so HasIgnoreRules() turns false once they all ran out.
+    bool IsIgnoring(uint64_t actor_id, float now);
+    bool HasIgnoreRules() const { return !ignored.empty(); }
+
+    /// The Rigidbody that created `b2body`, or nullptr.
+    static Rigidbody* FromBody(b2Body* b2body) {
+        return reinterpret_cast<Rigidbody*>(b2body->GetUserData().pointer);
+    }
+
+    /**
+     * @brief Reads the body's position, velocities, gravity scale and
+     * sleep state. Requires HasBody().
+     */
+    RigidbodyState CaptureState() const;
+
+    /**
+     * @brief Writes state back onto the body, replacing any motion since
+     * it was captured. Does nothing without a body.
+     */
+    void RestoreState(const RigidbodyState& state);
+
     // Physics configuration properties (set before Init() or from Lua):
 
     float x = 0.0f;                             ///< Initial X position
@@ -218,9 +286,14 @@ public:
     bool precise = true;                        ///< Use continuous collision detection (prevents tunneling)
     bool has_collider = true;                   ///< Enable collision shape
     bool has_trigger = true;                    ///< Enable trigger/sensor shape
+    bool one_way = false;                       ///< Collider only stops bodies arriving from its up side
+    float surface_speed = 0.0f;                 ///< Conveyor speed along the body's right direction
 
 private:
     void CreateFixtures(Actor* owner);
     b2Body* body = nullptr;                     ///< Box2D body handle
+
+    /// (actor id, time the rule ends) set by IgnoreCollisionsWith.
+    std::vector<std::pair<uint64_t, float>> ignored;
 };
 
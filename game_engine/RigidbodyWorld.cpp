@@ -8,20 +8,33 @@
 #include "RigidbodyWorld.hpp"
 #include "Helper.h"
 #include "CollisionListener.hpp"
+#include "ConfigManager.hpp"
+#include "JobSystem.hpp"
 
 
 void RigidbodyWorld::Init() {
     if (!world) {
         world = std::make_unique<b2World>(gravity);
 
-        static CollisionListener listener;
+        static thread_local CollisionListener listener;
         world->SetContactListener(&listener);
+
+        // Results are identical to solving in place, so this only trades
+        // worker time for a shorter step.
+        if (ConfigManager::GetParallelPhysics())
+            world->SetParallelFor(&RunSolverTasks, JobSystem::GetThreadCount(), nullptr);
     }
 }
 
+void RigidbodyWorld::RunSolverTasks(int32 count, b2TaskFcn* task, void* task_context, void* /*user_context*/) {
+    JobSystem::ParallelFor(count, [task, task_context](int i) { task(i, task_context); });
+}
+
 void RigidbodyWorld::UpdateWorld() {
-    if (world)
-        world->Step(physics_timestep, velocity_iterations, position_iterations);
+    if (!world) return;
+    world->Step(physics_timestep, velocity_iterations, position_iterations);
+    // Outside the step, so Stay handlers see settled poses and may touch bodies.
+    CollisionListener::DeliverStay();
 }
 
 b2Body* RigidbodyWorld::AddRigidbody(const b2BodyDef& bodyDef) {
@@ -19,6 +19,9 @@ public:
 
     static b2World* GetWorld() { return world.get(); }
 
+    /// b2ParallelForFcn that runs Box2D's island tasks on the JobSystem.
+    static void RunSolverTasks(int32 count, b2TaskFcn* task, void* task_context, void* user_context);
+
     static void Shutdown();
 
     // Configurable physics settings
@@ -30,13 +33,13 @@ public:
     }
 
 private:
-    inline static b2Vec2 gravity = b2Vec2(0.0f, 9.8f);
+    inline static thread_local b2Vec2 gravity = b2Vec2(0.0f, 9.8f);
 
-    inline static std::unique_ptr<b2World> world = nullptr;
+    inline static thread_local std::unique_ptr<b2World> world = nullptr;
 
     // Configurable physics parameters
-    inline static float physics_timestep = 1.0f / 60.0f;
-    inline static int velocity_iterations = 8;
-    inline static int position_iterations = 3;
+    inline static thread_local float physics_timestep = 1.0f / 60.0f;
+    inline static thread_local int velocity_iterations = 8;
+    inline static thread_local int position_iterations = 3;
 };
 
@@ -11,11 +11,21 @@
 #include "Actor.hpp"
 #include "RigidbodyWorld.hpp"
 #include "Rigidbody.hpp"
+#include "Transform.hpp"
+#include "SpriteRenderer.hpp"
+#include "CharacterController2D.hpp"
+#include "TransformHierarchy.hpp"
+#include "WorldStreaming.hpp"
+#include "Renderer.hpp"
 #include "Logger.hpp"
 #include "EngineException.hpp"
+#include "LuaWorkerPool.hpp"
+#include "Time.hpp"
+#include "Profiler.hpp"
 #include <iostream>
 #include <filesystem>
 #include <algorithm>
+#include <cmath>
 #include <unordered_set>
 
 SceneDB::~SceneDB() { }
@@ -34,17 +44,29 @@ void SceneDB::CallOnDestroyForActor(Actor& actor) {
     for (const auto& key : keys) {
         auto it = actor.components.find(key);
         if (it == actor.components.end()) continue;
+        CallOnDestroy(actor, key, *it->second);
+    }
+}
 
-        auto& comp = it->second;
-        if ((*comp).isUserdata() && (*comp).isInstance<Rigidbody>()) {
-            (*comp).cast<Rigidbody*>()->OnDestroy();
-        } else if ((*comp)["OnDestroy"].isFunction()) {
-            try {
-                (*comp)["OnDestroy"](*comp);
-            }
-            catch (luabridge::LuaException& e) {
-                ReportError(actor.GetName(), e);
-            }
+void SceneDB::CallOnDestroy(Actor& actor, const std::string& key, luabridge::LuaRef& comp) {
+    if (comp.isUserdata() && comp.isInstance<Rigidbody>()) {
+        comp.cast<Rigidbody*>()->OnDestroy();
+    } else if (comp.isUserdata() && comp.isInstance<Transform>()) {
+        comp.cast<Transform*>()->OnDestroy();
+    } else if (comp.isUserdata() && comp.isInstance<SpriteRenderer>()) {
+        comp.cast<SpriteRenderer*>()->OnDestroy();
+    } else if (comp.isUserdata() && comp.isInstance<CharacterController2D>()) {
+        comp.cast<CharacterController2D*>()->OnDestroy();
+    } else if (LuaWorkerPool::IsStub(comp)) {
+        LuaWorkerPool::Detach(actor.GetID(), key);
+    } else if (comp["OnDestroy"].isFunction()) {
+        try {
+            RunningActorScope running(actor.GetID());
+            Profiler::CountLuaCall();
+            comp["OnDestroy"](comp);
+        }
+        catch (luabridge::LuaException& e) {
+            ReportError(actor.GetName(), e);
         }
     }
 }
@@ -63,6 +85,78 @@ void SceneDB::DontDestroy(Actor* actor) {
     }
 }
 
+void SceneDB::LoadAdditive(const std::string& scene_name) {
+    if (IsLoaded(scene_name)
+        || std::find(additive_to_load.begin(), additive_to_load.end(), scene_name) != additive_to_load.end()) {
+        LOG_WARNING("Scene.LoadAdditive: '" + scene_name + "' is already loaded");
+        return;
+    }
+    additive_to_load.push_back(scene_name);
+}
+
+void SceneDB::Unload(const std::string& scene_name) {
+    auto queued = std::find(additive_to_load.begin(), additive_to_load.end(), scene_name);
+    if (queued != additive_to_load.end()) {
+        additive_to_load.erase(queued);
+        return;
+    }
+    auto loaded = std::find(additive_scenes.begin(), additive_scenes.end(), scene_name);
+    if (loaded == additive_scenes.end()) {
+        if (scene_name == current_scene_name) LOG_WARNING("Scene.Unload: '" + scene_name + "' is the main scene; use Scene.Load to replace it");
+        else LOG_WARNING("Scene.Unload: '" + scene_name + "' is not loaded");
+        return;
+    }
+    additive_scenes.erase(loaded);
+
+    for (uint64_t id : actor_id_vec) {
+        Actor* actor = actors[id].get();
+        if (actor->scene == scene_name && !actor->destroyed) DestroyActor(actor);
+    }
+}
+
+bool SceneDB::IsLoaded(const std::string& scene_name) {
+    return scene_name == current_scene_name
+        || std::find(additive_scenes.begin(), additive_scenes.end(), scene_name) != additive_scenes.end();
+}
+
+bool SceneDB::IsResidentOwner(uint64_t actor_id) {
+    auto it = actors.find(actor_id);
+    return it != actors.end() && !it->second->destroyed && it->second->IsResident();
+}
+
+void SceneDB::ApplyPendingAdditive() {
+    if (additive_to_load.empty()) return;
+    std::vector<std::string> pending;
+    pending.swap(additive_to_load);
+
+    for (const std::string& scene_name : pending) {
+        SceneReader reader(scene_name);
+        additive_scenes.push_back(scene_name);
+
+        // Same as a main load, but the caches gain only the new components.
+        auto on_field = [&scene_name](const std::string& key, const rapidjson::Value&) {
+            if (key == "streaming") LOG_WARNING("Scene '" + scene_name + "' streams only as the main scene; loading all of it");
+        };
+        reader.Read(0, on_field, [&scene_name](const rapidjson::Value& entry) {
+            auto actor = std::make_unique<Actor>();
+            actor->scene = scene_name;
+            loadEntry(actor.get(), entry);
+
+            actor->id = id_ctr;
+            Actor* added = actor.get();
+            actors[id_ctr] = std::move(actor);
+            actor_id_vec.push_back(id_ctr);
+            id_ctr++;
+
+            for (const std::string& key : added->component_keys) {
+                addComponentToCaches(added->id, key, added->components[key]);
+            }
+        });
+        LOG_INFO("Loaded additive scene '" + scene_name + "' (" + std::to_string(reader.GetActorCount()) + " actors)");
+    }
+    onstart_new = true;
+}
+
 void SceneDB::loadScene() {
     std::string scene_to_load = ConfigManager::GetInitialScene();
     if (!next_scene_to_load.empty()) {
@@ -72,22 +166,21 @@ void SceneDB::loadScene() {
     
     current_scene_name = scene_to_load;
 
-    std::string full_path = ConfigManager::GetResourcesPath() + "scenes/" + scene_to_load + ".scene";
-
-    if (!std::filesystem::exists(full_path)) {
-        LOG_FATAL("Scene missing: " + scene_to_load);
-        throw ResourceNotFoundException("scene", scene_to_load);
-    }
+    // Opened before the teardown so a missing scene leaves the old one up.
+    // It replaces any scene still being read.
+    scene_reader = std::make_unique<SceneReader>(scene_to_load);
     
     std::vector<std::unique_ptr<Actor>> persistent_actors;
 
-    // Tear down non-persistent actors; preserve dont_destroy ones.
+    // Tear down the main scene's actors; preserve dont_destroy ones and
+    // additive scenes.
     for (auto it = actors.begin(); it != actors.end();) {
-        if (it->second->dont_destroy && !it->second->destroyed) {
+        if (it->second->IsResident() && !it->second->destroyed) {
             persistent_actors.push_back(std::move(it->second));
             it = actors.erase(it);
         } else {
             CallOnDestroyForActor(*it->second);
+            UntagActor(it->second.get());
             ++it;
         }
     }
@@ -101,43 +194,76 @@ void SceneDB::loadScene() {
         actors[id] = std::move(actor);
         actor_id_vec.push_back(id);
     }
-    
-    rapidjson::Document scene_doc;
-    EngineUtils::ReadJsonFile(full_path, scene_doc);
 
-    const rapidjson::Value &jsonActors = scene_doc["actors"];
-    
-    uint64_t numActors = jsonActors.Size();
-    actors.reserve(numActors + persistent_actors.size());
-    actor_id_vec.reserve(numActors + persistent_actors.size());
-    
-    for (rapidjson::SizeType i = 0; i < jsonActors.Size(); i++) {
-        const auto& actor_json = jsonActors[i];
-        auto actor = std::make_unique<Actor>();
-        if (actor_json.HasMember("name"))
-            actor->name = actor_json["name"].GetString();
-        
-        if (actor_json.HasMember("template")) {
-            std::string template_name = actor_json["template"].GetString();
-            loadTemplate(template_name, actor.get());
+    WorldStreaming::Clear();
+    readSceneEntries(ConfigManager::GetSceneActorsPerFrame(), true);
+
+    rebuildComponentCaches();
+
+    onstart_new = true;
+}
+
+void SceneDB::readSceneEntries(int budget, bool load_frame) {
+    SceneReader& reader = *scene_reader;
+    auto on_field = [&reader](const std::string& key, const rapidjson::Value& value) {
+        if (key != "streaming") return;
+        if (reader.GetActorCount() > 0) {
+            LOG_WARNING("Scene '" + reader.GetSceneName() + "' has \"streaming\" after \"actors\"; only later entries stream");
         }
-        
-        if (actor_json.HasMember("components")) {
-            ComponentDB::loadComponents(actor.get(), actor_json["components"]);
+        WorldStreaming::Configure(value);
+    };
+    auto on_actor = [load_frame](const rapidjson::Value& entry) {
+        // Streamed entries are left for WorldStreaming to load by cell.
+        if (WorldStreaming::Defer(entry)) return;
+        if (!load_frame) {
+            InstantiateEntry(entry);
+            return;
         }
-        
+        auto actor = std::make_unique<Actor>();
+        loadEntry(actor.get(), entry);
         actor->id = id_ctr;
-        this->actors[id_ctr] = std::move(actor);
-        this->actor_id_vec.push_back(id_ctr);
+        actors[id_ctr] = std::move(actor);
+        actor_id_vec.push_back(id_ctr);
         id_ctr++;
-    }
+    };
+    if (!reader.Read(budget, on_field, on_actor)) return;
 
-    rebuildComponentCaches();
+    WorldStreaming::Report(reader.GetActorCount());
+    LOG_DEBUG("Read scene '" + reader.GetSceneName() + "': " + std::to_string(reader.GetActorCount())
+              + " entries, largest " + std::to_string(reader.GetLargestEntry()) + " bytes");
+    scene_reader.reset();
+}
 
-    onstart_new = true;
+bool SceneDB::IsLoading() {
+    return scene_reader != nullptr;
 }
 
-void SceneDB::loadTemplate(const std::string &template_name, Actor * actor) {
+void SceneDB::CancelLoad() {
+    if (!scene_reader) return;
+    LOG_WARNING("Stopped loading scene '" + scene_reader->GetSceneName() + "' after "
+                + std::to_string(scene_reader->GetActorCount()) + " entries");
+    scene_reader.reset();
+}
+
+void SceneDB::loadEntry(Actor* actor, const rapidjson::Value& actor_json) {
+    if (actor_json.HasMember("name"))
+        actor->name = actor_json["name"].GetString();
+    
+    if (actor_json.HasMember("template")) {
+        std::string template_name = actor_json["template"].GetString();
+        loadTemplate(template_name, actor);
+    }
+    
+    if (actor_json.HasMember("components")) {
+        ComponentDB::loadComponents(actor, actor_json["components"]);
+    }
+
+    if (actor_json.HasMember("tags")) {
+        loadTags(actor, actor_json["tags"]);
+    }
+}
+
+const rapidjson::Document& SceneDB::GetTemplate(const std::string& template_name) {
     if (templateCache.find(template_name) == templateCache.end()) {
         std::string template_path = ConfigManager::GetResourcesPath() + "actor_templates/" + template_name + ".template";
         if (!std::filesystem::exists(template_path)) {
@@ -148,14 +274,132 @@ void SceneDB::loadTemplate(const std::string &template_name, Actor * actor) {
         templateCache[template_name] = rapidjson::Document();
         EngineUtils::ReadJsonFile(template_path, templateCache[template_name]);
     }
-    
-    const auto& template_doc = templateCache[template_name];
+    return templateCache[template_name];
+}
+
+void SceneDB::loadTemplate(const std::string &template_name, Actor * actor) {
+    const auto& template_doc = GetTemplate(template_name);
     
     if (template_doc.HasMember("name"))
         actor->name = template_doc["name"].GetString();
     
     if (template_doc.HasMember("components"))
         ComponentDB::loadComponents(actor, template_doc["components"]);
+
+    if (template_doc.HasMember("tags"))
+        loadTags(actor, template_doc["tags"]);
+}
+
+void SceneDB::loadTags(Actor* actor, const rapidjson::Value& tags) {
+    if (!tags.IsArray()) {
+        LOG_WARNING("\"tags\" on actor '" + actor->name + "' must be an array of strings");
+        return;
+    }
+    for (const auto& tag : tags.GetArray()) {
+        if (tag.IsString()) actor->AddTag(tag.GetString());
+        else LOG_WARNING("Skipping non-string tag on actor '" + actor->name + "'");
+    }
+}
+
+int SceneDB::InternTag(const std::string& tag) {
+    auto it = tag_bits.find(tag);
+    if (it != tag_bits.end()) return it->second;
+    if (tag_bits.size() >= static_cast<size_t>(Actor::MAX_TAGS)) {
+        LOG_ERROR("Too many distinct tags (max " + std::to_string(Actor::MAX_TAGS) + "); ignoring '" + tag + "'");
+        return -1;
+    }
+    const int bit = static_cast<int>(tag_bits.size());
+    tag_bits.emplace(tag, bit);
+    return bit;
+}
+
+int SceneDB::FindTagBit(const std::string& tag) {
+    auto it = tag_bits.find(tag);
+    return it != tag_bits.end() ? it->second : -1;
+}
+
+void SceneDB::AddTag(Actor* actor, int bit) {
+    const uint64_t flag = uint64_t(1) << bit;
+    if (actor->destroyed || (actor->tags & flag)) return;
+    actor->tags |= flag;
+    actor->tag_slots[bit] = static_cast<int>(tag_members[bit].size());
+    tag_members[bit].push_back(actor);
+}
+
+void SceneDB::RemoveTag(Actor* actor, int bit) {
+    const uint64_t flag = uint64_t(1) << bit;
+    if (!(actor->tags & flag)) return;
+    actor->tags &= ~flag;
+
+    // Swap-remove, fixing up the moved actor's slot.
+    std::vector<Actor*>& members = tag_members[bit];
+    const int slot = actor->tag_slots[bit];
+    Actor* last = members.back();
+    members[slot] = last;
+    last->tag_slots[bit] = slot;
+    members.pop_back();
+}
+
+void SceneDB::UntagActor(Actor* actor) {
+    for (int bit = 0; actor->tags != 0 && bit < Actor::MAX_TAGS; ++bit) {
+        RemoveTag(actor, bit);
+    }
+}
+
+bool SceneDB::ResolveTagMask(const luabridge::LuaRef& tags, uint64_t& mask) {
+    mask = 0;
+    if (tags.isString()) {
+        const int bit = FindTagBit(tags.cast<std::string>());
+        if (bit < 0) return false;
+        mask = uint64_t(1) << bit;
+        return true;
+    }
+    if (!tags.isTable()) return false;
+    for (int i = 1, n = tags.length(); i <= n; ++i) {
+        if (!tags[i].isString()) return false;
+        const int bit = FindTagBit(tags[i].cast<std::string>());
+        if (bit < 0) return false;
+        mask |= uint64_t(1) << bit;
+    }
+    return mask != 0;
+}
+
+const std::vector<Actor*>& SceneDB::ShortestTagList(uint64_t mask) {
+    const std::vector<Actor*>* shortest = nullptr;
+    for (int bit = 0; bit < Actor::MAX_TAGS; ++bit) {
+        if ((mask & (uint64_t(1) << bit)) && (!shortest || tag_members[bit].size() < shortest->size())) {
+            shortest = &tag_members[bit];
+        }
+    }
+    return *shortest;
+}
+
+luabridge::LuaRef SceneDB::FindByTags(luabridge::LuaRef tags) {
+    luabridge::LuaRef ret_table = luabridge::newTable(ComponentDB::GetLuaState());
+    uint64_t mask = 0;
+    if (!ResolveTagMask(tags, mask)) return ret_table;
+
+    const std::vector<Actor*>& members = ShortestTagList(mask);
+
+    int idx = 1;
+    for (Actor* actor : members) {
+        if ((actor->tags & mask) == mask) ret_table[idx++] = actor;
+    }
+    return ret_table;
+}
+
+int SceneDB::CountByTags(luabridge::LuaRef tags) {
+    uint64_t mask = 0;
+    if (!ResolveTagMask(tags, mask)) return 0;
+
+    const std::vector<Actor*>& members = ShortestTagList(mask);
+    if ((mask & (mask - 1)) == 0) return static_cast<int>(members.size());
+
+    int count = 0;
+    for (Actor* actor : members) {
+        if ((actor->tags & mask) == mask) ++count;
+    }
+    return count;
 }
 
 void SceneDB::UpdateScene() {
@@ -165,7 +409,7 @@ void SceneDB::UpdateScene() {
     }
 
     // Process Rigidbodies that need initialization
-    auto currentFrame = Helper::GetFrameNumber();
+    auto currentFrame = Time::GetFrameNumber();
     for (auto it = rigidbodies_to_init.begin(); it != rigidbodies_to_init.end();) {
         // Skip initialization if it was added this frame
         if (it->isNew && it->frameAdded == currentFrame) {
@@ -198,15 +442,30 @@ void SceneDB::UpdateScene() {
 
     ProcessSceneUpdate();
     ProcessSceneLateUpdate();
+    {
+        // Native sprites draw at the same point in the frame as scripts.
+        Profiler::Scope sprite_scope(ProfileStage::Systems);
+        SpriteRenderer::SubmitAll();
+    }
     RemoveActorComponents();
     ActorsPendingDestruction();
+    {
+        // Streamed actors and the rest of a scene still being read join
+        // with this frame's spawns.
+        Profiler::Scope streaming_scope(ProfileStage::Systems);
+        if (scene_reader) readSceneEntries(ConfigManager::GetSceneActorsPerFrame(), false);
+        WorldStreaming::Update();
+    }
 
     for (Actor* actor : actors_to_add) {
         actor_id_vec.push_back(actor->id);
     }
     actors_to_add.clear();
     
+    Profiler::Scope physics_scope(ProfileStage::Physics);
+    CharacterController2D::ApplyAll(Time::GetDeltaTime());
     RigidbodyWorld::UpdateWorld();
+    CharacterController2D::ProbeAll();
 }
 
 void SceneDB::ProcessSceneOnStart() {
@@ -226,9 +485,11 @@ void SceneDB::ProcessSceneOnStart() {
         luabridge::LuaRef comp = *compRef;
         if (!comp["enabled"] || comp["on_start"]) continue;
 
-        if (comp["frame_added"] == Helper::GetFrameNumber() && comp["new_addition"]) continue;
+        if (comp["frame_added"] == Time::GetFrameNumber() && comp["new_addition"]) continue;
 
         try {
+            RunningActorScope running(actor->id);
+            Profiler::CountLuaCall();
             comp["OnStart"](comp);
         }
         catch (luabridge::LuaException& e) {
@@ -238,30 +499,71 @@ void SceneDB::ProcessSceneOnStart() {
     }
 }
 
-void SceneDB::ProcessLifecycleCache(LifecycleCache& cache, const char* method_name) {
-    if (cache.empty()) return;
-
-    std::vector<ComponentKey> keys;
-    keys.reserve(cache.size());
-    for (const auto& [key, _] : cache) keys.push_back(key);
+void SceneDB::ProcessLifecycleCache(LifecycleCache& cache, const char* method_name, bool late) {
+    size_t due = 0;
+    for (int slot : due_slots) {
+        const ScheduledComponent& entry = scheduled[slot];
+        if (late ? entry.has_late_update : entry.has_update) ++due;
+    }
+    if (cache.empty() && due == 0) return;
+
+    // Snapshot the keys: callbacks may add or remove components. Assigning
+    // into the reused elements keeps their string buffers, so the list never
+    // shrinks: the number of due components changes from frame to frame.
+    // Due scheduled components are merged in so the order stays (actor id, key).
+    std::vector<ComponentKey>& keys = lifecycle_keys;
+    if (keys.size() < cache.size() + due) keys.resize(cache.size() + due);
+    size_t next = 0;
+    auto cache_key_it = cache.begin();
+    auto due_it = due_slots.begin();
+    while (cache_key_it != cache.end() || due_it != due_slots.end()) {
+        if (due_it != due_slots.end()) {
+            const ScheduledComponent& entry = scheduled[*due_it];
+            if (!(late ? entry.has_late_update : entry.has_update)) {
+                ++due_it;
+                continue;
+            }
+            if (cache_key_it == cache.end() || entry.key < cache_key_it->first) {
+                keys[next++] = entry.key;
+                ++due_it;
+                continue;
+            }
+        }
+        keys[next++] = cache_key_it->first;
+        ++cache_key_it;
+    }
 
-    const int current_frame = Helper::GetFrameNumber();
+    const int current_frame = Time::GetFrameNumber();
 
-    for (const auto& cacheKey : keys) {
+    for (size_t i = 0; i < next; ++i) {
+        const ComponentKey& cacheKey = keys[i];
+        std::shared_ptr<luabridge::LuaRef>* ref = nullptr;
+        ScheduledComponent* entry = nullptr;
         auto cache_it = cache.find(cacheKey);
-        if (cache_it == cache.end()) continue;
+        if (cache_it != cache.end()) {
+            ref = &cache_it->second;
+        }
+        else {
+            auto scheduled_it = scheduled_index.find(cacheKey);
+            if (scheduled_it == scheduled_index.end()) continue;
+            entry = &scheduled[scheduled_it->second];
+            ref = &entry->ref;
+        }
 
         auto actor_it = actors.find(cacheKey.actorId);
         if (actor_it == actors.end()) continue;
         const auto& actor = actor_it->second;
         if (actor->destroyed) continue;
 
-        luabridge::LuaRef comp = *(cache_it->second);
+        luabridge::LuaRef comp = **ref;
         if (comp.isUserdata()) continue;
         if (!comp["enabled"]) continue;
         if (comp["frame_added"] == current_frame && comp["new_addition"]) continue;
+        if (entry) comp["update_dt"] = entry->update_dt;
 
         try {
+            RunningActorScope running(actor->id);
+            Profiler::CountLuaCall();
             comp[method_name](comp);
         }
         catch (luabridge::LuaException& e) {
@@ -280,11 +582,14 @@ void SceneDB::ProcessLifecycleCache(LifecycleCache& cache, const char* method_na
 }
 
 void SceneDB::ProcessSceneUpdate() {
-    ProcessLifecycleCache(on_update_cache, "OnUpdate");
+    CollectDueComponents();
+    ProcessLifecycleCache(on_update_cache, "OnUpdate", false);
+    LuaWorkerPool::Update("OnUpdate");
 }
 
 void SceneDB::ProcessSceneLateUpdate() {
-    ProcessLifecycleCache(on_late_update_cache, "OnLateUpdate");
+    ProcessLifecycleCache(on_late_update_cache, "OnLateUpdate", true);
+    LuaWorkerPool::Update("OnLateUpdate");
 }
 
 
@@ -302,10 +607,13 @@ void SceneDB::RemoveActorComponents() {
         for (auto & key : remove_vec) {
             auto comp_it = comp.find(key);
             if (comp_it != comp.end()) {
-                // Call OnDestroy if it exists
+                // Call OnDestroy if it exists. Isolated stubs already ran the
+                // worker-side OnDestroy in removeComponentFromCaches.
                 auto& component = comp_it->second;
-                if ((*component)["OnDestroy"].isFunction()) {
+                if ((*component)["OnDestroy"].isFunction() && !LuaWorkerPool::IsStub(*component)) {
                     try {
+                        RunningActorScope running(actor->id);
+                        Profiler::CountLuaCall();
                         (*component)["OnDestroy"](*component);
                     }
                     catch (luabridge::LuaException& e) {
@@ -314,10 +622,17 @@ void SceneDB::RemoveActorComponents() {
                 } else if ((*component).isUserdata() && (*component).isInstance<Rigidbody>()) {
                     Rigidbody* rb = (*component).cast<Rigidbody*>();
                     rb->OnDestroy();
+                } else if ((*component).isUserdata() && (*component).isInstance<Transform>()) {
+                    (*component).cast<Transform*>()->OnDestroy();
+                } else if ((*component).isUserdata() && (*component).isInstance<SpriteRenderer>()) {
+                    (*component).cast<SpriteRenderer*>()->OnDestroy();
+                } else if ((*component).isUserdata() && (*component).isInstance<CharacterController2D>()) {
+                    (*component).cast<CharacterController2D*>()->OnDestroy();
                 }
             }
             
             comp_keys.erase(key);
+            ++actor->component_version;
             comp.erase(key);
         }
         remove_vec.clear();
@@ -336,17 +651,32 @@ void SceneDB::addComponentToCaches(uint64_t actorId, const std::string& key, std
         return;
     }
 
+    // Isolated component types live in a worker Lua state; the main-state
+    // table stays on the actor as a stub and is never cached here.
+    if (LuaWorkerPool::IsEnabled() && component["isolated"].isBool() && component["isolated"].cast<bool>()) {
+        auto actor_it = actors.find(actorId);
+        std::string actor_name = actor_it != actors.end() ? actor_it->second->GetName() : std::string();
+        LuaWorkerPool::Attach(actorId, actor_name, key, component);
+        return;
+    }
+
     if (!component["enabled"]) return;
 
     if (component["OnStart"].isFunction() && !component["on_start"]) {
         on_start_cache[cacheKey] = compRef;
     }
 
-    if (component["OnUpdate"].isFunction()) {
+    const bool has_update = component["OnUpdate"].isFunction();
+    const bool has_late_update = component["OnLateUpdate"].isFunction();
+    if ((has_update || has_late_update) && ScheduleComponent(cacheKey, compRef, has_update, has_late_update)) {
+        return;
+    }
+
+    if (has_update) {
         on_update_cache[cacheKey] = compRef;
     }
 
-    if (component["OnLateUpdate"].isFunction()) {
+    if (has_late_update) {
         on_late_update_cache[cacheKey] = compRef;
     }
 }
@@ -356,12 +686,186 @@ void SceneDB::removeComponentFromCaches(uint64_t actorId, const std::string& key
     on_start_cache.erase(cacheKey);
     on_update_cache.erase(cacheKey);
     on_late_update_cache.erase(cacheKey);
+    UnscheduleComponent(cacheKey);
+    LuaWorkerPool::Detach(actorId, key);
+}
+
+bool SceneDB::ScheduleComponent(const ComponentKey& key, const std::shared_ptr<luabridge::LuaRef>& ref,
+                                bool has_update, bool has_late_update) {
+    const luabridge::LuaRef& component = *ref;
+    const luabridge::LuaRef interval_field = component["update_interval"];
+    const luabridge::LuaRef margin_field = component["suspend_offscreen"];
+    const int interval = interval_field.isNumber() ? std::max(1, interval_field.cast<int>()) : 1;
+    const float margin = margin_field.isNumber() ? margin_field.cast<float>() : -1.0f;
+    if (interval <= 1 && margin < 0.0f) return false;
+
+    UnscheduleComponent(key);
+
+    int slot;
+    if (!scheduled_free.empty()) {
+        slot = scheduled_free.back();
+        scheduled_free.pop_back();
+    }
+    else {
+        slot = static_cast<int>(scheduled.size());
+        scheduled.emplace_back();
+        // At most every slot is due in a frame.
+        due_slots.reserve(scheduled.capacity());
+    }
+
+    ScheduledComponent& entry = scheduled[slot];
+    entry = ScheduledComponent();
+    entry.key = key;
+    entry.ref = ref;
+    entry.has_update = has_update;
+    entry.has_late_update = has_late_update;
+    entry.interval = interval;
+    entry.offscreen_margin = margin;
+    entry.sleep_body = component["suspend_sleep"].isBool() && component["suspend_sleep"].cast<bool>();
+    entry.last_run = Time::GetTotalTime();
+
+    // Round-robin phase, so components sharing an interval take turns.
+    const int frame = Time::GetFrameNumber();
+    const int first = schedule_collected_frame == frame ? frame + 1 : frame;
+    entry.next_frame = first + static_cast<int>(schedule_stagger++ % static_cast<uint32_t>(interval));
+    FileScheduled(slot);
+
+    scheduled_index[key] = slot;
+    return true;
+}
+
+void SceneDB::UnscheduleComponent(const ComponentKey& key) {
+    auto it = scheduled_index.find(key);
+    if (it == scheduled_index.end()) return;
+    const int slot = it->second;
+    scheduled_index.erase(it);
+
+    ScheduledComponent& entry = scheduled[slot];
+    if (entry.suspended && entry.sleep_body && entry.body) entry.body->SetAwake(true);
+    entry.ref.reset();
+    entry.body = nullptr;
+    entry.transform = nullptr;
+    UnfileScheduled(slot);
+    scheduled_free.push_back(slot);
+
+    auto due_it = std::find(due_slots.begin(), due_slots.end(), slot);
+    if (due_it != due_slots.end()) due_slots.erase(due_it);
+}
+
+void SceneDB::FileScheduled(int slot) {
+    ScheduledComponent& entry = scheduled[slot];
+    int& head = schedule_wheel[entry.next_frame % SCHEDULE_WHEEL_SIZE];
+    entry.wheel_prev = -1;
+    entry.wheel_next = head;
+    if (head >= 0) scheduled[head].wheel_prev = slot;
+    head = slot;
+}
+
+void SceneDB::UnfileScheduled(int slot) {
+    ScheduledComponent& entry = scheduled[slot];
+    if (entry.wheel_prev >= 0) scheduled[entry.wheel_prev].wheel_next = entry.wheel_next;
+    else if (schedule_wheel[entry.next_frame % SCHEDULE_WHEEL_SIZE] == slot) {
+        schedule_wheel[entry.next_frame % SCHEDULE_WHEEL_SIZE] = entry.wheel_next;
+    }
+    if (entry.wheel_next >= 0) scheduled[entry.wheel_next].wheel_prev = entry.wheel_prev;
+    entry.wheel_prev = -1;
+    entry.wheel_next = -1;
+}
+
+void SceneDB::ClearSchedule() {
+    // Releases the Lua references; the slots stay for reuse.
+    for (ScheduledComponent& entry : scheduled) {
+        entry.ref.reset();
+        entry.body = nullptr;
+        entry.transform = nullptr;
+        entry.wheel_prev = -1;
+        entry.wheel_next = -1;
+    }
+    scheduled_free.clear();
+    for (int slot = static_cast<int>(scheduled.size()) - 1; slot >= 0; --slot) scheduled_free.push_back(slot);
+    scheduled_index.clear();
+    schedule_wheel.fill(-1);
+    due_slots.clear();
+    schedule_stagger = 0;
+    schedule_collected_frame = -1;
+}
+
+bool SceneDB::UpdateSuspension(ScheduledComponent& entry) {
+    if (entry.offscreen_margin < 0.0f) return false;
+
+    if (!entry.resolved) {
+        auto actor_it = actors.find(entry.key.actorId);
+        if (actor_it == actors.end()) return false;
+        const Actor& actor = *actor_it->second;
+        for (const std::string& key : actor.component_keys) {
+            auto it = actor.components.find(key);
+            if (it == actor.components.end() || !it->second->isUserdata()) continue;
+            const luabridge::LuaRef& comp = *it->second;
+            if (!entry.body && comp.isInstance<Rigidbody>()) entry.body = comp.cast<Rigidbody*>();
+            else if (!entry.transform && comp.isInstance<Transform>()) entry.transform = comp.cast<Transform*>();
+        }
+        entry.resolved = true;
+    }
+
+    b2Vec2 position;
+    if (entry.body) position = entry.body->GetPosition();
+    else if (entry.transform) position = entry.transform->GetWorldPosition();
+    else return false;
+
+    // Half the view in world units (100 pixels per unit at zoom 1).
+    const glm::vec2 camera = Renderer::GetCameraPosition();
+    const glm::ivec2 dimensions = Renderer::GetCameraDimensions();
+    const float zoom = std::max(Renderer::GetCameraZoomFactor(), 0.0001f);
+    const float half_w = dimensions.x * 0.5f / (100.0f * zoom) + entry.offscreen_margin;
+    const float half_h = dimensions.y * 0.5f / (100.0f * zoom) + entry.offscreen_margin;
+    const bool outside = std::fabs(position.x - camera.x) > half_w || std::fabs(position.y - camera.y) > half_h;
+
+    if (entry.sleep_body && entry.body) {
+        // Re-applied while suspended: a contact can wake the body.
+        if (outside) entry.body->SetAwake(false);
+        else if (entry.suspended) entry.body->SetAwake(true);
+    }
+    entry.suspended = outside;
+    return outside;
+}
+
+void SceneDB::CollectDueComponents() {
+    due_slots.clear();
+    const int frame = Time::GetFrameNumber();
+    schedule_collected_frame = frame;
+    if (scheduled_index.empty()) return;
+
+    // Detached first: an entry due again in SCHEDULE_WHEEL_SIZE frames is
+    // re-filed into the same bucket.
+    int& head = schedule_wheel[frame % SCHEDULE_WHEEL_SIZE];
+    int slot = head;
+    head = -1;
+
+    const float now = Time::GetTotalTime();
+    while (slot >= 0) {
+        ScheduledComponent& entry = scheduled[slot];
+        const int next = entry.wheel_next;
+        if (entry.next_frame <= frame) {
+            entry.next_frame = frame + entry.interval;
+            if (!UpdateSuspension(entry)) {
+                entry.update_dt = now - entry.last_run;
+                entry.last_run = now;
+                due_slots.push_back(slot);
+            }
+        }
+        FileScheduled(slot);
+        slot = next;
+    }
+
+    std::sort(due_slots.begin(), due_slots.end(),
+              [](int a, int b) { return scheduled[a].key < scheduled[b].key; });
 }
 
 void SceneDB::rebuildComponentCaches() {
     on_start_cache.clear();
     on_update_cache.clear();
     on_late_update_cache.clear();
+    ClearSchedule();
 
     for (const auto& [actorId, actor] : actors) {
         if (actor->destroyed) continue;
@@ -383,31 +887,47 @@ Actor* SceneDB::InstantiateActor(const std::string& temp) {
     loadTemplate(temp, actor);
     actor->id = newId;
 
+    RegisterInstantiated(actor);
+    return actor;
+}
+
+Actor* SceneDB::InstantiateEntry(const rapidjson::Value& actor_json) {
+    uint64_t newId = id_ctr++;
+    actors[newId] = std::make_unique<Actor>();
+    Actor* actor = actors[newId].get();
+
+    loadEntry(actor, actor_json);
+    actor->id = newId;
+
+    RegisterInstantiated(actor);
+    return actor;
+}
+
+void SceneDB::RegisterInstantiated(Actor* actor) {
     for (auto& key : actor->component_keys) {
         auto& comp = actor->components[key];
         
         if ((*comp).isTable()) {
-            (*comp)["frame_added"] = Helper::GetFrameNumber();
+            (*comp)["frame_added"] = Time::GetFrameNumber();
             (*comp)["new_addition"] = true;
         } else if ((*comp).isUserdata() && (*comp).isInstance<Rigidbody>()) {
             rigidbodies_to_init.push_back({
                 actor->id,
                 key,
                 true,
-                Helper::GetFrameNumber()
+                Time::GetFrameNumber()
             });
         }
 
-        addComponentToCaches(newId, key, comp);
+        addComponentToCaches(actor->id, key, comp);
     }
 
     actors_to_add.push_back(actor);
     onstart_new = true;
-
-    return actor;
 }
 
 void SceneDB::DestroyActor(Actor* actor) {
+    UntagActor(actor);
     actor->destroyed = true;
     actors_to_destroy.push_back(actor->GetID());
 
@@ -509,10 +1029,16 @@ void SceneDB::clearLuaRefs() {
     on_start_cache.clear();
     on_update_cache.clear();
     on_late_update_cache.clear();
+    ClearSchedule();
     rigidbodies_to_init.clear();
     actors_to_destroy.clear();
     actors_to_add.clear();
     actors.clear();
     actor_id_vec.clear();
     templateCache.clear();
+    additive_scenes.clear();
+    additive_to_load.clear();
+    scene_reader.reset();
+    tag_bits.clear();
+    for (auto& members : tag_members) members.clear();
 }
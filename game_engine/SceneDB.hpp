@@ -24,11 +24,16 @@
 #include "LuaBridge/LuaBridge.h"
 #include "Helper.h"
 #include "ComponentDB.hpp"
+#include "SceneReader.hpp"
 
+class Rigidbody;
+class Transform;
 
 class SceneDB {
 public:
     SceneDB() {
+        // Ids restart with every world so a rerun numbers actors the same.
+        id_ctr = 0;
         actor_id_vec.reserve(1000);
         actors_to_destroy.reserve(100);
         actors_to_add.reserve(100);
@@ -65,31 +70,148 @@ public:
     static luabridge::LuaRef FindAllActor(const std::string & name);
     
     static Actor * InstantiateActor(const std::string & temp);
+
+    /// Creates an actor from a scene file entry mid-game, like InstantiateActor.
+    static Actor * InstantiateEntry(const rapidjson::Value & actor_json);
+
+    /// A template's document, read and cached on first use.
+    static const rapidjson::Document & GetTemplate(const std::string & template_name);
     
     static void DestroyActor(Actor * actor);
     
-    inline static std::unordered_map<uint64_t, std::unique_ptr<Actor>> actors;
-    inline static std::vector<uint64_t> actor_id_vec;
+    inline static thread_local std::unordered_map<uint64_t, std::unique_ptr<Actor>> actors;
+    inline static thread_local std::vector<uint64_t> actor_id_vec;
     
-    inline static std::vector<uint64_t> actors_to_destroy;
-    inline static std::vector<Actor*> actors_to_add;
+    inline static thread_local std::vector<uint64_t> actors_to_destroy;
+    inline static thread_local std::vector<Actor*> actors_to_add;
     
-    inline static std::string current_scene_name;
-    inline static std::string next_scene_to_load;
+    inline static thread_local std::string current_scene_name;
+    inline static thread_local std::string next_scene_to_load;
+
+    /// Live actors carrying every tag in `tags` (a name or an array of names).
+    static luabridge::LuaRef FindByTags(luabridge::LuaRef tags);
+
+    /// Number of live actors carrying every tag in `tags`.
+    static int CountByTags(luabridge::LuaRef tags);
+
+    /// Bit for a tag name, interning it on first use; -1 once all
+    /// Actor::MAX_TAGS bits are taken.
+    static int InternTag(const std::string& tag);
+
+    /// Bit for a tag name, or -1 if it was never interned.
+    static int FindTagBit(const std::string& tag);
+
+    static void AddTag(Actor* actor, int bit);
+    static void RemoveTag(Actor* actor, int bit);
+
+    /**
+     * @brief Resolves a tag name or array of names to a bit mask.
+     * @return false if a name was never interned (nothing can match).
+     */
+    static bool ResolveTagMask(const luabridge::LuaRef& tags, uint64_t& mask);
 
     static void Load(const std::string& scene_name);
     static std::string GetCurrent();
     static void DontDestroy(Actor* actor);
+
+    /**
+     * @brief Queues a scene to load next to the current one at the start of
+     * the next frame. Its actors stay through Scene.Load until Unload(name).
+     */
+    static void LoadAdditive(const std::string& scene_name);
+
+    /// Destroys every actor of an additive scene (deferred, like Actor.Destroy).
+    static void Unload(const std::string& scene_name);
+
+    /// Whether a scene is the main scene or a loaded additive one.
+    static bool IsLoaded(const std::string& scene_name);
+
+    /// Whether the main scene is still being read (`scene_actors_per_frame`).
+    static bool IsLoading();
+
+    /// Abandons the rest of a main scene still being read.
+    static void CancelLoad();
+
+    /// Loads the queued additive scenes. Called by EngineContext after any main load.
+    static void ApplyPendingAdditive();
+
+    /// Owner id for code that no actor's component is running.
+    static constexpr uint64_t NO_ACTOR = ~0ull;
+
+    /// Actor whose component code is running (lifecycle, collision, timer,
+    /// tween or event callback), or NO_ACTOR. Timers, tweens and event
+    /// subscriptions are owned by the actor that made them.
+    static uint64_t GetRunningActor() { return running_actor; }
+
+    /// Makes `actor_id` the running actor until the scope ends.
+    class RunningActorScope {
+    public:
+        explicit RunningActorScope(uint64_t actor_id) : previous(running_actor) { running_actor = actor_id; }
+        ~RunningActorScope() { running_actor = previous; }
+        RunningActorScope(const RunningActorScope&) = delete;
+        RunningActorScope& operator=(const RunningActorScope&) = delete;
+    private:
+        uint64_t previous;
+    };
+
+    /// Whether an owner survives Scene.Load: a live DontDestroy or additive actor.
+    static bool IsResidentOwner(uint64_t actor_id);
+
+    /// Additive scenes in load order.
+    inline static thread_local std::vector<std::string> additive_scenes;
+    inline static thread_local std::vector<std::string> additive_to_load;
     
-    inline static std::unordered_map<std::string, rapidjson::Document> templateCache;
+    inline static thread_local std::unordered_map<std::string, rapidjson::Document> templateCache;
 
-    inline static std::map<ComponentKey, std::shared_ptr<luabridge::LuaRef>> on_start_cache;
-    inline static std::map<ComponentKey, std::shared_ptr<luabridge::LuaRef>> on_update_cache;
-    inline static std::map<ComponentKey, std::shared_ptr<luabridge::LuaRef>> on_late_update_cache;
+    inline static thread_local std::map<ComponentKey, std::shared_ptr<luabridge::LuaRef>> on_start_cache;
+    inline static thread_local std::map<ComponentKey, std::shared_ptr<luabridge::LuaRef>> on_update_cache;
+    inline static thread_local std::map<ComponentKey, std::shared_ptr<luabridge::LuaRef>> on_late_update_cache;
     
-    inline static std::vector<RigidbodyInitInfo> rigidbodies_to_init;
+    inline static thread_local std::vector<RigidbodyInitInfo> rigidbodies_to_init;
 
-    inline static bool onstart_new = false;
+    /**
+     * @brief A component with an update policy, dispatched only when due.
+     *
+     * Components whose table sets `update_interval` (frames, > 1) or
+     * `suspend_offscreen` (world units beyond the camera view) when they
+     * are registered live here instead of the every-frame caches. Each is
+     * filed in a timing wheel under the frame it is next due; intervals
+     * are staggered round-robin so components sharing an interval spread
+     * over its frames. A due component whose actor (Rigidbody or Transform
+     * position) is further off screen than its margin is skipped, and with
+     * `suspend_sleep = true` its Rigidbody is put to sleep until it is back
+     * in range. Before each OnUpdate/OnLateUpdate the engine sets the
+     * component's `update_dt` to the seconds since it last ran.
+     */
+    struct ScheduledComponent {
+        ComponentKey key;
+        std::shared_ptr<luabridge::LuaRef> ref;     ///< nullptr for a free slot
+        bool has_update = false;
+        bool has_late_update = false;
+        int interval = 1;
+        float offscreen_margin = -1.0f;             ///< < 0: never suspended
+        bool sleep_body = false;
+        int next_frame = 0;
+        float last_run = 0.0f;
+        float update_dt = 0.0f;
+        int wheel_prev = -1;                        ///< neighbours in its wheel bucket
+        int wheel_next = -1;
+        bool suspended = false;
+        bool resolved = false;
+        Rigidbody* body = nullptr;
+        Transform* transform = nullptr;
+    };
+
+    /// Frames in the update timing wheel; longer intervals go round again.
+    static constexpr int SCHEDULE_WHEEL_SIZE = 64;
+
+    /// Interned tag names and, per bit, the actors carrying it. Destroyed
+    /// actors leave their lists in DestroyActor, so the lists only hold
+    /// live actors.
+    inline static thread_local std::unordered_map<std::string, int> tag_bits;
+    inline static thread_local std::array<std::vector<Actor*>, Actor::MAX_TAGS> tag_members;
+
+    inline static thread_local bool onstart_new = false;
 
 
     static void ReportError(const std::string& actor_name, const luabridge::LuaException& e);
@@ -98,10 +220,49 @@ public:
     static void rebuildComponentCaches();
 
 private:
-    inline static uint64_t id_ctr = 0;
+    inline static thread_local uint64_t id_ctr = 0;
+    inline static thread_local uint64_t running_actor = NO_ACTOR;
 
     using LifecycleCache = std::map<ComponentKey, std::shared_ptr<luabridge::LuaRef>>;
 
+    /// Scratch key list for ProcessLifecycleCache, reused so steady-state
+    /// frames do not allocate.
+    inline static thread_local std::vector<ComponentKey> lifecycle_keys;
+
+    /// Components with an update policy, by slot; freed slots are reused.
+    inline static thread_local std::vector<ScheduledComponent> scheduled;
+    inline static thread_local std::vector<int> scheduled_free;
+    inline static thread_local std::map<ComponentKey, int> scheduled_index;
+    /// First slot filed under next_frame % SCHEDULE_WHEEL_SIZE, or -1. Each
+    /// bucket is a list threaded through the slots' wheel_prev/wheel_next,
+    /// so the wheel costs two ints per component whatever the phases.
+    inline static thread_local std::array<int, SCHEDULE_WHEEL_SIZE> schedule_wheel = [] {
+        std::array<int, SCHEDULE_WHEEL_SIZE> heads;
+        heads.fill(-1);
+        return heads;
+    }();
+    /// Slots due this frame, in key order.
+    inline static thread_local std::vector<int> due_slots;
+    inline static thread_local uint32_t schedule_stagger = 0;
+    inline static thread_local int schedule_collected_frame = -1;
+
+    /// Files a component under its update policy; false if it has none.
+    static bool ScheduleComponent(const ComponentKey& key, const std::shared_ptr<luabridge::LuaRef>& ref,
+                                  bool has_update, bool has_late_update);
+    static void UnscheduleComponent(const ComponentKey& key);
+
+    /// Links a slot into the bucket of its next_frame / out of its bucket.
+    static void FileScheduled(int slot);
+    static void UnfileScheduled(int slot);
+    static void ClearSchedule();
+
+    /// Pops this frame's wheel bucket into due_slots, re-filing each entry.
+    static void CollectDueComponents();
+
+    /// Whether a scheduled component's actor is out of range; sleeps or
+    /// wakes its body on a change.
+    static bool UpdateSuspension(ScheduledComponent& entry);
+
     void ProcessSceneOnStart();
     void ProcessSceneUpdate();
     void ProcessSceneLateUpdate();
@@ -111,9 +272,42 @@ private:
     /// Runs a lifecycle method (OnUpdate/OnLateUpdate) across a cache,
     /// skipping disabled/destroyed components and disabling any that
     /// throw 3+ times.
-    static void ProcessLifecycleCache(LifecycleCache& cache, const char* method_name);
+    /// Due scheduled components are merged in key order.
+    static void ProcessLifecycleCache(LifecycleCache& cache, const char* method_name, bool late);
 
-    /// Calls OnDestroy on every component of an actor (Rigidbody handled
-    /// specially), in sorted key order.
+    /// Applies a "tags" array from a template or scene entry.
+    static void loadTags(Actor* actor, const rapidjson::Value& tags);
+
+    /// Applies a scene entry's name, template, components and tags.
+    static void loadEntry(Actor* actor, const rapidjson::Value& actor_json);
+
+    /// Main scene still being read, `scene_actors_per_frame` entries a frame.
+    inline static thread_local std::unique_ptr<SceneReader> scene_reader;
+
+    /**
+     * @brief Builds the main scene's next `budget` entries (0 = the rest).
+     * In the load frame actors go straight into the scene; later ones are
+     * instantiated like spawns. Drops the reader once the file is read.
+     */
+    static void readSceneEntries(int budget, bool load_frame);
+
+    /// Queues a just-built actor's components for init and the caches, and
+    /// adds it to the scene at the end of the frame.
+    static void RegisterInstantiated(Actor* actor);
+
+    /// Member list of the rarest tag in a non-empty mask; candidates for
+    /// a multi-tag query.
+    static const std::vector<Actor*>& ShortestTagList(uint64_t mask);
+
+    /// Removes an actor from every tag list it is in.
+    static void UntagActor(Actor* actor);
+
+    /// Calls OnDestroy on every component of an actor (Rigidbody and
+    /// Transform handled specially), in sorted key order.
     static void CallOnDestroyForActor(Actor& actor);
+
+    /// Calls OnDestroy on one component; isolated stubs are detached.
+    static void CallOnDestroy(Actor& actor, const std::string& key, luabridge::LuaRef& comp);
+
+    friend class SceneSnapshot;
 };
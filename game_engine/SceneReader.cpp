@@ -0,0 +1,206 @@
+//
+//  SceneReader.cpp
+//  game_engine
+//
+//  Reads a scene file one actor entry at a time.
+//
+
+#include "SceneReader.hpp"
+#include "ConfigManager.hpp"
+#include "EngineException.hpp"
+#include "Logger.hpp"
+#include <filesystem>
+
+SceneReader::SceneReader(const std::string& scene_name)
+    : scene_name(scene_name),
+      path(ConfigManager::GetResourcesPath() + "scenes/" + scene_name + ".scene"),
+      file(nullptr, &std::fclose),
+      buffer(65536) {
+    if (!std::filesystem::exists(path)) {
+        LOG_FATAL("Scene missing: " + scene_name);
+        throw ResourceNotFoundException("scene", scene_name);
+    }
+#ifdef _WIN32
+    FILE* file_pointer = nullptr;
+    fopen_s(&file_pointer, path.c_str(), "rb");
+#else
+    FILE* file_pointer = fopen(path.c_str(), "rb");
+#endif
+    if (file_pointer == nullptr) {
+        LOG_FATAL("Failed to open file: " + path);
+        throw ConfigurationException("Cannot open file: " + path);
+    }
+    file.reset(file_pointer);
+}
+
+int SceneReader::Peek() {
+    if (buffer_pos == buffer_len) {
+        buffer_len = file ? std::fread(buffer.data(), 1, buffer.size(), file.get()) : 0;
+        buffer_pos = 0;
+        if (buffer_len == 0) return EOF;
+    }
+    return static_cast<unsigned char>(buffer[buffer_pos]);
+}
+
+int SceneReader::Get() {
+    const int c = Peek();
+    if (c != EOF) {
+        ++buffer_pos;
+        ++offset;
+    }
+    return c;
+}
+
+void SceneReader::SkipSpace() {
+    for (int c = Peek(); c == ' ' || c == '\t' || c == '\n' || c == '\r'; c = Peek()) Get();
+}
+
+void SceneReader::Expect(char expected) {
+    SkipSpace();
+    if (Get() != expected) Fail(std::string("expected '") + expected + "'");
+}
+
+void SceneReader::ReadString(std::string& out) {
+    // Raw text between the quotes; keys the loader looks at have no escapes.
+    out.clear();
+    Expect('"');
+    for (int c = Get(); c != '"'; c = Get()) {
+        if (c == EOF) Fail("unterminated string");
+        out.push_back(static_cast<char>(c));
+        if (c == '\\') {
+            const int escaped = Get();
+            if (escaped == EOF) Fail("unterminated string");
+            out.push_back(static_cast<char>(escaped));
+        }
+    }
+}
+
+void SceneReader::CaptureValue() {
+    text.clear();
+    SkipSpace();
+    int depth = 0;
+    bool in_string = false;
+    for (;;) {
+        const int c = Peek();
+        if (c == EOF) Fail("unexpected end of file");
+        if (!in_string && depth == 0 && !text.empty()
+            && (c == ',' || c == '}' || c == ']' || c == ' ' || c == '\t' || c == '\n' || c == '\r')) {
+            break;
+        }
+        Get();
+        text.push_back(static_cast<char>(c));
+
+        if (in_string) {
+            if (c == '\\') {
+                const int escaped = Get();
+                if (escaped == EOF) Fail("unterminated string");
+                text.push_back(static_cast<char>(escaped));
+            }
+            else if (c == '"') {
+                in_string = false;
+                if (depth == 0) break;
+            }
+        }
+        else if (c == '"') {
+            in_string = true;
+        }
+        else if (c == '{' || c == '[') {
+            ++depth;
+        }
+        else if (c == '}' || c == ']') {
+            if (--depth < 0) Fail("unbalanced brackets");
+            if (depth == 0) break;
+        }
+    }
+    if (text.size() > largest_entry) largest_entry = text.size();
+}
+
+void SceneReader::ParseCaptured(rapidjson::Document& doc) {
+    doc.Parse(text.c_str(), text.size());
+    if (doc.HasParseError()) Fail("invalid JSON value");
+}
+
+bool SceneReader::Read(int max_actors, const FieldCallback& on_field, const ActorCallback& on_actor) {
+    int read = 0;
+    for (;;) {
+        switch (state) {
+        case State::Start:
+            Expect('{');
+            SkipSpace();
+            if (Peek() == '}') {
+                Get();
+                state = State::Done;
+            }
+            else {
+                state = State::Key;
+            }
+            break;
+
+        case State::Key:
+            ReadString(key);
+            Expect(':');
+            if (key == "actors") {
+                Expect('[');
+                SkipSpace();
+                if (Peek() == ']') {
+                    Get();
+                    state = State::AfterValue;
+                }
+                else {
+                    state = State::Actor;
+                }
+            }
+            else {
+                CaptureValue();
+                rapidjson::Document value;
+                ParseCaptured(value);
+                on_field(key, value);
+                state = State::AfterValue;
+            }
+            break;
+
+        case State::Actor: {
+            if (max_actors > 0 && read >= max_actors) return false;
+            CaptureValue();
+            // A fresh document per entry, so memory never grows past the
+            // largest one.
+            rapidjson::Document entry;
+            ParseCaptured(entry);
+            if (!entry.IsObject()) Fail("actor entries must be objects");
+            ++actor_count;
+            ++read;
+            on_actor(entry);
+            state = State::AfterActor;
+            break;
+        }
+
+        case State::AfterActor: {
+            SkipSpace();
+            const int c = Get();
+            if (c == ',') state = State::Actor;
+            else if (c == ']') state = State::AfterValue;
+            else Fail("expected ',' or ']' after an actor");
+            break;
+        }
+
+        case State::AfterValue: {
+            SkipSpace();
+            const int c = Get();
+            if (c == ',') state = State::Key;
+            else if (c == '}') state = State::Done;
+            else Fail("expected ',' or '}'");
+            break;
+        }
+
+        case State::Done:
+            file.reset();
+            return true;
+        }
+    }
+}
+
+void SceneReader::Fail(const std::string& what) {
+    const std::string message = "JSON parse error in file: " + path + " at byte " + std::to_string(offset) + ": " + what;
+    LOG_FATAL(message);
+    throw ConfigurationException(message);
+}
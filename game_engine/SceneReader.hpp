@@ -0,0 +1,77 @@
+//
+//  SceneReader.hpp
+//  game_engine
+//
+//  Reads a scene file one actor entry at a time.
+//
+
+#pragma once
+
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+#include "rapidjson/document.h"
+
+/**
+ * @class SceneReader
+ * @brief Pull reader for `.scene` files that never holds the whole document.
+ *
+ * The file is read through a 64 KB buffer. A small scanner walks the root
+ * object. Each element of `"actors"` is cut out as text, parsed into its own
+ * rapidjson document and handed to the actor callback before the next one is
+ * read. Other root members go to the field callback the same way. Memory stays
+ * at the buffer plus the largest single entry, whatever the scene's size.
+ *
+ * Read() stops after a given number of actors and picks up there on the next
+ * call, so a large scene can be built over several frames. Malformed files
+ * throw ConfigurationException with the byte offset.
+ */
+class SceneReader {
+public:
+    using FieldCallback = std::function<void(const std::string& key, const rapidjson::Value& value)>;
+    using ActorCallback = std::function<void(const rapidjson::Value& entry)>;
+
+    /// Opens `scenes/<scene_name>.scene`; throws ResourceNotFoundException if it is missing.
+    explicit SceneReader(const std::string& scene_name);
+
+    /**
+     * @brief Reads on until `max_actors` entries have been handed out
+     * (0 = no limit) or the file ends.
+     * @return true once the whole file has been read.
+     */
+    bool Read(int max_actors, const FieldCallback& on_field, const ActorCallback& on_actor);
+
+    const std::string& GetSceneName() const { return scene_name; }
+    size_t GetActorCount() const { return actor_count; }
+    /// Longest entry text so far, in bytes.
+    size_t GetLargestEntry() const { return largest_entry; }
+
+private:
+    enum class State { Start, Key, Actor, AfterActor, AfterValue, Done };
+
+    int Peek();
+    int Get();
+    void SkipSpace();
+    void Expect(char expected);
+    void ReadString(std::string& out);
+    /// Copies the next JSON value's text into `text`.
+    void CaptureValue();
+    void ParseCaptured(rapidjson::Document& doc);
+    [[noreturn]] void Fail(const std::string& what);
+
+    std::string scene_name;
+    std::string path;
+    std::unique_ptr<FILE, int (*)(FILE*)> file;
+    std::vector<char> buffer;
+    size_t buffer_pos = 0;
+    size_t buffer_len = 0;
+    size_t offset = 0;
+
+    State state = State::Start;
+    std::string key;
+    std::string text;
+    size_t actor_count = 0;
+    size_t largest_entry = 0;
+};
@@ -0,0 +1,532 @@
+//
+//  SceneSnapshot.cpp
+//  game_engine
+//
+//  In-memory checkpoints of the live scene, restored in place.
+//
+
+#include "SceneSnapshot.hpp"
+#include "SceneDB.hpp"
+#include "Actor.hpp"
+#include "Transform.hpp"
+#include "SpriteRenderer.hpp"
+#include "CharacterController2D.hpp"
+#include "ComponentDB.hpp"
+#include "Logger.hpp"
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <sstream>
+#include <unordered_set>
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    double MsSince(Clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    }
+
+    /// Copies Lua values reachable from component tables into a snapshot.
+    class Capturer {
+    public:
+        Capturer(lua_State* L, SceneSnapshotData& data,
+                 const std::unordered_set<const void*>& components,
+                 const std::unordered_map<const Actor*, uint64_t>& live_actors)
+            : L(L), data(data), components(components), live_actors(live_actors) {}
+
+        /// Own fields of the component table at `index`; the table itself
+        /// is rewritten in place on restore, so its metatable is not kept.
+        int CaptureFields(int index) {
+            const int t = NewTable(LUA_NOREF);
+            CopyEntries(lua_absindex(L, index), t);
+            return t;
+        }
+
+    private:
+        SnapshotValue Capture(int index) {
+            index = lua_absindex(L, index);
+            SnapshotValue v{};
+            v.kind = SnapshotValue::Kind::Nil;
+            switch (lua_type(L, index)) {
+            case LUA_TNIL:
+                break;
+            case LUA_TBOOLEAN:
+                v.kind = SnapshotValue::Kind::Boolean;
+                v.boolean = lua_toboolean(L, index) != 0;
+                break;
+            case LUA_TNUMBER:
+                if (lua_isinteger(L, index)) {
+                    v.kind = SnapshotValue::Kind::Integer;
+                    v.integer = lua_tointeger(L, index);
+                } else {
+                    v.kind = SnapshotValue::Kind::Number;
+                    v.number = lua_tonumber(L, index);
+                }
+                break;
+            case LUA_TTABLE: {
+                const void* p = lua_topointer(L, index);
+                if (components.count(p)) {
+                    v.kind = SnapshotValue::Kind::Ref;
+                    v.ref = Ref(index);
+                    break;
+                }
+                auto it = seen.find(p);
+                v.kind = SnapshotValue::Kind::Table;
+                v.table = it != seen.end() ? it->second : CopyTable(index);
+                break;
+            }
+            case LUA_TUSERDATA:
+                if (luabridge::Stack<Actor>::isInstance(L, index)) {
+                    // Stored by id so a destroyed-and-restored actor (new
+                    // address) is still found. Stale pointers become nil.
+                    auto it = live_actors.find(luabridge::Stack<Actor*>::get(L, index));
+                    if (it != live_actors.end()) {
+                        v.kind = SnapshotValue::Kind::Actor;
+                        v.actor_id = it->second;
+                    }
+                    break;
+                }
+                v.kind = SnapshotValue::Kind::Ref;
+                v.ref = Ref(index);
+                break;
+            default:
+                // Strings, functions, threads, light userdata.
+                v.kind = SnapshotValue::Kind::Ref;
+                v.ref = Ref(index);
+                break;
+            }
+            return v;
+        }
+
+        int CopyTable(int index) {
+            int metatable = LUA_NOREF;
+            if (lua_getmetatable(L, index)) {
+                metatable = Ref(-1);
+                lua_pop(L, 1);
+            }
+            const int t = NewTable(metatable);
+            seen.emplace(lua_topointer(L, index), t);
+            CopyEntries(index, t);
+            return t;
+        }
+
+        int NewTable(int metatable) {
+            const int t = static_cast<int>(data.tables.size());
+            data.tables.emplace_back();
+            data.tables[t].metatable_ref = metatable;
+            return t;
+        }
+
+        void CopyEntries(int index, int t) {
+            luaL_checkstack(L, 4, "scene snapshot: table nesting too deep");
+            lua_pushnil(L);
+            while (lua_next(L, index)) {
+                const SnapshotValue key = Capture(-2);
+                const SnapshotValue value = Capture(-1);
+                lua_pop(L, 1);
+                // Index again: Capture may have grown data.tables.
+                data.tables[t].entries.emplace_back(key, value);
+            }
+        }
+
+        int Ref(int index) {
+            lua_pushvalue(L, index);
+            const int ref = luaL_ref(L, LUA_REGISTRYINDEX);
+            data.refs.push_back(ref);
+            return ref;
+        }
+
+        lua_State* L;
+        SceneSnapshotData& data;
+        const std::unordered_set<const void*>& components;
+        const std::unordered_map<const Actor*, uint64_t>& live_actors;
+        std::unordered_map<const void*, int> seen;
+    };
+
+    /// Rebuilds Lua values from a snapshot. Copied tables are created once
+    /// per restore, so shared and cyclic structure survives.
+    class Materializer {
+    public:
+        Materializer(lua_State* L, const SceneSnapshotData& data) : L(L), data(data) {
+            lua_createtable(L, static_cast<int>(data.tables.size()), 0);
+            cache = lua_gettop(L);
+        }
+
+        /// Replaces the own fields of the table at `index` with a saved copy.
+        void Rewrite(int index, int fields) {
+            index = lua_absindex(L, index);
+            lua_pushnil(L);
+            while (lua_next(L, index)) {
+                lua_pop(L, 1);
+                lua_pushvalue(L, -1);
+                lua_pushnil(L);
+                lua_rawset(L, index);
+            }
+            Fill(index, data.tables[fields]);
+        }
+
+    private:
+        void Push(const SnapshotValue& v) {
+            switch (v.kind) {
+            case SnapshotValue::Kind::Nil:
+                lua_pushnil(L);
+                break;
+            case SnapshotValue::Kind::Boolean:
+                lua_pushboolean(L, v.boolean);
+                break;
+            case SnapshotValue::Kind::Integer:
+                lua_pushinteger(L, v.integer);
+                break;
+            case SnapshotValue::Kind::Number:
+                lua_pushnumber(L, v.number);
+                break;
+            case SnapshotValue::Kind::Ref:
+                lua_rawgeti(L, LUA_REGISTRYINDEX, v.ref);
+                break;
+            case SnapshotValue::Kind::Actor: {
+                auto it = SceneDB::actors.find(v.actor_id);
+                if (it != SceneDB::actors.end() && !it->second->destroyed) {
+                    luabridge::Stack<Actor*>::push(L, it->second.get());
+                } else {
+                    lua_pushnil(L);
+                }
+                break;
+            }
+            case SnapshotValue::Kind::Table:
+                if (lua_rawgeti(L, cache, v.table + 1) != LUA_TNIL) break;
+                lua_pop(L, 1);
+                lua_createtable(L, 0, static_cast<int>(data.tables[v.table].entries.size()));
+                lua_pushvalue(L, -1);
+                lua_rawseti(L, cache, v.table + 1);
+                Fill(lua_gettop(L), data.tables[v.table]);
+                if (data.tables[v.table].metatable_ref != LUA_NOREF) {
+                    lua_rawgeti(L, LUA_REGISTRYINDEX, data.tables[v.table].metatable_ref);
+                    lua_setmetatable(L, -2);
+                }
+                break;
+            }
+        }
+
+        void Fill(int index, const SnapshotTable& table) {
+            luaL_checkstack(L, 4, "scene snapshot: table nesting too deep");
+            for (const auto& [key, value] : table.entries) {
+                Push(key);
+                if (lua_isnil(L, -1)) {     // key was an actor that is gone
+                    lua_pop(L, 1);
+                    continue;
+                }
+                Push(value);
+                lua_rawset(L, index);
+            }
+        }
+
+        lua_State* L;
+        const SceneSnapshotData& data;
+        int cache = 0;
+    };
+
+    size_t EstimateBytes(const SceneSnapshotData& data) {
+        size_t bytes = sizeof(SceneSnapshotData) + data.scene.capacity()
+            + data.actors.capacity() * sizeof(SnapshotActor)
+            + data.tables.capacity() * sizeof(SnapshotTable)
+            + data.refs.capacity() * sizeof(int)
+            + data.tasks.capacity() * sizeof(ScheduledTask)
+            + data.tweens.capacity() * sizeof(TweenInstance);
+        for (const SnapshotActor& actor : data.actors) {
+            bytes += actor.name.capacity() + actor.components.capacity() * sizeof(SnapshotComponent);
+            for (const SnapshotComponent& comp : actor.components) bytes += comp.key.capacity();
+        }
+        for (const SnapshotTable& table : data.tables) {
+            bytes += table.entries.capacity() * sizeof(table.entries[0]);
+        }
+        return bytes;
+    }
+}
+
+int SceneSnapshot::Snapshot() {
+    const auto start = Clock::now();
+    lua_State* L = ComponentDB::GetLuaState();
+    const int top = lua_gettop(L);
+
+    const int handle = next_handle++;
+    SceneSnapshotData& data = snapshots[handle];
+    data.scene = SceneDB::current_scene_name;
+    data.components = 0;
+    data.restore_ms = 0.0;
+
+    // Component tables are kept by identity, never copied into another
+    // component's fields.
+    std::unordered_set<const void*> component_tables;
+    std::unordered_map<const Actor*, uint64_t> live_actors;
+    for (const auto& [id, actor] : SceneDB::actors) {
+        live_actors.emplace(actor.get(), id);
+        for (const auto& [key, comp] : actor->components) {
+            if (!comp->isTable()) continue;
+            comp->push(L);
+            component_tables.insert(lua_topointer(L, -1));
+            lua_pop(L, 1);
+        }
+    }
+
+    Capturer capturer(L, data, component_tables, live_actors);
+    auto capture_actor = [&](Actor* actor) {
+        if (actor->IsResident() || actor->destroyed) return;
+
+        SnapshotActor& saved = data.actors.emplace_back();
+        saved.id = actor->id;
+        saved.name = actor->name;
+        saved.tags = actor->tags;
+        saved.components.reserve(actor->component_keys.size());
+
+        for (const std::string& key : actor->component_keys) {
+            auto it = actor->components.find(key);
+            if (it == actor->components.end()) continue;
+
+            SnapshotComponent& comp = saved.components.emplace_back();
+            comp.key = key;
+            comp.ref = it->second;
+            comp.fields = -1;
+            comp.has_body = false;
+
+            luabridge::LuaRef& ref = *it->second;
+            if (ref.isUserdata() && ref.isInstance<Rigidbody>()) {
+                const Rigidbody* rb = ref.cast<Rigidbody*>();
+                comp.has_body = rb->HasBody();
+                if (comp.has_body) comp.body = rb->CaptureState();
+            } else if (ref.isUserdata() && ref.isInstance<Transform>()) {
+                const Transform* t = ref.cast<Transform*>();
+                comp.transform[0] = t->x;
+                comp.transform[1] = t->y;
+                comp.transform[2] = t->rotation;
+                comp.transform[3] = t->scale_x;
+                comp.transform[4] = t->scale_y;
+            } else if (ref.isUserdata() && ref.isInstance<CharacterController2D>()) {
+                comp.enabled = ref.cast<CharacterController2D*>()->enabled;
+            } else if (ref.isTable()) {
+                ref.push(L);
+                comp.fields = capturer.CaptureFields(-1);
+                lua_pop(L, 1);
+            }
+            ++data.components;
+        }
+    };
+
+    for (uint64_t id : SceneDB::actor_id_vec) {
+        auto it = SceneDB::actors.find(id);
+        if (it != SceneDB::actors.end()) capture_actor(it->second.get());
+    }
+    for (Actor* actor : SceneDB::actors_to_add) capture_actor(actor);
+
+    data.tasks = Scheduler::GetTasks();
+    data.tweens = Tween::GetTweens();
+    data.streaming = WorldStreaming::CaptureState();
+    lua_settop(L, top);
+
+    data.bytes = EstimateBytes(data);
+    data.capture_ms = MsSince(start);
+
+    std::ostringstream msg;
+    msg << std::fixed << std::setprecision(2) << "Scene snapshot " << handle << ": "
+        << data.actors.size() << " actors, " << data.components << " components, "
+        << (data.bytes + 512) / 1024 << " KB in " << data.capture_ms << " ms";
+    LOG_INFO(msg.str());
+    return handle;
+}
+
+bool SceneSnapshot::Restore(int handle) {
+    auto it = snapshots.find(handle);
+    if (it == snapshots.end()) {
+        LOG_WARNING("Scene.Restore: unknown snapshot " + std::to_string(handle));
+        return false;
+    }
+    pending_restore = handle;
+    return true;
+}
+
+void SceneSnapshot::Release(int handle) {
+    auto it = snapshots.find(handle);
+    if (it == snapshots.end()) return;
+    ReleaseRefs(it->second);
+    snapshots.erase(it);
+    if (pending_restore == handle) pending_restore = 0;
+}
+
+luabridge::LuaRef SceneSnapshot::GetStats(int handle) {
+    lua_State* L = ComponentDB::GetLuaState();
+    auto it = snapshots.find(handle);
+    if (it == snapshots.end()) return luabridge::LuaRef(L);
+
+    const SceneSnapshotData& data = it->second;
+    luabridge::LuaRef stats = luabridge::newTable(L);
+    stats["actors"] = static_cast<int>(data.actors.size());
+    stats["components"] = static_cast<int>(data.components);
+    stats["bytes"] = static_cast<int>(data.bytes);
+    stats["capture_ms"] = data.capture_ms;
+    stats["restore_ms"] = data.restore_ms;
+    return stats;
+}
+
+void SceneSnapshot::ApplyPendingRestore() {
+    if (pending_restore == 0) return;
+    auto it = snapshots.find(pending_restore);
+    pending_restore = 0;
+    if (it != snapshots.end()) RestoreNow(it->second);
+}
+
+void SceneSnapshot::Clear() {
+    for (auto& [handle, data] : snapshots) ReleaseRefs(data);
+    snapshots.clear();
+    pending_restore = 0;
+}
+
+void SceneSnapshot::ReleaseRefs(SceneSnapshotData& data) {
+    lua_State* L = ComponentDB::GetLuaState();
+    if (L) {
+        for (int ref : data.refs) luaL_unref(L, LUA_REGISTRYINDEX, ref);
+    }
+    data.refs.clear();
+}
+
+void SceneSnapshot::RestoreNow(SceneSnapshotData& data) {
+    const auto start = Clock::now();
+    // The reader's place in the file no longer matches the restored actors.
+    SceneDB::CancelLoad();
+    lua_State* L = ComponentDB::GetLuaState();
+    const int top = lua_gettop(L);
+    auto& actors = SceneDB::actors;
+
+    std::unordered_set<uint64_t> kept;
+    kept.reserve(data.actors.size());
+    for (const SnapshotActor& saved : data.actors) kept.insert(saved.id);
+
+    auto tear_down = [&](uint64_t id) {
+        auto it = actors.find(id);
+        if (it == actors.end()) return;
+        Actor& actor = *it->second;
+        SceneDB::CallOnDestroyForActor(actor);
+        SceneDB::UntagActor(&actor);
+        for (const std::string& key : actor.component_keys) SceneDB::removeComponentFromCaches(id, key);
+        actors.erase(id);   // OnDestroy may have spawned actors, invalidating `it`
+    };
+
+    // 1. Actors spawned since the snapshot (and any not yet reaped) go away.
+    std::vector<uint64_t> doomed;
+    for (const auto& [id, actor] : actors) {
+        if (actor->destroyed || (!actor->IsResident() && !kept.count(id))) doomed.push_back(id);
+    }
+    std::sort(doomed.begin(), doomed.end());
+    for (uint64_t id : doomed) tear_down(id);
+    SceneDB::actors_to_destroy.clear();
+
+    // 2. Every snapshot actor exists again before any fields are written,
+    //    so actor references between them resolve.
+    for (const SnapshotActor& saved : data.actors) {
+        auto it = actors.find(saved.id);
+        if (it != actors.end() && it->second->destroyed) {
+            tear_down(saved.id);
+            it = actors.end();
+        }
+        if (it == actors.end()) {
+            auto actor = std::make_unique<Actor>();
+            actor->id = saved.id;
+            actors[saved.id] = std::move(actor);
+        }
+    }
+
+    // 3. Rewind names, components and tags.
+    Materializer materializer(L, data);
+    for (const SnapshotActor& saved : data.actors) {
+        Actor* actor = actors[saved.id].get();
+        actor->name = saved.name;
+        actor->components_to_remove.clear();
+
+        // Components added since the snapshot are destroyed.
+        std::vector<std::string> extra;
+        for (const std::string& key : actor->component_keys) {
+            const bool was_saved = std::any_of(saved.components.begin(), saved.components.end(),
+                [&](const SnapshotComponent& c) { return c.key == key; });
+            if (!was_saved) extra.push_back(key);
+        }
+        for (const std::string& key : extra) {
+            SceneDB::CallOnDestroy(*actor, key, *actor->components[key]);
+            SceneDB::removeComponentFromCaches(actor->id, key);
+            actor->components.erase(key);
+            actor->component_keys.erase(key);
+        }
+        ++actor->component_version;
+
+        for (const SnapshotComponent& comp : saved.components) {
+            actor->components[comp.key] = comp.ref;
+            actor->component_keys.insert(comp.key);
+
+            luabridge::LuaRef& ref = *comp.ref;
+            if (comp.fields >= 0) {
+                ref.push(L);
+                materializer.Rewrite(-1, comp.fields);
+                lua_pop(L, 1);
+            } else if (ref.isInstance<Rigidbody>()) {
+                // Bodies of removed components or destroyed actors are gone;
+                // recreate them before writing the saved motion back.
+                Rigidbody* rb = ref.cast<Rigidbody*>();
+                if (!rb->HasBody()) rb->Init(actor);
+                if (comp.has_body) rb->RestoreState(comp.body);
+            } else if (ref.isInstance<Transform>()) {
+                Transform* t = ref.cast<Transform*>();
+                t->x = comp.transform[0];
+                t->y = comp.transform[1];
+                t->rotation = comp.transform[2];
+                t->scale_x = comp.transform[3];
+                t->scale_y = comp.transform[4];
+                if (t->spatial_index < 0 || t->actor != actor) t->Init(actor);
+                else t->OnMoved();
+            } else if (ref.isInstance<SpriteRenderer>()) {
+                SpriteRenderer* sprite = ref.cast<SpriteRenderer*>();
+                if (sprite->registry_index < 0 || sprite->actor != actor) sprite->Init(actor, comp.key);
+            } else if (ref.isInstance<CharacterController2D>()) {
+                // Timers, input and ground state start over from the rewound body.
+                CharacterController2D* controller = ref.cast<CharacterController2D*>();
+                controller->enabled = comp.enabled;
+                controller->Init(actor);
+            }
+        }
+
+        SceneDB::UntagActor(actor);
+        for (int bit = 0; bit < Actor::MAX_TAGS; ++bit) {
+            if (saved.tags & (uint64_t(1) << bit)) SceneDB::AddTag(actor, bit);
+        }
+    }
+    lua_settop(L, top);
+
+    // Bodies were initialized above; a queued Init would move them back
+    // to their configured start position.
+    auto& pending_bodies = SceneDB::rigidbodies_to_init;
+    pending_bodies.erase(std::remove_if(pending_bodies.begin(), pending_bodies.end(),
+        [&](const SceneDB::RigidbodyInitInfo& info) {
+            auto it = actors.find(info.actorId);
+            return it == actors.end() || !it->second->IsResident();
+        }), pending_bodies.end());
+
+    // 4. Persistent actors keep their place at the front, as after a load.
+    std::vector<uint64_t> order;
+    order.reserve(SceneDB::actor_id_vec.size() + data.actors.size());
+    for (uint64_t id : SceneDB::actor_id_vec) {
+        auto it = actors.find(id);
+        if (it != actors.end() && it->second->IsResident() && !kept.count(id)) order.push_back(id);
+    }
+    for (const SnapshotActor& saved : data.actors) order.push_back(saved.id);
+    SceneDB::actor_id_vec.swap(order);
+
+    Scheduler::RestoreTasks(data.tasks);
+    Tween::RestoreTweens(data.tweens);
+    WorldStreaming::RestoreState(data.streaming);
+    SceneDB::rebuildComponentCaches();
+    SceneDB::onstart_new = true;
+
+    data.restore_ms = MsSince(start);
+
+    std::ostringstream msg;
+    msg << std::fixed << std::setprecision(2) << "Restored scene snapshot ("
+        << data.actors.size() << " actors, " << doomed.size() << " removed) in "
+        << data.restore_ms << " ms";
+    LOG_INFO(msg.str());
+}
@@ -0,0 +1,141 @@
+//
+//  SceneSnapshot.hpp
+//  game_engine
+//
+//  In-memory checkpoints of the live scene, restored in place.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "lua.hpp"
+#include "LuaBridge/LuaBridge.h"
+#include "Rigidbody.hpp"
+#include "Scheduler.hpp"
+#include "Tween.hpp"
+#include "WorldStreaming.hpp"
+
+class Actor;
+
+/**
+ * @struct SnapshotValue
+ * @brief One captured Lua value. Immutable or identity-bearing values
+ * (strings, functions, userdata, component tables) are held by registry
+ * reference; plain tables are copied; actors are stored by id.
+ */
+struct SnapshotValue {
+    enum class Kind : uint8_t { Nil, Boolean, Integer, Number, Table, Ref, Actor };
+    Kind kind;
+    union {
+        bool boolean;
+        lua_Integer integer;
+        lua_Number number;
+        int table;          ///< index into SceneSnapshotData::tables
+        int ref;            ///< LUA_REGISTRYINDEX reference
+        uint64_t actor_id;
+    };
+};
+
+/// Copy of a plain Lua table reachable from a component.
+struct SnapshotTable {
+    std::vector<std::pair<SnapshotValue, SnapshotValue>> entries;
+    int metatable_ref;      ///< LUA_NOREF when the table had none
+};
+
+/// One component: its Lua reference plus the state needed to rewind it.
+struct SnapshotComponent {
+    std::string key;
+    std::shared_ptr<luabridge::LuaRef> ref;
+    int fields;             ///< SnapshotTable index of a Lua component's own fields, -1 otherwise
+    bool has_body;          ///< Rigidbody only
+    RigidbodyState body;
+    float transform[5];     ///< Transform only: x, y, rotation, scale_x, scale_y
+    bool enabled;           ///< CharacterController2D only
+};
+
+struct SnapshotActor {
+    uint64_t id;
+    std::string name;
+    uint64_t tags;
+    std::vector<SnapshotComponent> components;
+};
+
+struct SceneSnapshotData {
+    std::string scene;
+    std::vector<SnapshotActor> actors;    ///< in actor_id_vec order
+    std::vector<SnapshotTable> tables;
+    std::vector<int> refs;                ///< every registry ref held, released on drop
+    std::vector<ScheduledTask> tasks;
+    std::vector<TweenInstance> tweens;
+    StreamingState streaming;
+    size_t components;
+    size_t bytes;
+    double capture_ms;
+    double restore_ms;
+};
+
+/**
+ * @class SceneSnapshot
+ * @brief Static checkpoint store exposed to Lua as `Scene.Snapshot()` /
+ * `Scene.Restore(handle)`.
+ *
+ * A snapshot records every main-scene actor (DontDestroy actors and those
+ * of additive scenes are left out and never touched), the own fields of
+ * each Lua component, Rigidbody position/velocity/sleep state, Transform
+ * values, CharacterController2D enabled flags, tags, the pending Timer and
+ * Tween entries, and which streamed actors were loaded. Restoring rewinds the scene in place: actors
+ * spawned since are destroyed (with OnDestroy), destroyed ones come back
+ * with their original ids and component tables, and everything else gets
+ * its fields and bodies reset. Nothing is re-parsed and surviving Box2D
+ * bodies are reused, so it is much cheaper than reloading the scene.
+ *
+ * Nested plain tables in component fields are deep-copied; component
+ * tables, functions, userdata and strings are kept by reference, and actor
+ * references are remapped by id. Lua globals, upvalues, event
+ * subscriptions, particles, isolated components' worker-side state, the
+ * Transform parent links of recreated actors and SpriteRenderer fields are
+ * not captured.
+ *
+ * Restore is deferred to the start of the next frame, like Scene.Load.
+ * Snapshots belong to the scene they were taken in and are dropped when
+ * another scene loads.
+ */
+class SceneSnapshot {
+public:
+    /// Captures the current scene; returns a handle (never 0).
+    static int Snapshot();
+
+    /**
+     * @brief Queues a restore for the start of the next frame.
+     * @return false for an unknown handle.
+     */
+    static bool Restore(int handle);
+
+    /// Frees a snapshot. Unknown handles are ignored.
+    static void Release(int handle);
+
+    /**
+     * @brief Lua table `{ actors, components, bytes, capture_ms, restore_ms }`
+     * for a snapshot, or nil. restore_ms is 0 until it has been restored.
+     */
+    static luabridge::LuaRef GetStats(int handle);
+
+    /// Applies a queued restore. Called by EngineContext before the frame's systems update.
+    static void ApplyPendingRestore();
+
+    /// Drops every snapshot and a queued restore. Called on scene change and shutdown.
+    static void Clear();
+
+private:
+    static void ReleaseRefs(SceneSnapshotData& data);
+    static void RestoreNow(SceneSnapshotData& data);
+
+    inline static thread_local std::unordered_map<int, SceneSnapshotData> snapshots;
+    inline static thread_local int next_handle = 1;
+    inline static thread_local int pending_restore = 0;
+};
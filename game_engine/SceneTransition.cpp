@@ -6,8 +6,6 @@
 //
 
 #include "SceneTransition.hpp"
-#include "Renderer.hpp"
-#include "SDL2/SDL.h"
 #include <algorithm>
 
 void SceneTransition::Init() {
@@ -59,39 +57,25 @@ void SceneTransition::Update(float dt) {
     }
 }
 
-void SceneTransition::Render() {
+int SceneTransition::GetFadeAlpha() {
     if (state == State::NONE) {
-        return;
+        return 0;
     }
 
-    SDL_Renderer* sdl_renderer = Renderer::getSDLRenderer();
-
-    // Temporarily reset render scale for full-screen overlay
-    float zoom = Renderer::GetCameraZoomFactor();
-    SDL_RenderSetScale(sdl_renderer, 1.0f, 1.0f);
-
     float half = duration * 0.5f;
-    Uint8 alpha = 0;
+    int alpha = 0;
 
     if (state == State::FADE_OUT) {
         // Alpha goes 0 -> 255 during first half
         float progress = (half > 0.0f) ? std::min(elapsed / half, 1.0f) : 1.0f;
-        alpha = (Uint8)(progress * 255.0f);
+        alpha = (int)(progress * 255.0f);
     } else if (state == State::FADE_IN) {
         // Alpha goes 255 -> 0 during second half
         float progress = (half > 0.0f) ? std::min((elapsed - half) / half, 1.0f) : 1.0f;
-        alpha = (Uint8)((1.0f - progress) * 255.0f);
+        alpha = (int)((1.0f - progress) * 255.0f);
     }
 
-    SDL_SetRenderDrawBlendMode(sdl_renderer, SDL_BLENDMODE_BLEND);
-    SDL_SetRenderDrawColor(sdl_renderer, 0, 0, 0, alpha);
-
-    glm::ivec2 dims = Renderer::GetCameraDimensions();
-    SDL_Rect fullscreen = {0, 0, dims.x, dims.y};
-    SDL_RenderFillRect(sdl_renderer, &fullscreen);
-
-    // Restore render scale
-    SDL_RenderSetScale(sdl_renderer, zoom, zoom);
+    return alpha;
 }
 
 bool SceneTransition::IsTransitioning() {
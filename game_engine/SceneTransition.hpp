@@ -20,18 +20,19 @@ public:
     static void Init();
     static void StartTransition(const std::string& scene_name, const std::string& type, float duration);
     static void Update(float dt);
-    static void Render();
+    // Opacity (0-255) of the black fade overlay for the current frame
+    static int GetFadeAlpha();
     static bool IsTransitioning();
     static bool ShouldLoadScene();
     static std::string GetTargetScene();
     static void ClearTargetScene();
 
 private:
-    inline static State state = State::NONE;
-    inline static std::string target_scene;
-    inline static std::string transition_type = "none";
-    inline static float duration = 0.0f;
-    inline static float elapsed = 0.0f;
-    inline static bool scene_load_pending = false;
+    inline static thread_local State state = State::NONE;
+    inline static thread_local std::string target_scene;
+    inline static thread_local std::string transition_type = "none";
+    inline static thread_local float duration = 0.0f;
+    inline static thread_local float elapsed = 0.0f;
+    inline static thread_local bool scene_load_pending = false;
 };
 
@@ -7,6 +7,8 @@
 
 #include "Scheduler.hpp"
 #include "Logger.hpp"
+#include "Profiler.hpp"
+#include "SceneDB.hpp"
 #include <algorithm>
 
 void Scheduler::Init() {
@@ -28,7 +30,9 @@ void Scheduler::Update(float delta_time) {
         if (task.delay <= 0) {
             // Execute callback
             try {
+                SceneDB::RunningActorScope running(task.owner);
                 if (task.callback && task.callback->isFunction()) {
+                    Profiler::CountLuaCall();
                     (*task.callback)();
                 }
             }
@@ -74,6 +78,7 @@ int Scheduler::After(float delay, luabridge::LuaRef callback) {
     task.repeat_count = 0;
     task.callback = std::make_shared<luabridge::LuaRef>(callback);
     task.cancelled = false;
+    task.owner = SceneDB::GetRunningActor();
 
     tasks.push_back(task);
 
@@ -95,6 +100,7 @@ int Scheduler::Every(float delay, float interval, luabridge::LuaRef callback) {
     task.repeat_count = -1;  // Infinite repeats
     task.callback = std::make_shared<luabridge::LuaRef>(callback);
     task.cancelled = false;
+    task.owner = SceneDB::GetRunningActor();
 
     tasks.push_back(task);
 
@@ -119,3 +125,11 @@ void Scheduler::CancelAll() {
 void Scheduler::Clear() {
     tasks.clear();
 }
+
+void Scheduler::ClearNonResident() {
+    tasks.erase(
+        std::remove_if(tasks.begin(), tasks.end(),
+            [](const ScheduledTask& task) { return !SceneDB::IsResidentOwner(task.owner); }),
+        tasks.end()
+    );
+}
@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <memory>
@@ -24,6 +25,7 @@ struct ScheduledTask {
     int repeat_count;      // -1 = infinite, 0 = done, >0 = remaining repeats
     std::shared_ptr<luabridge::LuaRef> callback;
     bool cancelled = false;
+    uint64_t owner;        // Actor that scheduled it (SceneDB::NO_ACTOR outside any actor)
 };
 
 /**
@@ -74,12 +76,24 @@ public:
     static void CancelAll();
 
     /**
-     * @brief Clear all tasks. Called on scene change.
+     * @brief Clear all tasks. Called on shutdown.
      */
     static void Clear();
 
+    /**
+     * @brief Drops the tasks not owned by a resident (DontDestroy or
+     * additive) actor. Called on Scene.Load.
+     */
+    static void ClearNonResident();
+
+    /// Pending tasks, copied by scene snapshots.
+    static const std::vector<ScheduledTask>& GetTasks() { return tasks; }
+
+    /// Replaces the pending tasks with a snapshot's copy.
+    static void RestoreTasks(const std::vector<ScheduledTask>& saved) { tasks = saved; }
+
 private:
-    inline static std::vector<ScheduledTask> tasks;
-    inline static int next_task_id = 1;
+    inline static thread_local std::vector<ScheduledTask> tasks;
+    inline static thread_local int next_task_id = 1;
 };
 
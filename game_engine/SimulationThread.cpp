@@ -0,0 +1,115 @@
+//
+//  SimulationThread.cpp
+//  game_engine
+//
+//  Hosts the windowed world on its own thread so the next frame's update
+//  overlaps with rendering the previous one.
+//
+
+#include "SimulationThread.hpp"
+#include "EngineContext.hpp"
+#include "RenderCommandBuffer.hpp"
+
+SimulationThread::SimulationThread() {
+    thread = std::thread(&SimulationThread::Run, this);
+
+    std::unique_lock<std::mutex> lock(mutex);
+    cv.wait(lock, [this] { return ready; });
+    if (error) {
+        lock.unlock();
+        thread.join();
+        std::rethrow_exception(error);
+    }
+}
+
+SimulationThread::~SimulationThread() {
+    if (!thread.joinable()) return;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    cv.notify_all();
+    thread.join();
+}
+
+void SimulationThread::StartStep(std::vector<SDL_Event>& new_events, float fixed_dt, RenderFrame& frame) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        events.clear();
+        events.swap(new_events);
+        step_dt = fixed_dt;
+        target = &frame;
+        step_pending = true;
+    }
+    cv.notify_all();
+}
+
+void SimulationThread::SetStateHashing(bool enabled) {
+    std::lock_guard<std::mutex> lock(mutex);
+    hash_state = enabled;
+}
+
+void SimulationThread::SetStatsCollection(bool enabled) {
+    std::lock_guard<std::mutex> lock(mutex);
+    collect_stats = enabled;
+}
+
+void SimulationThread::WaitStep() {
+    std::unique_lock<std::mutex> lock(mutex);
+    cv.wait(lock, [this] { return !step_pending; });
+    if (error) {
+        std::exception_ptr e = error;
+        error = nullptr;
+        std::rethrow_exception(e);
+    }
+}
+
+void SimulationThread::Run() {
+    std::unique_ptr<EngineContext> context;
+    try {
+        context = std::make_unique<EngineContext>(false);
+    }
+    catch (...) {
+        std::lock_guard<std::mutex> lock(mutex);
+        error = std::current_exception();
+        ready = true;
+        cv.notify_all();
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock(mutex);
+    ready = true;
+    cv.notify_all();
+
+    while (true) {
+        cv.wait(lock, [this] { return step_pending || stopping; });
+        if (!step_pending) break;
+
+        context->SetStateHashing(hash_state);
+        context->SetStatsCollection(collect_stats);
+        lock.unlock();
+        try {
+            for (const SDL_Event& e : events) {
+                context->QueueEvent(e);
+            }
+            context->Step(step_dt);
+            RenderCommandBuffer::Record(*target);
+        }
+        catch (...) {
+            error = std::current_exception();
+        }
+        profile = FrameProfile{};
+        Profiler::TakeFrame(profile);
+        lock.lock();
+
+        quit_requested = context->IsQuitRequested();
+        state_hash = context->GetStateHash();
+        world_stats = context->GetWorldStats();
+        step_pending = false;
+        cv.notify_all();
+    }
+    lock.unlock();
+
+    // The world's Lua states and physics world are thread_local here.
+    context.reset();
+}
@@ -0,0 +1,111 @@
+//
+//  SimulationThread.hpp
+//  game_engine
+//
+//  Hosts the windowed world on its own thread so the next frame's update
+//  overlaps with rendering the previous one.
+//
+
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "SDL2/SDL.h"
+#include "Profiler.hpp"
+#include "FrameStats.hpp"
+
+struct RenderFrame;
+
+/**
+ * @class SimulationThread
+ * @brief Runs an EngineContext on a dedicated thread, one Step() at a time.
+ *
+ * The context is constructed, stepped and destroyed on the simulation
+ * thread, so all of its thread_local world state (Lua, physics, input,
+ * draw queues) lives there. The main thread keeps SDL: it polls events,
+ * hands them over with StartStep(), and executes the previously recorded
+ * RenderFrame while the step runs.
+ *
+ * @code
+ * sim.StartStep(events, dt, frames[next]);   // update + record frame N+1
+ * RenderCommandBuffer::Execute(frames[cur]); // draw frame N meanwhile
+ * sim.WaitStep();
+ * @endcode
+ */
+class SimulationThread {
+public:
+    /**
+     * @brief Starts the thread and builds the world on it.
+     * @throws Whatever EngineContext's constructor threw, on the caller's thread.
+     */
+    SimulationThread();
+
+    /**
+     * @brief Finishes the running step, destroys the world on its own thread
+     *        and joins.
+     */
+    ~SimulationThread();
+
+    SimulationThread(const SimulationThread&) = delete;
+    SimulationThread& operator=(const SimulationThread&) = delete;
+
+    /**
+     * @brief Queues `events`, steps the world by `fixed_dt` (0 = wall clock)
+     *        and records its draws into `frame`, asynchronously.
+     *
+     * `events` is swapped out and left empty. `frame` must not be touched
+     * until WaitStep() returns.
+     */
+    void StartStep(std::vector<SDL_Event>& events, float fixed_dt, RenderFrame& frame);
+
+    /**
+     * @brief Blocks until the step started by StartStep() finishes.
+     * @throws Any exception the step raised, rethrown on the caller's thread.
+     */
+    void WaitStep();
+
+    /// Application.Quit() was called; valid after WaitStep().
+    bool IsQuitRequested() const { return quit_requested; }
+
+    /// Stage timings of the last step and record; valid after WaitStep().
+    const FrameProfile& GetProfile() const { return profile; }
+
+    /// Forwards to EngineContext::SetStateHashing() before the next step.
+    void SetStateHashing(bool enabled);
+
+    /// World hash after the last step (see EngineContext::GetStateHash()); valid after WaitStep().
+    uint64_t GetStateHash() const { return state_hash; }
+
+    /// Forwards to EngineContext::SetStatsCollection() before the next step.
+    void SetStatsCollection(bool enabled);
+
+    /// World counters after the last step (see EngineContext::GetWorldStats()); valid after WaitStep().
+    const WorldStats& GetWorldStats() const { return world_stats; }
+
+private:
+    void Run();
+
+    std::thread thread;
+    std::mutex mutex;
+    std::condition_variable cv;
+
+    bool ready = false;
+    bool step_pending = false;
+    bool stopping = false;
+    bool quit_requested = false;
+    std::exception_ptr error;
+
+    std::vector<SDL_Event> events;
+    float step_dt = 0.0f;
+    RenderFrame* target = nullptr;
+    FrameProfile profile;
+    bool hash_state = false;
+    uint64_t state_hash = 0;
+    bool collect_stats = false;
+    WorldStats world_stats;
+};
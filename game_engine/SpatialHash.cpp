@@ -0,0 +1,256 @@
+//
+//  SpatialHash.cpp
+//  game_engine
+//
+//  Uniform-grid index of Transform components for proximity queries.
+//
+
+#include "SpatialHash.hpp"
+#include "Transform.hpp"
+#include "Actor.hpp"
+#include "ComponentDB.hpp"
+#include "SceneDB.hpp"
+#include "ConfigManager.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    constexpr float MAX_CELL_COORD = 1073741824.0f;   // 2^30, keeps keys unique
+
+    /// Distance order with actor id as the tie-break, so results are
+    /// independent of bucket order.
+    bool CloserFirst(const std::pair<double, Transform*>& a, const std::pair<double, Transform*>& b) {
+        if (a.first != b.first) return a.first < b.first;
+        return a.second->actor->id < b.second->actor->id;
+    }
+}
+
+void SpatialHash::Init() {
+    Clear();
+    cell_size = ConfigManager::GetSpatialCellSize();
+}
+
+void SpatialHash::Clear() {
+    for (auto& [key, list] : cells) {
+        for (Transform* transform : list) transform->spatial_index = -1;
+    }
+    cells.clear();
+    count = 0;
+    min_cx = min_cy = 0;
+    max_cx = max_cy = -1;
+    hits.clear();
+}
+
+uint64_t SpatialHash::CellKey(int cx, int cy) {
+    return (static_cast<uint64_t>(static_cast<uint32_t>(cx)) << 32) | static_cast<uint32_t>(cy);
+}
+
+int SpatialHash::CellCoord(float v) {
+    return static_cast<int>(std::clamp(std::floor(v / cell_size), -MAX_CELL_COORD, MAX_CELL_COORD));
+}
+
+void SpatialHash::Insert(Transform* transform) {
+    if (transform->spatial_index >= 0) return;
+
+    const int cx = CellCoord(transform->world_x);
+    const int cy = CellCoord(transform->world_y);
+    std::vector<Transform*>& list = cells[CellKey(cx, cy)];
+    transform->spatial_cell = CellKey(cx, cy);
+    transform->spatial_index = static_cast<int>(list.size());
+    list.push_back(transform);
+
+    if (count++ == 0) {
+        min_cx = max_cx = cx;
+        min_cy = max_cy = cy;
+    }
+    else {
+        min_cx = std::min(min_cx, cx);
+        max_cx = std::max(max_cx, cx);
+        min_cy = std::min(min_cy, cy);
+        max_cy = std::max(max_cy, cy);
+    }
+}
+
+void SpatialHash::Remove(Transform* transform) {
+    if (transform->spatial_index < 0) return;
+
+    // Swap-remove; empty cells are kept so agents moving back and forth
+    // don't reallocate them.
+    auto it = cells.find(transform->spatial_cell);
+    if (it != cells.end()) {
+        std::vector<Transform*>& list = it->second;
+        Transform* last = list.back();
+        list[transform->spatial_index] = last;
+        last->spatial_index = transform->spatial_index;
+        list.pop_back();
+        --count;
+    }
+    transform->spatial_index = -1;
+}
+
+void SpatialHash::Move(Transform* transform) {
+    if (transform->spatial_index < 0) return;
+    if (CellKey(CellCoord(transform->world_x), CellCoord(transform->world_y)) == transform->spatial_cell) return;
+    Remove(transform);
+    Insert(transform);
+}
+
+template <typename Accept>
+void SpatialHash::Gather(int c0, int r0, int c1, int r1, Accept accept) {
+    if (c1 < c0 || r1 < r0) return;
+
+    // Walk the occupied cells instead when the range has more cells than
+    // the map (large radius over a sparse world).
+    const uint64_t span = static_cast<uint64_t>(c1 - c0 + 1) * static_cast<uint64_t>(r1 - r0 + 1);
+    if (span > cells.size()) {
+        for (const auto& [key, list] : cells) {
+            const int cx = static_cast<int32_t>(key >> 32);
+            const int cy = static_cast<int32_t>(key & 0xffffffffu);
+            if (cx < c0 || cx > c1 || cy < r0 || cy > r1) continue;
+            for (Transform* transform : list) accept(transform);
+        }
+        return;
+    }
+
+    for (int cy = r0; cy <= r1; ++cy) {
+        for (int cx = c0; cx <= c1; ++cx) {
+            auto it = cells.find(CellKey(cx, cy));
+            if (it == cells.end()) continue;
+            for (Transform* transform : it->second) accept(transform);
+        }
+    }
+}
+
+const SpatialHash::Filter& SpatialHash::ResolveFilter(const luabridge::LuaRef& filter) {
+    Filter& f = filter_scratch;
+    f.by_name = false;
+    f.tag_mask = 0;
+    f.match_none = false;
+    if (filter.isString()) {
+        f.by_name = true;
+        f.name = filter.cast<std::string>();
+    }
+    else if (filter.isTable()) {
+        if (filter["name"].isString()) {
+            f.by_name = true;
+            f.name = filter["name"].cast<std::string>();
+        }
+        luabridge::LuaRef tags = filter["tags"];
+        if (!tags.isNil()) f.match_none = !SceneDB::ResolveTagMask(tags, f.tag_mask);
+    }
+    return f;
+}
+
+bool SpatialHash::Matches(const Transform* transform, const Filter& filter) {
+    const Actor* actor = transform->actor;
+    if (!actor || actor->destroyed || filter.match_none) return false;
+    if ((actor->tags & filter.tag_mask) != filter.tag_mask) return false;
+    return !filter.by_name || actor->name == filter.name;
+}
+
+luabridge::LuaRef SpatialHash::ToTable(size_t n, luabridge::LuaRef out) {
+    lua_State* L = ComponentDB::GetLuaState();
+    const bool reuse = out.isTable();
+    luabridge::LuaRef table = reuse ? out : luabridge::newTable(L);
+    const int previous = reuse ? table.length() : 0;
+
+    for (size_t i = 0; i < n; ++i) {
+        table[static_cast<int>(i) + 1] = hits[i].second->actor;
+    }
+    for (int i = static_cast<int>(n) + 1; i <= previous; ++i) {
+        table[i] = luabridge::LuaRef(L);
+    }
+    return table;
+}
+
+luabridge::LuaRef SpatialHash::QueryRadius(const b2Vec2& center, float radius,
+                                           luabridge::LuaRef filter, luabridge::LuaRef out) {
+    hits.clear();
+    if (radius >= 0.0f) {
+        const Filter& f = ResolveFilter(filter);
+        const double r2 = static_cast<double>(radius) * radius;
+        Gather(CellCoord(center.x - radius), CellCoord(center.y - radius),
+               CellCoord(center.x + radius), CellCoord(center.y + radius),
+               [&](Transform* t) {
+                   if (!Matches(t, f)) return;
+                   const double dx = t->world_x - center.x;
+                   const double dy = t->world_y - center.y;
+                   const double d2 = dx * dx + dy * dy;
+                   if (d2 <= r2) hits.emplace_back(d2, t);
+               });
+        std::sort(hits.begin(), hits.end(), CloserFirst);
+    }
+    return ToTable(hits.size(), out);
+}
+
+int SpatialHash::CountRadius(const b2Vec2& center, float radius, luabridge::LuaRef filter) {
+    if (radius < 0.0f) return 0;
+    const Filter& f = ResolveFilter(filter);
+    const double r2 = static_cast<double>(radius) * radius;
+    int n = 0;
+    Gather(CellCoord(center.x - radius), CellCoord(center.y - radius),
+           CellCoord(center.x + radius), CellCoord(center.y + radius),
+           [&](Transform* t) {
+               if (!Matches(t, f)) return;
+               const double dx = t->world_x - center.x;
+               const double dy = t->world_y - center.y;
+               if (dx * dx + dy * dy <= r2) ++n;
+           });
+    return n;
+}
+
+luabridge::LuaRef SpatialHash::QueryRect(const b2Vec2& min, const b2Vec2& max,
+                                         luabridge::LuaRef filter, luabridge::LuaRef out) {
+    hits.clear();
+    const Filter& f = ResolveFilter(filter);
+    Gather(CellCoord(min.x), CellCoord(min.y), CellCoord(max.x), CellCoord(max.y), [&](Transform* t) {
+        if (!Matches(t, f)) return;
+        if (t->world_x < min.x || t->world_x > max.x || t->world_y < min.y || t->world_y > max.y) return;
+        hits.emplace_back(0.0, t);
+    });
+    std::sort(hits.begin(), hits.end(), CloserFirst);
+    return ToTable(hits.size(), out);
+}
+
+luabridge::LuaRef SpatialHash::QueryNearest(const b2Vec2& center, int k,
+                                            luabridge::LuaRef filter, luabridge::LuaRef out) {
+    hits.clear();
+    if (k <= 0 || count == 0) return ToTable(0, out);
+
+    const Filter& f = ResolveFilter(filter);
+    auto accept = [&](Transform* t) {
+        if (!Matches(t, f)) return;
+        const double dx = t->world_x - center.x;
+        const double dy = t->world_y - center.y;
+        hits.emplace_back(dx * dx + dy * dy, t);
+    };
+
+    // Search square rings of cells outward. Anything in ring r + 1 is at
+    // least r cells away, so stop once the k-th hit is closer than that.
+    const int cx = CellCoord(center.x);
+    const int cy = CellCoord(center.y);
+    const int last_ring = std::max(std::max(std::abs(cx - min_cx), std::abs(cx - max_cx)),
+                                   std::max(std::abs(cy - min_cy), std::abs(cy - max_cy)));
+    const size_t wanted = static_cast<size_t>(k);
+
+    for (int ring = 0; ring <= last_ring; ++ring) {
+        if (ring == 0) {
+            Gather(cx, cy, cx, cy, accept);
+        }
+        else {
+            Gather(cx - ring, cy - ring, cx + ring, cy - ring, accept);          // top
+            Gather(cx - ring, cy + ring, cx + ring, cy + ring, accept);          // bottom
+            Gather(cx - ring, cy - ring + 1, cx - ring, cy + ring - 1, accept);  // left
+            Gather(cx + ring, cy - ring + 1, cx + ring, cy + ring - 1, accept);  // right
+        }
+
+        if (hits.size() >= wanted) {
+            std::nth_element(hits.begin(), hits.begin() + (wanted - 1), hits.end(), CloserFirst);
+            const double reach = static_cast<double>(ring) * cell_size;
+            if (hits[wanted - 1].first <= reach * reach) break;
+        }
+    }
+
+    std::sort(hits.begin(), hits.end(), CloserFirst);
+    return ToTable(std::min(wanted, hits.size()), out);
+}
@@ -0,0 +1,105 @@
+//
+//  SpatialHash.hpp
+//  game_engine
+//
+//  Uniform-grid index of Transform components for proximity queries.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "box2d/box2d.h"
+#include "lua.hpp"
+#include "LuaBridge/LuaBridge.h"
+
+class Transform;
+class Actor;
+
+/**
+ * @class SpatialHash
+ * @brief Static per-world spatial hash over actors' Transform components,
+ * exposed to Lua as `Spatial`.
+ *
+ * Transform components register when they are initialized on an actor and
+ * leave when they are destroyed. They are indexed by world position;
+ * parented transforms are re-bucketed by TransformHierarchy::Update(). Moving a Transform re-buckets it only when
+ * it crosses into another cell, so updates are O(1). The cell size comes from
+ * `spatial_cell_size` in game.config (default 2 world units); pick roughly
+ * the typical query radius.
+ *
+ * Queries take an optional filter (nil for every actor, an actor name, or
+ * a table `{ name = ..., tags = { ... } }` with either key optional) and an
+ * optional `out` table. When `out` is given
+ * it is cleared, filled and returned, so a script that queries every frame
+ * can reuse one table.
+ * Candidate lists live in reused per-thread scratch storage. Radius and
+ * nearest queries return actors ordered by distance, rect queries by actor
+ * id; destroyed actors are skipped.
+ */
+class SpatialHash {
+public:
+    static void Init();
+
+    /// Forgets every registered Transform. Called before the scene is torn down.
+    static void Clear();
+
+    static void Insert(Transform* transform);
+    static void Remove(Transform* transform);
+
+    /// Re-buckets a registered Transform after its position changed.
+    static void Move(Transform* transform);
+
+    /// Actors within `radius` of `center`.
+    static luabridge::LuaRef QueryRadius(const b2Vec2& center, float radius,
+                                         luabridge::LuaRef filter, luabridge::LuaRef out);
+
+    /// Actors inside the axis-aligned rectangle [min, max].
+    static luabridge::LuaRef QueryRect(const b2Vec2& min, const b2Vec2& max,
+                                       luabridge::LuaRef filter, luabridge::LuaRef out);
+
+    /// Up to `count` actors closest to `center`.
+    static luabridge::LuaRef QueryNearest(const b2Vec2& center, int count,
+                                          luabridge::LuaRef filter, luabridge::LuaRef out);
+
+    /// Number of actors within `radius` of `center`; builds no table.
+    static int CountRadius(const b2Vec2& center, float radius, luabridge::LuaRef filter);
+
+    static size_t GetCount() { return count; }
+
+private:
+    /// Candidate with its squared distance (or actor id for rect queries).
+    using Hit = std::pair<double, Transform*>;
+
+    static uint64_t CellKey(int cx, int cy);
+    static int CellCoord(float v);
+
+    /// Calls accept(transform) for every Transform in cells [c0, c1] x [r0, r1].
+    template <typename Accept>
+    static void Gather(int c0, int r0, int c1, int r1, Accept accept);
+
+    /// Query filter, resolved once per call from the Lua argument.
+    struct Filter {
+        bool by_name;
+        std::string name;
+        uint64_t tag_mask;      ///< every bit must be set on the actor
+        bool match_none;        ///< an unknown tag was requested
+    };
+
+    static const Filter& ResolveFilter(const luabridge::LuaRef& filter);
+    static bool Matches(const Transform* transform, const Filter& filter);
+
+    /// Writes hits[0, n) into `out` (or a new table) as actors.
+    static luabridge::LuaRef ToTable(size_t n, luabridge::LuaRef out);
+
+    inline static thread_local float cell_size = 2.0f;
+    inline static thread_local std::unordered_map<uint64_t, std::vector<Transform*>> cells;
+    inline static thread_local size_t count = 0;
+    /// Occupied cell bounds, grown on insert; bounds the nearest-query rings.
+    inline static thread_local int min_cx = 0, min_cy = 0, max_cx = -1, max_cy = -1;
+    inline static thread_local std::vector<Hit> hits;
+    inline static thread_local Filter filter_scratch;
+};
@@ -0,0 +1,147 @@
+//
+//  SpriteRenderer.cpp
+//  game_engine
+//
+//  Native sprite component that draws an actor every frame without Lua.
+//
+
+#include "SpriteRenderer.hpp"
+#include "Actor.hpp"
+#include "Rigidbody.hpp"
+#include "Transform.hpp"
+#include "TransformHierarchy.hpp"
+#include "AnimationDB.hpp"
+#include "ImageDB.hpp"
+#include "Logger.hpp"
+
+void SpriteRenderer::Init(Actor* owner, const std::string& key) {
+    actor = owner;
+    body = nullptr;
+    transform = nullptr;
+    resolved = false;
+    animation_key = "sprite:" + std::to_string(owner->GetID()) + ":" + key;
+    playing.clear();
+    if (registry_index < 0) {
+        registry_index = static_cast<int>(live.size());
+        live.push_back(this);
+    }
+}
+
+void SpriteRenderer::OnDestroy() {
+    if (registry_index >= 0) {
+        // Compacted once per frame rather than erased here, so tearing down
+        // many sprites stays linear and draw order stays creation order.
+        live[registry_index] = nullptr;
+        ++destroyed;
+        registry_index = -1;
+    }
+    if (!animation_key.empty()) AnimationDB::Remove(animation_key);
+    playing.clear();
+}
+
+void SpriteRenderer::SetSuspended(bool suspended) {
+    if (!playing.empty()) AnimationDB::SetPaused(animation_key, suspended);
+}
+
+void SpriteRenderer::Init() {
+    Clear();
+}
+
+void SpriteRenderer::Clear() {
+    for (SpriteRenderer* sprite : live) {
+        if (sprite) sprite->registry_index = -1;
+    }
+    live.clear();
+    destroyed = 0;
+}
+
+void SpriteRenderer::Compact() {
+    size_t next = 0;
+    for (SpriteRenderer* sprite : live) {
+        if (!sprite) continue;
+        sprite->registry_index = static_cast<int>(next);
+        live[next++] = sprite;
+    }
+    live.resize(next);
+    destroyed = 0;
+}
+
+bool SpriteRenderer::ResolvePose() {
+    body = nullptr;
+    transform = nullptr;
+    resolved_version = actor->component_version;
+    for (const std::string& key : actor->component_keys) {
+        auto it = actor->components.find(key);
+        if (it == actor->components.end() || !it->second->isUserdata()) continue;
+        const luabridge::LuaRef& comp = *it->second;
+        if (comp.isInstance<Rigidbody>()) {
+            body = comp.cast<Rigidbody*>();
+            transform = nullptr;
+            break;
+        }
+        if (!transform && comp.isInstance<Transform>()) transform = comp.cast<Transform*>();
+    }
+    resolved = body || transform;
+    return resolved;
+}
+
+void SpriteRenderer::Submit() {
+    // Re-resolve when components came or went; the cached ones may be gone.
+    if (!resolved || resolved_version != actor->component_version) ResolvePose();
+
+    WorldPose pose = { 0.0f, 0.0f, 0.0f, 1.0f, 1.0f };
+    if (body) {
+        pose = TransformHierarchy::BodyPose(body);
+    }
+    else if (transform) {
+        transform->RefreshWorld();
+        pose = { transform->world_x, transform->world_y, transform->world_rotation,
+                 transform->world_scale_x, transform->world_scale_y };
+    }
+    const b2Vec2 position = TransformHierarchy::ToWorld(pose, b2Vec2(offset_x, offset_y));
+
+    ImageDrawRequest request;
+    request.x = position.x;
+    request.y = position.y;
+    request.rotation_degrees = static_cast<int>(pose.rotation + rotation);
+    request.scale_x = pose.scale_x * scale_x * (flip_x ? -1.0f : 1.0f);
+    request.scale_y = pose.scale_y * scale_y * (flip_y ? -1.0f : 1.0f);
+    request.pivot_x = pivot_x;
+    request.pivot_y = pivot_y;
+    request.r = static_cast<int>(r);
+    request.g = static_cast<int>(g);
+    request.b = static_cast<int>(b);
+    request.a = static_cast<int>(a);
+    request.sorting_order = sorting_order;
+
+    const std::string* sheet = nullptr;
+    if (!animation.empty()) {
+        if (animation != playing) {
+            playing = animation;
+            if (AnimationDB::HasAnimation(animation)) AnimationDB::Play(animation_key, animation, animation_loop);
+            else LOG_WARNING("SpriteRenderer on " + actor->GetName() + ": undefined animation '" + animation + "'");
+        }
+        sheet = AnimationDB::GetFrame(animation_key, request.source);
+        if (!sheet && AnimationDB::HasAnimation(animation)) {
+            // Playback state was cleared (a scene load); start over.
+            AnimationDB::Play(animation_key, animation, animation_loop);
+            sheet = AnimationDB::GetFrame(animation_key, request.source);
+        }
+    }
+    else if (!playing.empty()) {
+        AnimationDB::Remove(animation_key);
+        playing.clear();
+    }
+
+    const std::string& name = sheet ? *sheet : image;
+    if (name.empty()) return;
+    request.image_name = name;
+    ImageDB::QueueImageDrawRequest(request);
+}
+
+void SpriteRenderer::SubmitAll() {
+    if (destroyed > 0) Compact();
+    for (SpriteRenderer* sprite : live) {
+        if (sprite->enabled && !sprite->actor->destroyed && !sprite->actor->frozen) sprite->Submit();
+    }
+}
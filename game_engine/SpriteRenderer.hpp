@@ -0,0 +1,121 @@
+//
+//  SpriteRenderer.hpp
+//  game_engine
+//
+//  Native sprite component that draws an actor every frame without Lua.
+//
+
+#pragma once
+
+#include "box2d/box2d.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class Actor;
+class Rigidbody;
+class Transform;
+
+/**
+ * @class SpriteRenderer
+ * @brief Draws an image at its actor's Rigidbody or Transform pose.
+ *
+ * Added like any component (`"type": "SpriteRenderer"`); template and scene
+ * properties set the fields below. Every live renderer queues one world-space
+ * image draw per frame from C++, right after the scripts' LateUpdate, so an
+ * actor that only needs to be drawn has no OnUpdate at all. Scripts that
+ * animate a sprite change its fields instead of calling Image.DrawEx.
+ *
+ * The pose comes from the actor's first Rigidbody (as of the last physics
+ * step, like `rb:GetPosition()` in OnUpdate) or else its Transform (the world
+ * pose, so parented transforms work). The offset is in the actor's space and
+ * rotates and scales with it. With neither, the offset is the world position.
+ *
+ * `animation` names an Animation.Define() entry: while set, the renderer
+ * plays it under its own key and draws the current frame of its spritesheet
+ * instead of `image`. Sprites are not captured by Scene.Snapshot() beyond
+ * their registration, and are skipped by the state hash (they only describe
+ * presentation).
+ */
+class SpriteRenderer {
+public:
+    SpriteRenderer() = default;
+
+    std::string image;
+    float offset_x = 0.0f;
+    float offset_y = 0.0f;
+    /// Degrees clockwise, added to the followed pose.
+    float rotation = 0.0f;
+    float scale_x = 1.0f;
+    float scale_y = 1.0f;
+    float pivot_x = 0.5f;
+    float pivot_y = 0.5f;
+    /// Tint and alpha, 0-255.
+    float r = 255.0f;
+    float g = 255.0f;
+    float b = 255.0f;
+    float a = 255.0f;
+    int sorting_order = 0;
+    bool flip_x = false;
+    bool flip_y = false;
+    bool enabled = true;
+    std::string animation;
+    bool animation_loop = true;
+
+    /// Owning actor; nullptr until Init().
+    Actor* actor = nullptr;
+
+    /// Slot in the live list; -1 when not registered.
+    int registry_index = -1;
+
+    /// Registers the renderer for its actor; `key` is its component key.
+    void Init(Actor* owner, const std::string& key);
+
+    /// Unregisters the renderer and releases its animation state.
+    void OnDestroy();
+
+    /// Pauses or resumes the animation while WorldStreaming has the actor
+    /// frozen. Frozen actors are not drawn, but keep their slot and state.
+    void SetSuspended(bool suspended);
+
+    void SetScale(float x, float y) { scale_x = x; scale_y = y; }
+    void SetOffset(float x, float y) { offset_x = x; offset_y = y; }
+    void SetTint(float red, float green, float blue, float alpha) { r = red; g = green; b = blue; a = alpha; }
+    b2Vec2 GetScale() const { return b2Vec2(scale_x, scale_y); }
+    b2Vec2 GetOffset() const { return b2Vec2(offset_x, offset_y); }
+
+    static void Init();
+
+    /// Queues this frame's draw for every enabled renderer of a live, unfrozen
+    /// actor, in creation order.
+    /// Drops the slots of renderers destroyed since the last call first.
+    static void SubmitAll();
+
+    /// Forgets every renderer. Called before the scene is torn down.
+    static void Clear();
+
+    static size_t GetCount() { return live.size() - destroyed; }
+
+private:
+    void Submit();
+
+    /// Finds the Rigidbody or Transform to follow; false if the actor has neither yet.
+    bool ResolvePose();
+
+    /// Removes the null slots OnDestroy left, keeping creation order.
+    static void Compact();
+
+    Rigidbody* body = nullptr;
+    Transform* transform = nullptr;
+    bool resolved = false;
+    /// The actor's component_version when body/transform were looked up.
+    uint32_t resolved_version = 0;
+
+    /// AnimationDB key and the animation last started under it.
+    std::string animation_key;
+    std::string playing;
+
+    /// Creation order; destroyed renderers leave a null slot until Compact().
+    inline static thread_local std::vector<SpriteRenderer*> live;
+    inline static thread_local size_t destroyed = 0;
+};
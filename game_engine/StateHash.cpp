@@ -0,0 +1,225 @@
+//
+//  StateHash.cpp
+//  game_engine
+//
+//  Per-frame hash of simulation state for detecting divergence between runs.
+//
+
+#include "StateHash.hpp"
+#include "SceneDB.hpp"
+#include "Actor.hpp"
+#include "ComponentDB.hpp"
+#include "Rigidbody.hpp"
+#include "Transform.hpp"
+#include "Time.hpp"
+#include "EngineUtils.hpp"
+#include "Logger.hpp"
+#include "EngineException.hpp"
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+
+namespace {
+    /// MurmurHash3 finalizer: every input bit affects every output bit.
+    uint64_t Scramble(uint64_t x) {
+        x ^= x >> 33;
+        x *= 0xff51afd7ed558ccdULL;
+        x ^= x >> 33;
+        x *= 0xc4ceb9fe1a85ec53ULL;
+        x ^= x >> 33;
+        return x;
+    }
+
+    void Mix(uint64_t& h, uint64_t value) {
+        h = Scramble(h ^ (Scramble(value) + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2)));
+    }
+
+    uint64_t Bits(float f) {
+        uint32_t u;
+        std::memcpy(&u, &f, sizeof(u));
+        return u;
+    }
+
+    uint64_t Bits(double d) {
+        uint64_t u;
+        std::memcpy(&u, &d, sizeof(u));
+        return u;
+    }
+
+    /// FNV-1a over raw bytes.
+    uint64_t HashBytes(const char* data, size_t size) {
+        uint64_t h = 0xcbf29ce484222325ULL;
+        for (size_t i = 0; i < size; ++i) {
+            h ^= static_cast<unsigned char>(data[i]);
+            h *= 0x100000001b3ULL;
+        }
+        return h;
+    }
+
+    /// Hash of a key or value at `index`; false for types that are not hashed.
+    bool HashLuaValue(lua_State* L, int index, uint64_t& out) {
+        switch (lua_type(L, index)) {
+        case LUA_TNUMBER:
+            if (lua_isinteger(L, index)) out = Scramble(static_cast<uint64_t>(lua_tointeger(L, index)));
+            else out = Scramble(Bits(static_cast<double>(lua_tonumber(L, index))) ^ 0x5bd1e995ULL);
+            return true;
+        case LUA_TBOOLEAN:
+            out = lua_toboolean(L, index) ? 0x2545f4914f6cdd1dULL : 0x9e3779b97f4a7c15ULL;
+            return true;
+        case LUA_TSTRING: {
+            size_t size = 0;
+            const char* s = lua_tolstring(L, index, &size);
+            out = HashBytes(s, size);
+            return true;
+        }
+        default:
+            return false;
+        }
+    }
+
+    /// Order-independent hash of a table's own hashable fields.
+    uint64_t HashLuaTable(lua_State* L, int index) {
+        uint64_t sum = 0;
+        lua_pushnil(L);
+        while (lua_next(L, index)) {
+            uint64_t key = 0;
+            uint64_t value = 0;
+            if (HashLuaValue(L, -2, key) && HashLuaValue(L, -1, value)) {
+                sum += Scramble(key * 31 + value);
+            }
+            lua_pop(L, 1);
+        }
+        return sum;
+    }
+}
+
+uint64_t StateHash::Compute() {
+    lua_State* L = ComponentDB::GetLuaState();
+    const int top = lua_gettop(L);
+    uint64_t h = 0;
+
+    for (uint64_t id : SceneDB::actor_id_vec) {
+        auto it = SceneDB::actors.find(id);
+        if (it == SceneDB::actors.end()) continue;
+        const Actor& actor = *it->second;
+        if (actor.destroyed) continue;
+
+        Mix(h, actor.id);
+        Mix(h, HashBytes(actor.name.data(), actor.name.size()));
+        Mix(h, actor.tags);
+
+        for (const std::string& key : actor.component_keys) {
+            auto comp = actor.components.find(key);
+            if (comp == actor.components.end()) continue;
+            Mix(h, HashBytes(key.data(), key.size()));
+
+            luabridge::LuaRef& ref = *comp->second;
+            if (ref.isUserdata() && ref.isInstance<Rigidbody>()) {
+                const Rigidbody* rb = ref.cast<Rigidbody*>();
+                if (!rb->HasBody()) continue;
+                const RigidbodyState state = rb->CaptureState();
+                Mix(h, Bits(state.position.x));
+                Mix(h, Bits(state.position.y));
+                Mix(h, Bits(state.angle));
+                Mix(h, Bits(state.linear_velocity.x));
+                Mix(h, Bits(state.linear_velocity.y));
+                Mix(h, Bits(state.angular_velocity));
+                Mix(h, state.awake);
+            }
+            else if (ref.isUserdata() && ref.isInstance<Transform>()) {
+                const Transform* t = ref.cast<Transform*>();
+                Mix(h, Bits(t->x));
+                Mix(h, Bits(t->y));
+                Mix(h, Bits(t->rotation));
+                Mix(h, Bits(t->scale_x));
+                Mix(h, Bits(t->scale_y));
+            }
+            else if (ref.isTable()) {
+                ref.push(L);
+                Mix(h, HashLuaTable(L, lua_gettop(L)));
+                lua_settop(L, top);
+            }
+        }
+    }
+
+    Mix(h, Bits(Time::GetTotalTime()));
+    Mix(h, static_cast<uint64_t>(Time::GetFrameCount()));
+    for (size_t i = 0; i < static_cast<size_t>(RandomStream::Count); ++i) {
+        Mix(h, EngineUtils::GetRandomState(static_cast<RandomStream>(i)));
+    }
+    return h;
+}
+
+void StateHashLog::Open(const std::string& log_path) {
+    out.open(log_path, std::ios::out | std::ios::trunc);
+    if (!out) {
+        LOG_FATAL("Cannot create state hash log: " + log_path);
+        throw ConfigurationException("Cannot create state hash log: " + log_path);
+    }
+    path = log_path;
+    checking = false;
+}
+
+void StateHashLog::Load(const std::string& log_path) {
+    std::ifstream in(log_path);
+    if (!in) {
+        LOG_FATAL("Cannot open state hash log: " + log_path);
+        throw ConfigurationException("Cannot open state hash log: " + log_path);
+    }
+
+    expected.clear();
+    std::string line;
+    int line_number = 0;
+    while (std::getline(in, line)) {
+        ++line_number;
+        if (line.empty()) continue;
+        std::istringstream fields(line);
+        int frame = -1;
+        uint64_t hash = 0;
+        if (!(fields >> frame >> std::hex >> hash) || frame < 0) {
+            LOG_FATAL("Malformed state hash log " + log_path + " at line " + std::to_string(line_number));
+            throw ConfigurationException("Malformed state hash log " + log_path + " at line "
+                                         + std::to_string(line_number));
+        }
+        if (static_cast<size_t>(frame) >= expected.size()) expected.resize(frame + 1, 0);
+        expected[frame] = hash;
+    }
+    path = log_path;
+    checking = true;
+}
+
+void StateHashLog::AddFrame(int index, uint64_t hash) {
+    ++frames;
+    if (!checking) {
+        out << index << ' ' << std::hex << std::setw(16) << std::setfill('0') << hash << std::dec << '\n';
+        return;
+    }
+    if (index < 0 || static_cast<size_t>(index) >= expected.size()) return;
+    ++compared;
+    if (first_mismatch < 0 && expected[index] != hash) {
+        first_mismatch = index;
+        mismatch_expected = expected[index];
+        mismatch_actual = hash;
+    }
+}
+
+bool StateHashLog::Report() const {
+    if (!checking) {
+        LOG_INFO("State hash log " + path + ": wrote " + std::to_string(frames) + " frames");
+        return true;
+    }
+    if (compared == 0) {
+        LOG_ERROR("State hash log " + path + ": no frames to compare");
+        return false;
+    }
+    if (first_mismatch >= 0) {
+        std::ostringstream msg;
+        msg << "State hash log " << path << ": diverged at frame " << first_mismatch << " (expected "
+            << std::hex << std::setw(16) << std::setfill('0') << mismatch_expected << ", got "
+            << std::setw(16) << mismatch_actual << ")";
+        LOG_ERROR(msg.str());
+        return false;
+    }
+    LOG_INFO("State hash log " + path + ": " + std::to_string(compared) + " frames match");
+    return true;
+}
@@ -0,0 +1,83 @@
+//
+//  StateHash.hpp
+//  game_engine
+//
+//  Per-frame hash of simulation state for detecting divergence between runs.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+/**
+ * @class StateHash
+ * @brief 64-bit digest of the calling thread's world.
+ *
+ * Mixes, in actor order: every live actor's id, name and tags; for each
+ * component (in key order) the Box2D body's position, angle and velocities
+ * for a Rigidbody, the fields of a Transform, and the number, integer,
+ * boolean and string fields of a Lua component table; then time, the frame
+ * count and the engine random streams. Floats are hashed by bit pattern, so
+ * any divergence shows up in the frame it happens.
+ *
+ * Lua table fields are combined order-independently: `pairs()` order is not
+ * part of the state. Nested tables, functions and userdata are skipped.
+ * Nothing is allocated, so hashing every frame stays within the
+ * zero-allocation frame budget.
+ */
+class StateHash {
+public:
+    static uint64_t Compute();
+};
+
+/**
+ * @class StateHashLog
+ * @brief Writes one `<frame> <hash>` line per frame, or compares a run
+ * against such a file.
+ *
+ * Recording and checking the same scene with `--deterministic` and the same
+ * input must match on every frame; Report() names the first frame that
+ * does not.
+ */
+class StateHashLog {
+public:
+    /**
+     * @brief Starts a new log at `path`.
+     * @throws ConfigurationException if it cannot be created.
+     */
+    void Open(const std::string& path);
+
+    /**
+     * @brief Reads a log to compare this run against.
+     * @throws ConfigurationException if it is missing or malformed.
+     */
+    void Load(const std::string& path);
+
+    bool IsActive() const { return !path.empty(); }
+
+    /// Writes or checks frame `index`.
+    void AddFrame(int index, uint64_t hash);
+
+    /**
+     * @brief Logs how many frames were written or matched.
+     *
+     * A mismatch logs at ERROR with the first divergent frame.
+     * @return false if a frame diverged or none could be compared.
+     */
+    bool Report() const;
+
+private:
+    std::string path;
+    bool checking = false;
+    std::ofstream out;
+
+    std::vector<uint64_t> expected;         ///< by frame index
+    int frames = 0;
+    int compared = 0;
+    int first_mismatch = -1;
+    uint64_t mismatch_expected = 0;
+    uint64_t mismatch_actual = 0;
+};
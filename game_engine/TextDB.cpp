@@ -7,6 +7,7 @@
 
 #include <iostream>
 #include "TextDB.hpp"
+#include "EngineContext.hpp"
 #include "Logger.hpp"
 #include "EngineException.hpp"
 #include "ConfigManager.hpp"
@@ -48,9 +49,8 @@ void TextDB::Shutdown() {
     texts.clear();
     
     // Clear any pending draw requests
-    while (!drawRequests.empty()) {
-        drawRequests.pop();
-    }
+    drawRequests.clear();
+    queued_count = 0;
     
     if (initialized) {
         TTF_Quit();
@@ -81,6 +81,9 @@ TTF_Font* TextDB::GetFont(const std::string& fontName, int fontSize) {
         }
     }
 
+    // SDL_ttf starts with the first font load
+    Init();
+
     // Load the font
     std::string fp = ConfigManager::GetResourcesPath() + "fonts/" + fontName + ".ttf";
     if (!std::filesystem::exists(fp)) {
@@ -107,42 +110,56 @@ static inline Uint8 clamp_color_u8(float v) {
     return static_cast<Uint8>(v);
 }
 
-void TextDB::QueueTextDraw(const std::string& content, float x, float y,
-                          const std::string& fontName, float fontSize,
+void TextDB::QueueTextDraw(const char* content, float x, float y,
+                          const char* fontName, float fontSize,
                           float r, float g, float b, float a) {
-    TextDrawRequest request;
-    request.content = content;
+    // Headless contexts never render; skip the request unless it is recorded.
+    if (EngineContext::DropsDrawsOnThread()) {
+        EngineContext::CountDroppedDraws();
+        return;
+    }
+
+    // Overwrite a recycled entry so its strings keep their buffers.
+    if (queued_count == drawRequests.size()) drawRequests.emplace_back();
+    TextDrawRequest& request = drawRequests[queued_count++];
+    request.content.assign(content ? content : "");
     request.x = static_cast<int>(x);
     request.y = static_cast<int>(y);
-    request.fontName = fontName;
+    request.fontName.assign(fontName ? fontName : "");
     request.fontSize = static_cast<int>(fontSize);
     request.color = {clamp_color_u8(r), clamp_color_u8(g),
                      clamp_color_u8(b), clamp_color_u8(a)};
-    
-    drawRequests.push(request);
 }
 
-void TextDB::RenderQueuedTexts() {
-    while (!drawRequests.empty()) {
-        const TextDrawRequest& req = drawRequests.front();
-        
+void TextDB::TakeQueue(std::vector<TextDrawRequest>& out) {
+    // `out` held an older frame; its entries become the next frame's
+    // recycled storage.
+    drawRequests.resize(queued_count);
+    out.swap(drawRequests);
+    queued_count = 0;
+}
+
+void TextDB::RenderTexts(const std::vector<TextDrawRequest>& requests) {
+    for (const TextDrawRequest& req : requests) {
         // Get (or load) the requested font
         TTF_Font* font = GetFont(req.fontName, req.fontSize);
-        
+
         // Render the text with anti-aliasing for better quality
         SDL_Surface* surface = TTF_RenderText_Blended(font, req.content.c_str(), req.color);
         if (surface) {
             SDL_Texture* texture = SDL_CreateTextureFromSurface(Renderer::getSDLRenderer(), surface);
-            
+
             SDL_FRect destRect = {static_cast<float>(req.x), static_cast<float>(req.y), 0, 0};
             Helper::SDL_QueryTexture(texture, &destRect.w, &destRect.h);
             // Use dummy values for actor_id and actor_name as per requirements
             Helper::SDL_RenderCopy(Renderer::getSDLRenderer(), texture, nullptr, &destRect);
-            
+
             SDL_DestroyTexture(texture);
             SDL_FreeSurface(surface);
         }
-        
-        drawRequests.pop();
     }
 }
+
+void TextDB::ClearQueue() {
+    queued_count = 0;
+}
@@ -51,9 +51,9 @@ struct TextDrawRequest {
  * Rendering Pipeline:
  * 1. Components call QueueTextDraw() during Update phase
  * 2. Draw requests accumulate in drawRequests queue
- * 3. Engine::Render() calls RenderQueuedTexts()
- * 4. Each request is rendered as a texture (SDL_RenderCopy)
- * 5. Textures are destroyed and queue is cleared
+ * 3. RenderCommandBuffer::Record() moves the queue into a RenderFrame
+ * 4. The render stage calls RenderTexts(); each request is rendered as a
+ *    texture (SDL_RenderCopy), which is then destroyed
  *
  * @note TextDB uses static methods for global access from Lua scripts
  */
@@ -62,7 +62,9 @@ public:
     /**
      * @brief Initializes SDL2_ttf library.
      *
-     * @throws std::runtime_error if SDL_ttf initialization fails
+     * @throws RenderException if SDL_ttf initialization fails
+     *
+     * @note Called lazily by the first font load; safe to call repeatedly.
      */
     static void Init();
 
@@ -107,24 +109,38 @@ public:
      * @param a Alpha transparency (0-255)
      *
      * @note Text is rendered to screen space (ignores camera transform)
+     * @note Takes C strings straight from Lua, so a request a headless
+     *       context drops never allocates.
      */
-    static void QueueTextDraw(const std::string& content, float x, float y,
-                      const std::string& fontName, float fontSize,
+    static void QueueTextDraw(const char* content, float x, float y,
+                      const char* fontName, float fontSize,
                       float r, float g, float b, float a);
 
     /**
-     * @brief Renders all queued text draws, then clears the queue.
+     * @brief Moves this thread's queued text draws into a render frame.
+     *
+     * @note Called by RenderCommandBuffer::Record(); `out` keeps its capacity.
+     */
+    static void TakeQueue(std::vector<TextDrawRequest>& out);
+
+    /**
+     * @brief Draws recorded text requests.
      *
-     * Rendering process:
-     * 1. For each TextDrawRequest in queue:
-     *    - Render text to SDL_Texture using TTF_RenderText_Blended()
-     *    - Draw texture to screen at specified position
-     *    - Destroy texture
-     * 2. Clear queue
+     * Rendering process, for each TextDrawRequest:
+     * - Render text to SDL_Texture using TTF_RenderText_Blended()
+     * - Draw texture to screen at specified position
+     * - Destroy texture
+     *
+     * @note Called on the render thread by RenderCommandBuffer::Execute()
+     */
+    static void RenderTexts(const std::vector<TextDrawRequest>& requests);
+
+    /**
+     * @brief Drops all queued text draws without rendering them.
      *
-     * @note Called once per frame by Engine::Render()
+     * @note Used by headless engine contexts, which never render.
      */
-    static void RenderQueuedTexts();
+    static void ClearQueue();
 
 private:
     /// Font cache: font name -> font size -> TTF_Font*
@@ -136,8 +152,11 @@ private:
     /// Base path for font files
     inline static std::string fontPath = "resources/fonts/";
 
-    /// Deferred text draw request queue
-    inline static std::queue<TextDrawRequest> drawRequests;
+    /// Deferred text draw request queue. Entries past `queued_count` are
+    /// recycled storage from an older frame, reused to avoid reallocating
+    /// their strings.
+    inline static thread_local std::vector<TextDrawRequest> drawRequests;
+    inline static thread_local size_t queued_count = 0;
 
     /// Default text color (white, fully opaque)
     inline static SDL_Color textColor = {255, 255, 255, 255};
@@ -28,7 +28,15 @@ void Time::Update() {
     last_frame_time = current_time;
 
     // Clamp delta time to prevent large jumps (e.g., after debugging pause)
-    delta_time = std::clamp(elapsed.count(), 0.0001f, 0.25f);
+    Advance(std::clamp(elapsed.count(), 0.0001f, 0.25f));
+}
+
+void Time::Advance(float dt) {
+    if (!initialized) {
+        Init();
+    }
+
+    delta_time = dt;
 
     // Update total times
     unscaled_total_time += delta_time;
@@ -28,6 +28,16 @@ public:
      */
     static void Update();
 
+    /**
+     * @brief Advance time by an explicit step instead of the wall clock.
+     *
+     * Used by headless contexts that step the simulation at a fixed rate.
+     * Update() funnels its measured (clamped) frame time through here.
+     *
+     * @param dt Unscaled step in seconds.
+     */
+    static void Advance(float dt);
+
     /**
      * @brief Get the time elapsed since the last frame (affected by time scale).
      * @return Delta time in seconds.
@@ -76,15 +86,25 @@ public:
      */
     static int GetFrameCount() { return frame_count; }
 
+    /**
+     * @brief Get the zero-based index of the frame being simulated.
+     *
+     * Per-thread replacement for Helper::GetFrameNumber(), which counts
+     * presented frames process-wide and so cannot tell engine contexts apart.
+     *
+     * @return Frame index (0 before the first Update).
+     */
+    static int GetFrameNumber() { return frame_count > 0 ? frame_count - 1 : 0; }
+
 private:
-    inline static float delta_time = 1.0f / 60.0f;
-    inline static float time_scale = 1.0f;
-    inline static float fixed_delta_time = 1.0f / 60.0f;
-    inline static float total_time = 0.0f;
-    inline static float unscaled_total_time = 0.0f;
-    inline static int frame_count = 0;
-
-    inline static std::chrono::high_resolution_clock::time_point last_frame_time;
-    inline static bool initialized = false;
+    inline static thread_local float delta_time = 1.0f / 60.0f;
+    inline static thread_local float time_scale = 1.0f;
+    inline static thread_local float fixed_delta_time = 1.0f / 60.0f;
+    inline static thread_local float total_time = 0.0f;
+    inline static thread_local float unscaled_total_time = 0.0f;
+    inline static thread_local int frame_count = 0;
+
+    inline static thread_local std::chrono::high_resolution_clock::time_point last_frame_time;
+    inline static thread_local bool initialized = false;
 };
 
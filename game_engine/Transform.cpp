@@ -0,0 +1,141 @@
+//
+//  Transform.cpp
+//  game_engine
+//
+//  Non-physics transform component for position, rotation, and scale.
+//
+
+#include "Transform.hpp"
+#include "TransformHierarchy.hpp"
+#include "Actor.hpp"
+#include "Rigidbody.hpp"
+#include "ComponentDB.hpp"
+
+void Transform::Init(Actor* owner) {
+    actor = owner;
+    spatial_index = -1;
+    if (!parent && !parent_body) {
+        world_x = x;
+        world_y = y;
+        world_rotation = rotation;
+        world_scale_x = scale_x;
+        world_scale_y = scale_y;
+    }
+    SpatialHash::Insert(this);
+}
+
+void Transform::OnDestroy() {
+    TransformHierarchy::Remove(this);
+    SpatialHash::Remove(this);
+}
+
+void Transform::OnMoved() {
+    if (parent || parent_body) {
+        // Re-bucketed by the next TransformHierarchy::Update().
+        TransformHierarchy::MarkDirty(this);
+        return;
+    }
+    world_x = x;
+    world_y = y;
+    world_rotation = rotation;
+    world_scale_x = scale_x;
+    world_scale_y = scale_y;
+    for (Transform* child : children) TransformHierarchy::MarkDirty(child);
+    if (spatial_index >= 0) SpatialHash::Move(this);
+}
+
+void Transform::RefreshWorld() {
+    if (world_dirty && (parent || parent_body)) TransformHierarchy::Recompute(this);
+}
+
+bool Transform::SetParent(luabridge::LuaRef parent_ref, luabridge::LuaRef keep_world) {
+    const bool keep = keep_world.isNil() || keep_world.cast<bool>();
+    if (!actor) return false;
+    if (parent_ref.isNil()) {
+        TransformHierarchy::Detach(this, keep);
+        return true;
+    }
+    if (!parent_ref.isUserdata() || !parent_ref.isInstance<Actor>()) return false;
+
+    Actor* owner = parent_ref.cast<Actor*>();
+    if (!owner || owner == actor || owner->destroyed) return false;
+
+    Transform* parent_transform = nullptr;
+    Rigidbody* body = nullptr;
+    for (const std::string& key : owner->component_keys) {
+        auto it = owner->components.find(key);
+        if (it == owner->components.end() || !it->second->isUserdata()) continue;
+        const luabridge::LuaRef& comp = *it->second;
+        if (comp.isInstance<Transform>()) {
+            parent_transform = comp.cast<Transform*>();
+            break;
+        }
+        if (!body && comp.isInstance<Rigidbody>()) body = comp.cast<Rigidbody*>();
+    }
+    if (!parent_transform && !body) return false;
+
+    // A kinematic or static body on this actor rides along with the transform.
+    Rigidbody* new_follower = nullptr;
+    for (const std::string& key : actor->component_keys) {
+        auto it = actor->components.find(key);
+        if (it == actor->components.end() || !it->second->isUserdata()) continue;
+        const luabridge::LuaRef& comp = *it->second;
+        if (comp.isInstance<Rigidbody>() && !comp.cast<Rigidbody*>()->IsDynamic()) {
+            new_follower = comp.cast<Rigidbody*>();
+            break;
+        }
+    }
+
+    // Nothing changes if the link is rejected (a cycle).
+    if (!TransformHierarchy::Attach(this, owner, parent_transform, parent_transform ? nullptr : body, keep)) {
+        return false;
+    }
+    follower = new_follower;
+    return true;
+}
+
+luabridge::LuaRef Transform::GetParent() const {
+    lua_State* L = ComponentDB::GetLuaState();
+    if (!parent_actor) return luabridge::LuaRef(L);
+    return luabridge::LuaRef(L, parent_actor);
+}
+
+luabridge::LuaRef Transform::GetChildren() const {
+    lua_State* L = ComponentDB::GetLuaState();
+    luabridge::LuaRef table = luabridge::newTable(L);
+    int index = 1;
+    for (const Transform* child : children) {
+        if (child->actor) table[index++] = child->actor;
+    }
+    return table;
+}
+
+b2Vec2 Transform::GetWorldPosition() {
+    RefreshWorld();
+    return b2Vec2(world_x, world_y);
+}
+
+float Transform::GetWorldRotation() {
+    RefreshWorld();
+    return world_rotation;
+}
+
+b2Vec2 Transform::GetWorldScale() {
+    RefreshWorld();
+    return b2Vec2(world_scale_x, world_scale_y);
+}
+
+void Transform::SetWorldPosition(const b2Vec2& position) {
+    if (!parent && !parent_body) SetPosition(position);
+    else SetPosition(TransformHierarchy::ToLocal(TransformHierarchy::ParentPose(this), position));
+}
+
+b2Vec2 Transform::TransformPoint(const b2Vec2& local) {
+    RefreshWorld();
+    return TransformHierarchy::ToWorld({ world_x, world_y, world_rotation, world_scale_x, world_scale_y }, local);
+}
+
+b2Vec2 Transform::InverseTransformPoint(const b2Vec2& world) {
+    RefreshWorld();
+    return TransformHierarchy::ToLocal({ world_x, world_y, world_rotation, world_scale_x, world_scale_y }, world);
+}
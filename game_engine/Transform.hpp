@@ -8,7 +8,15 @@
 #pragma once
 
 #include "box2d/box2d.h"
+#include "lua.hpp"
+#include "LuaBridge/LuaBridge.h"
+#include "SpatialHash.hpp"
 #include <cmath>
+#include <cstdint>
+#include <vector>
+
+class Actor;
+class Rigidbody;
 
 /**
  * @class Transform
@@ -16,6 +24,14 @@
  *
  * Provides position, rotation, and scale without Box2D physics simulation.
  * Use this for objects that don't need collision detection.
+ *
+ * As an actor component (`"type": "Transform"`) it is registered in the
+ * SpatialHash for proximity queries and can be parented to another actor
+ * with SetParent(). x, y, rotation and scale are then relative to the
+ * parent, and the world pose is cached by TransformHierarchy. Changes go
+ * through the setters so the hash and the hierarchy stay current; C++ code
+ * writing the fields directly must call OnMoved(). Transforms created with
+ * `Transform()` in Lua are not registered and cannot be parented.
  */
 class Transform {
 public:
@@ -32,6 +48,59 @@ public:
     float scale_x = 1.0f;
     float scale_y = 1.0f;
 
+    /// Owning actor when attached as a component, nullptr otherwise.
+    Actor* actor = nullptr;
+
+    /// SpatialHash bucket and slot; spatial_index < 0 when not registered.
+    uint64_t spatial_cell = 0;
+    int spatial_index = -1;
+
+    /// Hierarchy links, maintained by TransformHierarchy. A transform has
+    /// at most one of `parent` and `parent_body`; `parent_actor` owns it.
+    Actor* parent_actor = nullptr;
+    Transform* parent = nullptr;
+    Rigidbody* parent_body = nullptr;
+    std::vector<Transform*> children;
+    /// Non-dynamic Rigidbody on the same actor, moved to the world pose.
+    Rigidbody* follower = nullptr;
+    int depth = 0;
+    bool in_hierarchy = false;
+    /// The cached world pose is stale; set on this transform and every descendant.
+    bool world_dirty = false;
+    /// The world pose changed since the last TransformHierarchy::Update().
+    bool world_moved = false;
+
+    /// Cached world pose. Equal to the local fields for an unparented transform.
+    float world_x = 0.0f;
+    float world_y = 0.0f;
+    float world_rotation = 0.0f;
+    float world_scale_x = 1.0f;
+    float world_scale_y = 1.0f;
+
+    /**
+     * @brief Attaches the component to its actor and registers it in the
+     * spatial hash.
+     */
+    void Init(Actor* owner);
+
+    /**
+     * @brief Unregisters the component and unlinks it from the hierarchy;
+     * called when it or its actor is destroyed. Children keep their world pose.
+     */
+    void OnDestroy();
+
+    /**
+     * @brief Propagates a change of the local fields: refreshes the world
+     * pose (or marks it stale under a parent) and re-buckets the spatial
+     * hash entry.
+     */
+    void OnMoved();
+
+    float GetX() const { return x; }
+    float GetY() const { return y; }
+    void SetX(float value) { x = value; OnMoved(); }
+    void SetY(float value) { y = value; OnMoved(); }
+
     /**
      * @brief Get position as Vector2.
      */
@@ -40,12 +109,12 @@ public:
     /**
      * @brief Set position from Vector2.
      */
-    void SetPosition(const b2Vec2& pos) { x = pos.x; y = pos.y; }
+    void SetPosition(const b2Vec2& pos) { x = pos.x; y = pos.y; OnMoved(); }
 
     /**
      * @brief Move by delta.
      */
-    void Translate(const b2Vec2& delta) { x += delta.x; y += delta.y; }
+    void Translate(const b2Vec2& delta) { x += delta.x; y += delta.y; OnMoved(); }
 
     /**
      * @brief Get rotation in degrees.
@@ -55,12 +124,12 @@ public:
     /**
      * @brief Set rotation in degrees.
      */
-    void SetRotation(float degrees) { rotation = degrees; }
+    void SetRotation(float degrees) { rotation = degrees; OnMoved(); }
 
     /**
      * @brief Add to rotation.
      */
-    void Rotate(float degrees) { rotation += degrees; }
+    void Rotate(float degrees) { rotation += degrees; OnMoved(); }
 
     /**
      * @brief Get scale as Vector2.
@@ -70,12 +139,17 @@ public:
     /**
      * @brief Set scale from Vector2.
      */
-    void SetScale(const b2Vec2& scale) { scale_x = scale.x; scale_y = scale.y; }
+    void SetScale(const b2Vec2& scale) { scale_x = scale.x; scale_y = scale.y; OnMoved(); }
 
     /**
      * @brief Set uniform scale.
      */
-    void SetUniformScale(float scale) { scale_x = scale; scale_y = scale; }
+    void SetUniformScale(float scale) { scale_x = scale; scale_y = scale; OnMoved(); }
+
+    float GetScaleX() const { return scale_x; }
+    float GetScaleY() const { return scale_y; }
+    void SetScaleX(float value) { scale_x = value; OnMoved(); }
+    void SetScaleY(float value) { scale_y = value; OnMoved(); }
 
     /**
      * @brief Get the up direction based on current rotation.
@@ -92,5 +166,40 @@ public:
         float rad = rotation * (b2_pi / 180.0f);
         return b2Vec2(std::cos(rad), -std::sin(rad));
     }
-};
 
+    /**
+     * @brief Parents this transform to `parent_actor`'s Transform, or to
+     * its Rigidbody if it has no Transform; nil detaches.
+     *
+     * @param keep_world Keep the current world pose (rewriting the local
+     *        fields) instead of reinterpreting them in the new parent's space.
+     * @return false if this transform is not an actor component, the parent
+     *         has neither component, or the link would form a cycle.
+     */
+    bool SetParent(luabridge::LuaRef parent_actor, luabridge::LuaRef keep_world);
+
+    /// Parent actor, or nil.
+    luabridge::LuaRef GetParent() const;
+
+    /// Actors parented to this transform, in attach order.
+    luabridge::LuaRef GetChildren() const;
+
+    int GetChildCount() const { return static_cast<int>(children.size()); }
+
+    /// World pose, refreshed first if an ancestor changed since the last update.
+    b2Vec2 GetWorldPosition();
+    float GetWorldRotation();
+    b2Vec2 GetWorldScale();
+
+    /// Moves the transform so its world position is `position`.
+    void SetWorldPosition(const b2Vec2& position);
+
+    /// Converts a point from this transform's local space to world space.
+    b2Vec2 TransformPoint(const b2Vec2& local);
+
+    /// Converts a world-space point into this transform's local space.
+    b2Vec2 InverseTransformPoint(const b2Vec2& world);
+
+    /// Recomputes the cached world pose of a parented transform if stale.
+    void RefreshWorld();
+};
@@ -0,0 +1,239 @@
+//
+//  TransformHierarchy.cpp
+//  game_engine
+//
+//  Parent/child links between actor Transforms with cached world poses.
+//
+
+#include "TransformHierarchy.hpp"
+#include "Transform.hpp"
+#include "Rigidbody.hpp"
+#include "SpatialHash.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    WorldPose CurrentWorld(const Transform* t) {
+        return { t->world_x, t->world_y, t->world_rotation, t->world_scale_x, t->world_scale_y };
+    }
+
+    /// Rewrites a transform's local fields so that under `parent` it has world pose `world`.
+    void SetLocalFromWorld(Transform* t, const WorldPose& parent, const WorldPose& world) {
+        const b2Vec2 local = TransformHierarchy::ToLocal(parent, b2Vec2(world.x, world.y));
+        t->x = local.x;
+        t->y = local.y;
+        t->rotation = world.rotation - parent.rotation;
+        t->scale_x = parent.scale_x != 0.0f ? world.scale_x / parent.scale_x : world.scale_x;
+        t->scale_y = parent.scale_y != 0.0f ? world.scale_y / parent.scale_y : world.scale_y;
+    }
+}
+
+void TransformHierarchy::Init() {
+    Clear();
+}
+
+void TransformHierarchy::Clear() {
+    for (Transform* t : nodes) {
+        t->parent_actor = nullptr;
+        t->parent = nullptr;
+        t->parent_body = nullptr;
+        t->follower = nullptr;
+        t->children.clear();
+        t->depth = 0;
+        t->in_hierarchy = false;
+        t->world_dirty = false;
+        t->world_moved = false;
+    }
+    nodes.clear();
+    order_dirty = false;
+}
+
+WorldPose TransformHierarchy::BodyPose(const Rigidbody* body) {
+    const b2Vec2 p = body->GetPosition();
+    return { p.x, p.y, body->GetRotation(), 1.0f, 1.0f };
+}
+
+WorldPose TransformHierarchy::ParentPose(Transform* t) {
+    if (t->parent) {
+        t->parent->RefreshWorld();
+        return CurrentWorld(t->parent);
+    }
+    return BodyPose(t->parent_body);
+}
+
+b2Vec2 TransformHierarchy::ToWorld(const WorldPose& pose, const b2Vec2& local) {
+    const float r = pose.rotation * (b2_pi / 180.0f);
+    const float c = std::cos(r);
+    const float s = std::sin(r);
+    const float ox = local.x * pose.scale_x;
+    const float oy = local.y * pose.scale_y;
+    return b2Vec2(pose.x + c * ox - s * oy, pose.y + s * ox + c * oy);
+}
+
+b2Vec2 TransformHierarchy::ToLocal(const WorldPose& pose, const b2Vec2& world) {
+    const float r = pose.rotation * (b2_pi / 180.0f);
+    const float c = std::cos(r);
+    const float s = std::sin(r);
+    const float dx = world.x - pose.x;
+    const float dy = world.y - pose.y;
+    const float lx = c * dx + s * dy;
+    const float ly = -s * dx + c * dy;
+    return b2Vec2(pose.scale_x != 0.0f ? lx / pose.scale_x : 0.0f,
+                  pose.scale_y != 0.0f ? ly / pose.scale_y : 0.0f);
+}
+
+void TransformHierarchy::Link(Transform* t) {
+    if (t->in_hierarchy) return;
+    t->in_hierarchy = true;
+    nodes.push_back(t);
+    order_dirty = true;
+}
+
+void TransformHierarchy::UnlinkIfIsolated(Transform* t) {
+    if (!t->in_hierarchy || t->parent || t->parent_body || !t->children.empty()) return;
+    t->in_hierarchy = false;
+    nodes.erase(std::find(nodes.begin(), nodes.end(), t));
+}
+
+void TransformHierarchy::SetDepth(Transform* t, int depth) {
+    t->depth = depth;
+    for (Transform* child : t->children) SetDepth(child, depth + 1);
+    order_dirty = true;
+}
+
+void TransformHierarchy::MarkDirty(Transform* t) {
+    // A dirty transform's descendants are already dirty.
+    if (t->world_dirty) return;
+    t->world_dirty = true;
+    for (Transform* child : t->children) MarkDirty(child);
+}
+
+void TransformHierarchy::Recompute(Transform* t) {
+    const WorldPose p = ParentPose(t);
+    const b2Vec2 position = ToWorld(p, b2Vec2(t->x, t->y));
+    const WorldPose w = { position.x, position.y, p.rotation + t->rotation,
+                          p.scale_x * t->scale_x, p.scale_y * t->scale_y };
+    if (w.x != t->world_x || w.y != t->world_y || w.rotation != t->world_rotation
+        || w.scale_x != t->world_scale_x || w.scale_y != t->world_scale_y) {
+        t->world_x = w.x;
+        t->world_y = w.y;
+        t->world_rotation = w.rotation;
+        t->world_scale_x = w.scale_x;
+        t->world_scale_y = w.scale_y;
+        t->world_moved = true;
+    }
+    t->world_dirty = false;
+}
+
+bool TransformHierarchy::Attach(Transform* child, Actor* owner, Transform* parent, Rigidbody* body,
+                                bool keep_world) {
+    for (const Transform* a = parent; a; a = a->parent) {
+        if (a == child) return false;
+    }
+
+    child->RefreshWorld();
+    const WorldPose world = CurrentWorld(child);
+
+    if (child->parent) {
+        std::vector<Transform*>& siblings = child->parent->children;
+        siblings.erase(std::find(siblings.begin(), siblings.end(), child));
+        UnlinkIfIsolated(child->parent);
+    }
+
+    child->parent_actor = owner;
+    child->parent = parent;
+    child->parent_body = parent ? nullptr : body;
+    if (parent) {
+        parent->children.push_back(child);
+        Link(parent);
+    }
+    Link(child);
+    SetDepth(child, parent ? parent->depth + 1 : 0);
+
+    if (keep_world) SetLocalFromWorld(child, ParentPose(child), world);
+
+    child->world_dirty = false;
+    MarkDirty(child);
+    Recompute(child);
+    return true;
+}
+
+void TransformHierarchy::Detach(Transform* child, bool keep_world) {
+    if (!child->parent && !child->parent_body) return;
+
+    child->RefreshWorld();
+    if (keep_world) {
+        child->x = child->world_x;
+        child->y = child->world_y;
+        child->rotation = child->world_rotation;
+        child->scale_x = child->world_scale_x;
+        child->scale_y = child->world_scale_y;
+    }
+
+    if (child->parent) {
+        std::vector<Transform*>& siblings = child->parent->children;
+        siblings.erase(std::find(siblings.begin(), siblings.end(), child));
+        UnlinkIfIsolated(child->parent);
+    }
+    child->parent_actor = nullptr;
+    child->parent = nullptr;
+    child->parent_body = nullptr;
+    child->follower = nullptr;
+    child->world_dirty = false;
+    child->world_moved = false;
+    SetDepth(child, 0);
+    UnlinkIfIsolated(child);
+
+    // Back to world == local, with descendants marked and the hash updated.
+    child->OnMoved();
+}
+
+void TransformHierarchy::Remove(Transform* t) {
+    if (!t->in_hierarchy) return;
+    while (!t->children.empty()) Detach(t->children.back(), true);
+    if (t->parent || t->parent_body) Detach(t, false);
+    UnlinkIfIsolated(t);
+}
+
+void TransformHierarchy::RemoveBody(Rigidbody* body) {
+    for (size_t i = 0; i < nodes.size();) {
+        Transform* t = nodes[i];
+        if (t->follower == body) t->follower = nullptr;
+        if (t->parent_body == body) {
+            // Detaching may shrink `nodes`; rescan from the start.
+            Detach(t, true);
+            i = 0;
+            continue;
+        }
+        ++i;
+    }
+}
+
+void TransformHierarchy::Update() {
+    if (order_dirty) {
+        std::stable_sort(nodes.begin(), nodes.end(),
+                         [](const Transform* a, const Transform* b) { return a->depth < b->depth; });
+        order_dirty = false;
+    }
+
+    // Parents come before their children, so each recompute reads a fresh
+    // parent pose.
+    for (Transform* t : nodes) {
+        if (t->parent_body) {
+            Recompute(t);
+            if (t->world_moved) {
+                for (Transform* child : t->children) MarkDirty(child);
+            }
+        }
+        else if (t->parent && t->world_dirty) {
+            Recompute(t);
+        }
+
+        if (!t->world_moved) continue;
+        t->world_moved = false;
+        if (t->spatial_index >= 0) SpatialHash::Move(t);
+        if (t->follower && t->follower->HasBody()) {
+            t->follower->SetPose(b2Vec2(t->world_x, t->world_y), t->world_rotation);
+        }
+    }
+}
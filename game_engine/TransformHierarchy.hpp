@@ -0,0 +1,98 @@
+//
+//  TransformHierarchy.hpp
+//  game_engine
+//
+//  Parent/child links between actor Transforms with cached world poses.
+//
+
+#pragma once
+
+#include <vector>
+#include "box2d/box2d.h"
+
+class Actor;
+class Transform;
+class Rigidbody;
+
+/**
+ * @struct WorldPose
+ * @brief Position, rotation (degrees clockwise) and scale in world space.
+ */
+struct WorldPose {
+    float x;
+    float y;
+    float rotation;
+    float scale_x;
+    float scale_y;
+};
+
+/**
+ * @class TransformHierarchy
+ * @brief Static per-world registry of parented Transforms.
+ *
+ * A child's x/y are offsets in its parent's space: scaled by the parent's
+ * scale, then rotated by its rotation like a Box2D body's local points.
+ * Rotation adds up and scale multiplies (no shear, so a rotated child of a
+ * non-uniformly scaled parent keeps its own axes).
+ *
+ * Changing a transform marks it and its descendants dirty; nothing else is
+ * recomputed until the world pose is read or Update() runs. Update() walks
+ * every linked transform once per frame in depth order (parents before
+ * children), recomputes only the dirty ones, re-buckets those that moved in
+ * the SpatialHash and moves their actor's kinematic or static Rigidbody
+ * along. Transforms parented to a Rigidbody follow the body's pose as of the
+ * last physics step.
+ */
+class TransformHierarchy {
+public:
+    static void Init();
+
+    /// Forgets every link. Called before the scene is torn down.
+    static void Clear();
+
+    /// Links `child` under `parent` or, when `parent` is null, under `body`;
+    /// `owner` is the actor holding either. Returns false if the link would
+    /// form a cycle.
+    static bool Attach(Transform* child, Actor* owner, Transform* parent, Rigidbody* body, bool keep_world);
+
+    /// Makes `child` a root, optionally keeping its world pose.
+    static void Detach(Transform* child, bool keep_world);
+
+    /// Unlinks a destroyed transform; its children become roots in place.
+    static void Remove(Transform* transform);
+
+    /// Detaches every transform parented to a body that is going away.
+    static void RemoveBody(Rigidbody* body);
+
+    /// Marks `transform` and its descendants stale.
+    static void MarkDirty(Transform* transform);
+
+    /// Recomputes a transform's world pose from its parent's.
+    static void Recompute(Transform* transform);
+
+    /// Depth-ordered pass over every linked transform. Called once per frame
+    /// after the physics step.
+    static void Update();
+
+    static size_t GetCount() { return nodes.size(); }
+
+    /// World pose of a parent body.
+    static WorldPose BodyPose(const Rigidbody* body);
+
+    /// World pose of a linked transform's parent (refreshed first).
+    static WorldPose ParentPose(Transform* transform);
+
+    /// Maps a point from the space of `pose` to world space.
+    static b2Vec2 ToWorld(const WorldPose& pose, const b2Vec2& local);
+
+    /// Maps a world point into the space of `pose`.
+    static b2Vec2 ToLocal(const WorldPose& pose, const b2Vec2& world);
+
+private:
+    static void Link(Transform* transform);
+    static void UnlinkIfIsolated(Transform* transform);
+    static void SetDepth(Transform* transform, int depth);
+
+    inline static thread_local std::vector<Transform*> nodes;
+    inline static thread_local bool order_dirty = false;
+};
@@ -7,6 +7,8 @@
 
 #include "Tween.hpp"
 #include "Logger.hpp"
+#include "Profiler.hpp"
+#include "SceneDB.hpp"
 #include <cmath>
 #include <algorithm>
 
@@ -28,6 +30,7 @@ void Tween::Update(float delta_time) {
             continue;
         }
 
+        SceneDB::RunningActorScope running(tween.owner);
         tween.elapsed += delta_time;
         float t = std::min(tween.elapsed / tween.duration, 1.0f);
         float eased_t = ApplyEasing(t, tween.ease_type);
@@ -48,6 +51,7 @@ void Tween::Update(float delta_time) {
         if (t >= 1.0f) {
             try {
                 if (tween.on_complete && tween.on_complete->isFunction()) {
+                    Profiler::CountLuaCall();
                     (*tween.on_complete)();
                 }
             }
@@ -83,6 +87,7 @@ int Tween::To(float from, float to, float duration,
     tween.elapsed = 0.0f;
     tween.ease_type = ParseEaseType(ease_type);
     tween.cancelled = false;
+    tween.owner = SceneDB::GetRunningActor();
 
     if (on_update.isFunction()) {
         tween.on_update = std::make_shared<luabridge::LuaRef>(on_update);
@@ -116,6 +121,14 @@ void Tween::Clear() {
     tweens.clear();
 }
 
+void Tween::ClearNonResident() {
+    tweens.erase(
+        std::remove_if(tweens.begin(), tweens.end(),
+            [](const TweenInstance& tw) { return !SceneDB::IsResidentOwner(tw.owner); }),
+        tweens.end()
+    );
+}
+
 EaseType Tween::ParseEaseType(const std::string& name) {
     if (name == "Linear") return EaseType::Linear;
     if (name == "EaseInQuad") return EaseType::EaseInQuad;
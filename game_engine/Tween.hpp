@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <memory>
@@ -44,6 +45,7 @@ struct TweenInstance {
     std::shared_ptr<luabridge::LuaRef> on_update;
     std::shared_ptr<luabridge::LuaRef> on_complete;
     bool cancelled = false;
+    uint64_t owner;    // Actor that started it (SceneDB::NO_ACTOR outside any actor)
 };
 
 /**
@@ -92,13 +94,25 @@ public:
     static void CancelAll();
 
     /**
-     * @brief Clear all tweens. Called on scene change.
+     * @brief Clear all tweens. Called on shutdown.
      */
     static void Clear();
 
+    /**
+     * @brief Drops the tweens not owned by a resident (DontDestroy or
+     * additive) actor. Called on Scene.Load.
+     */
+    static void ClearNonResident();
+
+    /// Active tweens, copied by scene snapshots.
+    static const std::vector<TweenInstance>& GetTweens() { return tweens; }
+
+    /// Replaces the active tweens with a snapshot's copy.
+    static void RestoreTweens(const std::vector<TweenInstance>& saved) { tweens = saved; }
+
 private:
-    inline static std::vector<TweenInstance> tweens;
-    inline static int next_tween_id = 1;
+    inline static thread_local std::vector<TweenInstance> tweens;
+    inline static thread_local int next_tween_id = 1;
 
     /**
      * @brief Parse easing type from string.
@@ -0,0 +1,409 @@
+//
+//  WorldStreaming.cpp
+//  game_engine
+//
+//  Loads and freezes a scene's actors by grid cell around the camera.
+//
+
+#include "WorldStreaming.hpp"
+#include "SceneDB.hpp"
+#include "Actor.hpp"
+#include "Transform.hpp"
+#include "SpriteRenderer.hpp"
+#include "SpatialHash.hpp"
+#include "LuaWorkerPool.hpp"
+#include "Renderer.hpp"
+#include "ComponentDB.hpp"
+#include "Logger.hpp"
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <string>
+
+namespace {
+    int64_t PackCell(int cx, int cy) {
+        return (static_cast<int64_t>(cx) << 32) | static_cast<uint32_t>(cy);
+    }
+
+    /// Reads `x` and `y` from the Rigidbody or Transform entries of a
+    /// "components" object; keys not present are left alone.
+    bool ReadPosition(const rapidjson::Value& components, float& x, float& y) {
+        if (!components.IsObject()) return false;
+        bool found = false;
+        for (auto it = components.MemberBegin(); it != components.MemberEnd(); ++it) {
+            const rapidjson::Value& comp = it->value;
+            if (!comp.IsObject()) continue;
+            std::string type = it->name.GetString();
+            if (comp.HasMember("type") && comp["type"].IsString()) type = comp["type"].GetString();
+            if (type != "Rigidbody" && type != "Transform") continue;
+            found = true;
+            if (comp.HasMember("x") && comp["x"].IsNumber()) x = comp["x"].GetFloat();
+            if (comp.HasMember("y") && comp["y"].IsNumber()) y = comp["y"].GetFloat();
+        }
+        return found;
+    }
+
+    float ReadFloat(const rapidjson::Value& obj, const char* key, float fallback) {
+        return obj.HasMember(key) && obj[key].IsNumber() ? obj[key].GetFloat() : fallback;
+    }
+}
+
+void WorldStreaming::Init() {
+    Clear();
+}
+
+void WorldStreaming::Clear() {
+    enabled = false;
+    first_update = true;
+    entries.SetNull();
+    entries.GetAllocator().Clear();
+    cells.clear();
+    cell_index.clear();
+    frozen_bodies.clear();
+}
+
+bool WorldStreaming::Configure(const rapidjson::Value& config) {
+    if (!config.IsObject()) {
+        LOG_WARNING("\"streaming\" must be an object; loading the whole scene");
+        return false;
+    }
+
+    cell_size = ReadFloat(config, "cell_size", 16.0f);
+    if (cell_size <= 0.0f) {
+        LOG_WARNING("streaming cell_size must be positive; using 16");
+        cell_size = 16.0f;
+    }
+    load_radius = std::max(0.0f, ReadFloat(config, "load_radius", cell_size * 1.25f));
+    unload_radius = ReadFloat(config, "unload_radius", load_radius + cell_size * 0.5f);
+    if (unload_radius < load_radius) {
+        LOG_WARNING("streaming unload_radius is below load_radius; using load_radius");
+        unload_radius = load_radius;
+    }
+    actors_per_frame = 16;
+    if (config.HasMember("actors_per_frame") && config["actors_per_frame"].IsInt()) {
+        actors_per_frame = std::max(1, config["actors_per_frame"].GetInt());
+    }
+    entries.SetArray();
+    enabled = true;
+    return true;
+}
+
+bool WorldStreaming::Defer(const rapidjson::Value& entry) {
+    if (!enabled) return false;
+    if (entry.HasMember("stream") && entry["stream"].IsBool() && !entry["stream"].GetBool()) return false;
+
+    int cell = -1;
+    if (entry.HasMember("cell")) {
+        const rapidjson::Value& at = entry["cell"];
+        if (at.IsArray() && at.Size() == 2 && at[0].IsInt() && at[1].IsInt()) {
+            cell = FindCell(at[0].GetInt(), at[1].GetInt());
+        } else {
+            LOG_WARNING("\"cell\" must be [cx, cy]; placing the actor by position");
+        }
+    }
+
+    if (cell < 0) {
+        float x = 0.0f;
+        float y = 0.0f;
+        bool found = false;
+        if (entry.HasMember("template") && entry["template"].IsString()) {
+            const rapidjson::Document& temp = SceneDB::GetTemplate(entry["template"].GetString());
+            if (temp.HasMember("components")) found = ReadPosition(temp["components"], x, y);
+        }
+        if (entry.HasMember("components")) found = ReadPosition(entry["components"], x, y) || found;
+        if (!found) return false;
+        cell = CellAt(x, y);
+    }
+
+    // A cell that already settled has to load the newcomer too.
+    cells[cell].entries.push_back(entries.Size());
+    cells[cell].settled = false;
+    // The reader's document goes away with the next entry; keep a copy.
+    entries.PushBack(rapidjson::Value(entry, entries.GetAllocator()), entries.GetAllocator());
+    return true;
+}
+
+void WorldStreaming::Report(size_t scene_actors) {
+    if (!enabled) return;
+    LOG_INFO("Streaming " + std::to_string(entries.Size()) + " of " + std::to_string(scene_actors)
+             + " actors in " + std::to_string(cells.size()) + " cells");
+}
+
+int WorldStreaming::FindCell(int cx, int cy) {
+    auto [it, inserted] = cell_index.try_emplace(PackCell(cx, cy), static_cast<int>(cells.size()));
+    if (inserted) {
+        Cell& cell = cells.emplace_back();
+        cell.cx = cx;
+        cell.cy = cy;
+    }
+    return it->second;
+}
+
+int WorldStreaming::CellAt(float x, float y) {
+    return FindCell(static_cast<int>(std::floor(x / cell_size)), static_cast<int>(std::floor(y / cell_size)));
+}
+
+void WorldStreaming::Update() {
+    if (!enabled) return;
+
+    // Distance from the camera to the nearest point of each cell.
+    const glm::vec2 focus = Renderer::GetCameraPosition();
+    distances.resize(cells.size());
+    work_order.clear();
+    for (size_t i = 0; i < cells.size(); ++i) {
+        Cell& cell = cells[i];
+        const float min_x = cell.cx * cell_size;
+        const float min_y = cell.cy * cell_size;
+        const float dx = std::max({ min_x - focus.x, 0.0f, focus.x - (min_x + cell_size) });
+        const float dy = std::max({ min_y - focus.y, 0.0f, focus.y - (min_y + cell_size) });
+        distances[i] = std::sqrt(dx * dx + dy * dy);
+
+        const bool active = cell.active ? distances[i] <= unload_radius : distances[i] <= load_radius;
+        if (active != cell.active) {
+            cell.active = active;
+            cell.settled = false;
+            cell.cursor = 0;
+        }
+        if (!cell.settled) work_order.push_back(static_cast<int>(i));
+    }
+
+    // Loads before freezes, nearest first.
+    std::sort(work_order.begin(), work_order.end(), [](int a, int b) {
+        if (cells[a].active != cells[b].active) return cells[a].active;
+        if (distances[a] != distances[b]) return distances[a] < distances[b];
+        return a < b;
+    });
+
+    int budget = first_update ? INT_MAX : actors_per_frame;
+    first_update = false;
+    for (int i : work_order) {
+        if (budget <= 0) break;
+        budget -= Work(i, budget);
+    }
+}
+
+int WorldStreaming::Work(int cell_index, int budget) {
+    auto& actors = SceneDB::actors;
+    int done = 0;
+
+    // Freezing may file actors under new cells, which can grow `cells`; the
+    // cell is looked up by index after each step.
+    while (done < budget) {
+        Cell& cell = cells[cell_index];
+        if (cell.cursor >= cell.actors.size()) break;
+
+        const uint64_t id = cell.actors[cell.cursor];
+        auto it = actors.find(id);
+        if (it == actors.end() || it->second->destroyed) {
+            cell.actors.erase(cell.actors.begin() + cell.cursor);
+            frozen_bodies.erase(id);
+            continue;
+        }
+        Actor& actor = *it->second;
+
+        if (cell.active) {
+            ++cell.cursor;
+            if (actor.frozen) {
+                Thaw(actor);
+                ++done;
+            }
+            continue;
+        }
+        if (actor.frozen) {
+            ++cell.cursor;
+            continue;
+        }
+
+        // File the actor under the cell it is in now. One that walked into
+        // an active cell stays awake there.
+        float x;
+        float y;
+        int home = cell_index;
+        if (ActorPosition(actor, x, y)) home = CellAt(x, y);
+        if (home != cell_index) {
+            cells[cell_index].actors.erase(cells[cell_index].actors.begin() + cells[cell_index].cursor);
+            cells[home].actors.push_back(id);
+            actor.stream_cell = home;
+            if (cells[home].active) continue;
+        } else {
+            ++cells[cell_index].cursor;
+        }
+        Freeze(actor);
+        ++done;
+    }
+
+    Cell& cell = cells[cell_index];
+    if (cell.cursor < cell.actors.size()) return done;
+    if (cell.active) {
+        while (done < budget && cell.loaded < cell.entries.size()) {
+            Actor* actor = SceneDB::InstantiateEntry(entries[cell.entries[cell.loaded++]]);
+            actor->stream_cell = cell_index;
+            cell.actors.push_back(actor->id);
+            // Already awake; nothing left to thaw.
+            cell.cursor = cell.actors.size();
+            ++done;
+        }
+        if (cell.loaded < cell.entries.size()) return done;
+    }
+    cell.settled = true;
+    return done;
+}
+
+void WorldStreaming::Freeze(Actor& actor) {
+    auto& bodies = frozen_bodies[actor.id];
+    bodies.clear();
+    for (const std::string& key : actor.component_keys) {
+        auto it = actor.components.find(key);
+        if (it == actor.components.end()) continue;
+        luabridge::LuaRef& comp = *it->second;
+        // Isolated components live on the workers and keep running.
+        if (LuaWorkerPool::IsStub(comp)) continue;
+        SceneDB::removeComponentFromCaches(actor.id, key);
+        if (!comp.isUserdata()) continue;
+
+        if (comp.isInstance<Rigidbody>()) {
+            Rigidbody* rb = comp.cast<Rigidbody*>();
+            if (!rb->HasBody()) continue;
+            const RigidbodyState state = rb->CaptureState();
+            bodies.emplace_back(rb, state);
+            // GetPosition() reports these while there is no body, and a
+            // snapshot restore recreates the body here.
+            rb->x = state.position.x;
+            rb->y = state.position.y;
+            rb->rotation = state.angle * (180.0f / b2_pi);
+            // Transforms parented to the body keep following its frozen pose.
+            rb->DestroyBody();
+        } else if (comp.isInstance<Transform>()) {
+            SpatialHash::Remove(comp.cast<Transform*>());
+        } else if (comp.isInstance<SpriteRenderer>()) {
+            // Sprites and controllers stay registered and skip frozen actors,
+            // so a thaw keeps draw order, animation and controller state.
+            comp.cast<SpriteRenderer*>()->SetSuspended(true);
+        }
+    }
+    actor.frozen = true;
+}
+
+void WorldStreaming::Thaw(Actor& actor) {
+    auto saved = frozen_bodies.find(actor.id);
+    for (const std::string& key : actor.component_keys) {
+        auto it = actor.components.find(key);
+        if (it == actor.components.end()) continue;
+        luabridge::LuaRef& comp = *it->second;
+        if (LuaWorkerPool::IsStub(comp)) continue;
+
+        if (comp.isUserdata() && comp.isInstance<Rigidbody>()) {
+            Rigidbody* rb = comp.cast<Rigidbody*>();
+            if (!rb->HasBody()) rb->Init(&actor);
+            if (saved != frozen_bodies.end()) {
+                for (const auto& [body, state] : saved->second) {
+                    if (body == rb) rb->RestoreState(state);
+                }
+            }
+        } else if (comp.isUserdata() && comp.isInstance<Transform>()) {
+            SpatialHash::Insert(comp.cast<Transform*>());
+        } else if (comp.isUserdata() && comp.isInstance<SpriteRenderer>()) {
+            comp.cast<SpriteRenderer*>()->SetSuspended(false);
+        }
+        SceneDB::addComponentToCaches(actor.id, key, it->second);
+    }
+    if (saved != frozen_bodies.end()) frozen_bodies.erase(saved);
+    actor.frozen = false;
+}
+
+void WorldStreaming::ResumeSprites(Actor& actor) {
+    for (const std::string& key : actor.component_keys) {
+        auto it = actor.components.find(key);
+        if (it == actor.components.end() || !it->second->isUserdata()) continue;
+        if (it->second->isInstance<SpriteRenderer>()) it->second->cast<SpriteRenderer*>()->SetSuspended(false);
+    }
+}
+
+bool WorldStreaming::ActorPosition(const Actor& actor, float& x, float& y) {
+    for (const std::string& key : actor.component_keys) {
+        auto it = actor.components.find(key);
+        if (it == actor.components.end() || !it->second->isUserdata()) continue;
+        const luabridge::LuaRef& comp = *it->second;
+        if (comp.isInstance<Rigidbody>()) {
+            const b2Vec2 p = comp.cast<Rigidbody*>()->GetPosition();
+            x = p.x;
+            y = p.y;
+            return true;
+        }
+        if (comp.isInstance<Transform>()) {
+            const b2Vec2 p = comp.cast<Transform*>()->GetWorldPosition();
+            x = p.x;
+            y = p.y;
+            return true;
+        }
+    }
+    return false;
+}
+
+StreamingState WorldStreaming::CaptureState() {
+    StreamingState state;
+    if (!enabled) return state;
+    state.loaded.reserve(cells.size());
+    state.actors.reserve(cells.size());
+    for (const Cell& cell : cells) {
+        state.loaded.push_back(cell.loaded);
+        state.actors.push_back(cell.actors);
+    }
+    return state;
+}
+
+void WorldStreaming::RestoreState(const StreamingState& state) {
+    if (!enabled) return;
+    auto& actors = SceneDB::actors;
+    frozen_bodies.clear();
+
+    // The restore woke every actor. Cells that had anything are marked
+    // active, and Update() freezes the ones that are out of range again.
+    for (size_t i = 0; i < cells.size(); ++i) {
+        Cell& cell = cells[i];
+        cell.loaded = i < state.loaded.size() ? state.loaded[i] : 0;
+        cell.actors.clear();
+        if (i < state.actors.size()) {
+            for (uint64_t id : state.actors[i]) {
+                auto it = actors.find(id);
+                if (it == actors.end()) continue;
+                it->second->stream_cell = static_cast<int>(i);
+                if (it->second->frozen) ResumeSprites(*it->second);
+                it->second->frozen = false;
+                cell.actors.push_back(id);
+            }
+        }
+        cell.active = cell.loaded > 0 || !cell.actors.empty();
+        cell.settled = !cell.active;
+        cell.cursor = 0;
+    }
+}
+
+luabridge::LuaRef WorldStreaming::GetStats() {
+    lua_State* L = ComponentDB::GetLuaState();
+    int active_cells = 0;
+    int pending_cells = 0;
+    int live = 0;
+    int frozen = 0;
+    int unloaded = 0;
+    for (const Cell& cell : cells) {
+        if (cell.active) ++active_cells;
+        if (!cell.settled) ++pending_cells;
+        unloaded += static_cast<int>(cell.entries.size() - cell.loaded);
+        for (uint64_t id : cell.actors) {
+            auto it = SceneDB::actors.find(id);
+            if (it == SceneDB::actors.end() || it->second->destroyed) continue;
+            if (it->second->frozen) ++frozen;
+            else ++live;
+        }
+    }
+
+    luabridge::LuaRef stats = luabridge::newTable(L);
+    stats["cells"] = static_cast<int>(cells.size());
+    stats["active_cells"] = active_cells;
+    stats["pending_cells"] = pending_cells;
+    stats["actors"] = live;
+    stats["frozen_actors"] = frozen;
+    stats["unloaded_entries"] = unloaded;
+    return stats;
+}
@@ -0,0 +1,140 @@
+//
+//  WorldStreaming.hpp
+//  game_engine
+//
+//  Loads and freezes a scene's actors by grid cell around the camera.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "rapidjson/document.h"
+#include "lua/lua.hpp"
+#include "LuaBridge/LuaBridge.h"
+#include "Rigidbody.hpp"
+
+class Actor;
+
+/// Streaming progress saved with a scene snapshot.
+struct StreamingState {
+    std::vector<size_t> loaded;                 ///< per cell: scene entries instantiated
+    std::vector<std::vector<uint64_t>> actors;  ///< per cell: actors filed under it
+};
+
+/**
+ * @class WorldStreaming
+ * @brief Splits a scene into square cells and keeps only the cells near the
+ * camera loaded and running.
+ *
+ * A scene opts in with a top-level `"streaming"` object (`cell_size`,
+ * `load_radius`, `unload_radius`, `actors_per_frame`). Each actor entry is
+ * filed under the cell of its Rigidbody or Transform `x`/`y` (scene values
+ * over template values), or under an authored `"cell": [cx, cy]`. Entries
+ * with `"stream": false` or no position load with the scene as usual.
+ *
+ * A cell activates when the camera comes within `load_radius` of it and
+ * deactivates beyond `unload_radius`, so a camera on a border does not make
+ * it flicker. An active cell instantiates its entries the first time, and
+ * thaws its frozen actors after that. A deactivated cell freezes its actors:
+ * their components leave the update caches, their bodies are removed (the
+ * motion is kept and put back on thaw), sprites stop drawing and pause their
+ * animation, character controllers stop, and Transforms leave the spatial
+ * hash. Lua fields, sprite draw order, controller state and Transforms
+ * parented to a frozen body (which hold its last pose) are kept as they
+ * are, so a thawed actor carries on where it froze. At freeze time an
+ * actor is filed under the cell it is in now, so a roaming enemy freezes and
+ * thaws where it went. No more than `actors_per_frame` actors are
+ * instantiated, frozen or thawed per frame, nearest cells first; the cells
+ * around the camera on a scene's first frame load at once.
+ *
+ * Frozen actors are still found by Actor.Find and tag queries, and
+ * `actor:IsFrozen()` tells them apart. Actors spawned at runtime, isolated
+ * components and DontDestroy actors are never streamed.
+ */
+class WorldStreaming {
+public:
+    static void Init();
+
+    /// Forgets the scene's cells and entries. Called on scene load and shutdown.
+    static void Clear();
+
+    /**
+     * @brief Reads a scene's `"streaming"` block.
+     * @return false when the block is unusable and the scene loads whole.
+     */
+    static bool Configure(const rapidjson::Value& config);
+
+    /**
+     * @brief Files a copy of a scene entry under its cell.
+     * @return false if the entry has to load with the scene.
+     */
+    static bool Defer(const rapidjson::Value& entry);
+
+    /// Logs how much of a finished scene read was deferred.
+    static void Report(size_t scene_actors);
+
+    /// Activates, loads and freezes cells around the camera. Called once
+    /// per frame by SceneDB before new actors join the scene.
+    static void Update();
+
+    static bool IsEnabled() { return enabled; }
+
+    static StreamingState CaptureState();
+
+    /// Re-files actors after Scene.Restore, which leaves every actor thawed.
+    static void RestoreState(const StreamingState& state);
+
+    /**
+     * @brief Lua table `{ cells, active_cells, pending_cells, actors,
+     * frozen_actors, unloaded_entries }`.
+     */
+    static luabridge::LuaRef GetStats();
+
+private:
+    struct Cell {
+        int cx, cy;
+        std::vector<rapidjson::SizeType> entries;   ///< indices into `entries`, in scene order
+        size_t loaded = 0;                          ///< entries instantiated so far
+        std::vector<uint64_t> actors;               ///< instantiated or moved in, live or frozen
+        bool active = false;
+        bool settled = true;                        ///< actors match `active`, entries loaded
+        size_t cursor = 0;                          ///< next actor to freeze or thaw
+    };
+
+    static int FindCell(int cx, int cy);
+    static int CellAt(float x, float y);
+
+    /// Freezes, thaws or loads up to `budget` actors of a cell; returns the count.
+    static int Work(int cell_index, int budget);
+
+    static void Freeze(Actor& actor);
+    static void Thaw(Actor& actor);
+
+    /// Resumes the sprite animations of an actor a restore woke without Thaw().
+    static void ResumeSprites(Actor& actor);
+
+    /// Current position of an actor's Rigidbody or Transform.
+    static bool ActorPosition(const Actor& actor, float& x, float& y);
+
+    inline static thread_local bool enabled = false;
+    inline static thread_local bool first_update = true;
+    inline static thread_local float cell_size = 16.0f;
+    inline static thread_local float load_radius = 20.0f;
+    inline static thread_local float unload_radius = 28.0f;
+    inline static thread_local int actors_per_frame = 16;
+
+    /// Deferred scene entries, copied out of SceneReader as they are read.
+    inline static thread_local rapidjson::Document entries;
+    inline static thread_local std::vector<Cell> cells;
+    inline static thread_local std::unordered_map<int64_t, int> cell_index;
+    /// Body motion of frozen actors, restored on thaw.
+    inline static thread_local std::unordered_map<uint64_t, std::vector<std::pair<Rigidbody*, RigidbodyState>>> frozen_bodies;
+
+    /// Scratch for Update, reused so steady frames do not allocate.
+    inline static thread_local std::vector<float> distances;
+    inline static thread_local std::vector<int> work_order;
+};
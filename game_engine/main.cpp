@@ -6,6 +6,7 @@
 #include <iostream>
 #include <string>
 #include "Engine.hpp"
+#include "EngineContext.hpp"
 #include "SDL2/SDL.h"
 #include "SDL2_image/SDL_image.h"
 #include "Renderer.hpp"
@@ -26,6 +27,18 @@ namespace {
             << "  --debug              Enable debug logging\n"
             << "  --self-check [N]     Run N frames (default 60) then exit 0. For CI / smoke test.\n"
             << "  --screenshot <path>  Save the final frame as a PNG, then exit (implies --self-check).\n"
+            << "  --capture-render <path>  Record every frame's draw stream to <path> for render_replay.\n"
+            << "  --golden <path>      Compare the final frame's draw stream with a golden capture (implies --self-check).\n"
+            << "  --update-golden      Write the final frame to the --golden path instead of comparing.\n"
+            << "  --golden-tolerance <t>  Allowed difference in numeric draw fields (default 0.01).\n"
+            << "  --frame-budget <path>  Check stage times and allocations per frame against a JSON budget.\n"
+            << "  --headless           No window, renderer or audio device; run as fast as possible.\n"
+            << "  --replay <path>      Feed recorded input from <path> (Helper.h recording format).\n"
+            << "  --fixed-dt <sec>     Step the simulation by a fixed dt (headless default 1/60).\n"
+            << "  --deterministic [seed]  Seed every random stream with seed (default 5489); implies a fixed dt.\n"
+            << "  --state-hash <path>  Write a hash of the simulation state for every frame to <path>.\n"
+            << "  --state-hash-check <path>  Compare every frame's state hash with a --state-hash log.\n"
+            << "  --stats-out <path>   Write per-frame timings and counters to <path> as JSON lines.\n"
             << "  --version            Print version and exit\n"
             << "  --help               Print this help message\n";
     }
@@ -47,7 +60,20 @@ int main(int argc, char* argv[]) {
     std::string resources_path = "resources/";
     std::string screenshot_path;
     std::string initial_scene_override;
+    std::string replay_path;
+    std::string capture_path;
+    std::string golden_path;
+    std::string budget_path;
+    std::string state_hash_path;
+    bool state_hash_check = false;
+    std::string stats_path;
+    bool update_golden = false;
+    float golden_tolerance = 0.01f;
     bool debug_mode = false;
+    bool headless = false;
+    float fixed_dt = 0.0f;  // 0 = wall clock (headless: 1/60)
+    bool deterministic = false;
+    uint32_t random_seed = 5489u;
     int max_frames = -1;  // -1 = no limit
 
     for (int i = 1; i < argc; ++i) {
@@ -67,6 +93,49 @@ int main(int argc, char* argv[]) {
             if (max_frames < 0) max_frames = 60;  // --screenshot implies self-check
             continue;
         }
+        if (arg == "--capture-render" && i + 1 < argc) {
+            capture_path = argv[++i];
+            continue;
+        }
+        if (arg == "--golden" && i + 1 < argc) {
+            golden_path = argv[++i];
+            if (max_frames < 0) max_frames = 60;  // --golden needs a final frame
+            continue;
+        }
+        if (arg == "--update-golden") { update_golden = true; continue; }
+        if (arg == "--golden-tolerance" && i + 1 < argc) {
+            try { golden_tolerance = std::stof(argv[++i]); } catch (...) {}
+            continue;
+        }
+        if (arg == "--frame-budget" && i + 1 < argc) {
+            budget_path = argv[++i];
+            continue;
+        }
+        if (arg == "--headless") { headless = true; continue; }
+        if (arg == "--replay" && i + 1 < argc) {
+            replay_path = argv[++i];
+            continue;
+        }
+        if (arg == "--fixed-dt" && i + 1 < argc) {
+            try { fixed_dt = std::stof(argv[++i]); } catch (...) {}
+            continue;
+        }
+        if (arg == "--deterministic") {
+            deterministic = true;
+            if (i + 1 < argc && argv[i + 1][0] != '-') {
+                try { random_seed = static_cast<uint32_t>(std::stoul(argv[++i])); } catch (...) {}
+            }
+            continue;
+        }
+        if ((arg == "--state-hash" || arg == "--state-hash-check") && i + 1 < argc) {
+            state_hash_path = argv[++i];
+            state_hash_check = arg == "--state-hash-check";
+            continue;
+        }
+        if (arg == "--stats-out" && i + 1 < argc) {
+            stats_path = argv[++i];
+            continue;
+        }
         if (arg == "--scene" && i + 1 < argc) {
             initial_scene_override = argv[++i];
             continue;
@@ -81,7 +150,27 @@ int main(int argc, char* argv[]) {
         return 1;
     }
 
+    if (headless && !screenshot_path.empty()) {
+        std::cerr << "--screenshot needs a renderer and cannot be combined with --headless\n";
+        return 1;
+    }
+    if (update_golden && golden_path.empty()) {
+        std::cerr << "--update-golden needs --golden <path>\n";
+        return 1;
+    }
+    if (headless && !capture_path.empty()) {
+        std::cerr << "--capture-render records what is rendered and cannot be combined with --headless\n";
+        return 1;
+    }
+
+    if (deterministic) {
+        // Wall-clock deltas would make every run different.
+        if (fixed_dt <= 0.0f) fixed_dt = 1.0f / 60.0f;
+        EngineContext::SetDeterministicSeed(random_seed);
+    }
+
     SdlLifecycle sdl;
+    Engine::BeginStartupTiming();
 
     try {
         Logger::Init();
@@ -92,6 +181,7 @@ int main(int argc, char* argv[]) {
         ConfigManager config(resources_path + "game.config", resources_path + "rendering.config");
         ConfigManager::Load();
         ConfigManager::SetInitialSceneOverride(initial_scene_override);
+        Engine::MarkStartupPhase("config");
 
         const std::string game_title = ConfigManager::GetGameTitle();
         const glm::ivec2 resolution = ConfigManager::GetResolution();
@@ -100,26 +190,50 @@ int main(int argc, char* argv[]) {
         LOG_INFO("Game: " + game_title);
         LOG_DEBUG("Resolution: " + std::to_string(resolution.x) + "x" + std::to_string(resolution.y));
 
-        if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO | SDL_INIT_EVENTS | SDL_INIT_TIMER) != 0) {
-            throw RenderException(std::string("SDL initialization failed: ") + SDL_GetError());
+        if (headless) {
+            // No SDL subsystem is needed: input comes from the replay file
+            // and nothing is drawn or played.
+            LOG_INFO("Running headless");
+            Engine engine(true);
+            if (fixed_dt > 0.0f) Engine::SetFixedDeltaTime(fixed_dt);
+            if (!replay_path.empty()) Engine::SetReplayPath(replay_path);
+            if (!golden_path.empty()) Engine::SetGoldenFrame(golden_path, update_golden, golden_tolerance);
+            if (!budget_path.empty()) Engine::SetFrameBudgetPath(budget_path);
+            if (!state_hash_path.empty()) Engine::SetStateHashLog(state_hash_path, state_hash_check);
+            if (!stats_path.empty()) Engine::SetStatsOutPath(stats_path);
+            Engine::GameLoop(max_frames);
         }
-        sdl.sdl_ok = true;
+        else {
+            // Audio is left to SDL_mixer, which starts the subsystem when
+            // the first sound opens the device.
+            if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_EVENTS | SDL_INIT_TIMER) != 0) {
+                throw RenderException(std::string("SDL initialization failed: ") + SDL_GetError());
+            }
+            sdl.sdl_ok = true;
 
-        if ((IMG_Init(IMG_INIT_PNG) & IMG_INIT_PNG) != IMG_INIT_PNG) {
-            throw RenderException(std::string("SDL_image initialization failed: ") + IMG_GetError());
-        }
-        sdl.img_ok = true;
+            if ((IMG_Init(IMG_INIT_PNG) & IMG_INIT_PNG) != IMG_INIT_PNG) {
+                throw RenderException(std::string("SDL_image initialization failed: ") + IMG_GetError());
+            }
+            sdl.img_ok = true;
+            Engine::MarkStartupPhase("sdl");
 
-        {
             Renderer renderer(game_title, clear_color, resolution);
+            Engine::MarkStartupPhase("renderer");
             Engine engine;
             if (!screenshot_path.empty()) Engine::SetScreenshotPath(screenshot_path);
+            if (!capture_path.empty()) Engine::SetRenderCapturePath(capture_path);
+            if (fixed_dt > 0.0f) Engine::SetFixedDeltaTime(fixed_dt);
+            if (!replay_path.empty()) Engine::SetReplayPath(replay_path);
+            if (!golden_path.empty()) Engine::SetGoldenFrame(golden_path, update_golden, golden_tolerance);
+            if (!budget_path.empty()) Engine::SetFrameBudgetPath(budget_path);
+            if (!state_hash_path.empty()) Engine::SetStateHashLog(state_hash_path, state_hash_check);
+            if (!stats_path.empty()) Engine::SetStatsOutPath(stats_path);
             Engine::GameLoop(max_frames);
         }
 
         LOG_INFO("Engine shutting down...");
         Logger::Shutdown();
-        return 0;
+        return Engine::ChecksFailed() ? 1 : 0;
     }
     catch (const EngineException& e) {
         LOG_FATAL(std::string("Engine error: ") + e.what());
@@ -0,0 +1,49 @@
+-- Seeker — follows a flow field around a wall to chase the ball.
+
+Seeker = {
+    speed = 1.5,
+}
+
+-- 16x9 cells of 0.6 units covering the 960x540 view; '#' blocks a cell.
+local TILES = {
+    "................",
+    "................",
+    "........#.......",
+    "........#.......",
+    "........#.......",
+    "........#.......",
+    "........#.......",
+    "................",
+    "................",
+}
+local ORIGIN = Vector2(-4.8, -2.7)
+local CELL = 0.6
+
+function Seeker:OnStart()
+    Navigation.BuildGridFromTiles(ORIGIN, CELL, TILES)
+    self.x = -4
+    self.y = 2
+    self.ball = Actor.Find("Ball")
+end
+
+function Seeker:OnUpdate()
+    -- Wall tiles
+    for row = 1, #TILES do
+        for col = 1, #TILES[row] do
+            if TILES[row]:sub(col, col) == "#" then
+                local wx = ORIGIN.x + (col - 0.5) * CELL
+                local wy = ORIGIN.y + (row - 0.5) * CELL
+                Image.DrawEx("mover", wx, wy, 0, 1.8, 1.8, 0.5, 0.5, 70, 80, 100, 255, 1)
+            end
+        end
+    end
+
+    local rb = self.ball and self.ball:GetComponent("Rigidbody")
+    if rb then
+        local dir = Navigation.GetFlowDirection(rb:GetPosition(), Vector2(self.x, self.y))
+        local dt = Time.GetDeltaTime()
+        self.x = self.x + dir.x * self.speed * dt
+        self.y = self.y + dir.y * self.speed * dt
+    end
+    Image.DrawEx("mover", self.x, self.y, 0, 0.6, 0.6, 0.5, 0.5, 255, 120, 90, 255, 3)
+end
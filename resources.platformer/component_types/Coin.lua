@@ -10,12 +10,16 @@ function Coin:OnStart()
     self.bob  = math.random() * 6.28
     self.spin = 0
     self.rb   = self.actor:GetComponent("Rigidbody")
+    self.sprite = self.actor:GetComponent("SpriteRenderer")
+    -- Off-screen coins are suspended and may not update before they are seen.
+    if self.sprite then
+        self.sprite:SetScale(COIN_W / NATURAL_WU, COIN_W / NATURAL_WU)
+    end
 end
 
 function Coin:OnUpdate()
-    if self.collected or not self.rb then return end
+    if self.collected or not self.sprite then return end
     local dt  = Time.GetDeltaTime()
-    local pos = self.rb:GetPosition()
 
     self.bob  = self.bob  + dt * 3.2
     self.spin = self.spin + dt * 3.0
@@ -23,8 +27,8 @@ function Coin:OnUpdate()
     local spin_sq  = math.abs(math.cos(self.spin)) * 0.8 + 0.2   -- 0.2..1.0
 
     local base = COIN_W / NATURAL_WU
-    Image.DrawEx("coin", pos.x, pos.y + bob_y, 0,
-        base * spin_sq, base, 0.5, 0.5, 255, 215, 40, 255, 2)
+    self.sprite:SetScale(base * spin_sq, base)
+    self.sprite.offset_y = bob_y
 end
 
 function Coin:Collect()
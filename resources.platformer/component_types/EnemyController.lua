@@ -20,6 +20,11 @@ function EnemyController:OnStart()
     self.direction = 1
     self.dead = false
     self.bob  = math.random() * 6.28
+
+    self.sprite = self.actor:GetComponent("SpriteRenderer")
+    if self.sprite then
+        self.sprite:SetScale(ENEMY_W / NATURAL_WU, ENEMY_W / NATURAL_WU)
+    end
 end
 
 function EnemyController:OnUpdate()
@@ -34,12 +39,10 @@ function EnemyController:OnUpdate()
     self.rb:SetVelocity(Vector2(self.patrol_speed * self.direction, 0))
 
     self.bob = self.bob + dt * 6
-    local bob_y = math.sin(self.bob) * 0.04
-
-    local sx = (self.direction >= 0 and 1 or -1) * ENEMY_W / NATURAL_WU
-    local sy = ENEMY_W / NATURAL_WU
-    Image.DrawEx("enemy", pos.x, pos.y + bob_y, 0,
-        sx, sy, 0.5, 0.5, 255, 255, 255, 255, 3)
+    if self.sprite then
+        self.sprite.offset_y = math.sin(self.bob) * 0.04
+        self.sprite.flip_x   = self.direction < 0
+    end
 end
 
 function EnemyController:Die()
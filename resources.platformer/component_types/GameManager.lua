@@ -4,7 +4,9 @@
 -- game so a fresh one spawns on level1.
 --
 -- Note: EventSystem is wiped on every scene load, so we re-subscribe in
--- OnUpdate whenever the scene name changes.
+-- OnUpdate whenever a scene loads. Each level is checkpointed with
+-- Scene.Snapshot on its first frame; a death rewinds to it with
+-- Scene.Restore instead of reloading the level.
 
 local LEVEL_NAMES = {
     level1 = "Level 1",
@@ -19,6 +21,9 @@ GameManager = {
     title_elapsed = 99.0,
     last_scene    = "",
     score_pulse   = 0,
+
+    scene_loaded  = false,  -- set by the scene's duplicate GameManager
+    checkpoint    = nil,    -- Scene.Snapshot handle for the current level
 }
 
 function GameManager:Subscribe()
@@ -34,6 +39,11 @@ function GameManager:Subscribe()
     Event.Subscribe("player_died", function()
         self.deaths = self.deaths + 1
     end)
+    Event.Subscribe("player_retry", function()
+        if not (self.checkpoint and Scene.Restore(self.checkpoint)) then
+            Scene.LoadWithTransition(Scene.GetCurrent(), "fade", 0.35)
+        end
+    end)
 end
 
 function GameManager:OnStart()
@@ -42,6 +52,13 @@ function GameManager:OnStart()
     -- JSON — destroy self and let the persistent one keep its state.
     local existing = Actor.FindAll("GameManager")
     if #existing > 1 then
+        -- The scene was (re)loaded: tell the persistent one to subscribe
+        -- and checkpoint again.
+        for _, other in ipairs(existing) do
+            if other:GetID() ~= self.actor:GetID() then
+                other:GetComponent("GameManager").scene_loaded = true
+            end
+        end
         Actor.Destroy(self.actor)
         return
     end
@@ -57,12 +74,17 @@ function GameManager:OnUpdate()
     local dt = Time.GetUnscaledDeltaTime()
     local current = Scene.GetCurrent()
 
-    -- Scene change → reset title card timer and re-subscribe to events
-    -- (EventSystem.Clear() runs on every scene transition).
-    if current ~= self.last_scene then
-        self.last_scene    = current
-        self.title_elapsed = 0
+    -- Scene change → reset title card timer. Any load (including a reload
+    -- of the same level) → re-subscribe to events, since EventSystem.Clear()
+    -- runs on every scene transition, and take a fresh level checkpoint.
+    if current ~= self.last_scene or self.scene_loaded then
+        if current ~= self.last_scene then
+            self.last_scene    = current
+            self.title_elapsed = 0
+        end
+        self.scene_loaded = false
         self:Subscribe()
+        self.checkpoint = LEVEL_NAMES[current] and Scene.Snapshot() or nil
     end
     self.title_elapsed = self.title_elapsed + dt
 
@@ -83,6 +105,8 @@ function GameManager:OnUpdate()
     Image.DrawUIEx("coin", 260, 40, 255, 215, 40, 255, 101)
     Text.Draw("x " .. self.coins, 292, 24,
         "OpenSans-Regular", 22, 255, 215, 40, 255)
+    Text.Draw(Actor.CountByTags("coin") .. " left", 292, 50,
+        "OpenSans-Regular", 14, 255, 215, 40, 200)
 
     Text.Draw(level_name, 620, 24,
         "OpenSans-Regular", 22, 220, 220, 230, 255)
@@ -15,6 +15,11 @@ function MovingPlatform:OnStart()
     if not self.rb then return end
     self.start_x   = self.rb:GetPosition().x
     self.direction = 1
+
+    local sprite = self.actor:GetComponent("SpriteRenderer")
+    if sprite then
+        sprite:SetScale((self.rb.width or 2.0) / NATURAL_WU, (self.rb.height or 0.5) / NATURAL_WU)
+    end
 end
 
 function MovingPlatform:OnUpdate()
@@ -25,9 +30,4 @@ function MovingPlatform:OnUpdate()
     if offset >  self.move_distance then self.direction = -1
     elseif offset < -self.move_distance then self.direction =  1 end
     self.rb:SetVelocity(Vector2(self.move_speed * self.direction, 0))
-
-    local sx = (self.rb.width  or 2.0) / NATURAL_WU
-    local sy = (self.rb.height or 0.5) / NATURAL_WU
-    Image.DrawEx("platform_moving", pos.x, pos.y, 0, sx, sy, 0.5, 0.5,
-        255, 255, 255, 255, 0)
 end
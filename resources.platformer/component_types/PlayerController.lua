@@ -1,19 +1,12 @@
--- PlayerController — movement, jumping, juicy feedback.
+-- PlayerController — input, juicy feedback. The CharacterController2D next
+-- to it does the movement, ground checks, coyote time and jump buffering.
 
 local NATURAL_WU = 64 * 0.01  -- Sprite is 64 px = 0.64 world units at scale 1.
 
 PlayerController = {
-    move_speed     = 5.5,
-    jump_force     = 9.0,
-    max_fall_speed = 14.0,
-    coyote_time    = 0.10,
-    jump_buffer    = 0.10,
-
     rb = nil,
-    facing_right     = true,
-    is_grounded      = false,
-    time_ungrounded  = 1.0,
-    jump_buffered_at = -1.0,
+    cc = nil,
+    facing_right = true,
     dead = false,
     hit_flash = 0,
     death_t   = 0,
@@ -30,20 +23,20 @@ local function burst(r1, g1, b1, r2, g2, b2)
     c.gravity      = 10
     c.start_size   = 10
     c.end_size     = 2
+    c.collision    = "bounce"
+    c.restitution  = 0.3
     c:SetStartColor(r1, g1, b1, 255)
     c:SetEndColor(r2, g2, b2, 0)
     return c
 end
 
 function PlayerController:OnStart()
-    self.rb              = self.actor:GetComponent("Rigidbody")
-    self.facing_right    = true
-    self.is_grounded     = false
-    self.time_ungrounded = 1.0
-    self.jump_buffered_at= -1.0
-    self.dead            = false
-    self.hit_flash       = 0
-    self.death_t         = 0
+    self.rb           = self.actor:GetComponent("Rigidbody")
+    self.cc           = self.actor:GetComponent("CharacterController2D")
+    self.facing_right = true
+    self.dead         = false
+    self.hit_flash    = 0
+    self.death_t      = 0
 end
 
 function PlayerController:DrawDeath()
@@ -75,78 +68,37 @@ function PlayerController:DrawDeath()
 end
 
 function PlayerController:OnUpdate()
-    if not self.rb then return end
+    if not self.rb or not self.cc then return end
     if self.dead then
         self:DrawDeath()
         return
     end
 
     local dt  = Time.GetDeltaTime()
-    local vel = self.rb:GetVelocity()
     local pos = self.rb:GetPosition()
 
     if self.hit_flash > 0 then
         self.hit_flash = math.max(0, self.hit_flash - dt * 3.5)
     end
 
-    -- Grounded check. Also capture any carry velocity from a MovingPlatform
-    -- below, so the player rides moving platforms properly.
-    local hit = Physics.Raycast(Vector2(pos.x, pos.y + 0.25), Vector2(0, 1), 0.18)
-    local was_grounded = self.is_grounded
-    self.is_grounded = (hit ~= nil and hit.actor ~= nil and not hit.is_trigger)
-
-    local carry_vx = 0
-    if self.is_grounded and hit.actor then
-        local mp = hit.actor:GetComponent("MovingPlatform")
-        if mp and mp.move_speed and mp.direction then
-            carry_vx = mp.move_speed * mp.direction
-        end
+    -- Ground state is from the last physics step.
+    if self.cc:JustLanded() then
+        Particles.Emit(pos.x, pos.y + 0.3, 6, burst(200, 200, 200, 150, 150, 150))
     end
-
-    if self.is_grounded then
-        self.time_ungrounded = 0.0
-        if not was_grounded then
-            Particles.Emit(pos.x, pos.y + 0.3, 6, burst(200, 200, 200, 150, 150, 150))
-        end
-    else
-        self.time_ungrounded = self.time_ungrounded + dt
+    if self.cc:JustJumped() then
+        Particles.Emit(pos.x, pos.y + 0.3, 8, burst(240, 240, 255, 180, 180, 220))
     end
 
-    -- Horizontal input
+    -- Input. The controller turns presses of the held jump key into jumps
+    -- (buffered, with coyote time) and cuts the jump short on release.
     local move_x = 0
     if Input.GetKey("left")  or Input.GetKey("a") then
-        move_x = -self.move_speed; self.facing_right = false
+        move_x = -1; self.facing_right = false
     elseif Input.GetKey("right") or Input.GetKey("d") then
-        move_x =  self.move_speed; self.facing_right = true
+        move_x =  1; self.facing_right = true
     end
-
-    local vy = vel.y
-    if vy > self.max_fall_speed then vy = self.max_fall_speed end
-    self.rb:SetVelocity(Vector2(move_x + carry_vx, vy))
-
-    -- Jump buffering + coyote time
-    if Input.GetKeyDown("space") or Input.GetKeyDown("up") or Input.GetKeyDown("w") then
-        self.jump_buffered_at = Time.GetTotalTime()
-    end
-    local now = Time.GetTotalTime()
-    local can_jump = (self.time_ungrounded <= self.coyote_time)
-        and (self.jump_buffered_at >= 0 and (now - self.jump_buffered_at) <= self.jump_buffer)
-
-    if can_jump then
-        -- Carry the platform's horizontal speed into the jump so you don't
-        -- just launch straight up while the platform slides out from under.
-        self.rb:SetVelocity(Vector2(move_x + carry_vx, -self.jump_force))
-        self.is_grounded = false
-        self.jump_buffered_at = -1.0
-        self.time_ungrounded  = self.coyote_time + 1.0
-        Particles.Emit(pos.x, pos.y + 0.3, 8, burst(240, 240, 255, 180, 180, 220))
-    end
-
-    -- Variable jump height: early release caps ascent.
     local holding = Input.GetKey("space") or Input.GetKey("up") or Input.GetKey("w")
-    if vy < -2.5 and not holding then
-        self.rb:SetVelocity(Vector2(move_x, vy * 0.5))
-    end
+    self.cc:Move(move_x, holding and -1 or 0)
 
     -- Draw. Sprite is 64 px; scale so 1 world unit corresponds to scale = 1/NATURAL_WU.
     -- Player collider is 0.4w x 0.6h; visual matches the body silhouette.
@@ -180,15 +132,17 @@ function PlayerController:Die()
     -- Dramatic pop: fling the body up and spin via a raw velocity set,
     -- then let physics take over for the rest of the death animation.
     if self.rb then
+        if self.cc then self.cc.enabled = false end
         self.rb:SetVelocity(Vector2(0, -6))
         self.rb:SetGravityScale(2.0)
     end
 
-    -- Reload scene after a short slo-mo beat (Scheduler uses scaled dt,
-    -- so 0.15s here is ~0.6s of wall time at time-scale 0.25).
+    -- Retry after a short slo-mo beat (Scheduler uses scaled dt, so 0.15s
+    -- here is ~0.6s of wall time at time-scale 0.25). GameManager rewinds
+    -- the level to its checkpoint, or reloads it if there is none.
     Timer.After(0.15, function()
         Time.SetTimeScale(1.0)
-        Scene.LoadWithTransition(Scene.GetCurrent(), "fade", 0.35)
+        Event.Emit("player_retry", {})
     end)
 end
 
@@ -5,14 +5,8 @@ local NATURAL_WU = 64 * 0.01
 Spike = {}
 
 function Spike:OnStart()
-    self.rb = self.actor:GetComponent("Rigidbody")
-end
-
-function Spike:OnUpdate()
-    if not self.rb then return end
-    local pos = self.rb:GetPosition()
-    local sx  = (self.rb.trigger_width  or 1.0) / NATURAL_WU
-    local sy  = (self.rb.trigger_height or 0.5) / NATURAL_WU
-    Image.DrawEx("spike", pos.x, pos.y, 0, sx, sy, 0.5, 0.5,
-        255, 255, 255, 255, 1)
+    local rb     = self.actor:GetComponent("Rigidbody")
+    local sprite = self.actor:GetComponent("SpriteRenderer")
+    if not rb or not sprite then return end
+    sprite:SetScale((rb.trigger_width or 1.0) / NATURAL_WU, (rb.trigger_height or 0.5) / NATURAL_WU)
 end
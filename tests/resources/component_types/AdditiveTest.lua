@@ -0,0 +1,89 @@
+-- AdditiveTest — loads additive_room next to the main scene, replaces the
+-- main scene with additive_next, checks that the room's event subscription
+-- and timer survived it, then unloads the room. Each phase waits for the
+-- deferred load or unload to apply, up to a few frames.
+
+AdditiveTest = {
+    phase = 0,
+    waited = 0,
+    failed = false,
+}
+
+function AdditiveTest:Check(condition, message)
+    if not condition then
+        self.failed = true
+        Debug.LogError("FAIL additive: " .. message)
+    end
+end
+
+function AdditiveTest:Next()
+    self.phase = self.phase + 1
+    self.waited = 0
+end
+
+-- Advances once `ready` holds; fails the run if it never does.
+function AdditiveTest:Wait(ready, what)
+    if ready then return true end
+    self.waited = self.waited + 1
+    if self.waited > 5 then
+        self:Check(false, "timed out waiting for " .. what)
+        Application.Quit()
+    end
+    return false
+end
+
+function AdditiveTest:OnUpdate()
+    if self.phase == 0 then
+        self:Check(Scene.IsLoaded("additive"), "main scene not reported as loaded")
+        self:Check(not Scene.IsLoaded("additive_room"), "room loaded before LoadAdditive")
+        Scene.LoadAdditive("additive_room")
+        self:Check(not Scene.IsLoaded("additive_room"), "LoadAdditive applied before the next frame")
+        self:Next()
+
+    elseif self.phase == 1 then
+        if not self:Wait(Scene.IsLoaded("additive_room"), "additive_room to load") then return end
+        self:Check(Scene.GetCurrent() == "additive", "main scene changed to " .. Scene.GetCurrent())
+        self:Check(Actor.Find("RoomA") ~= nil and Actor.Find("RoomB") ~= nil, "room actors missing")
+        self:Check(Actor.Find("MainOnly") ~= nil, "main scene actor gone")
+        self:Check(Actor.CountByTags("room") == 2, "room tags not indexed")
+
+        -- Additive actors are left out of snapshots.
+        local handle = Scene.Snapshot()
+        local stats = Scene.GetSnapshotStats(handle)
+        self:Check(stats.actors == 2, "snapshot holds " .. stats.actors .. " actors, expected the 2 main ones")
+        Scene.ReleaseSnapshot(handle)
+
+        Scene.DontDestroy(self.actor)
+        Scene.Load("additive_next")
+        self:Next()
+
+    elseif self.phase == 2 then
+        if not self:Wait(Scene.GetCurrent() == "additive_next", "additive_next to load") then return end
+        self:Check(Actor.Find("NextActor") ~= nil, "new main scene actor missing")
+        self:Check(Actor.Find("MainOnly") == nil, "old main scene actor survived Scene.Load")
+        self:Check(Actor.Find("RoomA") ~= nil, "additive actor did not survive Scene.Load")
+        self:Check(Scene.IsLoaded("additive_room"), "room no longer loaded after Scene.Load")
+        self:Check(RoomProbeCalls.start == 1, "room component started " .. RoomProbeCalls.start .. " times")
+        self:Check(RoomProbeCalls.update > 0, "room component never updated")
+        Event.Emit("room_ping", nil)
+        self:Check(RoomProbeCalls.pings == 1, "room's event subscription did not survive Scene.Load")
+        self.ticks = RoomProbeCalls.ticks
+        self:Next()
+
+    elseif self.phase == 3 then
+        self:Check(RoomProbeCalls.ticks > self.ticks, "room's timer did not survive Scene.Load")
+        Scene.Unload("additive_room")
+        self:Check(not Scene.IsLoaded("additive_room"), "room still reported loaded after Unload")
+        self:Next()
+
+    elseif self.phase == 4 then
+        if not self:Wait(Actor.Find("RoomA") == nil, "room actors to be destroyed") then return end
+        self:Check(Actor.Find("RoomB") == nil, "RoomB survived Unload")
+        self:Check(Actor.CountByTags("room") == 0, "room tags still indexed")
+        self:Check(RoomProbeCalls.destroy == 1, "room component destroyed " .. RoomProbeCalls.destroy .. " times")
+        self:Check(Actor.Find("NextActor") ~= nil, "Unload destroyed a main scene actor")
+
+        if not self.failed then Debug.Log("PASS additive") end
+        Application.Quit()
+    end
+end
@@ -0,0 +1,66 @@
+-- ContactsTest — checks per-body contact rules: a box jumping up through a
+-- one_way platform passes it and then lands on top, a crate resting on a
+-- surface_speed conveyor is carried along it, and a body told to
+-- IgnoreCollisionsWith a floor falls through it until the window expires,
+-- after which the floor stops it again.
+
+ContactsTest = {
+    step = 0,
+    failed = false,
+    jumper_top = 0,
+}
+
+function ContactsTest:Check(condition, message)
+    if not condition then
+        self.failed = true
+        Debug.LogError("FAIL contacts: " .. message)
+    end
+end
+
+-- Resting on a surface whose top is at y = -0.25: a 1x1 box sits at -0.75.
+function ContactsTest:CheckResting(rb, name)
+    local pos = rb:GetPosition()
+    local vel = rb:GetVelocity()
+    self:Check(math.abs(pos.y + 0.75) < 0.05, name .. " is not resting on the surface (y = " .. pos.y .. ")")
+    self:Check(math.abs(vel.y) < 0.05, name .. " is still moving vertically (" .. vel.y .. ")")
+end
+
+function ContactsTest:OnUpdate()
+    self.step = self.step + 1
+    local jumper = Actor.Find("Jumper"):GetComponent("Rigidbody")
+    local crate = Actor.Find("Crate"):GetComponent("Rigidbody")
+    local ghost = Actor.Find("Ghost"):GetComponent("Rigidbody")
+    self.jumper_top = math.min(self.jumper_top, jumper:GetPosition().y)
+
+    if self.step == 1 then
+        jumper:SetVelocity(Vector2(0, -8.5))
+        ghost:IgnoreCollisionsWith(Actor.Find("Floor"), 0.5)
+
+    elseif self.step == 20 then
+        self:Check(ghost:GetPosition().y > -0.5, "Ghost did not sink into the ignored Floor")
+        self.crate_x = crate:GetPosition().x
+
+    elseif self.step == 60 then
+        local y = ghost:GetPosition().y
+        self:Check(y > 3 and y < 3.3, "Ghost did not fall through Floor onto Ground (y = " .. y .. ")")
+        -- The window has run out; back above Floor, the pair collides again.
+        ghost:SetPosition(Vector2(40, -2))
+        ghost:SetVelocity(Vector2(0, 0))
+
+        local x = crate:GetPosition().x
+        self:Check(x - self.crate_x > 1, "Crate moved " .. (x - self.crate_x) .. " along the conveyor in 40 frames")
+        local vx = crate:GetVelocity().x
+        self:Check(math.abs(vx - 2) < 0.1, "Crate moves at " .. vx .. ", not the conveyor's 2")
+
+    elseif self.step == 110 then
+        self:Check(self.jumper_top < -0.75, "Jumper never rose above Platform (top y = " .. self.jumper_top .. ")")
+        self:CheckResting(jumper, "Jumper")
+        self:CheckResting(ghost, "Ghost")
+        self:CheckResting(crate, "Crate")
+
+        if not self.failed then
+            Debug.Log("PASS contacts")
+        end
+        Application.Quit()
+    end
+end
@@ -0,0 +1,14 @@
+-- Counter — component state for the snapshot test: a counter bumped every
+-- frame and a nested table the test overwrites.
+
+Counter = {
+    count = 0,
+}
+
+function Counter:OnStart()
+    self.data = { items = { 1, 2, 3 } }
+end
+
+function Counter:OnUpdate()
+    self.count = self.count + 1
+end
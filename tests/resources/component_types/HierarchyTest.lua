@@ -0,0 +1,71 @@
+-- HierarchyTest — parents Child to the moving Mover body and Grandchild to
+-- Child, then checks that world poses, the follower body on Child and the
+-- spatial index track the body, that a cycle is rejected without changing
+-- anything, and that detaching keeps the world pose.
+
+HierarchyTest = {
+    step = 0,
+    failed = false,
+}
+
+function HierarchyTest:Check(condition, message)
+    if not condition then
+        self.failed = true
+        Debug.LogError("FAIL hierarchy: " .. message)
+    end
+end
+
+function HierarchyTest:Near(a, b)
+    return math.abs(a.x - b.x) < 1e-4 and math.abs(a.y - b.y) < 1e-4
+end
+
+function HierarchyTest:OnUpdate()
+    self.step = self.step + 1
+    local mover = Actor.Find("Mover")
+    local child = Actor.Find("Child")
+    local grandchild = Actor.Find("Grandchild")
+    local child_t = child:GetComponent("Transform")
+    local grandchild_t = grandchild:GetComponent("Transform")
+
+    if self.step == 1 then
+        mover:GetComponent("Rigidbody"):SetVelocity(Vector2(2, 0))
+        self:Check(child_t:SetParent(mover, false), "Child could not be parented to the Mover body")
+        self:Check(grandchild_t:SetParent(child, false), "Grandchild could not be parented to Child")
+        self:Check(child_t:GetParent():GetName() == "Mover", "Child's parent is not Mover")
+        local children = child_t:GetChildren()
+        self:Check(#children == 1 and children[1]:GetName() == "Grandchild", "Child's children are wrong")
+
+        -- Rejected links leave the hierarchy as it was.
+        self:Check(not child_t:SetParent(grandchild, false), "a cycle was accepted")
+        self:Check(not child_t:SetParent(child, false), "a transform was parented to itself")
+        self:Check(child_t:GetParent():GetName() == "Mover", "a rejected SetParent changed the parent")
+
+    elseif self.step == 30 then
+        local m = mover:GetComponent("Rigidbody"):GetPosition()
+        self:Check(m.x > 0.5, "Mover did not move")
+
+        local c = child_t:GetWorldPosition()
+        local g = grandchild_t:GetWorldPosition()
+        self:Check(self:Near(c, Vector2(m.x + 1, m.y)), "Child world " .. c.x .. ", " .. c.y .. " with Mover at " .. m.x)
+        self:Check(self:Near(g, Vector2(m.x + 1, m.y + 1)), "Grandchild world " .. g.x .. ", " .. g.y)
+
+        local body = child:GetComponent("Rigidbody"):GetPosition()
+        self:Check(self:Near(body, c), "Child's kinematic body at " .. body.x .. ", " .. body.y .. " did not follow")
+
+        local hits = Spatial.QueryRadius(g, 0.01, "Grandchild", nil)
+        self:Check(#hits == 1, "Grandchild not re-bucketed in the spatial hash")
+
+        self.detached_at = g
+        grandchild_t:SetParent(nil, true)
+        self:Check(self:Near(Vector2(grandchild_t.x, grandchild_t.y), g), "detach did not keep the world pose")
+        self:Check(child_t:GetChildCount() == 0, "Child still lists the detached Grandchild")
+
+    elseif self.step == 31 then
+        self:Check(self:Near(grandchild_t:GetWorldPosition(), self.detached_at), "detached Grandchild still moves")
+        local m = mover:GetComponent("Rigidbody"):GetPosition()
+        self:Check(self:Near(child_t:GetWorldPosition(), Vector2(m.x + 1, m.y)), "Child stopped following")
+
+        if not self.failed then Debug.Log("PASS hierarchy") end
+        Application.Quit()
+    end
+end
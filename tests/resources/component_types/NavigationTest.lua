@@ -0,0 +1,119 @@
+-- NavigationTest — builds a tile grid with one blocked tile on the straight
+-- line from start to goal and checks that FindPath and FindPathAsync agree,
+-- that a blocked goal gives nil, and that SetWalkable opening and closing
+-- the tile changes the paths returned for the same query afterwards.
+
+NavigationTest = {
+    phase = 0,
+    waited = 0,
+    failed = false,
+}
+
+local TILES = {
+    "........",
+    "...#....",
+    "........",
+}
+local START = Vector2(0.5, 1.5)
+local GOAL = Vector2(7.5, 1.5)
+local HOLE = Vector2(3.5, 1.5)
+
+function NavigationTest:Check(condition, message)
+    if not condition then
+        self.failed = true
+        Debug.LogError("FAIL navigation: " .. message)
+    end
+end
+
+function NavigationTest:Next()
+    self.phase = self.phase + 1
+    self.waited = 0
+end
+
+-- Advances once `ready` holds; fails the run if it never does.
+function NavigationTest:Wait(ready, what)
+    if ready then return true end
+    self.waited = self.waited + 1
+    if self.waited > 5 then
+        self:Check(false, "timed out waiting for " .. what)
+        Application.Quit()
+    end
+    return false
+end
+
+function NavigationTest:SamePath(a, b)
+    if a == nil or b == nil then return a == b end
+    if #a ~= #b then return false end
+    for i = 1, #a do
+        if a[i].x ~= b[i].x or a[i].y ~= b[i].y then return false end
+    end
+    return true
+end
+
+function NavigationTest:Passes(path, point)
+    for _, waypoint in ipairs(path) do
+        if waypoint.x == point.x and waypoint.y == point.y then return true end
+    end
+    return false
+end
+
+-- Queues FindPathAsync for `goal` and records what its callback gets.
+function NavigationTest:Request(goal)
+    local request = { done = false }
+    Navigation.FindPathAsync(START, goal, function(path)
+        request.done = true
+        request.path = path
+    end)
+    return request
+end
+
+function NavigationTest:OnUpdate()
+    if self.phase == 0 then
+        Navigation.BuildGridFromTiles(Vector2(0, 0), 1, TILES)
+        self:Check(not Navigation.IsWalkable(HOLE), "blocked tile is walkable")
+
+        self.around = Navigation.FindPath(START, GOAL)
+        self:Check(self.around ~= nil, "no path around the blocked tile")
+        if self.around == nil then Application.Quit() return end
+        local last = self.around[#self.around]
+        self:Check(last.x == GOAL.x and last.y == GOAL.y, "path does not end on the goal")
+        for _, waypoint in ipairs(self.around) do
+            self:Check(Navigation.IsWalkable(waypoint), "path crosses a blocked cell")
+        end
+
+        self:Check(Navigation.FindPath(START, HOLE) == nil, "path to a blocked goal")
+        self.async = self:Request(GOAL)
+        self.async_blocked = self:Request(HOLE)
+        self:Next()
+
+    elseif self.phase == 1 then
+        local ready = self.async.done and self.async_blocked.done
+        if not self:Wait(ready, "FindPathAsync callbacks") then return end
+        self:Check(self:SamePath(self.async.path, self.around), "FindPathAsync returned a different path")
+        self:Check(self.async_blocked.path == nil, "FindPathAsync found a path to a blocked goal")
+
+        -- The cached detour must not outlive the edit: the straight line
+        -- through the opened tile is now the only shortest path.
+        Navigation.SetWalkable(HOLE, true)
+        self.through = Navigation.FindPath(START, GOAL)
+        self:Check(self.through ~= nil and self:Passes(self.through, HOLE), "path does not go through the opened tile")
+        for _, waypoint in ipairs(self.through or {}) do
+            self:Check(waypoint.y == START.y, "path through the opened tile is not straight")
+        end
+        self.async = self:Request(GOAL)
+        self:Next()
+
+    elseif self.phase == 2 then
+        if not self:Wait(self.async.done, "FindPathAsync callback") then return end
+        self:Check(self:SamePath(self.async.path, self.through), "FindPathAsync ignored the opened tile")
+
+        Navigation.SetWalkable(HOLE, false)
+        self:Check(self:SamePath(Navigation.FindPath(START, GOAL), self.around), "closing the tile did not restore the detour")
+        self:Check(Navigation.FindPath(START, HOLE) == nil, "path to the closed tile")
+
+        if not self.failed then
+            Debug.Log("PASS navigation")
+        end
+        Application.Quit()
+    end
+end
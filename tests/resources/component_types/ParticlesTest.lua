@@ -0,0 +1,74 @@
+-- ParticlesTest — checks particle collisions against a static floor whose
+-- top is at y = 4.5: "kill" particles falling onto it disappear, "stick"
+-- particles stop where they hit it and stay there, and with more colliding
+-- particles than SetCollisionBudget allows only the budget is tested per
+-- update, yet every "bounce" particle is still turned back by the floor on
+-- its turn.
+
+ParticlesTest = {
+    step = 0,
+    failed = false,
+}
+
+function ParticlesTest:Check(condition, message)
+    if not condition then
+        self.failed = true
+        Debug.LogError("FAIL particles: " .. message)
+    end
+end
+
+-- Straight down at 20 units/s, long-lived: the floor is reached in ~14 frames.
+function ParticlesTest:Config(collision)
+    local config = ParticleConfig()
+    config.direction = 90
+    config.spread_angle = 0
+    config.speed_min = 20
+    config.speed_max = 20
+    config.lifetime_min = 10
+    config.lifetime_max = 10
+    config.collision = collision
+    return config
+end
+
+function ParticlesTest:OnUpdate()
+    self.step = self.step + 1
+
+    if self.step == 1 then
+        Particles.Emit(-5, 0, 50, self:Config("kill"))
+        Particles.Emit(5, 0, 50, self:Config("stick"))
+
+    elseif self.step == 3 then
+        self:Check(Particles.GetActiveCount() == 100, Particles.GetActiveCount() .. " particles after emitting 100")
+        self:Check(Particles.GetCollisionChecks() == 100, Particles.GetCollisionChecks() .. " collision checks for 100 particles")
+
+    elseif self.step == 30 then
+        self:Check(Particles.GetActiveCount() == 50, Particles.GetActiveCount() .. " particles left, not the 50 stuck ones")
+        self:Check(Particles.CountInRect(-6, -100, -4, 100) == 0, "kill particles survived hitting the floor")
+        local resting = Particles.CountInRect(4.9, 4.4, 5.1, 4.6)
+        self:Check(resting == 50, resting .. " of 50 stick particles rest on the floor's top")
+        self:Check(Particles.GetCollisionChecks() == 0, "stuck particles are still tested")
+
+    elseif self.step == 40 then
+        local resting = Particles.CountInRect(4.9, 4.4, 5.1, 4.6)
+        self:Check(resting == 50, resting .. " of 50 stick particles stayed where they stuck")
+
+        Particles.SetCollisionBudget(10)
+        Particles.Emit(0, 0, 100, self:Config("bounce"))
+
+    elseif self.step == 42 then
+        self:Check(Particles.GetCollisionChecks() == 10, Particles.GetCollisionChecks() .. " collision checks with a budget of 10")
+
+    elseif self.step == 80 then
+        -- Each particle is tested every tenth update, from where its last
+        -- test ended, so none gets past the floor.
+        self:Check(Particles.CountInRect(-1, 4.5, 1, 100) == 0, "particles tunnelled through the floor over budget")
+        local above = Particles.CountInRect(-1, -100, 1, 4.5)
+        self:Check(above == 100, above .. " of 100 particles bounced off the floor over budget")
+        Particles.SetCollisionBudget(512)
+
+        if not self.failed then
+            Debug.Log("PASS particles")
+        end
+        Application.Quit()
+    end
+end
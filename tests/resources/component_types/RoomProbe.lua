@@ -0,0 +1,15 @@
+-- RoomProbe — counts its lifecycle calls, a "room_ping" event and a
+-- repeating timer in a global for the additive test.
+
+RoomProbeCalls = { start = 0, update = 0, destroy = 0, pings = 0, ticks = 0 }
+
+RoomProbe = {}
+
+function RoomProbe:OnStart()
+    RoomProbeCalls.start = RoomProbeCalls.start + 1
+    Event.Subscribe("room_ping", function() RoomProbeCalls.pings = RoomProbeCalls.pings + 1 end)
+    Timer.Every(0, 0.001, function() RoomProbeCalls.ticks = RoomProbeCalls.ticks + 1 end)
+end
+
+function RoomProbe:OnUpdate() RoomProbeCalls.update = RoomProbeCalls.update + 1 end
+function RoomProbe:OnDestroy() RoomProbeCalls.destroy = RoomProbeCalls.destroy + 1 end
@@ -0,0 +1,16 @@
+-- ScheduleProbe — records the frame, total time and update_dt of each
+-- OnUpdate it gets, for the schedule test.
+
+ScheduleProbe = {}
+
+function ScheduleProbe:OnStart()
+    self.frames = {}
+    self.times = {}
+    self.dts = {}
+end
+
+function ScheduleProbe:OnUpdate()
+    table.insert(self.frames, Application.GetFrame())
+    table.insert(self.times, Time.GetTotalTime())
+    table.insert(self.dts, self.update_dt)
+end
@@ -0,0 +1,74 @@
+-- ScheduleTest — checks component update policies: three components with
+-- update_interval = 3 run exactly every third frame on different phases,
+-- one with update_interval = 70 goes round the 64-frame wheel, update_dt is
+-- the time since the last run, and an off-screen component with
+-- suspend_sleep stays suspended with its body asleep until the camera
+-- comes to it.
+
+ScheduleTest = {
+    step = 0,
+    failed = false,
+}
+
+function ScheduleTest:Check(condition, message)
+    if not condition then
+        self.failed = true
+        Debug.LogError("FAIL schedule: " .. message)
+    end
+end
+
+-- Runs `interval` frames apart, each with update_dt equal to the time since
+-- the run before.
+function ScheduleTest:CheckRuns(probe, name, interval)
+    for i = 2, #probe.frames do
+        local gap = probe.frames[i] - probe.frames[i - 1]
+        self:Check(gap == interval, name .. " ran " .. gap .. " frames after its last run, not " .. interval)
+        local elapsed = probe.times[i] - probe.times[i - 1]
+        self:Check(math.abs(probe.dts[i] - elapsed) < 1e-5,
+                   name .. " update_dt " .. probe.dts[i] .. " but " .. elapsed .. " s elapsed")
+    end
+end
+
+function ScheduleTest:OnUpdate()
+    self.step = self.step + 1
+    local sleeper = Actor.Find("Sleeper")
+
+    if self.step == 1 then
+        Camera.SetPosition(0, 0)
+
+    elseif self.step == 20 then
+        self.sleeper_y = sleeper:GetComponent("Rigidbody"):GetPosition().y
+
+    elseif self.step == 40 then
+        local probe = sleeper:GetComponent("ScheduleProbe")
+        self:Check(#probe.frames == 0, "off-screen Sleeper ran " .. #probe.frames .. " times")
+        local y = sleeper:GetComponent("Rigidbody"):GetPosition().y
+        self:Check(y == self.sleeper_y, "suspended Sleeper's body fell from " .. self.sleeper_y .. " to " .. y)
+        Camera.SetPosition(50, y)
+
+    elseif self.step == 50 then
+        local probe = sleeper:GetComponent("ScheduleProbe")
+        self:Check(#probe.frames > 0, "Sleeper did not resume in view")
+        self:CheckRuns(probe, "Sleeper", 1)
+        local y = sleeper:GetComponent("Rigidbody"):GetPosition().y
+        self:Check(y > self.sleeper_y, "Sleeper's body was not woken")
+
+    elseif self.step == 100 then
+        -- Past the 64-frame wheel more than once.
+        local phases = {}
+        for _, ticker in ipairs(Actor.FindAll("Ticker")) do
+            local probe = ticker:GetComponent("ScheduleProbe")
+            self:Check(#probe.frames >= 32, "Ticker ran " .. #probe.frames .. " times in 100 frames")
+            self:CheckRuns(probe, "Ticker", 3)
+            phases[probe.frames[1] % 3] = true
+        end
+        self:Check(phases[0] and phases[1] and phases[2], "Tickers sharing update_interval = 3 share a phase")
+
+        local slow = Actor.Find("Slow"):GetComponent("ScheduleProbe")
+        self:Check(#slow.frames == 2, "Slow ran " .. #slow.frames .. " times, expected 2")
+        self:CheckRuns(slow, "Slow", 70)
+
+        if not self.failed then Debug.Log("PASS schedule") end
+        Application.Quit()
+    end
+end
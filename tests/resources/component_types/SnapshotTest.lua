@@ -0,0 +1,73 @@
+-- SnapshotTest — takes a snapshot, changes the scene for a few frames,
+-- restores and checks that the scene came back as captured.
+--
+-- Test progress lives in a global: a snapshot captures this component's
+-- own fields too, and restoring would rewind them.
+
+SnapshotState = { step = 0, failed = false }
+
+SnapshotTest = {}
+
+local function check(condition, message)
+    if not condition then
+        SnapshotState.failed = true
+        Debug.LogError("FAIL snapshot: " .. message)
+    end
+end
+
+local function counter()
+    return Actor.Find("Counter"):GetComponent("Counter")
+end
+
+function SnapshotTest:OnUpdate()
+    local state = SnapshotState
+    state.step = state.step + 1
+
+    if state.step == 1 then
+        -- This component runs first (lowest actor id), so the counter has
+        -- not updated yet this frame, before or after the restore.
+        local box = Actor.Find("Box"):GetComponent("Rigidbody")
+        state.box = box:GetPosition()
+        state.count = counter().count
+        state.victim_id = Actor.Find("Victim"):GetID()
+        state.handle = Scene.Snapshot()
+
+        local stats = Scene.GetSnapshotStats(state.handle)
+        check(stats ~= nil and stats.actors == 5, "snapshot stats report the wrong actor count")
+
+        counter().data.items[1] = 99
+        Actor.Find("Marker"):GetComponent("Transform"):SetPosition(Vector2(-4, -4))
+        Actor.Destroy(Actor.Find("Victim"))
+        Actor.Instantiate("tagged")
+
+    elseif state.step == 10 then
+        check(Actor.Find("Spawned") ~= nil, "instantiated actor missing before restore")
+        check(Actor.Find("Box"):GetComponent("Rigidbody"):GetPosition().y > state.box.y,
+            "box did not fall before restore")
+        check(Scene.Restore(state.handle), "Restore rejected a live handle")
+        check(not Scene.Restore(state.handle + 1000), "Restore accepted an unknown handle")
+
+    elseif state.step == 11 then
+        local position = Actor.Find("Box"):GetComponent("Rigidbody"):GetPosition()
+        check(math.abs(position.x - state.box.x) < 1e-5 and math.abs(position.y - state.box.y) < 1e-5,
+            "box at " .. position.x .. ", " .. position.y .. " after restore")
+        check(counter().count == state.count, "counter is " .. counter().count .. ", expected " .. state.count)
+        check(counter().data.items[1] == 1, "nested table not restored")
+
+        local marker = Actor.Find("Marker"):GetComponent("Transform")
+        check(marker.x == 2 and marker.y == 3, "marker transform not restored")
+
+        local victim = Actor.Find("Victim")
+        check(victim ~= nil and victim:GetID() == state.victim_id, "destroyed actor not restored with its id")
+        check(victim ~= nil and victim:HasTag("victim"), "restored actor lost its tag")
+        check(Actor.Find("Spawned") == nil, "actor spawned after the snapshot survived the restore")
+
+        local stats = Scene.GetSnapshotStats(state.handle)
+        check(stats ~= nil and stats.restore_ms > 0, "restore_ms not recorded")
+        Scene.ReleaseSnapshot(state.handle)
+        check(Scene.GetSnapshotStats(state.handle) == nil, "released snapshot still has stats")
+
+        if not state.failed then Debug.Log("PASS snapshot") end
+        Application.Quit()
+    end
+end
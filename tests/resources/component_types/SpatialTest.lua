@@ -0,0 +1,76 @@
+-- SpatialTest — checks Spatial queries against the fixed layout in spatial.scene.
+--
+--   Near (1, 0) [target]   Mid (0, 2)   Far (10, 10) [target]   Gone (0.5, 0.5)
+
+SpatialTest = {
+    step = 0,
+    failed = false,
+}
+
+function SpatialTest:Check(condition, message)
+    if not condition then
+        self.failed = true
+        Debug.LogError("FAIL spatial: " .. message)
+    end
+end
+
+function SpatialTest:Names(hits)
+    local names = {}
+    for i = 1, #hits do names[i] = hits[i]:GetName() end
+    return table.concat(names, ",")
+end
+
+function SpatialTest:OnUpdate()
+    self.step = self.step + 1
+    local origin = Vector2(0, 0)
+
+    if self.step == 1 then
+        -- Radius and nearest results are ordered by distance, rects by actor id.
+        local hits = Spatial.QueryRadius(origin, 2.5, nil, nil)
+        self:Check(self:Names(hits) == "Gone,Near,Mid", "QueryRadius got " .. self:Names(hits))
+
+        hits = Spatial.QueryRadius(origin, 100, "Far", nil)
+        self:Check(self:Names(hits) == "Far", "QueryRadius by name got " .. self:Names(hits))
+
+        hits = Spatial.QueryRadius(origin, 100, { tags = { "target" } }, nil)
+        self:Check(self:Names(hits) == "Near,Far", "QueryRadius by tag got " .. self:Names(hits))
+
+        hits = Spatial.QueryRadius(origin, 100, { tags = { "unknown" } }, nil)
+        self:Check(#hits == 0, "QueryRadius with an unknown tag got " .. self:Names(hits))
+
+        hits = Spatial.QueryRect(Vector2(-1, -1), Vector2(1.5, 1), nil, nil)
+        self:Check(self:Names(hits) == "Near,Gone", "QueryRect got " .. self:Names(hits))
+
+        hits = Spatial.QueryNearest(Vector2(9, 9), 2, nil, nil)
+        self:Check(self:Names(hits) == "Far,Mid", "QueryNearest got " .. self:Names(hits))
+
+        local count = Spatial.CountRadius(origin, 100, nil)
+        self:Check(count == 4, "CountRadius got " .. count)
+
+        -- A reused out table is cleared before it is filled.
+        local out = { "stale", "stale", "stale", "stale", "stale" }
+        hits = Spatial.QueryRadius(Vector2(10, 10), 1, nil, out)
+        self:Check(rawequal(hits, out), "QueryRadius did not return the out table")
+        self:Check(#out == 1 and out[1]:GetName() == "Far", "out table holds " .. #out .. " entries")
+
+        -- Moving a Transform re-buckets it; a destroyed actor drops out.
+        Actor.Find("Far"):GetComponent("Transform"):SetPosition(Vector2(-30, 0))
+        Actor.Destroy(Actor.Find("Gone"))
+
+    elseif self.step == 2 then
+        local hits = Spatial.QueryRadius(Vector2(10, 10), 1, nil, nil)
+        self:Check(#hits == 0, "moved actor still found at its old cell: " .. self:Names(hits))
+
+        hits = Spatial.QueryRadius(Vector2(-30, 0), 0.5, nil, nil)
+        self:Check(self:Names(hits) == "Far", "moved actor at its new cell got " .. self:Names(hits))
+
+        hits = Spatial.QueryRadius(origin, 2.5, nil, nil)
+        self:Check(self:Names(hits) == "Near,Mid", "QueryRadius after destroy got " .. self:Names(hits))
+
+        local count = Spatial.CountRadius(origin, 100, nil)
+        self:Check(count == 3, "CountRadius after destroy got " .. count)
+
+        if not self.failed then Debug.Log("PASS spatial") end
+        Application.Quit()
+    end
+end
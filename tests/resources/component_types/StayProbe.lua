@@ -0,0 +1,24 @@
+-- StayProbe — counts the OnCollisionStay and OnTriggerStay calls it gets in
+-- each frame, and from whom, for the stay test.
+
+StayProbe = {}
+
+function StayProbe:OnStart()
+    self.collision = {}
+    self.trigger = {}
+    self.others = {}
+end
+
+function StayProbe:Record(calls, collision)
+    local frame = Application.GetFrame()
+    calls[frame] = (calls[frame] or 0) + 1
+    self.others[collision.other:GetName()] = true
+end
+
+function StayProbe:OnCollisionStay(collision)
+    self:Record(self.collision, collision)
+end
+
+function StayProbe:OnTriggerStay(collision)
+    self:Record(self.trigger, collision)
+end
@@ -0,0 +1,53 @@
+-- StayTest — checks that stay callbacks come once per actor pair per frame:
+-- a box resting across the seam of two Rigidbodies on one Floor actor
+-- touches it through two contacts, and its tall trigger overlaps both of
+-- them too, yet each side gets exactly one OnCollisionStay and one
+-- OnTriggerStay in every frame.
+
+StayTest = {
+    step = 0,
+    failed = false,
+}
+
+function StayTest:Check(condition, message)
+    if not condition then
+        self.failed = true
+        Debug.LogError("FAIL stay: " .. message)
+    end
+end
+
+-- One call in each frame from the first to the last, with no gaps.
+function StayTest:CheckCalls(calls, name, fn, now)
+    local first = nil
+    for frame in pairs(calls) do
+        if not first or frame < first then first = frame end
+    end
+    self:Check(first ~= nil and first < now - 40, name .. " got no " .. fn .. " in time")
+    if not first then return end
+    for frame = first, now - 1 do
+        local count = calls[frame] or 0
+        self:Check(count == 1, name .. " got " .. count .. " " .. fn .. " in frame " .. frame)
+    end
+end
+
+function StayTest:OnUpdate()
+    self.step = self.step + 1
+
+    if self.step == 60 then
+        local now = Application.GetFrame()
+        local floor = Actor.Find("Floor"):GetComponent("StayProbe")
+        local box = Actor.Find("Box"):GetComponent("StayProbe")
+
+        self:CheckCalls(floor.collision, "Floor", "OnCollisionStay", now)
+        self:CheckCalls(floor.trigger, "Floor", "OnTriggerStay", now)
+        self:CheckCalls(box.collision, "Box", "OnCollisionStay", now)
+        self:CheckCalls(box.trigger, "Box", "OnTriggerStay", now)
+        self:Check(floor.others["Box"] and not floor.others["Floor"], "Floor's stays were not all from Box")
+        self:Check(box.others["Floor"] and not box.others["Box"], "Box's stays were not all from Floor")
+
+        if not self.failed then
+            Debug.Log("PASS stay")
+        end
+        Application.Quit()
+    end
+end
@@ -0,0 +1,9 @@
+-- StreamProbe — counts the updates its streamed actor gets.
+
+StreamProbe = {
+    updates = 0,
+}
+
+function StreamProbe:OnUpdate()
+    self.updates = self.updates + 1
+end
@@ -0,0 +1,102 @@
+-- StreamingTest — sweeps the camera across a streamed row of cells and back,
+-- checking that only the cells near it load and run, that every cell loads
+-- once, and that a thawed character keeps its body and controller state and
+-- the Rider parented to it.
+
+StreamingTest = {
+    step = 0,
+    failed = false,
+}
+
+local CELLS = 8
+local CELL_SIZE = 10
+
+function StreamingTest:Check(condition, message)
+    if not condition then
+        self.failed = true
+        Debug.LogError("FAIL streaming: " .. message)
+    end
+end
+
+-- Rider hangs one unit above Runner and moves its kinematic body along.
+function StreamingTest:CheckRider(runner, when)
+    local rider = Actor.Find("Rider")
+    local transform = rider:GetComponent("Transform")
+    local parent = transform:GetParent()
+    self:Check(parent ~= nil and parent:GetName() == "Runner", "Rider lost its parent " .. when)
+    local r = runner:GetComponent("Rigidbody"):GetPosition()
+    local w = transform:GetWorldPosition()
+    self:Check(math.abs(w.x - r.x) < 1e-3 and math.abs(w.y - (r.y - 1)) < 1e-3,
+               "Rider at " .. w.x .. ", " .. w.y .. " with Runner at " .. r.x .. ", " .. r.y .. " " .. when)
+    local body = rider:GetComponent("Rigidbody"):GetPosition()
+    self:Check(math.abs(body.x - w.x) < 1e-3 and math.abs(body.y - w.y) < 1e-3,
+               "Rider's body stopped following " .. when)
+end
+
+function StreamingTest:OnUpdate()
+    self.step = self.step + 1
+    local runner = Actor.Find("Runner")
+
+    if self.step == 1 then
+        Camera.SetPosition(5, 5)
+
+    elseif self.step == 2 then
+        -- Streamed actors join the scene a frame after their cell loads.
+        local stats = Scene.GetStreamingStats()
+        self:Check(stats.cells == CELLS, "expected " .. CELLS .. " cells, got " .. stats.cells)
+        self:Check(#Actor.FindAll("Post") == 1, "cells away from the camera loaded with the scene")
+        local rider = Actor.Find("Rider")
+        self:Check(rider:GetComponent("Transform"):SetParent(runner, false), "Rider could not be parented to Runner")
+
+    elseif self.step == 30 then
+        -- Settled on the ground; remember the state to compare after the thaw.
+        local controller = runner:GetComponent("CharacterController2D")
+        self:Check(controller:IsGrounded(), "Runner is not on the ground")
+        self.runner_y = runner:GetComponent("Rigidbody"):GetPosition().y
+        self:CheckRider(runner, "before the sweep")
+
+    elseif self.step > 30 and self.step <= 30 + CELLS * CELL_SIZE / 2 then
+        -- Two units a frame to the far end; at most the cells under and
+        -- just behind the camera are awake.
+        local x = 5 + (self.step - 30) * 2
+        Camera.SetPosition(x, 5)
+        local awake = 0
+        for _, post in ipairs(Actor.FindAll("Post")) do
+            if not post:IsFrozen() then awake = awake + 1 end
+        end
+        self:Check(awake <= 2, awake .. " cells awake with the camera at x " .. x)
+        if x > 20 then self:Check(runner:IsFrozen(), "Runner still awake with the camera at x " .. x) end
+
+    elseif self.step == 31 + CELLS * CELL_SIZE / 2 then
+        local posts = Actor.FindAll("Post")
+        self:Check(#posts == CELLS, "the sweep loaded " .. #posts .. " of " .. CELLS .. " cells")
+        for _, post in ipairs(posts) do
+            self:Check(post:GetComponent("StreamProbe").updates > 0, "a Post never ran")
+        end
+        self.first_updates = posts[1]:GetComponent("StreamProbe").updates
+        Camera.SetPosition(5, 5)
+
+    elseif self.step == 32 + CELLS * CELL_SIZE / 2 then
+        -- Thawed during the last frame. A controller that started over
+        -- would report landing again.
+        self:Check(not runner:IsFrozen(), "Runner did not thaw")
+        local controller = runner:GetComponent("CharacterController2D")
+        self:Check(controller:IsGrounded(), "Runner is not on the ground after the thaw")
+        self:Check(not controller:JustLanded(), "Runner's controller state was reset by the thaw")
+        local y = runner:GetComponent("Rigidbody"):GetPosition().y
+        self:Check(math.abs(y - self.runner_y) < 1e-3, "Runner moved from " .. self.runner_y .. " to " .. y)
+
+        local stats = Scene.GetStreamingStats()
+        self:Check(stats.unloaded_entries == 0, stats.unloaded_entries .. " entries never loaded")
+        self:Check(stats.frozen_actors == CELLS - 1, stats.frozen_actors .. " actors frozen after the return")
+
+    elseif self.step == 40 + CELLS * CELL_SIZE / 2 then
+        local first = Actor.FindAll("Post")[1]:GetComponent("StreamProbe").updates
+        self:Check(first > self.first_updates, "the first Post did not resume")
+        self:Check(runner:GetComponent("CharacterController2D"):IsGrounded(), "Runner fell after the thaw")
+        self:CheckRider(runner, "after the thaw")
+
+        if not self.failed then Debug.Log("PASS streaming") end
+        Application.Quit()
+    end
+end
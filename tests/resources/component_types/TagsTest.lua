@@ -0,0 +1,62 @@
+-- TagsTest — checks tag queries against tags.scene, then after adding,
+-- removing, destroying and instantiating tagged actors.
+--
+--   A [red, big]   B [red]   C [blue]   D []   template "tagged" [spawned, red]
+
+TagsTest = {
+    step = 0,
+    failed = false,
+}
+
+function TagsTest:Check(condition, message)
+    if not condition then
+        self.failed = true
+        Debug.LogError("FAIL tags: " .. message)
+    end
+end
+
+-- Member order is unspecified, so compare sorted names.
+function TagsTest:Names(actors)
+    local names = {}
+    for i = 1, #actors do names[i] = actors[i]:GetName() end
+    table.sort(names)
+    return table.concat(names, ",")
+end
+
+function TagsTest:OnUpdate()
+    self.step = self.step + 1
+
+    if self.step == 1 then
+        self:Check(self:Names(Actor.FindByTags("red")) == "A,B",
+            "FindByTags red got " .. self:Names(Actor.FindByTags("red")))
+        self:Check(self:Names(Actor.FindByTags({ "red", "big" })) == "A",
+            "FindByTags red+big got " .. self:Names(Actor.FindByTags({ "red", "big" })))
+        self:Check(Actor.CountByTags("red") == 2, "CountByTags red got " .. Actor.CountByTags("red"))
+        self:Check(Actor.CountByTags({ "red", "big" }) == 1, "CountByTags red+big wrong")
+        self:Check(Actor.CountByTags("unknown") == 0, "CountByTags of an unknown tag is not 0")
+        self:Check(#Actor.FindByTags({ "red", "unknown" }) == 0, "FindByTags with an unknown tag is not empty")
+
+        local a = Actor.Find("A")
+        local d = Actor.Find("D")
+        self:Check(a:HasTag("big"), "A has no big tag")
+        self:Check(not d:HasTag("red"), "D has a red tag")
+
+        d:AddTag("red")
+        d:AddTag("red")
+        a:RemoveTag("big")
+        Actor.Destroy(Actor.Find("B"))
+        Actor.Instantiate("tagged")
+
+    elseif self.step == 2 then
+        self:Check(self:Names(Actor.FindByTags("red")) == "A,D,Spawned",
+            "FindByTags red after changes got " .. self:Names(Actor.FindByTags("red")))
+        self:Check(Actor.CountByTags("red") == 3, "CountByTags red after changes got " .. Actor.CountByTags("red"))
+        self:Check(Actor.CountByTags("big") == 0, "A still counted as big")
+        self:Check(not Actor.Find("A"):HasTag("big"), "A still has the big tag")
+        self:Check(self:Names(Actor.FindByTags({ "spawned", "red" })) == "Spawned", "template tags missing")
+        self:Check(self:Names(Actor.FindByTags("blue")) == "C", "blue changed")
+
+        if not self.failed then Debug.Log("PASS tags") end
+        Application.Quit()
+    end
+end
@@ -0,0 +1,28 @@
+-- WorkerProbe — isolated component for the workers test. On its first
+-- update it spawns, destroys its victim, emits and reports to WorkersTest;
+-- every update it sends back what it sees of Time and Input.
+
+WorkerProbe = {
+    isolated = true,
+    test_id = 0,
+    victim = -1,
+    acted = false,
+}
+
+function WorkerProbe:OnUpdate()
+    if not self.acted then
+        self.acted = true
+        Actor.Instantiate("tagged")
+        Actor.Destroy(self.victim)
+        Event.Emit("worker_probe", self.actor_id)
+        Actor.Send(self.test_id, "OnProbe", self.actor_id)
+
+        local ok, err = pcall(function() leaked_from_worker = true end)
+        Actor.Send(self.test_id, "OnGlobalWrite", ok and "accepted" or tostring(err))
+    end
+
+    local mouse = Input.GetMousePosition()
+    Actor.Send(self.test_id, "OnSnapshot", string.format("%d %d %.6f %.6f %.6f %.3f %.3f %s",
+        Application.GetFrame(), Time.GetFrameCount(), Time.GetDeltaTime(), Time.GetTotalTime(),
+        Time.GetTimeScale(), mouse.x, mouse.y, tostring(Input.GetKey("space"))))
+end
@@ -0,0 +1,10 @@
+-- WorkerVictim — records the order its actors are destroyed in a global for
+-- the workers test.
+
+WorkerVictimDestroyed = {}
+
+WorkerVictim = {}
+
+function WorkerVictim:OnDestroy()
+    table.insert(WorkerVictimDestroyed, self.actor:GetID())
+end
@@ -0,0 +1,103 @@
+-- WorkersTest — runs four isolated WorkerProbe components in two worker
+-- states (game.config sets lua_worker_states) and checks that their
+-- Instantiate, Destroy, Event.Emit and Actor.Send commands replay in worker
+-- order, then submission order, that a worker cannot assign a global, and
+-- that the Time and Input they read match the main state's frame.
+
+WorkersTest = {
+    step = 0,
+    failed = false,
+    snapshots = 0,
+}
+
+local WORKERS = 2
+
+function WorkersTest:Check(condition, message)
+    if not condition then
+        self.failed = true
+        Debug.LogError("FAIL workers: " .. message)
+    end
+end
+
+function WorkersTest:OnStart()
+    self.log = {}
+    self.global_errors = {}
+    -- Numbers cross states as floats.
+    Event.Subscribe("worker_probe", function(id) table.insert(self.log, string.format("emit %d", id)) end)
+end
+
+-- Worker N hosts the actors with id % WORKERS == N; each worker's commands
+-- replay together, its instances in actor id order.
+function WorkersTest:ExpectedOrder()
+    local ids = {}
+    for _, probe in ipairs(Actor.FindAll("Probe")) do table.insert(ids, probe:GetID()) end
+    table.sort(ids, function(a, b)
+        if a % WORKERS ~= b % WORKERS then return a % WORKERS < b % WORKERS end
+        return a < b
+    end)
+    return ids
+end
+
+function WorkersTest:OnProbe(id)
+    -- Each probe spawns and destroys before it sends, so the counts tell
+    -- where its commands fell among the others'.
+    table.insert(self.log, string.format("send %d spawned %d victims %d", id, #Actor.FindAll("Spawned"),
+                                         #Actor.FindAll("Victim")))
+end
+
+function WorkersTest:OnGlobalWrite(result)
+    table.insert(self.global_errors, result)
+end
+
+function WorkersTest:OnSnapshot(seen)
+    self.snapshots = self.snapshots + 1
+    self:Check(seen == self.expected_snapshot,
+               "worker saw '" .. seen .. "', main state '" .. tostring(self.expected_snapshot) .. "'")
+end
+
+function WorkersTest:OnUpdate()
+    self.step = self.step + 1
+
+    -- Workers run after this OnUpdate, in the same frame.
+    local mouse = Input.GetMousePosition()
+    self.expected_snapshot = string.format("%d %d %.6f %.6f %.6f %.3f %.3f %s",
+        Application.GetFrame(), Time.GetFrameCount(), Time.GetDeltaTime(), Time.GetTotalTime(),
+        Time.GetTimeScale(), mouse.x, mouse.y, tostring(Input.GetKey("space")))
+
+    if self.step == 1 then
+        self:Check(self.actor:GetID() == 0, "WorkersTest is not actor 0, the probes' test_id")
+        local stub = Actor.Find("Probe"):GetComponent("WorkerProbe")
+        self:Check(stub ~= nil and stub.isolated_worker ~= nil, "WorkerProbe is not hosted in a worker state")
+
+    elseif self.step == 2 then
+        local order = self:ExpectedOrder()
+        local expected = {}
+        for i, id in ipairs(order) do
+            table.insert(expected, "emit " .. id)
+            table.insert(expected, "send " .. id .. " spawned " .. i .. " victims " .. (#order - i))
+        end
+        self:Check(table.concat(self.log, ", ") == table.concat(expected, ", "),
+                   "replayed " .. table.concat(self.log, ", ") .. "; expected " .. table.concat(expected, ", "))
+
+        -- Probe n destroys victim n + 4.
+        local victims = {}
+        for _, id in ipairs(order) do table.insert(victims, id + 4) end
+        self:Check(table.concat(WorkerVictimDestroyed, " ") == table.concat(victims, " "),
+                   "victims destroyed in order " .. table.concat(WorkerVictimDestroyed, " ")
+                   .. ", expected " .. table.concat(victims, " "))
+        self:Check(#Actor.FindAll("Spawned") == #order, #Actor.FindAll("Spawned") .. " actors spawned")
+
+        self:Check(#self.global_errors == #order, #self.global_errors .. " global write reports")
+        for _, result in ipairs(self.global_errors) do
+            self:Check(string.find(result, "cannot assign global", 1, true) ~= nil,
+                       "a worker global write was not rejected: " .. result)
+        end
+        self:Check(leaked_from_worker == nil, "a worker global reached the main state")
+
+    elseif self.step == 10 then
+        -- Four probes from frame 1 through 9 (this frame's reports are still to come).
+        self:Check(self.snapshots == 4 * 9, self.snapshots .. " Time/Input snapshots reported")
+        if not self.failed then Debug.Log("PASS workers") end
+        Application.Quit()
+    end
+end
@@ -0,0 +1,88 @@
+-- LoadingTest — checks incremental scene loading with
+-- scene_actors_per_frame = 4: the 19 Crates of the initial scene arrive a
+-- few per frame until Scene.IsLoading() turns false, and a second
+-- Scene.Load made while loading_next is still being read stops that read,
+-- so none of its remaining Boxes show up after loading_last replaces it.
+
+LoadingTest = {
+    phase = 0,
+    waited = 0,
+    failed = false,
+}
+
+local PER_FRAME = 4
+
+function LoadingTest:Check(condition, message)
+    if not condition then
+        self.failed = true
+        Debug.LogError("FAIL loading: " .. message)
+    end
+end
+
+function LoadingTest:Next()
+    self.phase = self.phase + 1
+    self.waited = 0
+end
+
+-- Advances once `ready` holds; fails the run if it never does.
+function LoadingTest:Wait(ready, what)
+    if ready then return true end
+    self.waited = self.waited + 1
+    if self.waited > 10 then
+        self:Check(false, "timed out waiting for " .. what)
+        Application.Quit()
+    end
+    return false
+end
+
+function LoadingTest:OnStart()
+    self.counts = {}
+end
+
+function LoadingTest:OnUpdate()
+    if self.phase == 0 then
+        table.insert(self.counts, #Actor.FindAll("Crate"))
+        if not self:Wait(not Scene.IsLoading(), "loading to finish") then return end
+
+        local frames = 0
+        for i = 2, #self.counts do
+            local added = self.counts[i] - self.counts[i - 1]
+            if added > 0 then frames = frames + 1 end
+            self:Check(added <= PER_FRAME, added .. " Crates arrived in one frame")
+        end
+        self:Check(self.counts[1] < 19, "all Crates arrived in the load frame")
+        self:Check(frames >= 3, "Crates arrived over " .. frames .. " frames")
+        self:Check(self.counts[#self.counts] == 19, self.counts[#self.counts] .. " of 19 Crates loaded")
+
+        Scene.DontDestroy(self.actor)
+        Scene.Load("loading_next")
+        self:Next()
+
+    elseif self.phase == 1 then
+        local ready = Scene.GetCurrent() == "loading_next" and #Actor.FindAll("Box") > 0
+        if not self:Wait(ready, "loading_next to start loading") then return end
+        self:Check(Scene.IsLoading(), "loading_next finished reading in one frame")
+        self.boxes = #Actor.FindAll("Box")
+        Scene.Load("loading_last")
+        self:Next()
+
+    elseif self.phase == 2 then
+        local ready = Scene.GetCurrent() == "loading_last" and not Scene.IsLoading()
+        if not self:Wait(ready, "loading_last to load") then return end
+        self:Check(#Actor.FindAll("Pallet") == 10, #Actor.FindAll("Pallet") .. " of 10 Pallets loaded")
+        self:Check(#Actor.FindAll("Crate") == 0, "Crates survived Scene.Load")
+        self.settled = Application.GetFrame()
+        self:Next()
+
+    elseif self.phase == 3 then
+        -- A few frames on, the cancelled read has added nothing.
+        self:Check(#Actor.FindAll("Box") == 0, #Actor.FindAll("Box") .. " Boxes of the cancelled loading_next appeared")
+        if Application.GetFrame() - self.settled < 5 then return end
+        self:Check(self.boxes < 20, "loading_next was read in full before the second Scene.Load")
+
+        if not self.failed then
+            Debug.Log("PASS loading")
+        end
+        Application.Quit()
+    end
+end
@@ -0,0 +1,220 @@
+//
+//  physics_bench.cpp
+//  FR-Ocean Engine tools
+//
+//  Steps the same Box2D scene twice, once solving islands on the calling
+//  thread and once on the JobSystem (the `parallel_physics` path), and
+//  reports the step times. Both runs must end in bit-identical body states
+//  with the same PostSolve sequence; any difference exits 1.
+//
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "box2d/box2d.h"
+#include "JobSystem.hpp"
+#include "RigidbodyWorld.hpp"
+
+namespace {
+    void PrintUsage(const char* program_name) {
+        std::cout
+            << "Usage: " << program_name << " [options]\n\n"
+            << "Options:\n"
+            << "  --piles <N>     Independent box pyramids on one shared ground (default 64)\n"
+            << "  --rows <N>      Rows per pyramid (default 10)\n"
+            << "  --chains <N>    Jointed chains hanging from the ground (default 4)\n"
+            << "  --steps <N>     Steps per run (default 300)\n"
+            << "  --threads <N>   JobSystem threads including the caller, 0 = all cores (default 0)\n"
+            << "  --help          Print this help message\n";
+    }
+
+    /// Folds every PostSolve, in call order, into one hash.
+    class ImpulseHash : public b2ContactListener {
+    public:
+        uint64_t hash = 1469598103934665603ull;
+        void PostSolve(b2Contact*, const b2ContactImpulse* impulse) override {
+            for (int32 i = 0; i < impulse->count; ++i) {
+                Mix(impulse->normalImpulses[i]);
+                Mix(impulse->tangentImpulses[i]);
+            }
+        }
+    private:
+        void Mix(float value) {
+            uint32_t bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            hash = (hash ^ bits) * 1099511628211ull;
+        }
+    };
+
+    struct Options {
+        int piles = 64;
+        int rows = 10;
+        int chains = 4;
+        int steps = 300;
+        int threads = 0;
+    };
+
+    struct RunResult {
+        std::vector<double> step_ms;
+        std::vector<float> state;   ///< x, y, angle, vx, vy, w per body, creation order
+        uint64_t impulse_hash = 0;
+        int32 bodies = 0;
+        int32 contacts = 0;
+    };
+
+    void BuildScene(b2World& world, const Options& options) {
+        const float pile_spacing = options.rows * 1.2f + 2.0f;
+        const float width = options.piles * pile_spacing + 10.0f;
+
+        b2BodyDef ground_def;
+        b2Body* ground = world.CreateBody(&ground_def);
+        b2EdgeShape floor;
+        floor.SetTwoSided(b2Vec2(-10.0f, 0.0f), b2Vec2(width, 0.0f));
+        ground->CreateFixture(&floor, 0.0f);
+
+        b2PolygonShape box;
+        box.SetAsBox(0.5f, 0.5f);
+        b2FixtureDef box_fixture;
+        box_fixture.shape = &box;
+        box_fixture.density = 1.0f;
+        box_fixture.friction = 0.6f;
+
+        // y is up here; the engine's +y-down gravity only flips the sign.
+        for (int p = 0; p < options.piles; ++p) {
+            const float base_x = p * pile_spacing;
+            for (int row = 0; row < options.rows; ++row) {
+                for (int col = 0; col < options.rows - row; ++col) {
+                    b2BodyDef def;
+                    def.type = b2_dynamicBody;
+                    def.position.Set(base_x + col * 1.05f + row * 0.525f, 0.5f + row * 1.0f);
+                    world.CreateBody(&def)->CreateFixture(&box_fixture);
+                }
+            }
+        }
+
+        b2PolygonShape link;
+        link.SetAsBox(0.5f, 0.125f);
+        b2FixtureDef link_fixture;
+        link_fixture.shape = &link;
+        link_fixture.density = 20.0f;
+        link_fixture.friction = 0.2f;
+        for (int c = 0; c < options.chains; ++c) {
+            const float anchor_x = -8.0f + c * 0.5f;
+            b2Body* previous = ground;
+            for (int i = 0; i < 8; ++i) {
+                b2BodyDef def;
+                def.type = b2_dynamicBody;
+                def.position.Set(anchor_x + 0.5f + i, 20.0f + c * 2.0f);
+                b2Body* body = world.CreateBody(&def);
+                body->CreateFixture(&link_fixture);
+
+                b2RevoluteJointDef joint;
+                joint.Initialize(previous, body, b2Vec2(anchor_x + i, 20.0f + c * 2.0f));
+                world.CreateJoint(&joint);
+                previous = body;
+            }
+        }
+    }
+
+    RunResult Run(const Options& options, bool parallel) {
+        b2World world(b2Vec2(0.0f, -9.8f));
+        ImpulseHash listener;
+        world.SetContactListener(&listener);
+        if (parallel) world.SetParallelFor(&RigidbodyWorld::RunSolverTasks, JobSystem::GetThreadCount(), nullptr);
+        BuildScene(world, options);
+
+        using clock = std::chrono::steady_clock;
+        RunResult result;
+        result.step_ms.reserve(static_cast<size_t>(options.steps));
+        for (int i = 0; i < options.steps; ++i) {
+            const auto start = clock::now();
+            world.Step(1.0f / 60.0f, 8, 3);
+            result.step_ms.push_back(std::chrono::duration<double, std::milli>(clock::now() - start).count());
+        }
+
+        // The body list is newest first; reverse it into creation order.
+        std::vector<const b2Body*> bodies;
+        for (const b2Body* b = world.GetBodyList(); b; b = b->GetNext()) bodies.push_back(b);
+        std::reverse(bodies.begin(), bodies.end());
+        for (const b2Body* b : bodies) {
+            const b2Vec2& p = b->GetPosition();
+            const b2Vec2& v = b->GetLinearVelocity();
+            result.state.insert(result.state.end(), { p.x, p.y, b->GetAngle(), v.x, v.y, b->GetAngularVelocity() });
+        }
+        result.impulse_hash = listener.hash;
+        result.bodies = world.GetBodyCount();
+        result.contacts = world.GetContactCount();
+        return result;
+    }
+
+    double Percentile(std::vector<double> values, double p) {
+        if (values.empty()) return 0.0;
+        const size_t at = std::min(values.size() - 1, static_cast<size_t>(p * (values.size() - 1) + 0.5));
+        std::nth_element(values.begin(), values.begin() + static_cast<std::ptrdiff_t>(at), values.end());
+        return values[at];
+    }
+
+    double Mean(const std::vector<double>& values) {
+        double total = 0.0;
+        for (double v : values) total += v;
+        return values.empty() ? 0.0 : total / static_cast<double>(values.size());
+    }
+}
+
+int main(int argc, char* argv[]) {
+    Options options;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--help" || arg == "-h") { PrintUsage(argv[0]); return 0; }
+        int* target = nullptr;
+        if (arg == "--piles") target = &options.piles;
+        else if (arg == "--rows") target = &options.rows;
+        else if (arg == "--chains") target = &options.chains;
+        else if (arg == "--steps") target = &options.steps;
+        else if (arg == "--threads") target = &options.threads;
+        if (target && i + 1 < argc) {
+            try { *target = std::max(0, std::stoi(argv[++i])); } catch (...) {}
+            continue;
+        }
+        std::cerr << "Unknown option: " << arg << "\n";
+        PrintUsage(argv[0]);
+        return 1;
+    }
+    options.rows = std::max(1, options.rows);
+
+    JobSystem::Init(options.threads);
+    const RunResult sequential = Run(options, false);
+    const RunResult parallel = Run(options, true);
+    const int threads = JobSystem::GetThreadCount();
+    JobSystem::Shutdown();
+
+    std::cerr << std::fixed << std::setprecision(3)
+              << sequential.bodies << " bodies, " << sequential.contacts << " contacts, "
+              << options.steps << " steps\n"
+              << "  sequential:          mean " << Mean(sequential.step_ms) << " ms, p95 "
+              << Percentile(sequential.step_ms, 0.95) << " ms\n"
+              << "  parallel (" << std::setw(2) << threads << " threads): mean " << Mean(parallel.step_ms)
+              << " ms, p95 " << Percentile(parallel.step_ms, 0.95) << " ms ("
+              << std::setprecision(2) << Mean(sequential.step_ms) / std::max(1e-9, Mean(parallel.step_ms))
+              << "x)\n";
+
+    if (sequential.state.size() != parallel.state.size()
+        || std::memcmp(sequential.state.data(), parallel.state.data(), sequential.state.size() * sizeof(float)) != 0) {
+        size_t at = 0;
+        while (at < sequential.state.size() && at < parallel.state.size()
+               && std::memcmp(&sequential.state[at], &parallel.state[at], sizeof(float)) == 0) ++at;
+        std::cerr << "Body states differ, first at body " << at / 6 << "\n";
+        return 1;
+    }
+    if (sequential.impulse_hash != parallel.impulse_hash) {
+        std::cerr << "PostSolve sequences differ\n";
+        return 1;
+    }
+    std::cerr << "Body states and PostSolve sequence identical\n";
+    return 0;
+}
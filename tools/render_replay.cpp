@@ -0,0 +1,197 @@
+//
+//  render_replay.cpp
+//  FR-Ocean Engine tools
+//
+//  Feeds a --capture-render file back through the renderer as fast as
+//  possible and reports per-frame submission time, draw calls and batches.
+//  No scripts or physics run, so the numbers isolate the render stage.
+//
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "SDL2/SDL.h"
+#include "SDL2_image/SDL_image.h"
+#include "ConfigManager.hpp"
+#include "EngineException.hpp"
+#include "Logger.hpp"
+#include "RenderCapture.hpp"
+#include "RenderCommandBuffer.hpp"
+#include "Renderer.hpp"
+#include "TextDB.hpp"
+
+namespace {
+    void PrintUsage(const char* program_name) {
+        std::cout
+            << "Usage: " << program_name << " <capture> [options]\n\n"
+            << "Options:\n"
+            << "  --resources <path>   Resources the capture was recorded with (default: resources/)\n"
+            << "  --loops <N>          Replay the capture N times (default 1)\n"
+            << "  --csv <path>         Write per-frame results to <path> instead of stdout\n"
+            << "  --help               Print this help message\n";
+    }
+
+    struct FrameResult {
+        int frame;
+        double submit_ms;   ///< clear + RenderCommandBuffer::Execute
+        double present_ms;
+        RenderStats stats;
+    };
+
+    double Percentile(std::vector<double> values, double p) {
+        if (values.empty()) return 0.0;
+        const size_t at = std::min(values.size() - 1, static_cast<size_t>(p * (values.size() - 1) + 0.5));
+        std::nth_element(values.begin(), values.begin() + static_cast<std::ptrdiff_t>(at), values.end());
+        return values[at];
+    }
+
+    struct SdlLifecycle {
+        bool sdl_ok = false;
+        bool img_ok = false;
+        ~SdlLifecycle() {
+            if (img_ok) IMG_Quit();
+            if (sdl_ok) SDL_Quit();
+        }
+    };
+}
+
+int main(int argc, char* argv[]) {
+    std::string capture_path;
+    std::string resources_path = "resources/";
+    std::string csv_path;
+    int loops = 1;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--help" || arg == "-h") { PrintUsage(argv[0]); return 0; }
+        if (arg == "--resources" && i + 1 < argc) {
+            resources_path = argv[++i];
+            if (!resources_path.empty() && resources_path.back() != '/') resources_path += '/';
+            continue;
+        }
+        if (arg == "--loops" && i + 1 < argc) {
+            try { loops = std::max(1, std::stoi(argv[++i])); } catch (...) {}
+            continue;
+        }
+        if (arg == "--csv" && i + 1 < argc) {
+            csv_path = argv[++i];
+            continue;
+        }
+        if (arg[0] != '-' && capture_path.empty()) {
+            capture_path = arg;
+            continue;
+        }
+        std::cerr << "Unknown option: " << arg << "\n";
+        PrintUsage(argv[0]);
+        return 1;
+    }
+    if (capture_path.empty()) {
+        PrintUsage(argv[0]);
+        return 1;
+    }
+
+    SdlLifecycle sdl;
+    std::vector<FrameResult> results;
+
+    try {
+        Logger::Init();
+        ConfigManager::SetResourcesPath(resources_path);
+
+        RenderCaptureReader reader;
+        reader.Open(capture_path);
+        const glm::ivec2 resolution = reader.GetResolution();
+        glm::ivec3 clear_color = reader.GetClearColor();
+
+        if (SDL_Init(SDL_INIT_VIDEO) != 0) {
+            throw RenderException(std::string("SDL initialization failed: ") + SDL_GetError());
+        }
+        sdl.sdl_ok = true;
+        if ((IMG_Init(IMG_INIT_PNG) & IMG_INIT_PNG) != IMG_INIT_PNG) {
+            throw RenderException(std::string("SDL_image initialization failed: ") + IMG_GetError());
+        }
+        sdl.img_ok = true;
+
+        {
+            // No vsync: present as fast as the driver allows.
+            Renderer renderer("render_replay", clear_color, resolution, false);
+
+            // Frames are decoded up front so file I/O stays out of the timings.
+            std::vector<RenderFrame> frames;
+            RenderFrame frame;
+            while (reader.ReadFrame(frame)) {
+                frames.push_back(frame);
+            }
+            LOG_INFO("Replaying " + std::to_string(frames.size()) + " frames from " + capture_path);
+
+            using clock = std::chrono::steady_clock;
+            results.reserve(frames.size() * static_cast<size_t>(loops));
+            for (int loop = 0; loop < loops; ++loop) {
+                for (size_t i = 0; i < frames.size(); ++i) {
+                    SDL_Event e;
+                    while (SDL_PollEvent(&e)) {}
+
+                    const auto start = clock::now();
+                    Renderer::clear(clear_color);
+                    RenderCommandBuffer::Execute(frames[i]);
+                    const auto submitted = clock::now();
+                    // Straight to SDL: Helper's present paces frames to 16 ms.
+                    SDL_RenderPresent(Renderer::getSDLRenderer());
+                    const auto presented = clock::now();
+
+                    results.push_back({static_cast<int>(i),
+                        std::chrono::duration<double, std::milli>(submitted - start).count(),
+                        std::chrono::duration<double, std::milli>(presented - submitted).count(),
+                        RenderCommandBuffer::Measure(frames[i])});
+                }
+            }
+        }
+        TextDB::Shutdown();
+    }
+    catch (const EngineException& e) {
+        LOG_FATAL(std::string("render_replay error: ") + e.what());
+        Logger::Shutdown();
+        return 1;
+    }
+
+    std::ofstream csv_file;
+    if (!csv_path.empty()) {
+        csv_file.open(csv_path);
+        if (!csv_file) {
+            std::cerr << "Cannot write " << csv_path << "\n";
+            Logger::Shutdown();
+            return 1;
+        }
+    }
+    std::ostream& csv = csv_path.empty() ? std::cout : csv_file;
+    csv << "frame,submit_ms,present_ms,draw_calls,batches\n" << std::fixed << std::setprecision(4);
+    for (const FrameResult& r : results) {
+        csv << r.frame << ',' << r.submit_ms << ',' << r.present_ms << ','
+            << r.stats.draw_calls << ',' << r.stats.batches << '\n';
+    }
+
+    std::vector<double> submit;
+    double draw_calls = 0.0;
+    double batches = 0.0;
+    for (const FrameResult& r : results) {
+        submit.push_back(r.submit_ms);
+        draw_calls += r.stats.draw_calls;
+        batches += r.stats.batches;
+    }
+    const double n = results.empty() ? 1.0 : static_cast<double>(results.size());
+    double total = 0.0;
+    for (double ms : submit) total += ms;
+
+    std::cerr << std::fixed << std::setprecision(3)
+              << results.size() << " frames: submit mean " << total / n << " ms, p50 "
+              << Percentile(submit, 0.50) << " ms, p95 " << Percentile(submit, 0.95) << " ms, max "
+              << (submit.empty() ? 0.0 : *std::max_element(submit.begin(), submit.end())) << " ms; "
+              << std::setprecision(1) << draw_calls / n << " draw calls, "
+              << batches / n << " batches per frame\n";
+
+    Logger::Shutdown();
+    return 0;
+}